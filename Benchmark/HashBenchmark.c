@@ -0,0 +1,127 @@
+///
+//Micro-benchmark of the hash functions in Data/Hash.h on the engine's real key sets.
+//Reports hashing throughput and the rate of bucket collisions at the hashmap's load factor.
+//
+//Build and run with:
+//	make HashBenchmark && ./HashBenchmark
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../Data/Hash.h"
+#include "../Data/HashMap.h"
+#include "../Data/MemoryPool.h"
+#include "../GObject/GObject.h"
+
+//Number of GObjects to allocate when generating pointer keys
+#define HashBenchmark_NUM_OBJECTS 4096
+//Number of times each key set is hashed when timing throughput
+#define HashBenchmark_REPETITIONS 2000
+
+typedef unsigned long(*HashBenchmark_HashFunc)(void* key, unsigned int keyLength);
+
+//Keys used by the AssetManager's mesh and texture maps
+static const char* assetKeys[] =
+{
+	"Cube", "Sphere", "Cylinder", "Cone", "Pipe", "Torus", "CubeWire", "Square", "Suzanne",
+	"Tetrahedron", "Trash Can", "Bottle", "Target", "Arrow",
+	"Concrete", "Earth", "Checkered", "Wall", "Wood", "White", "Granite", "Test", "Stone"
+};
+
+///
+//Determines the capacity a HashMap will have after the given number of keys are added
+//
+//Parameters:
+//	numKeys: The number of keys in the map
+//
+//Returns:
+//	The power of two capacity of the map
+static unsigned int HashBenchmark_GetCapacity(unsigned int numKeys)
+{
+	unsigned int capacity = 32;
+	while(numKeys * HashMap_MAX_LOAD_DENOMINATOR > capacity * HashMap_MAX_LOAD_NUMERATOR)
+		capacity *= 2;
+	return capacity;
+}
+
+///
+//Hashes a key set and reports throughput and the number of keys which land in an already occupied bucket
+//
+//Parameters:
+//	name: The name of the hash function
+//	Hash: The hash function to measure
+//	keys: Array of pointers to the keys
+//	keyLengths: Array of the length of each key in bytes
+//	numKeys: The number of keys in the key set
+static void HashBenchmark_Measure(const char* name, HashBenchmark_HashFunc Hash, void** keys, unsigned int* keyLengths, unsigned int numKeys)
+{
+	//Throughput
+	volatile unsigned long sink = 0;
+	clock_t start = clock();
+	for(unsigned int r = 0; r < HashBenchmark_REPETITIONS; r++)
+	{
+		for(unsigned int i = 0; i < numKeys; i++)
+		{
+			sink += Hash(keys[i], keyLengths[i]);
+		}
+	}
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	double hashesPerSecond = seconds > 0.0 ? (double)numKeys * HashBenchmark_REPETITIONS / seconds : 0.0;
+
+	//Collision rate
+	unsigned int capacity = HashBenchmark_GetCapacity(numKeys);
+	unsigned char occupied[1 << 16];
+	memset(occupied, 0, sizeof(occupied));
+	unsigned int collisions = 0;
+	for(unsigned int i = 0; i < numKeys; i++)
+	{
+		unsigned int bucket = Hash(keys[i], keyLengths[i]) & (capacity - 1);
+		if(occupied[bucket]) collisions++;
+		else occupied[bucket] = 1;
+	}
+
+	printf("\t%-16s %10.1f Mhash/s\t%4u / %4u keys collide (%5.1f%%) in %u buckets\n",
+		name, hashesPerSecond / 1000000.0, collisions, numKeys, 100.0f * collisions / numKeys, capacity);
+}
+
+int main(void)
+{
+	//Asset keys
+	unsigned int numAssetKeys = sizeof(assetKeys) / sizeof(assetKeys[0]);
+	void* stringKeys[sizeof(assetKeys) / sizeof(assetKeys[0])];
+	unsigned int stringLengths[sizeof(assetKeys) / sizeof(assetKeys[0])];
+	for(unsigned int i = 0; i < numAssetKeys; i++)
+	{
+		stringKeys[i] = (void*)assetKeys[i];
+		stringLengths[i] = strlen(assetKeys[i]);
+	}
+
+	//GObject* keys used by the OctTree's log map are addresses within the object pool
+	MemoryPool* objectPool = MemoryPool_Allocate();
+	MemoryPool_Initialize(objectPool, sizeof(GObject));
+	for(unsigned int i = 0; i < HashBenchmark_NUM_OBJECTS; i++)
+		MemoryPool_RequestID(objectPool);
+
+	static GObject* objects[HashBenchmark_NUM_OBJECTS];
+	static void* pointerKeys[HashBenchmark_NUM_OBJECTS];
+	static unsigned int pointerLengths[HashBenchmark_NUM_OBJECTS];
+	for(unsigned int i = 0; i < HashBenchmark_NUM_OBJECTS; i++)
+	{
+		objects[i] = (GObject*)MemoryPool_RequestAddress(objectPool, i);
+		pointerKeys[i] = &objects[i];
+		pointerLengths[i] = sizeof(GObject*);
+	}
+
+	printf("Asset name keys (%u):\n", numAssetKeys);
+	HashBenchmark_Measure("SDBM", Hash_SDBM, stringKeys, stringLengths, numAssetKeys);
+	HashBenchmark_Measure("FNV-1a 64", Hash_FNV1a64, stringKeys, stringLengths, numAssetKeys);
+
+	printf("GObject pointer keys (%u):\n", HashBenchmark_NUM_OBJECTS);
+	HashBenchmark_Measure("SDBM", Hash_SDBM, pointerKeys, pointerLengths, HashBenchmark_NUM_OBJECTS);
+	HashBenchmark_Measure("FNV-1a 64", Hash_FNV1a64, pointerKeys, pointerLengths, HashBenchmark_NUM_OBJECTS);
+	HashBenchmark_Measure("Multiply-shift", Hash_MultiplyShift, pointerKeys, pointerLengths, HashBenchmark_NUM_OBJECTS);
+
+	MemoryPool_Free(objectPool);
+	return 0;
+}
@@ -0,0 +1,216 @@
+///
+//Benchmark of keeping the oct tree up to date as objects move.
+//Compares updating every object in place, updating only the moved (dirty) objects in place,
+//and rebuilding the tree from scratch serially and across a worker pool,
+//for several object counts and fractions of moving objects, in classic and loose oct trees.
+//
+//Build and run with:
+//	make OctTreeBenchmark && ./OctTreeBenchmark
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../Data/OctTree.h"
+#include "../Data/MemoryPool.h"
+#include "../Data/WorkerPool.h"
+#include "../GObject/GObject.h"
+#include "../Collision/SphereCollider.h"
+#include "../Manager/CollisionManager.h"
+
+//Half the width of the simulated world
+#define OctTreeBenchmark_WORLD_EXTENT 100.0f
+//Radius of every object's sphere collider
+#define OctTreeBenchmark_RADIUS 0.5f
+//Largest distance an object moves along each axis in one frame
+#define OctTreeBenchmark_STEP 1.0f
+//Number of frames each measurement is averaged over
+#define OctTreeBenchmark_FRAMES 5
+
+static const unsigned int objectCounts[] = { 1000, 10000, 100000 };
+static const float movingFractions[] = { 0.01f, 0.1f, 0.25f, 0.5f, 1.0f };
+static const float loosenesses[] = { 0.0f, OctTree_DEFAULT_LOOSENESS };
+
+///
+//Gets the current wall clock time
+//
+//Returns:
+//	The time in seconds from an arbitrary point
+static double OctTreeBenchmark_GetTime(void)
+{
+#ifdef _WIN32
+	return (double)clock() / CLOCKS_PER_SEC;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+#endif
+}
+
+///
+//Gets a random float in a range
+//
+//Parameters:
+//	extent: The magnitude of the range's bounds
+//
+//Returns:
+//	A random float between -extent and extent
+static float OctTreeBenchmark_Random(float extent)
+{
+	return ((float)rand() / RAND_MAX * 2.0f - 1.0f) * extent;
+}
+
+///
+//Moves a fraction of the objects in a pool a short random distance, keeping them inside the world
+//
+//Parameters:
+//	pool: The memory pool of objects
+//	fraction: The fraction of the objects to move
+//	moved: A pointer to an array to fill with the moved objects, as the object manager's dirty set would be
+//
+//Returns:
+//	The number of objects moved
+static unsigned int OctTreeBenchmark_MoveObjects(MemoryPool* pool, float fraction, GObject** moved)
+{
+	unsigned int numLive = MemoryPool_GetNumLive(pool);
+	unsigned int stride = (unsigned int)(1.0f / fraction + 0.5f);
+	unsigned int first = rand() % stride;
+	unsigned int numMoved = 0;
+
+	for(unsigned int i = first; i < numLive; i += stride)
+	{
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
+		moved[numMoved++] = obj;
+		for(int j = 0; j < 3; j++)
+		{
+			float* component = obj->frameOfReference->position->components + j;
+			*component += OctTreeBenchmark_Random(OctTreeBenchmark_STEP);
+
+			float limit = OctTreeBenchmark_WORLD_EXTENT - OctTreeBenchmark_RADIUS;
+			if(*component > limit) *component = limit;
+			if(*component < -limit) *component = -limit;
+		}
+	}
+
+	return numMoved;
+}
+
+///
+//Measures one object count
+//
+//Parameters:
+//	numObjects: The number of objects to simulate
+//	workers: The worker pool to rebuild with
+//	looseness: The looseness of the oct tree, 0 for a classic oct tree
+static void OctTreeBenchmark_Measure(unsigned int numObjects, WorkerPool* workers, float looseness)
+{
+	//Reserve every ID first, the pool's storage moves as it grows
+	MemoryPool* pool = MemoryPool_Allocate();
+	MemoryPool_Initialize(pool, sizeof(GObject));
+	for(unsigned int i = 0; i < numObjects; i++)
+		MemoryPool_RequestID(pool);
+
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, i);
+		memset(obj, 0, sizeof(GObject));
+
+		obj->frameOfReference = FrameOfReference_Allocate();
+		FrameOfReference_Initialize(obj->frameOfReference);
+		for(int j = 0; j < 3; j++)
+			obj->frameOfReference->position->components[j] = OctTreeBenchmark_Random(OctTreeBenchmark_WORLD_EXTENT - OctTreeBenchmark_RADIUS);
+
+		obj->collider = Collider_Allocate();
+		Collider_Initialize(obj->collider, COLLIDER_SPHERE, NULL);
+		obj->collider->data->sphereDataID = SphereCollider_AllocateData();
+		struct ColliderData_Sphere* sphere = (struct ColliderData_Sphere*)Collider_GetColliderData(obj->collider);
+		sphere->x = sphere->y = sphere->z = 0.0f;
+		sphere->radius = OctTreeBenchmark_RADIUS;
+	}
+
+	OctTree* tree = OctTree_Allocate();
+	tree->maxDepth = 6;
+	tree->looseness = looseness;
+	OctTree_Initialize(tree,
+		-OctTreeBenchmark_WORLD_EXTENT, OctTreeBenchmark_WORLD_EXTENT,
+		-OctTreeBenchmark_WORLD_EXTENT, OctTreeBenchmark_WORLD_EXTENT,
+		-OctTreeBenchmark_WORLD_EXTENT, OctTreeBenchmark_WORLD_EXTENT);
+
+	//Populate the tree and every object's log
+	OctTree_RebuildWithMemoryPool(tree, pool, NULL, workers);
+
+	GObject** moved = (GObject**)malloc(sizeof(GObject*) * numObjects);
+
+	printf("%u objects, %s oct tree, %u leaves, %u occupants:\n", numObjects, looseness != 0.0f ? "loose" : "classic", tree->leaves->size, tree->occupants->size);
+	printf("\t%8s %14s %14s %16s %16s\n", "moving", "update (ms)", "dirty (ms)", "rebuild 1T (ms)", "rebuild MT (ms)");
+
+	for(unsigned int f = 0; f < sizeof(movingFractions) / sizeof(movingFractions[0]); f++)
+	{
+		double updateTime = 0.0, dirtyTime = 0.0, serialTime = 0.0, parallelTime = 0.0;
+		for(unsigned int frame = 0; frame < OctTreeBenchmark_FRAMES; frame++)
+		{
+			//Incremental updates include compaction, which the collision pass does once per frame
+			OctTreeBenchmark_MoveObjects(pool, movingFractions[f], moved);
+			double start = OctTreeBenchmark_GetTime();
+			OCtTree_UpdateWithMemoryPool(tree, pool);
+			OctTree_Compact(tree);
+			updateTime += OctTreeBenchmark_GetTime() - start;
+
+			unsigned int numMoved = OctTreeBenchmark_MoveObjects(pool, movingFractions[f], moved);
+			start = OctTreeBenchmark_GetTime();
+			for(unsigned int i = 0; i < numMoved; i++)
+				OctTree_UpdateObject(tree, moved[i]);
+			OctTree_Compact(tree);
+			dirtyTime += OctTreeBenchmark_GetTime() - start;
+
+			OctTreeBenchmark_MoveObjects(pool, movingFractions[f], moved);
+			start = OctTreeBenchmark_GetTime();
+			OctTree_RebuildWithMemoryPool(tree, pool, NULL, NULL);
+			serialTime += OctTreeBenchmark_GetTime() - start;
+
+			OctTreeBenchmark_MoveObjects(pool, movingFractions[f], moved);
+			start = OctTreeBenchmark_GetTime();
+			OctTree_RebuildWithMemoryPool(tree, pool, NULL, workers);
+			parallelTime += OctTreeBenchmark_GetTime() - start;
+		}
+
+		printf("\t%7.0f%% %14.3f %14.3f %16.3f %16.3f\n", 100.0f * movingFractions[f],
+			1000.0 * updateTime / OctTreeBenchmark_FRAMES,
+			1000.0 * dirtyTime / OctTreeBenchmark_FRAMES,
+			1000.0 * serialTime / OctTreeBenchmark_FRAMES,
+			1000.0 * parallelTime / OctTreeBenchmark_FRAMES);
+	}
+
+	free(moved);
+	OctTree_Free(tree);
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, i);
+		Collider_Free(obj->collider);
+		FrameOfReference_Free(obj->frameOfReference);
+	}
+	MemoryPool_Free(pool);
+}
+
+int main(void)
+{
+	srand(1);
+	CollisionManager_Initialize();
+
+	WorkerPool* workers = WorkerPool_Allocate();
+	WorkerPool_Initialize(workers, WorkerPool_GetNumProcessors() - 1);
+	printf("Rebuilding across %u threads\n", WorkerPool_GetConcurrency(workers));
+
+	for(unsigned int i = 0; i < sizeof(objectCounts) / sizeof(objectCounts[0]); i++)
+		for(unsigned int j = 0; j < sizeof(loosenesses) / sizeof(loosenesses[0]); j++)
+			OctTreeBenchmark_Measure(objectCounts[i], workers, loosenesses[j]);
+
+	WorkerPool_Free(workers);
+	CollisionManager_Free();
+	return 0;
+}
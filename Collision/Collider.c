@@ -3,6 +3,8 @@
 #include "ColliderEnum.h"
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
 
 #include "../Manager/CollisionManager.h"
 
@@ -37,6 +39,10 @@ void Collider_Initialize(Collider* collider, ColliderType type, Mesh* rep)
 	collider->currentCollisions = LinkedList_Allocate();
 	LinkedList_Initialize(collider->currentCollisions);
 
+	//Colliders start on the first layer, colliding with everything
+	collider->layer = 0;
+	collider->collisionMask = Collider_ALL_LAYERS;
+
 	//Initialize with debug mode on & setup debug settings
 	collider->debug = 0;
 	collider->representation = rep;
@@ -142,7 +148,109 @@ void Collider_Update(Collider* collider, FrameOfReference* frame)
 		case COLLIDER_AABB:
 			AABBCollider_Update(collider->data->AABBDataID, frame);
 			break;
+		case COLLIDER_CONVEXHULL:
+			ConvexHullCollider_Update(collider->data->convexHullData, frame);
+			break;
 		default:
 			break;
 	}
 }
+
+///
+//Gets the world space axis aligned bounds of a collider oriented by a frame of reference.
+//Convex hulls are bounded by the world AABB of their minimum AABB.
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the bounds in
+//	collider: A pointer to the collider to get the bounds of
+//	frame: A pointer to the frame of reference orienting the collider
+//
+//Returns:
+//	0 if the collider has no finite bounds (rays), else 1
+unsigned char Collider_GetWorldAABB(struct ColliderData_AABB* dest, Collider* collider, FrameOfReference* frame)
+{
+	void* colliderData = Collider_GetColliderData(collider);
+
+	switch(collider->type)
+	{
+	case COLLIDER_SPHERE:
+	{
+		float scaledRadius = SphereCollider_GetScaledRadius(colliderData, frame);
+		for(int i = 0; i < 3; i++)
+		{
+			dest->min[i] = frame->position->components[i] - scaledRadius;
+			dest->max[i] = frame->position->components[i] + scaledRadius;
+		}
+		return 1;
+	}
+	case COLLIDER_AABB:
+		AABBCollider_GetWorldAABB(dest, colliderData, frame);
+		return 1;
+	case COLLIDER_CONVEXHULL:
+	{
+		struct ColliderData_AABB modelAABB;
+		ConvexHullCollider_GenerateMinimumAABB(&modelAABB, colliderData, frame);
+		AABBCollider_GetWorldAABB(dest, &modelAABB, frame);
+		return 1;
+	}
+	default:
+		return 0;
+	}
+}
+
+///
+//Gets the world space axis aligned bounds of a collider oriented by a frame of reference,
+//giving colliders without finite bounds (rays) bounds spanning all of space
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the bounds in
+//	collider: A pointer to the collider to get the bounds of
+//	frame: A pointer to the frame of reference orienting the collider
+//
+//Returns:
+//	0 if the collider has no finite bounds (rays), else 1
+unsigned char Collider_GetWorldAABBUnbounded(struct ColliderData_AABB* dest, Collider* collider, FrameOfReference* frame)
+{
+	if(Collider_GetWorldAABB(dest, collider, frame)) return 1;
+
+	for(int i = 0; i < 3; i++)
+	{
+		dest->min[i] = -FLT_MAX;
+		dest->max[i] = FLT_MAX;
+	}
+	return 0;
+}
+
+///
+//Places a collider on a collision layer and sets which layers it may collide with
+//
+//Parameters:
+//	collider: A pointer to the collider to set the layer of
+//	layer: The collision layer, from 0 to Collider_NUM_LAYERS - 1
+//	collisionMask: Bit n is set if the collider may collide with colliders on layer n
+void Collider_SetLayer(Collider* collider, unsigned int layer, unsigned int collisionMask)
+{
+	if(layer >= Collider_NUM_LAYERS)
+	{
+		printf("Collider_SetLayer Failed: Layer %u is out of range.\n", layer);
+		return;
+	}
+
+	collider->layer = layer;
+	collider->collisionMask = collisionMask;
+}
+
+///
+//Determines if the layers of two colliders allow them to collide
+//Each collider's mask must include the other's layer.
+//
+//Parameters:
+//	collider1: A pointer to the first collider
+//	collider2: A pointer to the second collider
+//
+//Returns:
+//	1 if the colliders may collide, else 0
+unsigned char Collider_DoLayersCollide(const Collider* collider1, const Collider* collider2)
+{
+	return (collider1->collisionMask & (1u << collider2->layer)) != 0 && (collider2->collisionMask & (1u << collider1->layer)) != 0;
+}
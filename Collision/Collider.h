@@ -17,6 +17,11 @@ enum ColliderType
 };
 */
 
+//Number of collision layers a collider may be placed on
+#define Collider_NUM_LAYERS 32
+//Collision mask of a collider which collides with every layer
+#define Collider_ALL_LAYERS 0xFFFFFFFFu
+
 //union for the data different colliders will provide
 union ColliderData
 {
@@ -35,6 +40,9 @@ typedef struct Collider
 
 	LinkedList* currentCollisions;	//List of all collisions which occurred with this collider last frame
 
+	unsigned int layer;			//Collision layer of the collider, from 0 to Collider_NUM_LAYERS - 1
+	unsigned int collisionMask;		//Bit n is set if the collider may collide with colliders on layer n
+
 	unsigned char debug;			//Is collider in debug mode?
 	Mesh* representation;			//ptr to Mesh representation of collider
 	Matrix* colorMatrix;			//Matrix to control color of mesh representation in debug mode
@@ -91,4 +99,51 @@ void* Collider_GetColliderDataWorldSpace(Collider* collider);
 //	frame: A pointer to the frame of reference to update with
 void Collider_Update(Collider* collider, FrameOfReference* frame);
 
+///
+//Gets the world space axis aligned bounds of a collider oriented by a frame of reference.
+//Convex hulls are bounded by the world AABB of their minimum AABB.
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the bounds in
+//	collider: A pointer to the collider to get the bounds of
+//	frame: A pointer to the frame of reference orienting the collider
+//
+//Returns:
+//	0 if the collider has no finite bounds (rays), else 1
+unsigned char Collider_GetWorldAABB(struct ColliderData_AABB* dest, Collider* collider, FrameOfReference* frame);
+
+///
+//Gets the world space axis aligned bounds of a collider oriented by a frame of reference,
+//giving colliders without finite bounds (rays) bounds spanning all of space
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the bounds in
+//	collider: A pointer to the collider to get the bounds of
+//	frame: A pointer to the frame of reference orienting the collider
+//
+//Returns:
+//	0 if the collider has no finite bounds (rays), else 1
+unsigned char Collider_GetWorldAABBUnbounded(struct ColliderData_AABB* dest, Collider* collider, FrameOfReference* frame);
+
+///
+//Places a collider on a collision layer and sets which layers it may collide with
+//
+//Parameters:
+//	collider: A pointer to the collider to set the layer of
+//	layer: The collision layer, from 0 to Collider_NUM_LAYERS - 1
+//	collisionMask: Bit n is set if the collider may collide with colliders on layer n
+void Collider_SetLayer(Collider* collider, unsigned int layer, unsigned int collisionMask);
+
+///
+//Determines if the layers of two colliders allow them to collide
+//Each collider's mask must include the other's layer.
+//
+//Parameters:
+//	collider1: A pointer to the first collider
+//	collider2: A pointer to the second collider
+//
+//Returns:
+//	1 if the colliders may collide, else 0
+unsigned char Collider_DoLayersCollide(const Collider* collider1, const Collider* collider2);
+
 #endif
@@ -1,12 +1,23 @@
 #include "ConvexHullCollider.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <float.h>
 
 #include "Collider.h"
 
 #include "../Manager/AssetManager.h"
 
+///
+//Static Declarations
+
+///
+//Allocates the world space cache of a convex hull, sized for it's current points, faces and edges
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider data whose cache is allocated
+static void ConvexHullCollider_AllocateWorldCache(struct ColliderData_ConvexHull* collider);
+
 ///
 //Allocates memory for a new Convex Hull face
 //
@@ -86,6 +97,14 @@ void ConvexHullCollider_InitializeData(struct ColliderData_ConvexHull* convexHul
 
 	convexHullData->edges = DynamicArray_Allocate();
 	DynamicArray_Initialize(convexHullData->edges, sizeof(Vector*));
+
+	convexHullData->worldPoints = NULL;
+	convexHullData->worldAxes = NULL;
+	convexHullData->worldEdges = NULL;
+	convexHullData->worldCache = NULL;
+	convexHullData->numCachedPoints = 0;
+	convexHullData->numCachedFaces = 0;
+	convexHullData->numCachedEdges = 0;
 }
 
 ///
@@ -182,6 +201,8 @@ void ConvexHullCollider_FreeData(struct ColliderData_ConvexHull* colliderData)
 	DynamicArray_Clear(colliderData->edges);
 	DynamicArray_Free(colliderData->edges);
 
+	free(colliderData->worldCache);
+
 	free(colliderData);
 }
 
@@ -654,6 +675,78 @@ void ConvexHullCollider_MakeRectangularCollider(struct ColliderData_ConvexHull*
 	ConvexHullCollider_AddFace(collider, face);
 }
 
+///
+//Orients the points, face normals and edges of a convex hull into world space
+//The world space data is only recomputed when the frame of reference has changed since the last update.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider data to update
+//	frame: A pointer to the frame of reference with which to orient the convex hull
+void ConvexHullCollider_Update(struct ColliderData_ConvexHull* collider, const FrameOfReference* frame)
+{
+	unsigned char upToDate = 1;
+
+	//Points, faces or edges may have been added since the cache was allocated
+	if(collider->worldCache == NULL ||
+		collider->numCachedPoints != collider->points->size ||
+		collider->numCachedFaces != collider->faces->size ||
+		collider->numCachedEdges != collider->edges->size)
+	{
+		free(collider->worldCache);
+		ConvexHullCollider_AllocateWorldCache(collider);
+		upToDate = 0;
+	}
+
+	float* cachedRotation = collider->cachedFrame;
+	float* cachedScale = collider->cachedFrame + 9;
+	float* cachedPosition = collider->cachedFrame + 18;
+	if(upToDate &&
+		memcmp(cachedRotation, frame->rotation->components, sizeof(float) * 9) == 0 &&
+		memcmp(cachedScale, frame->scale->components, sizeof(float) * 9) == 0 &&
+		memcmp(cachedPosition, frame->position->components, sizeof(float) * 3) == 0)
+	{
+		return;
+	}
+
+	memcpy(cachedRotation, frame->rotation->components, sizeof(float) * 9);
+	memcpy(cachedScale, frame->scale->components, sizeof(float) * 9);
+	memcpy(cachedPosition, frame->position->components, sizeof(float) * 3);
+
+	ConvexHullCollider_GetOrientedWorldPoints(collider->worldPoints, collider, frame);
+	ConvexHullCollider_GetOrientedAxes(collider->worldAxes, collider, frame);
+	ConvexHullCollider_GetOrientedEdges(collider->worldEdges, collider, frame);
+}
+
+///
+//Allocates the world space cache of a convex hull, sized for it's current points, faces and edges
+//The pointers, vectors and components share one allocation, so the tests reading them touch as little memory as possible.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider data whose cache is allocated
+static void ConvexHullCollider_AllocateWorldCache(struct ColliderData_ConvexHull* collider)
+{
+	collider->numCachedPoints = collider->points->size;
+	collider->numCachedFaces = collider->faces->size;
+	collider->numCachedEdges = collider->edges->size;
+	unsigned int numVectors = collider->numCachedPoints + collider->numCachedFaces + collider->numCachedEdges;
+
+	collider->worldCache = malloc((sizeof(Vector*) + sizeof(Vector) + sizeof(float) * 3) * numVectors);
+
+	Vector** pointers = (Vector**)collider->worldCache;
+	Vector* vectors = (Vector*)(pointers + numVectors);
+	float* components = (float*)(vectors + numVectors);
+	for(unsigned int i = 0; i < numVectors; i++)
+	{
+		vectors[i].dimension = 3;
+		vectors[i].components = components + i * 3;
+		pointers[i] = vectors + i;
+	}
+
+	collider->worldPoints = pointers;
+	collider->worldAxes = pointers + collider->numCachedPoints;
+	collider->worldEdges = collider->worldAxes + collider->numCachedFaces;
+}
+
 ///
 //Gets the points of the collider oriented in world space to match a given frame of reference
 //
@@ -803,7 +896,7 @@ void ConvexHullCollider_GenerateMinimumAABB(struct ColliderData_AABB* dest, cons
 
 	unsigned char firstPointAssigned = 0;
 
-	for(unsigned int i = 0; i > collider->points->size; i++)
+	for(unsigned int i = 0; i < collider->points->size; i++)
 	{
 		Vector* current = *(Vector**)DynamicArray_Index(collider->points, i);
 		Matrix_GetProductVector(&currentPoint, frame->rotation, current);
@@ -32,6 +32,16 @@ struct ColliderData_ConvexHull
 	DynamicArray* points;
 	DynamicArray* faces;
 	DynamicArray* edges;
+
+	//World space data computed by ConvexHullCollider_Update, valid for the frame of reference the hull was last updated with
+	Vector** worldPoints;		//Points oriented into world space
+	Vector** worldAxes;		//Face normals oriented into world space, one per face
+	Vector** worldEdges;		//Edge directions oriented into world space
+	void* worldCache;		//Single allocation holding the world space vectors and their components, NULL before the first update
+	unsigned int numCachedPoints;	//Number of points, faces and edges the world cache was allocated for
+	unsigned int numCachedFaces;
+	unsigned int numCachedEdges;
+	float cachedFrame[21];		//Rotation, scale and position the world space data was computed with
 };
 
 
@@ -152,6 +162,15 @@ void ConvexHullCollider_MakeCubeCollider(struct ColliderData_ConvexHull* collide
 //	depth: The depth of the collider
 void ConvexHullCollider_MakeRectangularCollider(struct ColliderData_ConvexHull* collider, float width, float height, float depth);
 
+///
+//Orients the points, face normals and edges of a convex hull into world space
+//The world space data is only recomputed when the frame of reference has changed since the last update.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider data to update
+//	frame: A pointer to the frame of reference with which to orient the convex hull
+void ConvexHullCollider_Update(struct ColliderData_ConvexHull* collider, const FrameOfReference* frame);
+
 ///
 //Gets the points of the collider oriented in world space to match a given frame of reference
 //
@@ -0,0 +1,693 @@
+#include "GJK.h"
+
+#include <math.h>
+#include <float.h>
+#include <stddef.h>
+#include <string.h>
+
+//Squared length below which vectors of the Minkowski difference are treated as zero
+#define GJK_EPSILON 1e-10f
+
+///
+//A triangle on the boundary of an EPA polytope
+//The vertices wind counter clockwise seen from outside the polytope.
+struct GJK_Face
+{
+	unsigned int vertices[3];	//Indices of the polytope vertices of the face
+	float normal[3];		//Outward unit normal of the face
+	float distance;			//Distance from the origin to the plane of the face
+};
+
+///
+//Static Declarations
+
+///
+//Computes the dot product of two vectors of dimension 3
+//
+//Parameters:
+//	a: The first vector
+//	b: The second vector
+//
+//Returns:
+//	The dot product of a and b
+static float GJK_Dot(const float a[3], const float b[3]);
+
+///
+//Computes the cross product of two vectors of dimension 3
+//
+//Parameters:
+//	dest: The destination of a cross b, must not alias a or b
+//	a: The first vector
+//	b: The second vector
+static void GJK_Cross(float dest[3], const float a[3], const float b[3]);
+
+///
+//Finds the point of the Minkowski difference of two shapes which is furthest along a direction
+//
+//Parameters:
+//	dest: The destination of the point
+//	shape1: The shape the second shape is subtracted from
+//	shape2: The shape subtracted from the first shape
+//	direction: The direction to search along
+static void GJK_Support(float dest[3], const struct GJK_Shape* shape1, const struct GJK_Shape* shape2, const float direction[3]);
+
+///
+//Finds the point of a simplex closest to the origin
+//The simplex is reduced to the smallest set of it's points whose hull holds the closest point.
+//
+//Parameters:
+//	dest: The destination of the closest point
+//	simplex: A pointer to the simplex to search and reduce
+static void GJK_Simplex_Reduce(float dest[3], struct GJK_Simplex* simplex);
+
+///
+//Finds the point of a triangular simplex closest to the origin and reduces the simplex to the feature holding it
+//
+//Parameters:
+//	dest: The destination of the closest point
+//	simplex: A pointer to a simplex of 3 points
+static void GJK_Simplex_ReduceTriangle(float dest[3], struct GJK_Simplex* simplex);
+
+///
+//Finds the point of a tetrahedral simplex closest to the origin and reduces the simplex to the feature holding it
+//The simplex is left whole if it encloses the origin.
+//
+//Parameters:
+//	dest: The destination of the closest point
+//	simplex: A pointer to a simplex of 4 points
+static void GJK_Simplex_ReduceTetrahedron(float dest[3], struct GJK_Simplex* simplex);
+
+///
+//Determines if a point would increase the dimension of the hull of a set of points
+//
+//Parameters:
+//	vertices: The points of the hull
+//	numVertices: The number of points, 1 to 3
+//	point: The point to test
+//
+//Returns:
+//	1 if the point is not on the point, line or plane spanned by the vertices, else 0
+static unsigned char GJK_DoesAddDimension(float vertices[][3], unsigned int numVertices, const float point[3]);
+
+///
+//Initializes a face of an EPA polytope
+//
+//Parameters:
+//	face: A pointer to the face to initialize
+//	vertices: The vertices of the polytope
+//	a, b, c: The indices of the face's vertices, counter clockwise seen from outside
+//
+//Returns:
+//	0 if the face is degenerate and must not be used, else 1
+static unsigned char GJK_Face_Initialize(struct GJK_Face* face, float vertices[][3], unsigned int a, unsigned int b, unsigned int c);
+
+///
+//Determines if two convex shapes overlap using the Gilbert-Johnson-Keerthi algorithm
+//
+//Parameters:
+//	simplex: The destination of the final simplex, which encloses the origin if the shapes overlap
+//	distance: The destination of the distance between the shapes if they do not overlap, or NULL
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+//
+//Returns:
+//	1 if the shapes overlap, else 0
+unsigned char GJK_Intersect(struct GJK_Simplex* simplex, float* distance, const struct GJK_Shape* shape1, const struct GJK_Shape* shape2)
+{
+	float direction[3] =
+	{
+		shape1->center[0] - shape2->center[0],
+		shape1->center[1] - shape2->center[1],
+		shape1->center[2] - shape2->center[2]
+	};
+	if(GJK_Dot(direction, direction) <= GJK_EPSILON)
+	{
+		direction[0] = 1.0f;
+		direction[1] = 0.0f;
+		direction[2] = 0.0f;
+	}
+
+	//v is the point of the simplex closest to the origin
+	float* v = simplex->direction;
+	GJK_Support(v, shape1, shape2, direction);
+	simplex->points[0][0] = v[0];
+	simplex->points[0][1] = v[1];
+	simplex->points[0][2] = v[2];
+	simplex->numPoints = 1;
+
+	float vSq = GJK_Dot(v, v);
+	for(unsigned int i = 0; i < GJK_MAX_ITERATIONS; i++)
+	{
+		//The origin is on the simplex, the shapes touch
+		if(vSq <= GJK_EPSILON) return 1;
+
+		float search[3] = { -v[0], -v[1], -v[2] };
+		float w[3];
+		GJK_Support(w, shape1, shape2, search);
+
+		float vDotW = GJK_Dot(v, w);
+		//The furthest point towards the origin does not reach it, v is a separating axis
+		if(distance == NULL && vDotW > 0.0f) return 0;
+		//No point of the difference is meaningfully closer to the origin than v
+		if(vSq - vDotW <= GJK_TOLERANCE * vSq)
+		{
+			if(distance != NULL) *distance = sqrtf(vSq);
+			return 0;
+		}
+
+		simplex->points[simplex->numPoints][0] = w[0];
+		simplex->points[simplex->numPoints][1] = w[1];
+		simplex->points[simplex->numPoints][2] = w[2];
+		simplex->numPoints++;
+
+		GJK_Simplex_Reduce(v, simplex);
+		vSq = GJK_Dot(v, v);
+
+		//Only a simplex which encloses the origin keeps all four points
+		if(simplex->numPoints == 4) return 1;
+	}
+
+	if(distance != NULL) *distance = sqrtf(vSq);
+	return vSq <= GJK_EPSILON;
+}
+
+///
+//Finds how far two overlapping convex shapes penetrate each other using the Expanding Polytope Algorithm
+//Translating the first shape by -depth * normal separates the shapes.
+//
+//Parameters:
+//	normal: The destination of the normalized direction of penetration
+//	depth: The destination of the penetration depth
+//	simplex: A pointer to the simplex GJK_Intersect found when it detected the overlap
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+void GJK_GetPenetration(float normal[3], float* depth, const struct GJK_Simplex* simplex, const struct GJK_Shape* shape1, const struct GJK_Shape* shape2)
+{
+	float vertices[GJK_EPA_MAX_VERTICES][3];
+	unsigned int numVertices = simplex->numPoints;
+	for(unsigned int i = 0; i < numVertices; i++)
+	{
+		vertices[i][0] = simplex->points[i][0];
+		vertices[i][1] = simplex->points[i][1];
+		vertices[i][2] = simplex->points[i][2];
+	}
+
+	//Without a better answer the shapes are touching, pushed apart along the line between their centers
+	normal[0] = shape2->center[0] - shape1->center[0];
+	normal[1] = shape2->center[1] - shape1->center[1];
+	normal[2] = shape2->center[2] - shape1->center[2];
+	float length = sqrtf(GJK_Dot(normal, normal));
+	if(length > 0.0f)
+	{
+		normal[0] /= length;
+		normal[1] /= length;
+		normal[2] /= length;
+	}
+	else
+	{
+		normal[0] = 1.0f;
+		normal[1] = 0.0f;
+		normal[2] = 0.0f;
+	}
+	*depth = 0.0f;
+
+	//The simplex only keeps fewer than four points when the origin is on it's boundary.
+	//Grow it into a tetrahedron with points found along the axes, or along the normal of a triangle.
+	static const float axes[6][3] =
+	{
+		{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+		{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+		{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+	};
+	while(numVertices < 4)
+	{
+		float directions[8][3];
+		unsigned int numDirections = 0;
+		if(numVertices == 3)
+		{
+			float ab[3] = { vertices[1][0] - vertices[0][0], vertices[1][1] - vertices[0][1], vertices[1][2] - vertices[0][2] };
+			float ac[3] = { vertices[2][0] - vertices[0][0], vertices[2][1] - vertices[0][1], vertices[2][2] - vertices[0][2] };
+			GJK_Cross(directions[0], ab, ac);
+			directions[1][0] = -directions[0][0];
+			directions[1][1] = -directions[0][1];
+			directions[1][2] = -directions[0][2];
+			numDirections = 2;
+		}
+		for(unsigned int i = 0; i < 6; i++, numDirections++)
+		{
+			directions[numDirections][0] = axes[i][0];
+			directions[numDirections][1] = axes[i][1];
+			directions[numDirections][2] = axes[i][2];
+		}
+
+		unsigned char grown = 0;
+		for(unsigned int i = 0; i < numDirections && !grown; i++)
+		{
+			float w[3];
+			GJK_Support(w, shape1, shape2, directions[i]);
+			if(GJK_DoesAddDimension(vertices, numVertices, w))
+			{
+				vertices[numVertices][0] = w[0];
+				vertices[numVertices][1] = w[1];
+				vertices[numVertices][2] = w[2];
+				numVertices++;
+				grown = 1;
+			}
+		}
+
+		//The difference is flat, the shapes can only be touching
+		if(!grown) return;
+	}
+
+	//Build the faces of the tetrahedron, wound outwards from it's centroid
+	struct GJK_Face faces[GJK_EPA_MAX_FACES];
+	unsigned int numFaces = 0;
+	static const unsigned int tetrahedron[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+	float centroid[3];
+	for(unsigned int i = 0; i < 3; i++)
+	{
+		centroid[i] = (vertices[0][i] + vertices[1][i] + vertices[2][i] + vertices[3][i]) * 0.25f;
+	}
+	for(unsigned int i = 0; i < 4; i++)
+	{
+		unsigned int a = tetrahedron[i][0];
+		unsigned int b = tetrahedron[i][1];
+		unsigned int c = tetrahedron[i][2];
+		float ab[3] = { vertices[b][0] - vertices[a][0], vertices[b][1] - vertices[a][1], vertices[b][2] - vertices[a][2] };
+		float ac[3] = { vertices[c][0] - vertices[a][0], vertices[c][1] - vertices[a][1], vertices[c][2] - vertices[a][2] };
+		float ao[3] = { vertices[a][0] - centroid[0], vertices[a][1] - centroid[1], vertices[a][2] - centroid[2] };
+		float n[3];
+		GJK_Cross(n, ab, ac);
+		if(GJK_Dot(n, ao) < 0.0f)
+		{
+			unsigned int swap = b;
+			b = c;
+			c = swap;
+		}
+		if(GJK_Face_Initialize(faces + numFaces, vertices, a, b, c)) numFaces++;
+	}
+
+	//Edges on the horizon of the faces removed by a new vertex, each edge of a removed face is at most once on the horizon
+	unsigned int edges[GJK_EPA_MAX_FACES * 3][2];
+
+	while(numFaces > 0)
+	{
+		//Expand the face closest to the origin
+		unsigned int closest = 0;
+		for(unsigned int i = 1; i < numFaces; i++)
+		{
+			if(faces[i].distance < faces[closest].distance) closest = i;
+		}
+
+		normal[0] = faces[closest].normal[0];
+		normal[1] = faces[closest].normal[1];
+		normal[2] = faces[closest].normal[2];
+		*depth = faces[closest].distance > 0.0f ? faces[closest].distance : 0.0f;
+
+		float w[3];
+		GJK_Support(w, shape1, shape2, faces[closest].normal);
+
+		//The closest face is on the boundary of the difference
+		if(GJK_Dot(w, faces[closest].normal) - faces[closest].distance <= GJK_EPA_TOLERANCE) return;
+		if(numVertices == GJK_EPA_MAX_VERTICES) return;
+
+		unsigned int newVertex = numVertices++;
+		vertices[newVertex][0] = w[0];
+		vertices[newVertex][1] = w[1];
+		vertices[newVertex][2] = w[2];
+
+		//Remove every face the new vertex can see, keeping the edges around them
+		unsigned int numEdges = 0;
+		for(unsigned int i = numFaces; i-- > 0;)
+		{
+			const float* a = vertices[faces[i].vertices[0]];
+			float aw[3] = { w[0] - a[0], w[1] - a[1], w[2] - a[2] };
+			if(GJK_Dot(faces[i].normal, aw) <= 0.0f) continue;
+
+			for(unsigned int j = 0; j < 3; j++)
+			{
+				unsigned int from = faces[i].vertices[j];
+				unsigned int to = faces[i].vertices[(j + 1) % 3];
+
+				//An edge shared with another removed face is not on the horizon
+				unsigned int k = 0;
+				while(k < numEdges && !(edges[k][0] == to && edges[k][1] == from)) k++;
+				if(k < numEdges)
+				{
+					edges[k][0] = edges[numEdges - 1][0];
+					edges[k][1] = edges[numEdges - 1][1];
+					numEdges--;
+				}
+				else
+				{
+					edges[numEdges][0] = from;
+					edges[numEdges][1] = to;
+					numEdges++;
+				}
+			}
+
+			faces[i] = faces[--numFaces];
+		}
+
+		//Keep the current answer rather than overflow the polytope
+		if(numFaces + numEdges > GJK_EPA_MAX_FACES) return;
+
+		//Close the hole with faces fanning out from the new vertex
+		for(unsigned int i = 0; i < numEdges; i++)
+		{
+			if(GJK_Face_Initialize(faces + numFaces, vertices, edges[i][0], edges[i][1], newVertex)) numFaces++;
+		}
+	}
+}
+
+///
+//Determines if an axis separates two convex shapes
+//
+//Parameters:
+//	axis: The world space axis to test, pointing from the second shape towards the first
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+//
+//Returns:
+//	1 if every point of the first shape is further along the axis than every point of the second shape, else 0
+unsigned char GJK_IsSeparatingAxis(const float axis[3], const struct GJK_Shape* shape1, const struct GJK_Shape* shape2)
+{
+	//The point of the Minkowski difference least far along the axis must still be past the origin
+	float search[3] = { -axis[0], -axis[1], -axis[2] };
+	float w[3];
+	GJK_Support(w, shape1, shape2, search);
+	return GJK_Dot(w, axis) > 0.0f;
+}
+
+///
+//Computes the dot product of two vectors of dimension 3
+//
+//Parameters:
+//	a: The first vector
+//	b: The second vector
+//
+//Returns:
+//	The dot product of a and b
+static float GJK_Dot(const float a[3], const float b[3])
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+///
+//Computes the cross product of two vectors of dimension 3
+//
+//Parameters:
+//	dest: The destination of a cross b, must not alias a or b
+//	a: The first vector
+//	b: The second vector
+static void GJK_Cross(float dest[3], const float a[3], const float b[3])
+{
+	dest[0] = a[1] * b[2] - a[2] * b[1];
+	dest[1] = a[2] * b[0] - a[0] * b[2];
+	dest[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+///
+//Finds the point of the Minkowski difference of two shapes which is furthest along a direction
+//
+//Parameters:
+//	dest: The destination of the point
+//	shape1: The shape the second shape is subtracted from
+//	shape2: The shape subtracted from the first shape
+//	direction: The direction to search along
+static void GJK_Support(float dest[3], const struct GJK_Shape* shape1, const struct GJK_Shape* shape2, const float direction[3])
+{
+	float opposite[3] = { -direction[0], -direction[1], -direction[2] };
+	float point1[3];
+	float point2[3];
+	shape1->support(point1, shape1->data, direction);
+	shape2->support(point2, shape2->data, opposite);
+
+	dest[0] = point1[0] - point2[0];
+	dest[1] = point1[1] - point2[1];
+	dest[2] = point1[2] - point2[2];
+}
+
+///
+//Finds the point of a simplex closest to the origin
+//The simplex is reduced to the smallest set of it's points whose hull holds the closest point.
+//
+//Parameters:
+//	dest: The destination of the closest point
+//	simplex: A pointer to the simplex to search and reduce
+static void GJK_Simplex_Reduce(float dest[3], struct GJK_Simplex* simplex)
+{
+	float (*p)[3] = simplex->points;
+
+	switch(simplex->numPoints)
+	{
+	case 1:
+		dest[0] = p[0][0];
+		dest[1] = p[0][1];
+		dest[2] = p[0][2];
+		break;
+	case 2:
+	{
+		float ab[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+		float abSq = GJK_Dot(ab, ab);
+		float t = abSq > 0.0f ? -GJK_Dot(p[0], ab) / abSq : 0.0f;
+		if(t <= 0.0f)
+		{
+			simplex->numPoints = 1;
+		}
+		else if(t >= 1.0f)
+		{
+			p[0][0] = p[1][0];
+			p[0][1] = p[1][1];
+			p[0][2] = p[1][2];
+			simplex->numPoints = 1;
+			t = 0.0f;
+		}
+		dest[0] = p[0][0] + t * ab[0];
+		dest[1] = p[0][1] + t * ab[1];
+		dest[2] = p[0][2] + t * ab[2];
+		break;
+	}
+	case 3:
+		GJK_Simplex_ReduceTriangle(dest, simplex);
+		break;
+	case 4:
+		GJK_Simplex_ReduceTetrahedron(dest, simplex);
+		break;
+	}
+}
+
+///
+//Finds the point of a triangular simplex closest to the origin and reduces the simplex to the feature holding it
+//
+//Parameters:
+//	dest: The destination of the closest point
+//	simplex: A pointer to a simplex of 3 points
+static void GJK_Simplex_ReduceTriangle(float dest[3], struct GJK_Simplex* simplex)
+{
+	float a[3] = { simplex->points[0][0], simplex->points[0][1], simplex->points[0][2] };
+	float b[3] = { simplex->points[1][0], simplex->points[1][1], simplex->points[1][2] };
+	float c[3] = { simplex->points[2][0], simplex->points[2][1], simplex->points[2][2] };
+	float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+
+	//Walk the voronoi regions of the triangle's features, the origin is the point being projected
+	float d1 = -GJK_Dot(ab, a);
+	float d2 = -GJK_Dot(ac, a);
+	if(d1 <= 0.0f && d2 <= 0.0f)
+	{
+		simplex->numPoints = 1;
+		dest[0] = a[0]; dest[1] = a[1]; dest[2] = a[2];
+		return;
+	}
+
+	float d3 = -GJK_Dot(ab, b);
+	float d4 = -GJK_Dot(ac, b);
+	if(d3 >= 0.0f && d4 <= d3)
+	{
+		simplex->points[0][0] = b[0]; simplex->points[0][1] = b[1]; simplex->points[0][2] = b[2];
+		simplex->numPoints = 1;
+		dest[0] = b[0]; dest[1] = b[1]; dest[2] = b[2];
+		return;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		float t = d1 / (d1 - d3);
+		simplex->numPoints = 2;
+		dest[0] = a[0] + t * ab[0]; dest[1] = a[1] + t * ab[1]; dest[2] = a[2] + t * ab[2];
+		return;
+	}
+
+	float d5 = -GJK_Dot(ab, c);
+	float d6 = -GJK_Dot(ac, c);
+	if(d6 >= 0.0f && d5 <= d6)
+	{
+		simplex->points[0][0] = c[0]; simplex->points[0][1] = c[1]; simplex->points[0][2] = c[2];
+		simplex->numPoints = 1;
+		dest[0] = c[0]; dest[1] = c[1]; dest[2] = c[2];
+		return;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		float t = d2 / (d2 - d6);
+		simplex->points[1][0] = c[0]; simplex->points[1][1] = c[1]; simplex->points[1][2] = c[2];
+		simplex->numPoints = 2;
+		dest[0] = a[0] + t * ac[0]; dest[1] = a[1] + t * ac[1]; dest[2] = a[2] + t * ac[2];
+		return;
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if(va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		simplex->points[0][0] = b[0]; simplex->points[0][1] = b[1]; simplex->points[0][2] = b[2];
+		simplex->points[1][0] = c[0]; simplex->points[1][1] = c[1]; simplex->points[1][2] = c[2];
+		simplex->numPoints = 2;
+		dest[0] = b[0] + t * (c[0] - b[0]); dest[1] = b[1] + t * (c[1] - b[1]); dest[2] = b[2] + t * (c[2] - b[2]);
+		return;
+	}
+
+	//The closest point is within the face
+	float denominator = va + vb + vc;
+	float v = denominator != 0.0f ? vb / denominator : 0.0f;
+	float w = denominator != 0.0f ? vc / denominator : 0.0f;
+	dest[0] = a[0] + ab[0] * v + ac[0] * w;
+	dest[1] = a[1] + ab[1] * v + ac[1] * w;
+	dest[2] = a[2] + ab[2] * v + ac[2] * w;
+}
+
+///
+//Finds the point of a tetrahedral simplex closest to the origin and reduces the simplex to the feature holding it
+//The simplex is left whole if it encloses the origin.
+//
+//Parameters:
+//	dest: The destination of the closest point
+//	simplex: A pointer to a simplex of 4 points
+static void GJK_Simplex_ReduceTetrahedron(float dest[3], struct GJK_Simplex* simplex)
+{
+	static const unsigned int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+
+	float bestSq = FLT_MAX;
+	struct GJK_Simplex best;
+	best.numPoints = 0;
+
+	for(unsigned int i = 0; i < 4; i++)
+	{
+		const float* a = simplex->points[faces[i][0]];
+		const float* b = simplex->points[faces[i][1]];
+		const float* c = simplex->points[faces[i][2]];
+		const float* d = simplex->points[faces[i][3]];
+
+		float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+		float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+		float ad[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+		float n[3];
+		GJK_Cross(n, ab, ac);
+
+		//The origin is outside of this face when it is on the other side of the face from the fourth point.
+		//A flat tetrahedron has every face treated as outside.
+		float originSide = -GJK_Dot(n, a);
+		float pointSide = GJK_Dot(n, ad);
+		if(pointSide * pointSide > GJK_EPSILON && originSide * pointSide >= 0.0f) continue;
+
+		struct GJK_Simplex triangle;
+		for(unsigned int j = 0; j < 3; j++)
+		{
+			triangle.points[j][0] = simplex->points[faces[i][j]][0];
+			triangle.points[j][1] = simplex->points[faces[i][j]][1];
+			triangle.points[j][2] = simplex->points[faces[i][j]][2];
+		}
+		triangle.numPoints = 3;
+
+		float closest[3];
+		GJK_Simplex_ReduceTriangle(closest, &triangle);
+		float closestSq = GJK_Dot(closest, closest);
+		if(closestSq < bestSq)
+		{
+			bestSq = closestSq;
+			best = triangle;
+			dest[0] = closest[0];
+			dest[1] = closest[1];
+			dest[2] = closest[2];
+		}
+	}
+
+	if(best.numPoints == 0)
+	{
+		//The origin is inside the tetrahedron
+		dest[0] = 0.0f;
+		dest[1] = 0.0f;
+		dest[2] = 0.0f;
+		return;
+	}
+
+	memcpy(simplex->points, best.points, sizeof(best.points));
+	simplex->numPoints = best.numPoints;
+}
+
+///
+//Determines if a point would increase the dimension of the hull of a set of points
+//
+//Parameters:
+//	vertices: The points of the hull
+//	numVertices: The number of points, 1 to 3
+//	point: The point to test
+//
+//Returns:
+//	1 if the point is not on the point, line or plane spanned by the vertices, else 0
+static unsigned char GJK_DoesAddDimension(float vertices[][3], unsigned int numVertices, const float point[3])
+{
+	float ap[3] = { point[0] - vertices[0][0], point[1] - vertices[0][1], point[2] - vertices[0][2] };
+	if(numVertices == 1)
+	{
+		return GJK_Dot(ap, ap) > GJK_EPSILON;
+	}
+
+	float ab[3] = { vertices[1][0] - vertices[0][0], vertices[1][1] - vertices[0][1], vertices[1][2] - vertices[0][2] };
+	float n[3];
+	if(numVertices == 2)
+	{
+		GJK_Cross(n, ab, ap);
+		return GJK_Dot(n, n) > GJK_EPSILON;
+	}
+
+	float ac[3] = { vertices[2][0] - vertices[0][0], vertices[2][1] - vertices[0][1], vertices[2][2] - vertices[0][2] };
+	GJK_Cross(n, ab, ac);
+	float volume = GJK_Dot(n, ap);
+	return volume * volume > GJK_EPSILON;
+}
+
+///
+//Initializes a face of an EPA polytope
+//
+//Parameters:
+//	face: A pointer to the face to initialize
+//	vertices: The vertices of the polytope
+//	a, b, c: The indices of the face's vertices, counter clockwise seen from outside
+//
+//Returns:
+//	0 if the face is degenerate and must not be used, else 1
+static unsigned char GJK_Face_Initialize(struct GJK_Face* face, float vertices[][3], unsigned int a, unsigned int b, unsigned int c)
+{
+	float ab[3] = { vertices[b][0] - vertices[a][0], vertices[b][1] - vertices[a][1], vertices[b][2] - vertices[a][2] };
+	float ac[3] = { vertices[c][0] - vertices[a][0], vertices[c][1] - vertices[a][1], vertices[c][2] - vertices[a][2] };
+
+	GJK_Cross(face->normal, ab, ac);
+	float lengthSq = GJK_Dot(face->normal, face->normal);
+	if(lengthSq <= GJK_EPSILON * GJK_EPSILON) return 0;
+
+	float length = sqrtf(lengthSq);
+	face->normal[0] /= length;
+	face->normal[1] /= length;
+	face->normal[2] /= length;
+
+	face->vertices[0] = a;
+	face->vertices[1] = b;
+	face->vertices[2] = c;
+	face->distance = GJK_Dot(face->normal, vertices[a]);
+	return 1;
+}
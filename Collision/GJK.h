@@ -0,0 +1,79 @@
+#ifndef GJK_H
+#define GJK_H
+
+//Most support points searched for before a GJK test gives up on converging
+#define GJK_MAX_ITERATIONS 64
+//Relative improvement in the distance estimate below which a GJK test has converged
+#define GJK_TOLERANCE 0.0001f
+//Most points the polytope of an EPA expansion may grow to
+#define GJK_EPA_MAX_VERTICES 64
+//Most faces the polytope of an EPA expansion may hold
+#define GJK_EPA_MAX_FACES 128
+//Improvement in the penetration depth below which an EPA expansion has converged
+#define GJK_EPA_TOLERANCE 0.0001f
+
+///
+//Finds the point of a convex shape which is furthest along a direction
+//
+//Parameters:
+//	dest: The destination of the world space point
+//	shape: The data of the shape, as given by the struct GJK_Shape
+//	direction: The world space direction to search along, not necessarily normalized
+typedef void (*GJK_SupportFunction)(float dest[3], const void* shape, const float direction[3]);
+
+///
+//A convex shape which is only known through it's support function
+struct GJK_Shape
+{
+	GJK_SupportFunction support;	//Finds the points of the shape
+	const void* data;		//Passed to the support function
+	float center[3];		//Any world space point within the shape, used to pick the first search direction
+};
+
+///
+//A simplex of points of the Minkowski difference of two shapes
+struct GJK_Simplex
+{
+	float points[4][3];
+	unsigned int numPoints;
+	float direction[3];	//Point of the simplex closest to the origin, a separating axis when the shapes do not overlap
+};
+
+///
+//Determines if two convex shapes overlap using the Gilbert-Johnson-Keerthi algorithm
+//
+//Parameters:
+//	simplex: The destination of the final simplex, which encloses the origin if the shapes overlap
+//	distance: The destination of the distance between the shapes if they do not overlap, or NULL
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+//
+//Returns:
+//	1 if the shapes overlap, else 0
+unsigned char GJK_Intersect(struct GJK_Simplex* simplex, float* distance, const struct GJK_Shape* shape1, const struct GJK_Shape* shape2);
+
+///
+//Finds how far two overlapping convex shapes penetrate each other using the Expanding Polytope Algorithm
+//Translating the first shape by -depth * normal separates the shapes.
+//
+//Parameters:
+//	normal: The destination of the normalized direction of penetration
+//	depth: The destination of the penetration depth
+//	simplex: A pointer to the simplex GJK_Intersect found when it detected the overlap
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+void GJK_GetPenetration(float normal[3], float* depth, const struct GJK_Simplex* simplex, const struct GJK_Shape* shape1, const struct GJK_Shape* shape2);
+
+///
+//Determines if an axis separates two convex shapes
+//
+//Parameters:
+//	axis: The world space axis to test, pointing from the second shape towards the first
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+//
+//Returns:
+//	1 if every point of the first shape is further along the axis than every point of the second shape, else 0
+unsigned char GJK_IsSeparatingAxis(const float axis[3], const struct GJK_Shape* shape1, const struct GJK_Shape* shape2);
+
+#endif
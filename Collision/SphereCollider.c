@@ -60,6 +60,7 @@ void SphereCollider_FreeData(int colliderDataID)
 	//free(colliderData);
 	MemoryPool_ReleaseID(collisionBuffer->sphereData, colliderDataID);
 	MemoryPool_ReleaseID(collisionBuffer->worldSphereData, colliderDataID);
+	MemoryPool_ReleaseID(collisionBuffer->sphereTransformations, colliderDataID);
 }
 
 ///
@@ -0,0 +1,923 @@
+#include "AABBTree.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <float.h>
+
+///
+//A pair of nodes left to test against each other while finding pairs
+//A node paired with itself stands for the pairs within it's subtree.
+struct AABBTree_NodePair
+{
+	unsigned int node1;
+	unsigned int node2;
+};
+
+///
+//A node left to visit while casting a ray
+struct AABBTree_RayNode
+{
+	unsigned int node;
+	float entry;		//Parametric value along the ray where it enters the node's bounds
+};
+
+///
+//A ray prepared for the slab tests of a ray cast
+struct AABBTree_SlabRay
+{
+	float origin[3];
+	float inverseDirection[3];	//Reciprocal of each component of the direction, 0 where the ray is parallel to a slab
+	unsigned char parallel[3];	//1 where the ray is parallel to a slab
+};
+
+///
+//Static Declarations
+
+///
+//Gets the index of the leaf holding a game object
+//
+//Parameters:
+//	tree: A pointer to the AABB tree holding the object
+//	obj: A pointer to the game object
+//	dest: A pointer to the destination of the leaf's index
+//
+//Returns:
+//	1 if the object has a leaf, else 0
+static unsigned char AABBTree_LookUpLeaf(AABBTree* tree, GObject* obj, unsigned int* dest);
+
+///
+//Takes a node from the free list of an AABB tree, growing the node pool if it is empty
+//Pointers to nodes may be invalidated.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to take a node from
+//
+//Returns:
+//	The index of the node
+static unsigned int AABBTree_AllocateNode(AABBTree* tree);
+
+///
+//Returns a node to the free list of an AABB tree
+//
+//Parameters:
+//	tree: A pointer to the AABB tree the node belongs to
+//	index: The index of the node to free
+static void AABBTree_FreeNode(AABBTree* tree, unsigned int index);
+
+///
+//Inserts a leaf into an AABB tree beside the node which grows the tree's surface area the least
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to insert into
+//	leaf: The index of the leaf to insert, it's bounds must be set
+static void AABBTree_InsertLeaf(AABBTree* tree, unsigned int leaf);
+
+///
+//Detaches a leaf from an AABB tree, freeing it's parent
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to remove from
+//	leaf: The index of the leaf to remove
+static void AABBTree_RemoveLeaf(AABBTree* tree, unsigned int leaf);
+
+///
+//Rebalances and refits every node from a node up to the root of an AABB tree
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	index: The index of the first node to refit
+static void AABBTree_Refit(AABBTree* tree, unsigned int index);
+
+///
+//Rotates a node's taller grandchild up if it's children's heights differ by more than one
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	index: The index of the node to balance
+//
+//Returns:
+//	The index of the node now at the node's position in the tree
+static unsigned int AABBTree_Balance(AABBTree* tree, unsigned int index);
+
+///
+//Replaces a child of a node, or the root if the node is AABBTree_NULL_NODE
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	parent: The index of the parent node, or AABBTree_NULL_NODE
+//	oldChild: The index of the child to replace
+//	newChild: The index of the replacement
+static void AABBTree_ReplaceChild(AABBTree* tree, unsigned int parent, unsigned int oldChild, unsigned int newChild);
+
+///
+//Computes the smallest axis aligned bounding box containing two others
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the union in
+//	a: A pointer to the first AABB
+//	b: A pointer to the second AABB
+static void AABBTree_Union(struct ColliderData_AABB* dest, const struct ColliderData_AABB* a, const struct ColliderData_AABB* b);
+
+///
+//Computes half the surface area of an axis aligned bounding box
+//Computed in double precision, so bounds spanning all of space do not overflow.
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//
+//Returns:
+//	Half of the surface area of the bounds
+static double AABBTree_GetArea(const struct ColliderData_AABB* bounds);
+
+///
+//Determines if two axis aligned bounding boxes overlap
+//
+//Parameters:
+//	a: A pointer to the first AABB
+//	b: A pointer to the second AABB
+//
+//Returns:
+//	1 if the boxes overlap or touch, else 0
+static unsigned char AABBTree_DoesOverlap(const struct ColliderData_AABB* a, const struct ColliderData_AABB* b);
+
+///
+//Determines if an axis aligned bounding box contains another
+//
+//Parameters:
+//	outer: A pointer to the containing AABB
+//	inner: A pointer to the contained AABB
+//
+//Returns:
+//	1 if inner lies entirely within outer, else 0
+static unsigned char AABBTree_DoesContain(const struct ColliderData_AABB* outer, const struct ColliderData_AABB* inner);
+
+///
+//Determines if a ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	worldRay: A pointer to the ray oriented in world space
+//
+//Returns:
+//	1 if the ray crosses or starts within the bounds, else 0
+static unsigned char AABBTree_DoesRayCross(const struct ColliderData_AABB* bounds, struct ColliderData_Ray* worldRay);
+
+///
+//Finds where a prepared ray enters an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//	maxDistance: The furthest parametric value along the ray to consider
+//
+//Returns:
+//	The parametric value where the ray enters the bounds, 0 if it starts within them,
+//	or a negative value if the ray misses the bounds within maxDistance
+static float AABBTree_GetRayEntry(const struct ColliderData_AABB* bounds, const struct AABBTree_SlabRay* ray, float maxDistance);
+
+///
+//Implementations
+
+///
+//Allocates memory for an AABB tree
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized AABB tree
+AABBTree* AABBTree_Allocate(void)
+{
+	AABBTree* tree = (AABBTree*)malloc(sizeof(AABBTree));
+	return tree;
+}
+
+///
+//Initializes an empty AABB tree
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to initialize
+//	margin: The distance to fatten each leaf's bounds by on every side, or 0 for AABBTree_DEFAULT_MARGIN
+void AABBTree_Initialize(AABBTree* tree, float margin)
+{
+	tree->nodes = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->nodes, sizeof(struct AABBTree_Node));
+	tree->root = AABBTree_NULL_NODE;
+	tree->freeList = AABBTree_NULL_NODE;
+
+	if(margin < 0.0f)
+	{
+		printf("AABBTree_Initialize given negative margin %f, using default margin %f.\n", margin, AABBTree_DEFAULT_MARGIN);
+	}
+	tree->margin = margin > 0.0f ? margin : AABBTree_DEFAULT_MARGIN;
+
+	tree->map = HashMap_Allocate();
+	HashMap_InitializeWithKeyType(tree->map, HashMap_KeyType_POINTER);
+
+	tree->stack = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->stack, sizeof(struct AABBTree_NodePair));
+
+	tree->rayStack = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->rayStack, sizeof(struct AABBTree_RayNode));
+}
+
+///
+//Frees the data allocated by an AABB tree.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to free
+void AABBTree_Free(AABBTree* tree)
+{
+	DynamicArray_Free(tree->nodes);
+	HashMap_Free(tree->map);
+	DynamicArray_Free(tree->stack);
+	DynamicArray_Free(tree->rayStack);
+	free(tree);
+}
+
+///
+//Adds a game object with a collider to an AABB tree
+//The object's leaf is inserted beside the node which grows the tree's surface area the least,
+//then the tree is rebalanced on the way back to the root.
+//Objects which have already been added are updated instead.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to add to
+//	obj: A pointer to the game object to add
+void AABBTree_Add(AABBTree* tree, GObject* obj)
+{
+	unsigned int leaf;
+	if(AABBTree_LookUpLeaf(tree, obj, &leaf))
+	{
+		AABBTree_UpdateObject(tree, obj);
+		return;
+	}
+
+	leaf = AABBTree_AllocateNode(tree);
+	struct AABBTree_Node* node = DynamicArray_AABBTreeNode_Index(tree->nodes, leaf);
+	node->obj = obj;
+	node->height = 0;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	Collider_GetWorldAABBUnbounded(&node->bounds, obj->collider, frame);
+	for(int i = 0; i < 3; i++)
+	{
+		node->bounds.min[i] -= tree->margin;
+		node->bounds.max[i] += tree->margin;
+	}
+
+	HashMap_Add(tree->map, &obj, (void*)(uintptr_t)leaf, sizeof(GObject*));
+	AABBTree_InsertLeaf(tree, leaf);
+}
+
+///
+//Removes a game object from an AABB tree
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to remove from
+//	obj: A pointer to the game object to remove
+void AABBTree_Remove(AABBTree* tree, GObject* obj)
+{
+	unsigned int leaf;
+	if(!AABBTree_LookUpLeaf(tree, obj, &leaf)) return;
+	HashMap_Remove(tree->map, &obj, sizeof(GObject*));
+
+	AABBTree_RemoveLeaf(tree, leaf);
+	AABBTree_FreeNode(tree, leaf);
+}
+
+///
+//Updates the position of a single game object within an AABB tree
+//Call this for every object whose frame of reference has changed since the tree was last updated.
+//The object is only reinserted if it's bounds have left the fattened bounds of it's leaf.
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to update
+//	obj: A pointer to the game object which moved
+//
+//Returns:
+//	1 if the object was reinserted, else 0
+unsigned char AABBTree_UpdateObject(AABBTree* tree, GObject* obj)
+{
+	unsigned int leaf;
+	if(!AABBTree_LookUpLeaf(tree, obj, &leaf)) return 0;
+
+	struct ColliderData_AABB bounds;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	Collider_GetWorldAABBUnbounded(&bounds, obj->collider, frame);
+
+	struct AABBTree_Node* node = DynamicArray_AABBTreeNode_Index(tree->nodes, leaf);
+	if(AABBTree_DoesContain(&node->bounds, &bounds)) return 0;
+
+	AABBTree_RemoveLeaf(tree, leaf);
+	for(int i = 0; i < 3; i++)
+	{
+		node->bounds.min[i] = bounds.min[i] - tree->margin;
+		node->bounds.max[i] = bounds.max[i] + tree->margin;
+	}
+	AABBTree_InsertLeaf(tree, leaf);
+	return 1;
+}
+
+///
+//Finds every pair of objects in an AABB tree whose fattened bounds overlap
+//by traversing the tree against itself, skipping pairs of subtrees whose bounds do not overlap.
+//Each pair is appended once.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	dest: A pointer to the dynamic array to append the pairs to (struct GObject_Pair)
+void AABBTree_GetPairs(AABBTree* tree, DynamicArray* dest)
+{
+	if(tree->root == AABBTree_NULL_NODE) return;
+
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	tree->stack->size = 0;
+	struct AABBTree_NodePair start = { tree->root, tree->root };
+	DynamicArray_Append(tree->stack, &start);
+
+	while(tree->stack->size > 0)
+	{
+		struct AABBTree_NodePair pair = ((struct AABBTree_NodePair*)tree->stack->data)[--tree->stack->size];
+		struct AABBTree_Node* node1 = nodes + pair.node1;
+		struct AABBTree_Node* node2 = nodes + pair.node2;
+
+		if(pair.node1 == pair.node2)
+		{
+			//Pairs within a subtree are those within each child and those between the children
+			if(node1->height == 0) continue;
+			struct AABBTree_NodePair children[3] =
+			{
+				{ node1->children[0], node1->children[0] },
+				{ node1->children[1], node1->children[1] },
+				{ node1->children[0], node1->children[1] }
+			};
+			DynamicArray_AppendN(tree->stack, children, 3);
+			continue;
+		}
+
+		if(!AABBTree_DoesOverlap(&node1->bounds, &node2->bounds)) continue;
+
+		if(node1->height == 0 && node2->height == 0)
+		{
+			struct GObject_Pair objects = { node1->obj, node2->obj };
+			DynamicArray_GObjectPair_Append(dest, objects);
+			continue;
+		}
+
+		//Descend into the taller of the two subtrees
+		if(node2->height > node1->height)
+		{
+			struct AABBTree_NodePair children[2] =
+			{
+				{ pair.node1, node2->children[0] },
+				{ pair.node1, node2->children[1] }
+			};
+			DynamicArray_AppendN(tree->stack, children, 2);
+		}
+		else
+		{
+			struct AABBTree_NodePair children[2] =
+			{
+				{ node1->children[0], pair.node2 },
+				{ node1->children[1], pair.node2 }
+			};
+			DynamicArray_AppendN(tree->stack, children, 2);
+		}
+	}
+}
+
+///
+//Finds every object in an AABB tree whose fattened bounds overlap an axis aligned bounding box
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void AABBTree_QueryAABB(AABBTree* tree, const struct ColliderData_AABB* bounds, DynamicArray* dest)
+{
+	if(tree->root == AABBTree_NULL_NODE) return;
+
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	tree->stack->size = 0;
+	struct AABBTree_NodePair start = { tree->root, tree->root };
+	DynamicArray_Append(tree->stack, &start);
+
+	while(tree->stack->size > 0)
+	{
+		struct AABBTree_Node* node = nodes + ((struct AABBTree_NodePair*)tree->stack->data)[--tree->stack->size].node1;
+		if(!AABBTree_DoesOverlap(&node->bounds, bounds)) continue;
+
+		if(node->height == 0)
+		{
+			DynamicArray_Append(dest, &node->obj);
+			continue;
+		}
+
+		struct AABBTree_NodePair children[2] =
+		{
+			{ node->children[0], node->children[0] },
+			{ node->children[1], node->children[1] }
+		};
+		DynamicArray_AppendN(tree->stack, children, 2);
+	}
+}
+
+///
+//Finds every object in an AABB tree whose fattened bounds are crossed by a ray
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void AABBTree_QueryRay(AABBTree* tree, struct ColliderData_Ray* worldRay, DynamicArray* dest)
+{
+	if(tree->root == AABBTree_NULL_NODE) return;
+
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	tree->stack->size = 0;
+	struct AABBTree_NodePair start = { tree->root, tree->root };
+	DynamicArray_Append(tree->stack, &start);
+
+	while(tree->stack->size > 0)
+	{
+		struct AABBTree_Node* node = nodes + ((struct AABBTree_NodePair*)tree->stack->data)[--tree->stack->size].node1;
+		if(!AABBTree_DoesRayCross(&node->bounds, worldRay)) continue;
+
+		if(node->height == 0)
+		{
+			DynamicArray_Append(dest, &node->obj);
+			continue;
+		}
+
+		struct AABBTree_NodePair children[2] =
+		{
+			{ node->children[0], node->children[0] },
+			{ node->children[1], node->children[1] }
+		};
+		DynamicArray_AppendN(tree->stack, children, 2);
+	}
+}
+
+///
+//Casts a batch of rays through an AABB tree, finding the object each ray meets first
+//The nearer child of each node is visited first, and subtrees the ray enters beyond the closest hit so far are skipped.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	dest: An array of numRays hits to store the result of each ray in
+//	worldRays: An array of numRays rays oriented in world space
+//	numRays: The number of rays to cast
+//	maxDistance: The furthest parametric value along each ray at which a hit is accepted
+//	anyHit: 1 to stop each ray at the first object it meets in traversal order rather than the nearest, else 0
+//	test: The function testing a ray against the collider of an object whose bounds the ray crosses
+//	data: Passed to the test function
+void AABBTree_RayCast(AABBTree* tree, struct AABBTree_RayHit* dest, struct ColliderData_Ray* worldRays, unsigned int numRays, float maxDistance, unsigned char anyHit, AABBTree_RayTestFunction test, void* data)
+{
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	DynamicArray* stack = tree->rayStack;
+
+	for(unsigned int i = 0; i < numRays; i++)
+	{
+		struct ColliderData_Ray* worldRay = worldRays + i;
+		dest[i].obj = NULL;
+		dest[i].distance = maxDistance;
+		if(tree->root == AABBTree_NULL_NODE) continue;
+
+		struct AABBTree_SlabRay ray;
+		for(int j = 0; j < 3; j++)
+		{
+			float direction = worldRay->direction->components[j];
+			ray.origin[j] = worldRay->position->components[j];
+			ray.parallel[j] = direction > -FLT_EPSILON && direction < FLT_EPSILON;
+			ray.inverseDirection[j] = ray.parallel[j] ? 0.0f : 1.0f / direction;
+		}
+
+		float closest = maxDistance;
+		struct AABBTree_RayNode root = { tree->root, AABBTree_GetRayEntry(&nodes[tree->root].bounds, &ray, closest) };
+		if(root.entry < 0.0f) continue;
+
+		stack->size = 0;
+		DynamicArray_Append(stack, &root);
+
+		while(stack->size > 0)
+		{
+			struct AABBTree_RayNode visit = ((struct AABBTree_RayNode*)stack->data)[--stack->size];
+			//A closer hit may have been found since the node was pushed
+			if(visit.entry > closest) continue;
+
+			struct AABBTree_Node* node = nodes + visit.node;
+			if(node->height == 0)
+			{
+				float distance = test(node->obj, worldRay, data);
+				if(distance >= 0.0f && distance <= closest)
+				{
+					closest = distance;
+					dest[i].obj = node->obj;
+					dest[i].distance = distance;
+					if(anyHit) break;
+				}
+				continue;
+			}
+
+			struct AABBTree_RayNode children[2] =
+			{
+				{ node->children[0], AABBTree_GetRayEntry(&nodes[node->children[0]].bounds, &ray, closest) },
+				{ node->children[1], AABBTree_GetRayEntry(&nodes[node->children[1]].bounds, &ray, closest) }
+			};
+
+			//Push the further child first so the nearer one is visited first
+			unsigned int nearer = children[1].entry >= 0.0f && (children[0].entry < 0.0f || children[1].entry < children[0].entry);
+			if(children[1 - nearer].entry >= 0.0f) DynamicArray_Append(stack, children + 1 - nearer);
+			if(children[nearer].entry >= 0.0f) DynamicArray_Append(stack, children + nearer);
+		}
+	}
+}
+
+///
+//Gets the index of the leaf holding a game object
+//
+//Parameters:
+//	tree: A pointer to the AABB tree holding the object
+//	obj: A pointer to the game object
+//	dest: A pointer to the destination of the leaf's index
+//
+//Returns:
+//	1 if the object has a leaf, else 0
+static unsigned char AABBTree_LookUpLeaf(AABBTree* tree, GObject* obj, unsigned int* dest)
+{
+	struct HashMap_KeyValuePair* pair = HashMap_LookUp(tree->map, &obj, sizeof(GObject*));
+	if(pair == NULL) return 0;
+
+	*dest = (unsigned int)(uintptr_t)pair->data;
+	return 1;
+}
+
+///
+//Takes a node from the free list of an AABB tree, growing the node pool if it is empty
+//Pointers to nodes may be invalidated.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to take a node from
+//
+//Returns:
+//	The index of the node
+static unsigned int AABBTree_AllocateNode(AABBTree* tree)
+{
+	unsigned int index = tree->freeList;
+	if(index != AABBTree_NULL_NODE)
+	{
+		tree->freeList = DynamicArray_AABBTreeNode_Index(tree->nodes, index)->parent;
+	}
+	else
+	{
+		index = tree->nodes->size;
+		struct AABBTree_Node empty = { 0 };
+		DynamicArray_AABBTreeNode_Append(tree->nodes, empty);
+	}
+
+	struct AABBTree_Node* node = DynamicArray_AABBTreeNode_Index(tree->nodes, index);
+	node->obj = NULL;
+	node->parent = AABBTree_NULL_NODE;
+	node->children[0] = node->children[1] = AABBTree_NULL_NODE;
+	node->height = 0;
+	return index;
+}
+
+///
+//Returns a node to the free list of an AABB tree
+//
+//Parameters:
+//	tree: A pointer to the AABB tree the node belongs to
+//	index: The index of the node to free
+static void AABBTree_FreeNode(AABBTree* tree, unsigned int index)
+{
+	struct AABBTree_Node* node = DynamicArray_AABBTreeNode_Index(tree->nodes, index);
+	node->obj = NULL;
+	node->height = -1;
+	node->parent = tree->freeList;
+	tree->freeList = index;
+}
+
+///
+//Inserts a leaf into an AABB tree beside the node which grows the tree's surface area the least
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to insert into
+//	leaf: The index of the leaf to insert, it's bounds must be set
+static void AABBTree_InsertLeaf(AABBTree* tree, unsigned int leaf)
+{
+	if(tree->root == AABBTree_NULL_NODE)
+	{
+		tree->root = leaf;
+		DynamicArray_AABBTreeNode_Index(tree->nodes, leaf)->parent = AABBTree_NULL_NODE;
+		return;
+	}
+
+	//Allocate the new parent first, growing the pool moves the nodes
+	unsigned int newParent = AABBTree_AllocateNode(tree);
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	struct ColliderData_AABB leafBounds = nodes[leaf].bounds;
+
+	//Descend while placing the leaf beside a child costs less than placing it beside this node
+	unsigned int sibling = tree->root;
+	while(nodes[sibling].height > 0)
+	{
+		struct AABBTree_Node* node = nodes + sibling;
+		struct ColliderData_AABB combined;
+		AABBTree_Union(&combined, &node->bounds, &leafBounds);
+		double combinedArea = AABBTree_GetArea(&combined);
+
+		//Cost of a new parent holding this node and the leaf
+		double cost = 2.0 * combinedArea;
+		//Every ancestor below this node grows by at least as much as this node would
+		double inheritedCost = 2.0 * (combinedArea - AABBTree_GetArea(&node->bounds));
+
+		double childCosts[2];
+		for(int i = 0; i < 2; i++)
+		{
+			struct AABBTree_Node* child = nodes + node->children[i];
+			AABBTree_Union(&combined, &child->bounds, &leafBounds);
+			childCosts[i] = inheritedCost + (child->height == 0 ? AABBTree_GetArea(&combined) : AABBTree_GetArea(&combined) - AABBTree_GetArea(&child->bounds));
+		}
+
+		if(cost <= childCosts[0] && cost <= childCosts[1]) break;
+		sibling = childCosts[0] <= childCosts[1] ? node->children[0] : node->children[1];
+	}
+
+	unsigned int oldParent = nodes[sibling].parent;
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].height = nodes[sibling].height + 1;
+	AABBTree_Union(&nodes[newParent].bounds, &nodes[sibling].bounds, &leafBounds);
+	nodes[newParent].children[0] = sibling;
+	nodes[newParent].children[1] = leaf;
+	AABBTree_ReplaceChild(tree, oldParent, sibling, newParent);
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	AABBTree_Refit(tree, oldParent);
+}
+
+///
+//Detaches a leaf from an AABB tree, freeing it's parent
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to remove from
+//	leaf: The index of the leaf to remove
+static void AABBTree_RemoveLeaf(AABBTree* tree, unsigned int leaf)
+{
+	if(leaf == tree->root)
+	{
+		tree->root = AABBTree_NULL_NODE;
+		return;
+	}
+
+	//The leaf's sibling takes it's parent's place
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	unsigned int parent = nodes[leaf].parent;
+	unsigned int grandParent = nodes[parent].parent;
+	unsigned int sibling = nodes[parent].children[0] == leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	AABBTree_ReplaceChild(tree, grandParent, parent, sibling);
+	nodes[sibling].parent = grandParent;
+	AABBTree_FreeNode(tree, parent);
+
+	AABBTree_Refit(tree, grandParent);
+}
+
+///
+//Rebalances and refits every node from a node up to the root of an AABB tree
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	index: The index of the first node to refit
+static void AABBTree_Refit(AABBTree* tree, unsigned int index)
+{
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	while(index != AABBTree_NULL_NODE)
+	{
+		index = AABBTree_Balance(tree, index);
+
+		struct AABBTree_Node* node = nodes + index;
+		struct AABBTree_Node* child1 = nodes + node->children[0];
+		struct AABBTree_Node* child2 = nodes + node->children[1];
+		node->height = 1 + (child1->height > child2->height ? child1->height : child2->height);
+		AABBTree_Union(&node->bounds, &child1->bounds, &child2->bounds);
+
+		index = node->parent;
+	}
+}
+
+///
+//Rotates a node's taller grandchild up if it's children's heights differ by more than one
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	index: The index of the node to balance
+//
+//Returns:
+//	The index of the node now at the node's position in the tree
+static unsigned int AABBTree_Balance(AABBTree* tree, unsigned int index)
+{
+	struct AABBTree_Node* nodes = DynamicArray_AABBTreeNode_Data(tree->nodes);
+	struct AABBTree_Node* node = nodes + index;
+	if(node->height < 2) return index;
+
+	int balance = nodes[node->children[1]].height - nodes[node->children[0]].height;
+	if(balance >= -1 && balance <= 1) return index;
+
+	//Rotate the taller child up into this node's place, this node takes it's shorter grandchild
+	unsigned int taller = balance > 1 ? 1 : 0;
+	unsigned int pivot = node->children[taller];
+	unsigned int shorter = node->children[1 - taller];
+	struct AABBTree_Node* pivotNode = nodes + pivot;
+
+	unsigned int grandChild1 = pivotNode->children[0];
+	unsigned int grandChild2 = pivotNode->children[1];
+	unsigned int kept = nodes[grandChild1].height > nodes[grandChild2].height ? grandChild1 : grandChild2;
+	unsigned int given = kept == grandChild1 ? grandChild2 : grandChild1;
+
+	pivotNode->parent = node->parent;
+	AABBTree_ReplaceChild(tree, node->parent, index, pivot);
+	pivotNode->children[0] = index;
+	pivotNode->children[1] = kept;
+	node->parent = pivot;
+
+	node->children[taller] = given;
+	nodes[given].parent = index;
+
+	AABBTree_Union(&node->bounds, &nodes[shorter].bounds, &nodes[given].bounds);
+	node->height = 1 + (nodes[shorter].height > nodes[given].height ? nodes[shorter].height : nodes[given].height);
+	AABBTree_Union(&pivotNode->bounds, &node->bounds, &nodes[kept].bounds);
+	pivotNode->height = 1 + (node->height > nodes[kept].height ? node->height : nodes[kept].height);
+
+	return pivot;
+}
+
+///
+//Replaces a child of a node, or the root if the node is AABBTree_NULL_NODE
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	parent: The index of the parent node, or AABBTree_NULL_NODE
+//	oldChild: The index of the child to replace
+//	newChild: The index of the replacement
+static void AABBTree_ReplaceChild(AABBTree* tree, unsigned int parent, unsigned int oldChild, unsigned int newChild)
+{
+	if(parent == AABBTree_NULL_NODE)
+	{
+		tree->root = newChild;
+		return;
+	}
+
+	struct AABBTree_Node* node = DynamicArray_AABBTreeNode_Index(tree->nodes, parent);
+	node->children[node->children[0] == oldChild ? 0 : 1] = newChild;
+}
+
+///
+//Computes the smallest axis aligned bounding box containing two others
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the union in
+//	a: A pointer to the first AABB
+//	b: A pointer to the second AABB
+static void AABBTree_Union(struct ColliderData_AABB* dest, const struct ColliderData_AABB* a, const struct ColliderData_AABB* b)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		dest->min[i] = a->min[i] < b->min[i] ? a->min[i] : b->min[i];
+		dest->max[i] = a->max[i] > b->max[i] ? a->max[i] : b->max[i];
+	}
+}
+
+///
+//Computes half the surface area of an axis aligned bounding box
+//Computed in double precision, so bounds spanning all of space do not overflow.
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//
+//Returns:
+//	Half of the surface area of the bounds
+static double AABBTree_GetArea(const struct ColliderData_AABB* bounds)
+{
+	double width = (double)bounds->max[0] - bounds->min[0];
+	double height = (double)bounds->max[1] - bounds->min[1];
+	double depth = (double)bounds->max[2] - bounds->min[2];
+	return width * height + height * depth + depth * width;
+}
+
+///
+//Determines if two axis aligned bounding boxes overlap
+//
+//Parameters:
+//	a: A pointer to the first AABB
+//	b: A pointer to the second AABB
+//
+//Returns:
+//	1 if the boxes overlap or touch, else 0
+static unsigned char AABBTree_DoesOverlap(const struct ColliderData_AABB* a, const struct ColliderData_AABB* b)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		if(a->min[i] > b->max[i] || b->min[i] > a->max[i]) return 0;
+	}
+	return 1;
+}
+
+///
+//Determines if an axis aligned bounding box contains another
+//
+//Parameters:
+//	outer: A pointer to the containing AABB
+//	inner: A pointer to the contained AABB
+//
+//Returns:
+//	1 if inner lies entirely within outer, else 0
+static unsigned char AABBTree_DoesContain(const struct ColliderData_AABB* outer, const struct ColliderData_AABB* inner)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		if(inner->min[i] < outer->min[i] || inner->max[i] > outer->max[i]) return 0;
+	}
+	return 1;
+}
+
+///
+//Determines if a ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	worldRay: A pointer to the ray oriented in world space
+//
+//Returns:
+//	1 if the ray crosses or starts within the bounds, else 0
+static unsigned char AABBTree_DoesRayCross(const struct ColliderData_AABB* bounds, struct ColliderData_Ray* worldRay)
+{
+	float entry = 0.0f;
+	float exit = FLT_MAX;
+	for(int i = 0; i < 3; i++)
+	{
+		float origin = worldRay->position->components[i];
+		float direction = worldRay->direction->components[i];
+
+		//A ray parallel to a slab must start within it
+		if(direction > -FLT_EPSILON && direction < FLT_EPSILON)
+		{
+			if(origin < bounds->min[i] || origin > bounds->max[i]) return 0;
+			continue;
+		}
+
+		float t1 = (bounds->min[i] - origin) / direction;
+		float t2 = (bounds->max[i] - origin) / direction;
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > entry) entry = t1;
+		if(t2 < exit) exit = t2;
+		if(entry > exit) return 0;
+	}
+	return 1;
+}
+
+///
+//Finds where a prepared ray enters an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//	maxDistance: The furthest parametric value along the ray to consider
+//
+//Returns:
+//	The parametric value where the ray enters the bounds, 0 if it starts within them,
+//	or a negative value if the ray misses the bounds within maxDistance
+static float AABBTree_GetRayEntry(const struct ColliderData_AABB* bounds, const struct AABBTree_SlabRay* ray, float maxDistance)
+{
+	float entry = 0.0f;
+	float exit = maxDistance;
+	for(int i = 0; i < 3; i++)
+	{
+		//A ray parallel to a slab must start within it
+		if(ray->parallel[i])
+		{
+			if(ray->origin[i] < bounds->min[i] || ray->origin[i] > bounds->max[i]) return -1.0f;
+			continue;
+		}
+
+		float t1 = (bounds->min[i] - ray->origin[i]) * ray->inverseDirection[i];
+		float t2 = (bounds->max[i] - ray->origin[i]) * ray->inverseDirection[i];
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > entry) entry = t1;
+		if(t2 < exit) exit = t2;
+		if(entry > exit) return -1.0f;
+	}
+	return entry;
+}
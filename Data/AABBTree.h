@@ -0,0 +1,173 @@
+#ifndef AABBTREE_H
+#define AABBTREE_H
+
+#include "../GObject/GObject.h"		//The data the AABB tree will contain
+#include "DynamicArray.h"
+#include "HashMap.h"
+
+//Index standing in for a missing node
+#define AABBTree_NULL_NODE 0xFFFFFFFFu
+//Distance each leaf's bounds are fattened by on every side when the tree is initialized with a margin of 0
+#define AABBTree_DEFAULT_MARGIN 0.25f
+
+struct AABBTree_Node
+{
+	//Fattened bounds of the object in a leaf, the union of the children's bounds in an inner node
+	struct ColliderData_AABB bounds;
+	//The object held by a leaf, NULL in an inner node
+	GObject* obj;
+
+	//Index of the parent of this node, or of the next free node while this node is free
+	unsigned int parent;
+	//Indices of the children of this node, AABBTree_NULL_NODE in a leaf
+	unsigned int children[2];
+	//Length of the longest path from this node to a leaf, -1 while this node is free
+	int height;
+};
+
+//Typed accessors for node arrays
+DYNARRAY_DECLARE(AABBTreeNode, struct AABBTree_Node);
+
+///
+//Tests a ray against the collider of the object held by a leaf of an AABB tree
+//
+//Parameters:
+//	obj: A pointer to the object held by the leaf
+//	worldRay: A pointer to the ray oriented in world space
+//	data: The data given to AABBTree_RayCast
+//
+//Returns:
+//	The parametric value along the ray where it first meets the object's collider,
+//	negative or NaN if it misses the collider
+typedef float (*AABBTree_RayTestFunction)(GObject* obj, struct ColliderData_Ray* worldRay, void* data);
+
+///
+//The result of casting a single ray through an AABB tree
+struct AABBTree_RayHit
+{
+	GObject* obj;		//The object the ray met, NULL if it met none
+	float distance;		//Parametric value along the ray where it met the object
+};
+
+typedef struct AABBTree
+{
+	//Pool of nodes (struct AABBTree_Node), including free ones
+	DynamicArray* nodes;
+	//Index of the root, AABBTree_NULL_NODE while the tree is empty
+	unsigned int root;
+	//Index of the first free node, AABBTree_NULL_NODE if every node is in use
+	unsigned int freeList;
+
+	//Distance each leaf's bounds are fattened by on every side.
+	//An object is only reinserted when it moves out of it's fattened bounds.
+	float margin;
+
+	//Maps each object to the index of it's leaf
+	HashMap* map;
+	//Storage for the nodes or pairs of nodes left to visit during a traversal
+	DynamicArray* stack;
+	//Storage for the nodes left to visit during a ray cast, along with the distance each ray enters them
+	DynamicArray* rayStack;
+} AABBTree;
+
+///
+//Allocates memory for an AABB tree
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized AABB tree
+AABBTree* AABBTree_Allocate(void);
+
+///
+//Initializes an empty AABB tree
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to initialize
+//	margin: The distance to fatten each leaf's bounds by on every side, or 0 for AABBTree_DEFAULT_MARGIN
+void AABBTree_Initialize(AABBTree* tree, float margin);
+
+///
+//Frees the data allocated by an AABB tree.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to free
+void AABBTree_Free(AABBTree* tree);
+
+///
+//Adds a game object with a collider to an AABB tree
+//The object's leaf is inserted beside the node which grows the tree's surface area the least,
+//then the tree is rebalanced on the way back to the root.
+//Objects which have already been added are updated instead.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to add to
+//	obj: A pointer to the game object to add
+void AABBTree_Add(AABBTree* tree, GObject* obj);
+
+///
+//Removes a game object from an AABB tree
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to remove from
+//	obj: A pointer to the game object to remove
+void AABBTree_Remove(AABBTree* tree, GObject* obj);
+
+///
+//Updates the position of a single game object within an AABB tree
+//Call this for every object whose frame of reference has changed since the tree was last updated.
+//The object is only reinserted if it's bounds have left the fattened bounds of it's leaf.
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree to update
+//	obj: A pointer to the game object which moved
+//
+//Returns:
+//	1 if the object was reinserted, else 0
+unsigned char AABBTree_UpdateObject(AABBTree* tree, GObject* obj);
+
+///
+//Finds every pair of objects in an AABB tree whose fattened bounds overlap
+//by traversing the tree against itself, skipping pairs of subtrees whose bounds do not overlap.
+//Each pair is appended once.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	dest: A pointer to the dynamic array to append the pairs to (struct GObject_Pair)
+void AABBTree_GetPairs(AABBTree* tree, DynamicArray* dest);
+
+///
+//Finds every object in an AABB tree whose fattened bounds overlap an axis aligned bounding box
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void AABBTree_QueryAABB(AABBTree* tree, const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Finds every object in an AABB tree whose fattened bounds are crossed by a ray
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void AABBTree_QueryRay(AABBTree* tree, struct ColliderData_Ray* worldRay, DynamicArray* dest);
+
+///
+//Casts a batch of rays through an AABB tree, finding the object each ray meets first
+//The nearer child of each node is visited first, and subtrees the ray enters beyond the closest hit so far are skipped.
+//
+//Parameters:
+//	tree: A pointer to the AABB tree
+//	dest: An array of numRays hits to store the result of each ray in
+//	worldRays: An array of numRays rays oriented in world space
+//	numRays: The number of rays to cast
+//	maxDistance: The furthest parametric value along each ray at which a hit is accepted
+//	anyHit: 1 to stop each ray at the first object it meets in traversal order rather than the nearest, else 0
+//	test: The function testing a ray against the collider of an object whose bounds the ray crosses
+//	data: Passed to the test function
+void AABBTree_RayCast(AABBTree* tree, struct AABBTree_RayHit* dest, struct ColliderData_Ray* worldRays, unsigned int numRays, float maxDistance, unsigned char anyHit, AABBTree_RayTestFunction test, void* data);
+
+#endif
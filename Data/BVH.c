@@ -0,0 +1,714 @@
+#include "BVH.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <float.h>
+
+///
+//The objects whose centroids fall in one bin of a node along one axis while searching for a split
+struct BVH_Bin
+{
+	struct ColliderData_AABB bounds;	//Union of the bounds of the objects in the bin
+	unsigned int count;			//Number of objects in the bin
+};
+
+///
+//A node left to visit while casting a ray
+struct BVH_RayNode
+{
+	unsigned int node;
+	float entry;		//Parametric value along the ray where it enters the node's bounds
+};
+
+///
+//A ray prepared for the slab tests of a ray cast
+struct BVH_SlabRay
+{
+	float origin[3];
+	float inverseDirection[3];	//Reciprocal of each component of the direction, 0 where the ray is parallel to a slab
+	unsigned char parallel[3];	//1 where the ray is parallel to a slab
+};
+
+///
+//Static Declarations
+
+///
+//Builds the subtree of a BVH holding a range of it's entries, appending it's nodes in depth first order
+//The entries are reordered so each leaf's objects are contiguous.
+//
+//Parameters:
+//	tree: A pointer to the BVH being built
+//	first: The index of the first entry of the subtree
+//	count: The number of entries in the subtree
+//
+//Returns:
+//	The index of the root node of the subtree
+static unsigned int BVH_BuildNode(BVH* tree, unsigned int first, unsigned int count);
+
+///
+//Gets the bin of a centroid along an axis of a node
+//
+//Parameters:
+//	centroid: The position of the centroid along the axis
+//	min: The smallest position of any centroid in the node along the axis
+//	scale: The number of bins per unit along the axis
+//
+//Returns:
+//	The index of the bin, from 0 to BVH_NUM_BINS - 1
+static unsigned int BVH_GetBin(float centroid, float min, float scale);
+
+///
+//Gets half of the surface area of an axis aligned bounding box
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//
+//Returns:
+//	The sum of the areas of three of the faces of the AABB
+static float BVH_GetHalfArea(const struct ColliderData_AABB* bounds);
+
+///
+//Grows an axis aligned bounding box to contain another
+//
+//Parameters:
+//	dest: A pointer to the AABB to grow
+//	bounds: A pointer to the AABB to contain
+static void BVH_Merge(struct ColliderData_AABB* dest, const struct ColliderData_AABB* bounds);
+
+///
+//Sets an axis aligned bounding box to the empty box which any other box grows it to
+//
+//Parameters:
+//	dest: A pointer to the AABB to empty
+static void BVH_Empty(struct ColliderData_AABB* dest);
+
+///
+//Determines if two axis aligned bounding boxes overlap
+//
+//Parameters:
+//	bounds1: A pointer to the first AABB
+//	bounds2: A pointer to the second AABB
+//
+//Returns:
+//	1 if the boxes overlap, else 0
+static unsigned char BVH_DoesOverlap(const struct ColliderData_AABB* bounds1, const struct ColliderData_AABB* bounds2);
+
+///
+//Prepares a ray for the slab tests of a ray cast
+//
+//Parameters:
+//	dest: A pointer to the prepared ray to initialize
+//	worldRay: A pointer to the ray oriented in world space
+static void BVH_PrepareRay(struct BVH_SlabRay* dest, struct ColliderData_Ray* worldRay);
+
+///
+//Finds where a prepared ray enters an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//	maxDistance: The furthest parametric value along the ray to consider
+//
+//Returns:
+//	The parametric value where the ray enters the bounds, 0 if it starts within them,
+//	or a negative value if the ray misses the bounds within maxDistance
+static float BVH_GetRayEntry(const struct ColliderData_AABB* bounds, const struct BVH_SlabRay* ray, float maxDistance);
+
+///
+//Function Definitions
+
+///
+//Allocates memory for a BVH
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized BVH
+BVH* BVH_Allocate(void)
+{
+	BVH* tree = (BVH*)malloc(sizeof(BVH));
+	return tree;
+}
+
+///
+//Initializes an empty BVH
+//
+//Parameters:
+//	tree: A pointer to the BVH to initialize
+void BVH_Initialize(BVH* tree)
+{
+	tree->objects = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->objects, sizeof(GObject*));
+
+	tree->map = HashMap_Allocate();
+	HashMap_InitializeWithKeyType(tree->map, HashMap_KeyType_POINTER);
+
+	tree->nodes = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->nodes, sizeof(struct BVH_Node));
+	tree->entries = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->entries, sizeof(struct BVH_Entry));
+	tree->dirty = 0;
+
+	tree->stack = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->stack, sizeof(unsigned int));
+	tree->rayStack = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->rayStack, sizeof(struct BVH_RayNode));
+}
+
+///
+//Frees the data allocated by a BVH.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	tree: A pointer to the BVH to free
+void BVH_Free(BVH* tree)
+{
+	DynamicArray_Free(tree->objects);
+	HashMap_Free(tree->map);
+	DynamicArray_Free(tree->nodes);
+	DynamicArray_Free(tree->entries);
+	DynamicArray_Free(tree->stack);
+	DynamicArray_Free(tree->rayStack);
+	free(tree);
+}
+
+///
+//Adds a game object with a collider of finite bounds to a BVH
+//The tree is rebuilt the next time it is updated.
+//Objects which have already been added are ignored.
+//
+//Parameters:
+//	tree: A pointer to the BVH to add to
+//	obj: A pointer to the game object to add
+void BVH_Add(BVH* tree, GObject* obj)
+{
+	if(obj->collider == NULL || obj->collider->type == COLLIDER_RAY)
+	{
+		printf("BVH_Add Failed: Only objects with colliders of finite bounds may be added.\n");
+		return;
+	}
+	if(BVH_Contains(tree, obj)) return;
+
+	HashMap_Add(tree->map, &obj, (void*)(uintptr_t)tree->objects->size, sizeof(GObject*));
+	DynamicArray_Append(tree->objects, &obj);
+	tree->dirty = 1;
+}
+
+///
+//Removes a game object from a BVH
+//The tree is rebuilt the next time it is updated.
+//
+//Parameters:
+//	tree: A pointer to the BVH to remove from
+//	obj: A pointer to the game object to remove
+//
+//Returns:
+//	1 if the object was held by the tree, else 0
+unsigned char BVH_Remove(BVH* tree, GObject* obj)
+{
+	struct HashMap_KeyValuePair* pair = HashMap_LookUp(tree->map, &obj, sizeof(GObject*));
+	if(pair == NULL) return 0;
+
+	unsigned int index = (unsigned int)(uintptr_t)pair->data;
+	HashMap_Remove(tree->map, &obj, sizeof(GObject*));
+
+	//Move the last object into the removed object's place
+	GObject** objects = (GObject**)tree->objects->data;
+	GObject* moved = objects[--tree->objects->size];
+	if(index < tree->objects->size)
+	{
+		objects[index] = moved;
+		HashMap_LookUp(tree->map, &moved, sizeof(GObject*))->data = (void*)(uintptr_t)index;
+	}
+
+	tree->dirty = 1;
+	return 1;
+}
+
+///
+//Determines if a BVH holds a game object
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	obj: A pointer to the game object
+//
+//Returns:
+//	1 if the object has been added to the tree, else 0
+unsigned char BVH_Contains(BVH* tree, GObject* obj)
+{
+	return HashMap_Contains(tree->map, &obj, sizeof(GObject*));
+}
+
+///
+//Marks a BVH to be rebuilt the next time it is updated
+//Call this when an object held by the tree has moved.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+void BVH_Invalidate(BVH* tree)
+{
+	tree->dirty = 1;
+}
+
+///
+//Rebuilds a BVH if it's objects have changed since it was last built
+//Each node is split along the axis and binned centroid position which minimizes
+//the surface area heuristic, or left as a leaf when no split is cheaper than testing all of it's objects.
+//
+//Parameters:
+//	tree: A pointer to the BVH to update
+void BVH_Update(BVH* tree)
+{
+	if(!tree->dirty) return;
+	tree->dirty = 0;
+
+	DynamicArray_Clear(tree->nodes);
+	DynamicArray_Clear(tree->entries);
+	if(tree->objects->size == 0) return;
+
+	GObject** objects = (GObject**)tree->objects->data;
+	for(unsigned int i = 0; i < tree->objects->size; i++)
+	{
+		struct BVH_Entry entry;
+		FrameOfReference* frame = objects[i]->body != NULL ? objects[i]->body->frame : objects[i]->frameOfReference;
+		Collider_GetWorldAABB(&entry.bounds, objects[i]->collider, frame);
+		for(int j = 0; j < 3; j++)
+		{
+			entry.centroid[j] = (entry.bounds.min[j] + entry.bounds.max[j]) * 0.5f;
+		}
+		entry.obj = objects[i];
+		DynamicArray_BVHEntry_Append(tree->entries, entry);
+	}
+
+	BVH_BuildNode(tree, 0, tree->entries->size);
+}
+
+///
+//Finds every object in a BVH whose bounds overlap an axis aligned bounding box
+//The tree must be up to date.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void BVH_QueryAABB(BVH* tree, const struct ColliderData_AABB* bounds, DynamicArray* dest)
+{
+	if(tree->nodes->size == 0) return;
+
+	struct BVH_Node* nodes = DynamicArray_BVHNode_Data(tree->nodes);
+	struct BVH_Entry* entries = DynamicArray_BVHEntry_Data(tree->entries);
+	unsigned int root = 0;
+	tree->stack->size = 0;
+	DynamicArray_Append(tree->stack, &root);
+
+	while(tree->stack->size > 0)
+	{
+		unsigned int index = ((unsigned int*)tree->stack->data)[--tree->stack->size];
+		struct BVH_Node* node = nodes + index;
+		if(!BVH_DoesOverlap(&node->bounds, bounds)) continue;
+
+		if(node->count > 0)
+		{
+			for(unsigned int i = node->offset; i < node->offset + node->count; i++)
+			{
+				if(BVH_DoesOverlap(&entries[i].bounds, bounds))
+				{
+					DynamicArray_Append(dest, &entries[i].obj);
+				}
+			}
+			continue;
+		}
+
+		unsigned int children[2] = { index + 1, node->offset };
+		DynamicArray_AppendN(tree->stack, children, 2);
+	}
+}
+
+///
+//Finds every object in a BVH whose bounds are crossed by a ray
+//The tree must be up to date.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void BVH_QueryRay(BVH* tree, struct ColliderData_Ray* worldRay, DynamicArray* dest)
+{
+	if(tree->nodes->size == 0) return;
+
+	struct BVH_SlabRay ray;
+	BVH_PrepareRay(&ray, worldRay);
+
+	struct BVH_Node* nodes = DynamicArray_BVHNode_Data(tree->nodes);
+	struct BVH_Entry* entries = DynamicArray_BVHEntry_Data(tree->entries);
+	unsigned int root = 0;
+	tree->stack->size = 0;
+	DynamicArray_Append(tree->stack, &root);
+
+	while(tree->stack->size > 0)
+	{
+		unsigned int index = ((unsigned int*)tree->stack->data)[--tree->stack->size];
+		struct BVH_Node* node = nodes + index;
+		if(BVH_GetRayEntry(&node->bounds, &ray, FLT_MAX) < 0.0f) continue;
+
+		if(node->count > 0)
+		{
+			for(unsigned int i = node->offset; i < node->offset + node->count; i++)
+			{
+				if(BVH_GetRayEntry(&entries[i].bounds, &ray, FLT_MAX) >= 0.0f)
+				{
+					DynamicArray_Append(dest, &entries[i].obj);
+				}
+			}
+			continue;
+		}
+
+		unsigned int children[2] = { index + 1, node->offset };
+		DynamicArray_AppendN(tree->stack, children, 2);
+	}
+}
+
+///
+//Casts a batch of rays through a BVH, replacing the hit of each ray with any nearer object it meets
+//The nearer child of each node is visited first, and subtrees the ray enters beyond it's closest hit are skipped,
+//so the hits found by casting the rays through another structure first are merged for little extra work.
+//The tree must be up to date.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	dest: An array of numRays hits holding the closest hit of each ray so far,
+//		each with a NULL object and the furthest parametric value to accept if the ray has not met an object
+//	worldRays: An array of numRays rays oriented in world space
+//	numRays: The number of rays to cast
+//	anyHit: 1 to leave rays which have already met an object and stop the rest at the first object they meet, else 0
+//	test: The function testing a ray against the collider of an object whose bounds the ray crosses
+//	data: Passed to the test function
+void BVH_RayCast(BVH* tree, struct AABBTree_RayHit* dest, struct ColliderData_Ray* worldRays, unsigned int numRays, unsigned char anyHit, AABBTree_RayTestFunction test, void* data)
+{
+	if(tree->nodes->size == 0) return;
+
+	struct BVH_Node* nodes = DynamicArray_BVHNode_Data(tree->nodes);
+	struct BVH_Entry* entries = DynamicArray_BVHEntry_Data(tree->entries);
+	DynamicArray* stack = tree->rayStack;
+
+	for(unsigned int i = 0; i < numRays; i++)
+	{
+		if(anyHit && dest[i].obj != NULL) continue;
+
+		struct ColliderData_Ray* worldRay = worldRays + i;
+		struct BVH_SlabRay ray;
+		BVH_PrepareRay(&ray, worldRay);
+
+		float closest = dest[i].distance;
+		struct BVH_RayNode root = { 0, BVH_GetRayEntry(&nodes[0].bounds, &ray, closest) };
+		if(root.entry < 0.0f) continue;
+
+		stack->size = 0;
+		DynamicArray_Append(stack, &root);
+
+		unsigned char done = 0;
+		while(stack->size > 0 && !done)
+		{
+			struct BVH_RayNode visit = ((struct BVH_RayNode*)stack->data)[--stack->size];
+			//A closer hit may have been found since the node was pushed
+			if(visit.entry > closest) continue;
+
+			struct BVH_Node* node = nodes + visit.node;
+			if(node->count > 0)
+			{
+				for(unsigned int j = node->offset; j < node->offset + node->count; j++)
+				{
+					if(BVH_GetRayEntry(&entries[j].bounds, &ray, closest) < 0.0f) continue;
+
+					float distance = test(entries[j].obj, worldRay, data);
+					if(distance >= 0.0f && distance <= closest)
+					{
+						closest = distance;
+						dest[i].obj = entries[j].obj;
+						dest[i].distance = distance;
+						if(anyHit)
+						{
+							done = 1;
+							break;
+						}
+					}
+				}
+				continue;
+			}
+
+			struct BVH_RayNode children[2] =
+			{
+				{ visit.node + 1, BVH_GetRayEntry(&nodes[visit.node + 1].bounds, &ray, closest) },
+				{ node->offset, BVH_GetRayEntry(&nodes[node->offset].bounds, &ray, closest) }
+			};
+
+			//Push the further child first so the nearer one is visited first
+			unsigned int nearer = children[1].entry >= 0.0f && (children[0].entry < 0.0f || children[1].entry < children[0].entry);
+			if(children[1 - nearer].entry >= 0.0f) DynamicArray_Append(stack, children + 1 - nearer);
+			if(children[nearer].entry >= 0.0f) DynamicArray_Append(stack, children + nearer);
+		}
+	}
+}
+
+///
+//Builds the subtree of a BVH holding a range of it's entries, appending it's nodes in depth first order
+//The entries are reordered so each leaf's objects are contiguous.
+//
+//Parameters:
+//	tree: A pointer to the BVH being built
+//	first: The index of the first entry of the subtree
+//	count: The number of entries in the subtree
+//
+//Returns:
+//	The index of the root node of the subtree
+static unsigned int BVH_BuildNode(BVH* tree, unsigned int first, unsigned int count)
+{
+	struct BVH_Entry* entries = DynamicArray_BVHEntry_Data(tree->entries) + first;
+
+	struct BVH_Node node;
+	struct ColliderData_AABB centroidBounds;
+	BVH_Empty(&node.bounds);
+	BVH_Empty(&centroidBounds);
+	for(unsigned int i = 0; i < count; i++)
+	{
+		struct ColliderData_AABB centroid;
+		for(int j = 0; j < 3; j++)
+		{
+			centroid.min[j] = centroid.max[j] = entries[i].centroid[j];
+		}
+		BVH_Merge(&node.bounds, &entries[i].bounds);
+		BVH_Merge(&centroidBounds, &centroid);
+	}
+	node.offset = first;
+	node.count = count;
+
+	unsigned int index = tree->nodes->size;
+	DynamicArray_BVHNode_Append(tree->nodes, node);
+	if(count == 1) return index;
+
+	//Find the cheapest split over the bins of every axis
+	float parentArea = BVH_GetHalfArea(&node.bounds);
+	float bestCost = FLT_MAX;
+	int bestAxis = -1;
+	unsigned int bestSplit = 0;
+	for(int axis = 0; axis < 3; axis++)
+	{
+		float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+		if(extent <= FLT_EPSILON) continue;
+		float scale = BVH_NUM_BINS / extent;
+
+		struct BVH_Bin bins[BVH_NUM_BINS];
+		for(unsigned int i = 0; i < BVH_NUM_BINS; i++)
+		{
+			BVH_Empty(&bins[i].bounds);
+			bins[i].count = 0;
+		}
+		for(unsigned int i = 0; i < count; i++)
+		{
+			struct BVH_Bin* bin = bins + BVH_GetBin(entries[i].centroid[axis], centroidBounds.min[axis], scale);
+			BVH_Merge(&bin->bounds, &entries[i].bounds);
+			bin->count++;
+		}
+
+		//Sweep from the right to find the cost of the right side of each split, then from the left to find the total
+		float rightCosts[BVH_NUM_BINS];
+		struct ColliderData_AABB rightBounds;
+		unsigned int rightCount = 0;
+		BVH_Empty(&rightBounds);
+		for(unsigned int i = BVH_NUM_BINS - 1; i > 0; i--)
+		{
+			BVH_Merge(&rightBounds, &bins[i].bounds);
+			rightCount += bins[i].count;
+			rightCosts[i] = rightCount > 0 ? rightCount * BVH_GetHalfArea(&rightBounds) : 0.0f;
+		}
+
+		struct ColliderData_AABB leftBounds;
+		unsigned int leftCount = 0;
+		BVH_Empty(&leftBounds);
+		for(unsigned int split = 1; split < BVH_NUM_BINS; split++)
+		{
+			BVH_Merge(&leftBounds, &bins[split - 1].bounds);
+			leftCount += bins[split - 1].count;
+			if(leftCount == 0 || leftCount == count) continue;
+
+			float cost = BVH_TRAVERSAL_COST + (leftCount * BVH_GetHalfArea(&leftBounds) + rightCosts[split]) / parentArea;
+			if(cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	//Small nodes are only split when it is cheaper than testing each of their objects
+	if(count <= BVH_MAX_LEAF_SIZE && !(bestCost < (float)count)) return index;
+
+	unsigned int leftCount;
+	if(bestAxis >= 0)
+	{
+		float scale = BVH_NUM_BINS / (centroidBounds.max[bestAxis] - centroidBounds.min[bestAxis]);
+		unsigned int left = 0;
+		unsigned int right = count;
+		while(left < right)
+		{
+			if(BVH_GetBin(entries[left].centroid[bestAxis], centroidBounds.min[bestAxis], scale) < bestSplit)
+			{
+				left++;
+			}
+			else
+			{
+				struct BVH_Entry swap = entries[left];
+				entries[left] = entries[--right];
+				entries[right] = swap;
+			}
+		}
+		leftCount = left;
+	}
+	else
+	{
+		//Every centroid is in the same place, no split separates them so halve the objects
+		leftCount = count / 2;
+	}
+
+	//Appending the children may move the nodes, so the node is found by it's index afterwards
+	BVH_BuildNode(tree, first, leftCount);
+	unsigned int rightChild = BVH_BuildNode(tree, first + leftCount, count - leftCount);
+
+	struct BVH_Node* inner = DynamicArray_BVHNode_Index(tree->nodes, index);
+	inner->offset = rightChild;
+	inner->count = 0;
+	return index;
+}
+
+///
+//Gets the bin of a centroid along an axis of a node
+//
+//Parameters:
+//	centroid: The position of the centroid along the axis
+//	min: The smallest position of any centroid in the node along the axis
+//	scale: The number of bins per unit along the axis
+//
+//Returns:
+//	The index of the bin, from 0 to BVH_NUM_BINS - 1
+static unsigned int BVH_GetBin(float centroid, float min, float scale)
+{
+	unsigned int bin = (unsigned int)((centroid - min) * scale);
+	return bin < BVH_NUM_BINS ? bin : BVH_NUM_BINS - 1;
+}
+
+///
+//Gets half of the surface area of an axis aligned bounding box
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//
+//Returns:
+//	The sum of the areas of three of the faces of the AABB
+static float BVH_GetHalfArea(const struct ColliderData_AABB* bounds)
+{
+	float x = bounds->max[0] - bounds->min[0];
+	float y = bounds->max[1] - bounds->min[1];
+	float z = bounds->max[2] - bounds->min[2];
+	return x * y + y * z + z * x;
+}
+
+///
+//Grows an axis aligned bounding box to contain another
+//
+//Parameters:
+//	dest: A pointer to the AABB to grow
+//	bounds: A pointer to the AABB to contain
+static void BVH_Merge(struct ColliderData_AABB* dest, const struct ColliderData_AABB* bounds)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		if(bounds->min[i] < dest->min[i]) dest->min[i] = bounds->min[i];
+		if(bounds->max[i] > dest->max[i]) dest->max[i] = bounds->max[i];
+	}
+}
+
+///
+//Sets an axis aligned bounding box to the empty box which any other box grows it to
+//
+//Parameters:
+//	dest: A pointer to the AABB to empty
+static void BVH_Empty(struct ColliderData_AABB* dest)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		dest->min[i] = FLT_MAX;
+		dest->max[i] = -FLT_MAX;
+	}
+}
+
+///
+//Determines if two axis aligned bounding boxes overlap
+//
+//Parameters:
+//	bounds1: A pointer to the first AABB
+//	bounds2: A pointer to the second AABB
+//
+//Returns:
+//	1 if the boxes overlap, else 0
+static unsigned char BVH_DoesOverlap(const struct ColliderData_AABB* bounds1, const struct ColliderData_AABB* bounds2)
+{
+	return bounds1->min[0] <= bounds2->max[0] && bounds2->min[0] <= bounds1->max[0]
+		&& bounds1->min[1] <= bounds2->max[1] && bounds2->min[1] <= bounds1->max[1]
+		&& bounds1->min[2] <= bounds2->max[2] && bounds2->min[2] <= bounds1->max[2];
+}
+
+///
+//Prepares a ray for the slab tests of a ray cast
+//
+//Parameters:
+//	dest: A pointer to the prepared ray to initialize
+//	worldRay: A pointer to the ray oriented in world space
+static void BVH_PrepareRay(struct BVH_SlabRay* dest, struct ColliderData_Ray* worldRay)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		float direction = worldRay->direction->components[i];
+		dest->origin[i] = worldRay->position->components[i];
+		dest->parallel[i] = direction > -FLT_EPSILON && direction < FLT_EPSILON;
+		dest->inverseDirection[i] = dest->parallel[i] ? 0.0f : 1.0f / direction;
+	}
+}
+
+///
+//Finds where a prepared ray enters an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//	maxDistance: The furthest parametric value along the ray to consider
+//
+//Returns:
+//	The parametric value where the ray enters the bounds, 0 if it starts within them,
+//	or a negative value if the ray misses the bounds within maxDistance
+static float BVH_GetRayEntry(const struct ColliderData_AABB* bounds, const struct BVH_SlabRay* ray, float maxDistance)
+{
+	float entry = 0.0f;
+	float exit = maxDistance;
+	for(int i = 0; i < 3; i++)
+	{
+		//A ray parallel to a slab must start within it
+		if(ray->parallel[i])
+		{
+			if(ray->origin[i] < bounds->min[i] || ray->origin[i] > bounds->max[i]) return -1.0f;
+			continue;
+		}
+
+		float t1 = (bounds->min[i] - ray->origin[i]) * ray->inverseDirection[i];
+		float t2 = (bounds->max[i] - ray->origin[i]) * ray->inverseDirection[i];
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > entry) entry = t1;
+		if(t2 < exit) exit = t2;
+		if(entry > exit) return -1.0f;
+	}
+	return entry;
+}
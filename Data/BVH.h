@@ -0,0 +1,172 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include "../GObject/GObject.h"		//The data the BVH will contain
+#include "DynamicArray.h"
+#include "HashMap.h"
+#include "AABBTree.h"		//The ray hits and ray tests shared with the AABB tree
+
+//Most objects a leaf of a BVH holds before the builder considers splitting it further
+#define BVH_MAX_LEAF_SIZE 4
+//Number of bins the centroids of a node's objects are sorted into along each axis when searching for a split
+#define BVH_NUM_BINS 16
+//Cost of visiting an inner node relative to testing the bounds of one object, weighed by the surface area heuristic
+#define BVH_TRAVERSAL_COST 1.0f
+
+struct BVH_Node
+{
+	//The union of the bounds of every object beneath the node
+	struct ColliderData_AABB bounds;
+	//Index of the first object of a leaf, or of the second child of an inner node.
+	//The first child of an inner node always directly follows it.
+	unsigned int offset;
+	//Number of objects in a leaf, 0 in an inner node
+	unsigned int count;
+};
+
+///
+//An object held by a leaf of a BVH
+struct BVH_Entry
+{
+	struct ColliderData_AABB bounds;	//World space bounds of the object's collider when the tree was built
+	float centroid[3];			//Center of the bounds
+	GObject* obj;
+};
+
+//Typed accessors for node and entry arrays
+DYNARRAY_DECLARE(BVHNode, struct BVH_Node);
+DYNARRAY_DECLARE(BVHEntry, struct BVH_Entry);
+
+///
+//A bounding volume hierarchy of objects which do not move, built top down with the surface area heuristic.
+//The tree is never updated in place, it is rebuilt from scratch the next time it is used after it's objects change.
+typedef struct BVH
+{
+	//Every object held by the tree, in no particular order (GObject*)
+	DynamicArray* objects;
+	//Maps each object to it's index in objects
+	HashMap* map;
+
+	//Nodes of the tree in depth first order, the root is the first node (struct BVH_Node)
+	DynamicArray* nodes;
+	//Objects of the tree in the order of the leaves holding them (struct BVH_Entry)
+	DynamicArray* entries;
+	//1 if objects have been added, removed or moved since the tree was last built, else 0
+	unsigned char dirty;
+
+	//Storage for the nodes left to visit during a query
+	DynamicArray* stack;
+	//Storage for the nodes left to visit during a ray cast, along with the distance each ray enters them
+	DynamicArray* rayStack;
+} BVH;
+
+///
+//Allocates memory for a BVH
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized BVH
+BVH* BVH_Allocate(void);
+
+///
+//Initializes an empty BVH
+//
+//Parameters:
+//	tree: A pointer to the BVH to initialize
+void BVH_Initialize(BVH* tree);
+
+///
+//Frees the data allocated by a BVH.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	tree: A pointer to the BVH to free
+void BVH_Free(BVH* tree);
+
+///
+//Adds a game object with a collider of finite bounds to a BVH
+//The tree is rebuilt the next time it is updated.
+//Objects which have already been added are ignored.
+//
+//Parameters:
+//	tree: A pointer to the BVH to add to
+//	obj: A pointer to the game object to add
+void BVH_Add(BVH* tree, GObject* obj);
+
+///
+//Removes a game object from a BVH
+//The tree is rebuilt the next time it is updated.
+//
+//Parameters:
+//	tree: A pointer to the BVH to remove from
+//	obj: A pointer to the game object to remove
+//
+//Returns:
+//	1 if the object was held by the tree, else 0
+unsigned char BVH_Remove(BVH* tree, GObject* obj);
+
+///
+//Determines if a BVH holds a game object
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	obj: A pointer to the game object
+//
+//Returns:
+//	1 if the object has been added to the tree, else 0
+unsigned char BVH_Contains(BVH* tree, GObject* obj);
+
+///
+//Marks a BVH to be rebuilt the next time it is updated
+//Call this when an object held by the tree has moved.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+void BVH_Invalidate(BVH* tree);
+
+///
+//Rebuilds a BVH if it's objects have changed since it was last built
+//Each node is split along the axis and binned centroid position which minimizes
+//the surface area heuristic, or left as a leaf when no split is cheaper than testing all of it's objects.
+//
+//Parameters:
+//	tree: A pointer to the BVH to update
+void BVH_Update(BVH* tree);
+
+///
+//Finds every object in a BVH whose bounds overlap an axis aligned bounding box
+//The tree must be up to date.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void BVH_QueryAABB(BVH* tree, const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Finds every object in a BVH whose bounds are crossed by a ray
+//The tree must be up to date.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void BVH_QueryRay(BVH* tree, struct ColliderData_Ray* worldRay, DynamicArray* dest);
+
+///
+//Casts a batch of rays through a BVH, replacing the hit of each ray with any nearer object it meets
+//The nearer child of each node is visited first, and subtrees the ray enters beyond it's closest hit are skipped,
+//so the hits found by casting the rays through another structure first are merged for little extra work.
+//The tree must be up to date.
+//
+//Parameters:
+//	tree: A pointer to the BVH
+//	dest: An array of numRays hits holding the closest hit of each ray so far,
+//		each with a NULL object and the furthest parametric value to accept if the ray has not met an object
+//	worldRays: An array of numRays rays oriented in world space
+//	numRays: The number of rays to cast
+//	anyHit: 1 to leave rays which have already met an object and stop the rest at the first object they meet, else 0
+//	test: The function testing a ray against the collider of an object whose bounds the ray crosses
+//	data: Passed to the test function
+void BVH_RayCast(BVH* tree, struct AABBTree_RayHit* dest, struct ColliderData_Ray* worldRays, unsigned int numRays, unsigned char anyHit, AABBTree_RayTestFunction test, void* data);
+
+#endif
@@ -92,6 +92,20 @@ void DynamicArray_Append(DynamicArray* arr, void* data)
 }
 
 
+///
+//Appends a dynamic array with multiple contiguous elements, growing at most once
+//
+//Parameters:
+//	arr: Dynamic array to append
+//	data: Pointer to the first of the elements to append
+//	n: The number of elements to append
+void DynamicArray_AppendN(DynamicArray* arr, void* data, unsigned int n)
+{
+	DynamicArray_Reserve(arr, arr->size + n);
+	memcpy(((char*)arr->data) + (arr->dataSize * arr->size), data, arr->dataSize * n);
+	arr->size += n;
+}
+
 ///
 //Indexes a dynamic array
 //
@@ -156,6 +170,46 @@ void DynamicArray_RemoveAndReposition(DynamicArray* arr, const unsigned int inde
 	arr->size--;
 }
 
+///
+//Inserts n contiguous elements into a dynamic array at the given index,
+//moving all elements at and after the index forward n spaces to preserve their order.
+//
+//Parameters:
+//	arr: The dynamic array to insert into
+//	index: The index the first inserted element will occupy
+//	data: Pointer to the first of the elements to insert
+//	n: The number of elements to insert
+void DynamicArray_InsertN(DynamicArray* arr, const unsigned int index, void* data, unsigned int n)
+{
+	DynamicArray_Reserve(arr, arr->size + n);
+
+	char* insertPointer = (char*)arr->data + (index * arr->dataSize);
+	//Move the elements following the index forward to make room
+	memmove(insertPointer + (n * arr->dataSize), insertPointer, (arr->size - index) * arr->dataSize);
+	memcpy(insertPointer, data, n * arr->dataSize);
+
+	arr->size += n;
+}
+
+///
+//Removes n contiguous elements from the dynamic array starting at the given index.
+//Then copies all data back n spaces to ensure no gaps in data exist.
+//
+//Parameters:
+//	arr: A pointer to the dynamic array to remove elements from
+//	index: The index of the first element to remove
+//	n: The number of elements to remove
+void DynamicArray_RemoveN(DynamicArray* arr, const unsigned int index, unsigned int n)
+{
+	char* dstPointer = (char*)arr->data + (index * arr->dataSize);
+	//Copy the elements following the removed range back over it
+	memmove(dstPointer, dstPointer + (n * arr->dataSize), (arr->size - (index + n)) * arr->dataSize);
+
+	//Clear the now unused elements at the end of the array
+	arr->size -= n;
+	memset((char*)arr->data + (arr->size * arr->dataSize), 0, n * arr->dataSize);
+}
+
 ///
 //Removes an element from the dynamic array.
 //
@@ -210,6 +264,22 @@ void DynamicArray_RemoveData(DynamicArray* arr, void* data)
 	}
 }
 
+///
+//Removes an element from the dynamic array by moving the last element into it's place.
+//Does not preserve the order of the elements.
+//
+//Parameters:
+//	arr: A pointer to the dynamic array to remove an element from
+//	index: The index of the element to remove
+void DynamicArray_SwapRemove(DynamicArray* arr, const unsigned int index)
+{
+	arr->size--;
+	if(index != arr->size)
+	{
+		memcpy((char*)arr->data + (index * arr->dataSize), (char*)arr->data + (arr->size * arr->dataSize), arr->dataSize);
+	}
+}
+
 ///
 //Determines if data is already contained in the array
 //Searches the entire array
@@ -279,3 +349,28 @@ void DynamicArray_Grow(DynamicArray* arr)
 	free(arr->data);
 	arr->data = newPtr;
 }
+
+///
+//Increases the capacity of a dynamic array until it can hold at least the given number of elements
+//
+//Parameters:
+//	arr: The dynamic array to reserve space in
+//	capacity: The number of elements the array must be able to hold
+void DynamicArray_Reserve(DynamicArray* arr, unsigned int capacity)
+{
+	if(capacity <= arr->capacity) return;
+
+	unsigned int oldSize = arr->capacity;
+
+	//Grow by the growth rate as many times as needed so repeated reserves stay amortized
+	while(arr->capacity < capacity)
+	{
+		unsigned int grown = (unsigned int)(arr->growthRate * arr->capacity);
+		arr->capacity = grown > arr->capacity ? grown : arr->capacity + 1;
+	}
+
+	void* newPtr = malloc(arr->dataSize * arr->capacity);
+	memcpy(newPtr, arr->data, oldSize * arr->dataSize);
+	free(arr->data);
+	arr->data = newPtr;
+}
@@ -1,6 +1,8 @@
 #ifndef DYNAMICARRAY_H
 #define DYNAMICARRAY_H
 
+#include <string.h>
+
 typedef struct DynamicArray {
 	unsigned int capacity;	//Total available slots
 	unsigned int size;		//Current size
@@ -52,6 +54,14 @@ void DynamicArray_Copy(DynamicArray* arr, DynamicArray* toCopy);
 //	arr: The dynamic array to increase in size
 void DynamicArray_Grow(DynamicArray* arr);
 
+///
+//Increases the capacity of a dynamic array until it can hold at least the given number of elements
+//
+//Parameters:
+//	arr: The dynamic array to reserve space in
+//	capacity: The number of elements the array must be able to hold
+void DynamicArray_Reserve(DynamicArray* arr, unsigned int capacity);
+
 ///
 //Appends a dynamic array with data
 //
@@ -60,6 +70,15 @@ void DynamicArray_Grow(DynamicArray* arr);
 //	data: Data to append to array
 void DynamicArray_Append(DynamicArray* arr, void* data);
 
+///
+//Appends a dynamic array with multiple contiguous elements, growing at most once
+//
+//Parameters:
+//	arr: Dynamic array to append
+//	data: Pointer to the first of the elements to append
+//	n: The number of elements to append
+void DynamicArray_AppendN(DynamicArray* arr, void* data, unsigned int n);
+
 ///
 //Indexes a dynamic array
 //
@@ -88,6 +107,27 @@ void DynamicArray_Clear(DynamicArray* arr);
 //	index: The index of the element to remove
 void DynamicArray_RemoveAndReposition(DynamicArray* arr, const unsigned int index);
 
+///
+//Inserts n contiguous elements into a dynamic array at the given index,
+//moving all elements at and after the index forward n spaces to preserve their order.
+//
+//Parameters:
+//	arr: The dynamic array to insert into
+//	index: The index the first inserted element will occupy
+//	data: Pointer to the first of the elements to insert
+//	n: The number of elements to insert
+void DynamicArray_InsertN(DynamicArray* arr, const unsigned int index, void* data, unsigned int n);
+
+///
+//Removes n contiguous elements from the dynamic array starting at the given index.
+//Then copies all data back n spaces to ensure no gaps in data exist.
+//
+//Parameters:
+//	arr: A pointer to the dynamic array to remove elements from
+//	index: The index of the first element to remove
+//	n: The number of elements to remove
+void DynamicArray_RemoveN(DynamicArray* arr, const unsigned int index, unsigned int n);
+
 ///
 //Removes an element from the dynamic array.
 //
@@ -113,6 +153,15 @@ void DynamicArray_RemoveDataAndReposition(DynamicArray* arr, void* data);
 //	data: The data to remove
 void DynamicArray_RemoveData(DynamicArray* arr, void* data);
 
+///
+//Removes an element from the dynamic array by moving the last element into it's place.
+//Does not preserve the order of the elements.
+//
+//Parameters:
+//	arr: A pointer to the dynamic array to remove an element from
+//	index: The index of the element to remove
+void DynamicArray_SwapRemove(DynamicArray* arr, const unsigned int index);
+
 ///
 //Determines if data is already contained in the array
 //Searches the entire array
@@ -139,4 +188,48 @@ unsigned char DynamicArray_Contains(DynamicArray* arr, void* data);
 //	1 if the data is contained
 unsigned char DynamicArray_ContainsWithin(DynamicArray* arr, void* data, unsigned int n);
 
+///
+//Typed access
+//
+//DYNARRAY_DECLARE(Name, Type) generates inline functions named DynamicArray_<Name>_<Function>
+//which treat a DynamicArray initialized with a dataSize of sizeof(Type) as an array of Type.
+//They operate on the same DynamicArray struct, so typed and untyped calls can be mixed.
+//Declare each Name once, in the header which owns the element type.
+//
+//	DynamicArray_<Name>_Data(arr)			Pointer to the first element
+//	DynamicArray_<Name>_Index(arr, index)		Pointer to the element at index
+//	DynamicArray_<Name>_Get(arr, index)		Copy of the element at index
+//	DynamicArray_<Name>_Append(arr, value)		Appends a single element
+//	DynamicArray_<Name>_AppendN(arr, values, n)	Appends n contiguous elements
+//	DynamicArray_<Name>_SwapRemove(arr, index)	Removes the element at index, moving the last element into it's place
+//	DynamicArray_<Name>_Begin(arr), _End(arr)	Pointers to the first element and one past the last element
+//
+//Iterate with DYNARRAY_FOREACH(Name, iterator, arr), where iterator is a pointer to each element in turn.
+#define DYNARRAY_DECLARE(Name, Type) \
+	static inline Type* DynamicArray_##Name##_Data(DynamicArray* arr) { return (Type*)arr->data; } \
+	static inline Type* DynamicArray_##Name##_Index(DynamicArray* arr, unsigned int index) { return (Type*)arr->data + index; } \
+	static inline Type DynamicArray_##Name##_Get(DynamicArray* arr, unsigned int index) { return ((Type*)arr->data)[index]; } \
+	static inline void DynamicArray_##Name##_Append(DynamicArray* arr, Type value) \
+	{ \
+		if(arr->size == arr->capacity) DynamicArray_Grow(arr); \
+		((Type*)arr->data)[arr->size++] = value; \
+	} \
+	static inline void DynamicArray_##Name##_AppendN(DynamicArray* arr, Type const* values, unsigned int n) \
+	{ \
+		DynamicArray_Reserve(arr, arr->size + n); \
+		memcpy((Type*)arr->data + arr->size, values, n * sizeof(Type)); \
+		arr->size += n; \
+	} \
+	static inline void DynamicArray_##Name##_SwapRemove(DynamicArray* arr, unsigned int index) \
+	{ \
+		Type* elements = (Type*)arr->data; \
+		elements[index] = elements[--arr->size]; \
+	} \
+	static inline Type* DynamicArray_##Name##_Begin(DynamicArray* arr) { return (Type*)arr->data; } \
+	static inline Type* DynamicArray_##Name##_End(DynamicArray* arr) { return (Type*)arr->data + arr->size; } \
+	typedef Type DynamicArray_##Name##_Type
+
+#define DYNARRAY_FOREACH(Name, iterator, arr) \
+	for(DynamicArray_##Name##_Type* iterator = DynamicArray_##Name##_Begin(arr); iterator != DynamicArray_##Name##_End(arr); iterator++)
+
 #endif
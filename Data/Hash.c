@@ -1,6 +1,7 @@
 #include "Hash.h"
 
 #include <string.h>
+#include <stdint.h>
 
 ///
 //A quick 'n dirty implementation of the sdbm public domain hash. 
@@ -8,6 +9,7 @@
 //
 //Parameters:
 //	key: The key to hash
+//	keyLength: The size of the key in bytes
 //
 //Returns:
 //	The hashvalue of the key
@@ -24,3 +26,47 @@ unsigned long Hash_SDBM(void* key, unsigned int keyLength)
 	}
 	return hash;
 }
+
+///
+//64 bit FNV-1a hash, for string and other variable length keys
+//
+//Parameters:
+//	key: The key to hash
+//	keyLength: The size of the key in bytes
+//
+//Returns:
+//	The hashvalue of the key
+unsigned long Hash_FNV1a64(void* key, unsigned int keyLength)
+{
+	unsigned char* byteKey = (unsigned char*)key;
+	uint64_t hash = 14695981039346656037ULL;
+
+	for(unsigned int i = 0; i < keyLength; i++)
+	{
+		hash ^= byteKey[i];
+		hash *= 1099511628211ULL;
+	}
+
+	//Fold the well mixed high bits onto the low bits used to index power of two tables
+	return (unsigned long)(hash ^ (hash >> 32));
+}
+
+///
+//Fibonacci multiply-shift hash, for pointer and integer keys of up to 8 bytes.
+//Keys longer than 8 bytes only have their first 8 bytes hashed.
+//
+//Parameters:
+//	key: The key to hash
+//	keyLength: The size of the key in bytes
+//
+//Returns:
+//	The hashvalue of the key
+unsigned long Hash_MultiplyShift(void* key, unsigned int keyLength)
+{
+	uint64_t value = 0;
+	memcpy(&value, key, keyLength < sizeof(uint64_t) ? keyLength : sizeof(uint64_t));
+
+	//2^64 / golden ratio. The high bits of the product depend on every bit of the key,
+	//shift them down so they are the ones selected by a power of two mask.
+	return (unsigned long)((value * 11400714819323198485ULL) >> 32);
+}
@@ -6,9 +6,33 @@
 //
 //Parameters:
 //	key: The key to hash
+//	keyLength: The size of the key in bytes
 //
 //Returns:
 //	The hashvalue of the key
 unsigned long Hash_SDBM(void* key, unsigned int keyLength);
 
+///
+//64 bit FNV-1a hash, for string and other variable length keys
+//
+//Parameters:
+//	key: The key to hash
+//	keyLength: The size of the key in bytes
+//
+//Returns:
+//	The hashvalue of the key
+unsigned long Hash_FNV1a64(void* key, unsigned int keyLength);
+
+///
+//Fibonacci multiply-shift hash, for pointer and integer keys of up to 8 bytes.
+//Keys longer than 8 bytes only have their first 8 bytes hashed.
+//
+//Parameters:
+//	key: The key to hash
+//	keyLength: The size of the key in bytes
+//
+//Returns:
+//	The hashvalue of the key
+unsigned long Hash_MultiplyShift(void* key, unsigned int keyLength);
+
 #endif
@@ -5,26 +5,45 @@
 #include <stdio.h>
 
 #include "Hash.h"
-#include "../GObject/GObject.h"
 
 ///
 //Internal Declarations
 
 ///
-//Increases the internal storage of the hashmap, and re-hashes all existing key value pairs
+//Determines if the key held by a pair matches a key
 //
 //Parameters:
-//	map: THe hashmap to increase the internal storage of
-static void HashMap_Grow(HashMap* map);
+//	map: The hashmap the pair belongs to
+//	pair: The occupied key value pair to compare against
+//	key: The key to compare
+//	keyLength: The size of the key in bytes
+//	hash: The hash of the key
+//
+//Returns:
+//	1 if the keys match, else 0
+static unsigned char HashMap_KeyEquals(HashMap* map, struct HashMap_KeyValuePair* pair, void* key, unsigned int keyLength, unsigned long hash);
+
+///
+//Finds the slot holding a key
+//Probing stops at the first empty slot, tombstones are skipped.
+//
+//Parameters:
+//	map: The hashmap to search
+//	key: The key to search for
+//	keyLength: The size of the key in bytes
+//	hash: The hash of the key
+//
+//Returns:
+//	A pointer to the slot holding the key, or NULL if the key is not in the map
+static struct HashMap_KeyValuePair* HashMap_FindSlot(HashMap* map, void* key, unsigned int keyLength, unsigned long hash);
 
 ///
-//Takes an existing key value pair and re-hashes and re-adds it to the hashmap
-//To be used when a hashmap is growing in size
+//Rebuilds the slots of a hashmap with a new capacity, re-adding all occupied slots and dropping all tombstones
 //
 //Parameters:
-//	map: THe hashmap the existing pair is being added to
-//	pair: THe pair to add
-static void HashMap_AddPair(HashMap* map, struct HashMap_KeyValuePair* pair);
+//	map: The hashmap to rehash
+//	capacity: The new capacity of the hashmap, must be a power of two
+static void HashMap_Rehash(HashMap* map, unsigned int capacity);
 
 ///
 //Implementations
@@ -41,15 +60,38 @@ HashMap* HashMap_Allocate(void)
 }
 
 ///
-//Initializes a HashMap
+//Initializes a HashMap for keys of arbitrary bytes
 //
 //Parameters:
 //	map: Hashmap to initialize
 void HashMap_Initialize(HashMap* map)
+{
+	HashMap_InitializeWithKeyType(map, HashMap_KeyType_BYTES);
+}
+
+///
+//Initializes a HashMap for a specific type of key
+//Selects the hash function suited to the key type, which can be overridden through map->Hash.
+//
+//Parameters:
+//	map: Hashmap to initialize
+//	keyType: The type of key the map will hold
+void HashMap_InitializeWithKeyType(HashMap* map, enum HashMap_KeyType keyType)
 {
 	map->data = DynamicArray_Allocate();
-	DynamicArray_Initialize(map->data, sizeof(struct HashMap_KeyValuePair*));
-	map->Hash = Hash_SDBM;
+	DynamicArray_Initialize(map->data, sizeof(struct HashMap_KeyValuePair));
+	map->tombstones = 0;
+	map->keyType = keyType;
+
+	switch(keyType)
+	{
+	case HashMap_KeyType_POINTER:
+		map->Hash = Hash_MultiplyShift;
+		break;
+	default:
+		map->Hash = Hash_FNV1a64;
+		break;
+	}
 }
 
 ///
@@ -60,16 +102,13 @@ void HashMap_Initialize(HashMap* map)
 //	map: The Hashmap to free
 void HashMap_Free(HashMap* map)
 {
-	//for (unsigned int i = 0; i < map->size; i++)
 	for(unsigned int i = 0; i < map->data->capacity; i++)
 	{
-		struct HashMap_KeyValuePair* pair = NULL;
-		if((pair = *(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, i)) != NULL)
+		struct HashMap_KeyValuePair* pair = HashMap_GetPair(map, i);
+		if(pair != NULL)
 		{
 			HashMap_KeyValuePair_Free(pair);
-			DynamicArray_Remove(map->data, i);
 		}
-
 	}
 	
 	DynamicArray_Free(map->data);
@@ -78,6 +117,7 @@ void HashMap_Free(HashMap* map)
 
 ///
 //Adds data to a hashmap
+//If the key is already in the map the data it maps to is replaced.
 //
 //Parameters:
 //	map: Map to add to
@@ -86,23 +126,47 @@ void HashMap_Free(HashMap* map)
 //	keyLength: The size of the key in bytes
 void HashMap_Add(HashMap* map, void* key, void* data, unsigned int keyLength)
 {
-	struct HashMap_KeyValuePair* pair = HashMap_KeyValuePair_Allocate();
-	HashMap_KeyValuePair_Initialize(pair, key, data, keyLength);
-
-	unsigned int index = map->Hash(key, keyLength) % map->data->capacity;
-	while(*(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, index) != NULL)
+	//Keep the load factor below the maximum, counting tombstones as they lengthen probe sequences
+	if((map->data->size + map->tombstones + 1) * HashMap_MAX_LOAD_DENOMINATOR > map->data->capacity * HashMap_MAX_LOAD_NUMERATOR)
 	{
-		index = (index + 1) % map->data->capacity;
+		//If removals made room, rehashing in place clears the tombstones
+		if((map->data->size + 1) * 2 > map->data->capacity)
+			HashMap_Rehash(map, map->data->capacity * 2);
+		else
+			HashMap_Rehash(map, map->data->capacity);
 	}
 
-	*(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, index) = pair;
-	map->data->size++;
+	unsigned long hash = map->Hash(key, keyLength);
+	unsigned int mask = map->data->capacity - 1;
+	unsigned int index = hash & mask;
+
+	struct HashMap_KeyValuePair* slots = (struct HashMap_KeyValuePair*)map->data->data;
+	struct HashMap_KeyValuePair* firstTombstone = NULL;
+
+	while(slots[index].state != HashMap_SlotState_EMPTY)
+	{
+		struct HashMap_KeyValuePair* pair = slots + index;
+		if(pair->state == HashMap_SlotState_TOMBSTONE)
+		{
+			if(firstTombstone == NULL) firstTombstone = pair;
+		}
+		else if(HashMap_KeyEquals(map, pair, key, keyLength, hash))
+		{
+			pair->data = data;
+			return;
+		}
+		index = (index + 1) & mask;
+	}
 
-	//If the array needs to grow
-	if(map->data->size == map->data->capacity)
+	struct HashMap_KeyValuePair* destination = slots + index;
+	if(firstTombstone != NULL)
 	{
-		HashMap_Grow(map);
+		destination = firstTombstone;
+		map->tombstones--;
 	}
+
+	HashMap_KeyValuePair_Initialize(destination, key, data, keyLength, hash);
+	map->data->size++;
 }
 
 ///
@@ -113,45 +177,27 @@ void HashMap_Add(HashMap* map, void* key, void* data, unsigned int keyLength)
 //	map: Map to remove entry from
 //	key: Key relating to data to be removed
 //	keyLength: The size of the key in bytes
+//
+//Returns:
+//	The data which was mapped to the key, or NULL if the key was not in the map
 void* HashMap_Remove(HashMap* map, void* key, unsigned int keyLength)
 {
-	unsigned short found = 0;
+	struct HashMap_KeyValuePair* pair = HashMap_FindSlot(map, key, keyLength, map->Hash(key, keyLength));
+	if(pair == NULL)
+		return NULL;
+
+	void* data = pair->data;
+	HashMap_KeyValuePair_Free(pair);
+	pair->state = HashMap_SlotState_TOMBSTONE;
+	map->data->size--;
+	map->tombstones++;
 
-	unsigned int index = (map->Hash(key, keyLength) % map->data->capacity);
-	struct HashMap_KeyValuePair* pairToRemove = 0;
-	//for (unsigned int i = 0; i < map->capacity; i++)
-	for(unsigned int i = 0; i < map->data->capacity; i++)
-	{
-		pairToRemove = *(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, (index + i) % map->data->capacity);
-		
-		if(pairToRemove == NULL)
-		{
-			//printf("Pair NULL..\n");
-		}
-		else if(keyLength == pairToRemove->keyLength)
-		{
-			if (memcmp(key, pairToRemove->key, pairToRemove->keyLength) == 0)
-			{
-				index = (index + i) % map->data->capacity;
-				found = 1;
-				break;
-			}
-		}
-	}
-	void* data = NULL;
-	if (found == 1)
-	{
-		data = pairToRemove->data;
-		HashMap_KeyValuePair_Free(pairToRemove);
-		//DynamicArray_Remove(map->data, index);
-		memset((char*)map->data->data + index * map->data->dataSize, 0, map->data->dataSize);
-		map->data->size--;
-	}
 	return data;
 }
 
 ///
 //Looks up a key and returns the related data
+//The returned pair lives inside of the map and is only valid until the next add or remove.
 //
 //Parameters:
 //	map: The HashMap to lookup data in
@@ -159,22 +205,10 @@ void* HashMap_Remove(HashMap* map, void* key, unsigned int keyLength)
 //	keyLength: The size of the key in bytes
 //
 //Returns:
-//	Pointer to data
+//	Pointer to the key value pair, or NULL if the key is not in the map
 struct HashMap_KeyValuePair* HashMap_LookUp(HashMap* map, void* key, unsigned int keyLength)
 {
-	unsigned int index = (map->Hash(key, keyLength) % map->data->capacity);
-	struct HashMap_KeyValuePair* pair = 0;
-	for (unsigned int i = 0; i < map->data->capacity; i++)
-	{
-		pair = *(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, (index + i) % map->data->capacity);
-		if (pair != NULL)
-			if(keyLength == pair->keyLength)
-				if (memcmp(key, pair->key, pair->keyLength) == 0) 	return pair;
-
-	}
-
-	return NULL;
-
+	return HashMap_FindSlot(map, key, keyLength, map->Hash(key, keyLength));
 }
 
 ///
@@ -186,58 +220,52 @@ struct HashMap_KeyValuePair* HashMap_LookUp(HashMap* map, void* key, unsigned in
 //	keyLength: The length of the key in bytes
 unsigned char HashMap_Contains(HashMap* map, void* key, unsigned int keyLength)
 {
-	unsigned int index = (map->Hash(key, keyLength) % map->data->capacity);
-	struct HashMap_KeyValuePair* pair = NULL;
-	for(unsigned int i = 0; i < map->data->capacity; i++)
-	{
-		pair = *(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, (index + i) % map->data->capacity);
-
-
-		if(pair == NULL)
-		{
-			//This cannot be assumed because what if there is a collision, then the object which initially caused the collision is removed
-			//And we search for the object which was subject to the collision.
-			//break;
-		}
-		else
-		{
-			if(keyLength == pair->keyLength)
-			{
-				if(memcmp(key, pair->key, pair->keyLength) == 0) return 1;
-			}
-		}
-	}
-	return 0;
+	return HashMap_FindSlot(map, key, keyLength, map->Hash(key, keyLength)) != NULL;
 }
 
-
-
-//Internals
-
 ///
-//Allocates memory for a Key Value Pair for the HashMap data structure
+//Gets the key value pair held in a slot of the hashmap
+//Used to iterate over all pairs, from slot 0 to map->data->capacity - 1
+//
+//Parameters:
+//	map: The map to index
+//	index: The index of the slot
 //
 //Returns:
-//	A pointer to a newly allocated Key Value Pair
-struct HashMap_KeyValuePair* HashMap_KeyValuePair_Allocate()
+//	Pointer to the key value pair held in the slot, or NULL if the slot is not occupied
+struct HashMap_KeyValuePair* HashMap_GetPair(HashMap* map, unsigned int index)
 {
-	struct HashMap_KeyValuePair* pair = (struct HashMap_KeyValuePair*)malloc(sizeof(struct HashMap_KeyValuePair));
-	return pair;
+	struct HashMap_KeyValuePair* pair = (struct HashMap_KeyValuePair*)DynamicArray_Index(map->data, index);
+	return pair->state == HashMap_SlotState_OCCUPIED ? pair : NULL;
 }
 
+
+
+//Internals
+
 ///
 //Initializes a key value pair
 //
 //Parameters:
 //	pair: The key value pair being initialized
-//	key: A null terminated character array containing the key to map the data to
+//	key: A pointer to the key to map the data to
 //	data: A pointer to the data to be contained in this key value pair
 //	keyLength: The size of the key in bytes
-void HashMap_KeyValuePair_Initialize(struct HashMap_KeyValuePair* pair, void* key, void* data, unsigned int keyLength)
+//	hash: The hash of the key
+void HashMap_KeyValuePair_Initialize(struct HashMap_KeyValuePair* pair, void* key, void* data, unsigned int keyLength, unsigned long hash)
 {
-	pair->key = (char*)malloc(sizeof(char) * keyLength);
-	memcpy(pair->key, key, keyLength);
+	if(keyLength <= HashMap_INLINE_KEY_SIZE)
+	{
+		memcpy(pair->key.inlineKey, key, keyLength);
+	}
+	else
+	{
+		pair->key.heapKey = malloc(keyLength);
+		memcpy(pair->key.heapKey, key, keyLength);
+	}
 	pair->keyLength = keyLength;
+	pair->state = HashMap_SlotState_OCCUPIED;
+	pair->hash = hash;
 	pair->data = data;
 }
 
@@ -249,57 +277,109 @@ void HashMap_KeyValuePair_Initialize(struct HashMap_KeyValuePair* pair, void* ke
 //	pair: Key value pair to free
 void HashMap_KeyValuePair_Free(struct HashMap_KeyValuePair* pair)
 {
-	free(pair->key);
-	free(pair);
+	if(pair->keyLength > HashMap_INLINE_KEY_SIZE)
+	{
+		free(pair->key.heapKey);
+	}
 }
 
 ///
-//Increases the internal storage of the hashmap, and re-hashes all existing key value pairs
+//Gets the key of a key value pair
 //
 //Parameters:
-//	map: THe hashmap to increase the internal storage of
-static void HashMap_Grow(HashMap* map)
+//	pair: The key value pair to get the key of
+//
+//Returns:
+//	A pointer to the first byte of the key
+void* HashMap_KeyValuePair_GetKey(struct HashMap_KeyValuePair* pair)
 {
-	//Grow it
-	DynamicArray_Grow(map->data);
+	return pair->keyLength <= HashMap_INLINE_KEY_SIZE ? (void*)pair->key.inlineKey : pair->key.heapKey;
+}
 
-	//Copy data
-	struct HashMap_KeyValuePair** copy = (struct HashMap_KeyValuePair**)malloc(sizeof(struct HashMap_KeyValuePair*) * map->data->size);
-	memcpy(copy, map->data->data, sizeof(struct HashMap_KeyValuePair*) * map->data->size);
+///
+//Determines if the key held by a pair matches a key
+//
+//Parameters:
+//	map: The hashmap the pair belongs to
+//	pair: The occupied key value pair to compare against
+//	key: The key to compare
+//	keyLength: The size of the key in bytes
+//	hash: The hash of the key
+//
+//Returns:
+//	1 if the keys match, else 0
+static unsigned char HashMap_KeyEquals(HashMap* map, struct HashMap_KeyValuePair* pair, void* key, unsigned int keyLength, unsigned long hash)
+{
+	if(pair->hash != hash) return 0;
+
+	if(map->keyType == HashMap_KeyType_POINTER)
+		return pair->key.pointerKey == *(void**)key;
 
-	//Save size
-	unsigned int size = map->data->size;
+	return pair->keyLength == keyLength && memcmp(HashMap_KeyValuePair_GetKey(pair), key, keyLength) == 0;
+}
 
-	//Clear dynamic array
-	DynamicArray_Clear(map->data);
+///
+//Finds the slot holding a key
+//Probing stops at the first empty slot, tombstones are skipped.
+//
+//Parameters:
+//	map: The hashmap to search
+//	key: The key to search for
+//	keyLength: The size of the key in bytes
+//	hash: The hash of the key
+//
+//Returns:
+//	A pointer to the slot holding the key, or NULL if the key is not in the map
+static struct HashMap_KeyValuePair* HashMap_FindSlot(HashMap* map, void* key, unsigned int keyLength, unsigned long hash)
+{
+	unsigned int mask = map->data->capacity - 1;
+	unsigned int index = hash & mask;
+	struct HashMap_KeyValuePair* slots = (struct HashMap_KeyValuePair*)map->data->data;
 
-	//Re-Add all entries
-	for(unsigned int i = 0; i < size; i++)
+	//The load factor is kept below 1, so an empty slot always ends the probe
+	while(slots[index].state != HashMap_SlotState_EMPTY)
 	{
-		HashMap_AddPair(map, copy[i]);
+		struct HashMap_KeyValuePair* pair = slots + index;
+		if(pair->state == HashMap_SlotState_OCCUPIED && HashMap_KeyEquals(map, pair, key, keyLength, hash)) return pair;
+		index = (index + 1) & mask;
 	}
 
-	//Delete the list of copies
-	free(copy);
+	return NULL;
 }
 
 ///
-//Takes an existing key value pair and re-hashes and re-adds it to the hashmap
-//To be used when a hashmap is growing in size
+//Rebuilds the slots of a hashmap with a new capacity, re-adding all occupied slots and dropping all tombstones
 //
 //Parameters:
-//	map: THe hashmap the existing pair is being added to
-//	pair: THe pair to add
-static void HashMap_AddPair(HashMap* map, struct HashMap_KeyValuePair* pair)
+//	map: The hashmap to rehash
+//	capacity: The new capacity of the hashmap, must be a power of two
+static void HashMap_Rehash(HashMap* map, unsigned int capacity)
 {
-	unsigned int hash = map->Hash(pair->key, pair->keyLength);
-	unsigned int index = hash % map->data->capacity;
+	DynamicArray* old = map->data;
 
-	while(*(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, index) != NULL)
+	map->data = DynamicArray_Allocate();
+	map->data->capacity = capacity;
+	map->data->growthRate = old->growthRate;
+	DynamicArray_Initialize(map->data, sizeof(struct HashMap_KeyValuePair));
+	map->tombstones = 0;
+
+	unsigned int mask = capacity - 1;
+	struct HashMap_KeyValuePair* slots = (struct HashMap_KeyValuePair*)map->data->data;
+
+	//Move all pairs over using their cached hashes, keys stay where they are
+	for(unsigned int i = 0; i < old->capacity; i++)
 	{
-		index = (index + 1) % map->data->capacity;
+		struct HashMap_KeyValuePair* pair = (struct HashMap_KeyValuePair*)DynamicArray_Index(old, i);
+		if(pair->state != HashMap_SlotState_OCCUPIED) continue;
+
+		unsigned int index = pair->hash & mask;
+		while(slots[index].state != HashMap_SlotState_EMPTY)
+		{
+			index = (index + 1) & mask;
+		}
+		slots[index] = *pair;
+		map->data->size++;
 	}
 
-	*(struct HashMap_KeyValuePair**)DynamicArray_Index(map->data, index) = pair;
-	map->data->size++;
+	DynamicArray_Free(old);
 }
@@ -3,17 +3,47 @@
 
 #include "DynamicArray.h"
 
+//Keys of up to this many bytes are stored inside of the map's slots
+//Longer keys are copied to the heap.
+#define HashMap_INLINE_KEY_SIZE 24
+
+//Slots are rehashed once occupied slots and tombstones exceed this fraction of the capacity
+#define HashMap_MAX_LOAD_NUMERATOR 3
+#define HashMap_MAX_LOAD_DENOMINATOR 4
+
+enum HashMap_SlotState
+{
+	HashMap_SlotState_EMPTY = 0,	//Slot has never held a pair since the last rehash, ends a probe sequence
+	HashMap_SlotState_OCCUPIED,	//Slot holds a pair
+	HashMap_SlotState_TOMBSTONE	//Slot held a pair which was removed, probe sequences continue past it
+};
+
+enum HashMap_KeyType
+{
+	HashMap_KeyType_BYTES = 0,	//Keys are arbitrary byte strings hashed with Hash_FNV1a64 and compared with memcmp
+	HashMap_KeyType_POINTER		//Keys are pointers (keyLength == sizeof(void*)) hashed with Hash_MultiplyShift and compared by value
+};
+
 typedef struct HashMap
 {
-	DynamicArray* data;
+	DynamicArray* data;	//Slots of the map stored inline. Capacity is always a power of two, size is the number of occupied slots.
+	unsigned int tombstones;	//Number of slots holding tombstones
+	enum HashMap_KeyType keyType;
 	unsigned long(*Hash)(void* key, unsigned int keyLength);
 
 } HashMap;
 
 struct HashMap_KeyValuePair
 {
-	void* key;
+	union
+	{
+		char inlineKey[HashMap_INLINE_KEY_SIZE];	//Used when keyLength <= HashMap_INLINE_KEY_SIZE
+		void* pointerKey;				//Used by maps with HashMap_KeyType_POINTER
+		void* heapKey;					//Used otherwise
+	} key;
 	unsigned int keyLength;	//Size in bytes of key
+	unsigned char state;	//HashMap_SlotState of this slot
+	unsigned long hash;	//Cached result of the map's hash function on the key
 	void* data;
 };
 
@@ -21,22 +51,16 @@ struct HashMap_KeyValuePair
 //Internals
 ///
 
-///
-//Allocates memory for a Key Value Pair for the HashMap data structure
-//
-//Returns:
-//	A pointer to a newly allocated Key Value Pair
-struct HashMap_KeyValuePair* HashMap_KeyValuePair_Allocate();
-
 ///
 //Initializes a key value pair
 //
 //Parameters:
 //	pair: The key value pair being initialized
-//	key: A null terminated character array containing the key to map the data to
+//	key: A pointer to the key to map the data to
 //	data: A pointer to the data to be contained in this key value pair
 //	keyLength: The size of the key in bytes
-void HashMap_KeyValuePair_Initialize(struct HashMap_KeyValuePair* pair, void* key, void* data, unsigned int keyLength);
+//	hash: The hash of the key
+void HashMap_KeyValuePair_Initialize(struct HashMap_KeyValuePair* pair, void* key, void* data, unsigned int keyLength, unsigned long hash);
 
 ///
 //Frees memory being used by a Key Value Pair
@@ -46,6 +70,16 @@ void HashMap_KeyValuePair_Initialize(struct HashMap_KeyValuePair* pair, void* ke
 //	pair: Key value pair to free
 void HashMap_KeyValuePair_Free(struct HashMap_KeyValuePair* pair);
 
+///
+//Gets the key of a key value pair
+//
+//Parameters:
+//	pair: The key value pair to get the key of
+//
+//Returns:
+//	A pointer to the first byte of the key
+void* HashMap_KeyValuePair_GetKey(struct HashMap_KeyValuePair* pair);
+
 ///
 //Functions
 ///
@@ -58,12 +92,21 @@ void HashMap_KeyValuePair_Free(struct HashMap_KeyValuePair* pair);
 HashMap* HashMap_Allocate(void);
 
 ///
-//Initializes a HashMap
+//Initializes a HashMap for keys of arbitrary bytes
 //
 //Parameters:
 //	map: Hashmap to initialize
 void HashMap_Initialize(HashMap* map);
 
+///
+//Initializes a HashMap for a specific type of key
+//Selects the hash function suited to the key type, which can be overridden through map->Hash.
+//
+//Parameters:
+//	map: Hashmap to initialize
+//	keyType: The type of key the map will hold
+void HashMap_InitializeWithKeyType(HashMap* map, enum HashMap_KeyType keyType);
+
 ///
 //Frees a hashmap
 //Does not free data!! Delete prior to this! OR have other references!!!
@@ -89,10 +132,14 @@ void HashMap_Add(HashMap* map, void* key, void* data, unsigned int keyLength);
 //	map: Map to remove entry from
 //	key: Key relating to data to be removed
 //	keyLength: The size of the key in bytes
+//
+//Returns:
+//	The data which was mapped to the key, or NULL if the key was not in the map
 void* HashMap_Remove(HashMap* map, void* key, unsigned int keyLength);
 
 ///
 //Looks up a key and returns the related data
+//The returned pair lives inside of the map and is only valid until the next add or remove.
 //
 //Parameters:
 //	map: The HashMap to lookup data in
@@ -100,7 +147,7 @@ void* HashMap_Remove(HashMap* map, void* key, unsigned int keyLength);
 //	keyLength: The size of the key in bytes
 //
 //Returns:
-//	Pointer to data
+//	Pointer to the key value pair, or NULL if the key is not in the map
 struct HashMap_KeyValuePair* HashMap_LookUp(HashMap* map, void* key, unsigned int keyLength);
 
 ///
@@ -112,6 +159,16 @@ struct HashMap_KeyValuePair* HashMap_LookUp(HashMap* map, void* key, unsigned in
 //	keyLength: The length of the key in bytes
 unsigned char HashMap_Contains(HashMap* map, void* key, unsigned int keyLength);
 
-
+///
+//Gets the key value pair held in a slot of the hashmap
+//Used to iterate over all pairs, from slot 0 to map->data->capacity - 1
+//
+//Parameters:
+//	map: The map to index
+//	index: The index of the slot
+//
+//Returns:
+//	Pointer to the key value pair held in the slot, or NULL if the slot is not occupied
+struct HashMap_KeyValuePair* HashMap_GetPair(HashMap* map, unsigned int index);
 
 #endif
@@ -5,11 +5,27 @@
 ///
 //Internal Delcarations
 
+//Number of nodes allocated at once when the node pool runs dry
+#define LinkedList_NODE_BLOCK_SIZE 256
+
+///
+//A block of nodes allocated together to back the node pool
+struct LinkedList_NodeBlock
+{
+	struct LinkedList_NodeBlock* next;
+	struct LinkedList_Node nodes[LinkedList_NODE_BLOCK_SIZE];
+};
+
+//Nodes which are not part of any list, chained through their next pointers
+static struct LinkedList_Node* freeNodes = NULL;
+//All blocks allocated by the node pool
+static struct LinkedList_NodeBlock* nodeBlocks = NULL;
+
 ///
-//Allocates a Node for a Linked List
+//Takes a Node for a Linked List from the node pool shared by all linked lists
 //
 //Returns:
-//	Newly allocated Pointer to linked list node
+//	Pointer to an uninitialized linked list node
 static struct LinkedList_Node* LinkedList_Node_Allocate(void);
 
 ///
@@ -21,7 +37,7 @@ static struct LinkedList_Node* LinkedList_Node_Allocate(void);
 static void LinkedList_Node_Initialize(struct LinkedList_Node* node, void* data);
 
 ///
-//Frees resources being used by a Linked List node
+//Returns a Linked List node to the node pool shared by all linked lists
 //
 //Parameters:
 //	node: The node to free
@@ -58,16 +74,22 @@ void LinkedList_Initialize(LinkedList* list)
 //	list: The linked list to free
 void LinkedList_Free(LinkedList* list)
 {
-	struct LinkedList_Node* current = list->head;
+	LinkedList_Clear(list);
+	free(list);
+}
 
-	while (current != NULL)
+///
+//Frees all memory held by the node pool shared by every linked list
+//Must only be called once all linked lists have been freed.
+void LinkedList_FreeNodePool(void)
+{
+	while(nodeBlocks != NULL)
 	{
-		struct LinkedList_Node* next = current->next;
-		LinkedList_Node_Free(current);
-		current = next;
+		struct LinkedList_NodeBlock* next = nodeBlocks->next;
+		free(nodeBlocks);
+		nodeBlocks = next;
 	}
-
-	free(list);
+	freeNodes = NULL;
 }
 
 ///
@@ -302,14 +324,11 @@ void LinkedList_RemoveNode(LinkedList* list, struct LinkedList_Node* nodeToRemov
 //	list: The linked list to clear
 void LinkedList_Clear(LinkedList* list)
 {
-	struct LinkedList_Node* current = list->head;
-	struct LinkedList_Node* next = NULL;
-	while(current != NULL)
+	//The nodes are already chained together, return the whole chain to the node pool at once
+	if(list->size > 0)
 	{
-		next = current->next;
-
-		LinkedList_Node_Free(current);
-		current = next;
+		list->tail->next = freeNodes;
+		freeNodes = list->head;
 	}
 
 	list->head = NULL;
@@ -320,13 +339,29 @@ void LinkedList_Clear(LinkedList* list)
 //Internals
 
 ///
-//Allocates a Node for a Linked List
+//Takes a Node for a Linked List from the node pool shared by all linked lists
 //
 //Returns:
-//	Newly allocated Pointer to linked list node
+//	Pointer to an uninitialized linked list node
 static struct LinkedList_Node* LinkedList_Node_Allocate(void)
 {
-	struct LinkedList_Node* node = (struct LinkedList_Node*)malloc(sizeof(struct LinkedList_Node));
+	//Refill the node pool with a new block when it runs dry
+	if(freeNodes == NULL)
+	{
+		struct LinkedList_NodeBlock* block = (struct LinkedList_NodeBlock*)malloc(sizeof(struct LinkedList_NodeBlock));
+		block->next = nodeBlocks;
+		nodeBlocks = block;
+
+		for(unsigned int i = 0; i < LinkedList_NODE_BLOCK_SIZE - 1; i++)
+		{
+			block->nodes[i].next = block->nodes + i + 1;
+		}
+		block->nodes[LinkedList_NODE_BLOCK_SIZE - 1].next = NULL;
+		freeNodes = block->nodes;
+	}
+
+	struct LinkedList_Node* node = freeNodes;
+	freeNodes = node->next;
 	return node;
 }
 
@@ -344,13 +379,14 @@ static void LinkedList_Node_Initialize(struct LinkedList_Node* node, void* data)
 }
 
 ///
-//Frees resources being used by a Linked List node
+//Returns a Linked List node to the node pool shared by all linked lists
 //Does NOT free the data in the node. If the data is on the heap, delete before this!
 //
 //Parameters:
 //	node: The node to free
 static void LinkedList_Node_Free(struct LinkedList_Node* node)
 {
-	free(node);
+	node->next = freeNodes;
+	freeNodes = node;
 }
 
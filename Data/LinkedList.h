@@ -35,6 +35,11 @@ void LinkedList_Initialize(LinkedList* list);
 //	list: The linked list to free
 void LinkedList_Free(LinkedList* list);
 
+///
+//Frees all memory held by the node pool shared by every linked list
+//Must only be called once all linked lists have been freed.
+void LinkedList_FreeNodePool(void);
+
 
 ///
 //Searches a linked list for a value
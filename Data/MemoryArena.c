@@ -0,0 +1,170 @@
+#include "MemoryArena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+///
+//Static Declarations
+
+///
+//Rounds a size up to a multiple of the arena alignment
+//
+//Parameters:
+//	size: The size to round
+//
+//Returns:
+//	The rounded size
+static size_t MemoryArena_Align(size_t size);
+
+///
+//Allocates a new memory arena
+//
+//Returns:
+//	A pointer to an uninitialized memory arena
+MemoryArena* MemoryArena_Allocate(void)
+{
+	return malloc(sizeof(MemoryArena));
+}
+
+///
+//Initializes a memory arena
+//
+//Parameters:
+//	arena: A pointer to the memory arena to initialize
+//	capacity: The initial size of the arena's main block in bytes
+void MemoryArena_Initialize(MemoryArena* arena, size_t capacity)
+{
+	arena->capacity = MemoryArena_Align(capacity);
+	arena->data = malloc(arena->capacity);
+	arena->used = 0;
+	arena->overflowUsed = 0;
+	arena->highWaterMark = 0;
+	arena->overflow = NULL;
+}
+
+///
+//Frees a memory arena and all memory requested from it
+//
+//Parameters:
+//	arena: A pointer to the memory arena to free
+void MemoryArena_Free(MemoryArena* arena)
+{
+	MemoryArena_Reset(arena);
+	free(arena->data);
+	free(arena);
+}
+
+///
+//Requests uninitialized memory from a memory arena
+//The memory remains valid until the arena is reset.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to request memory from
+//	size: The number of bytes to request
+//
+//Returns:
+//	A pointer to the requested memory, aligned to MemoryArena_ALIGNMENT
+void* MemoryArena_Request(MemoryArena* arena, size_t size)
+{
+	size = MemoryArena_Align(size);
+	void* memory;
+
+	if(arena->used + size <= arena->capacity)
+	{
+		memory = arena->data + arena->used;
+		arena->used += size;
+	}
+	else
+	{
+		//Serve the request from the current overflow block, or start a new one
+		struct MemoryArena_Block* block = arena->overflow;
+		if(block == NULL || block->used + size > block->capacity)
+		{
+			size_t capacity = size > arena->capacity ? size : arena->capacity;
+			block = malloc(MemoryArena_Align(sizeof(struct MemoryArena_Block)) + capacity);
+			block->capacity = capacity;
+			block->used = 0;
+			block->next = arena->overflow;
+			arena->overflow = block;
+		}
+
+		memory = (char*)block + MemoryArena_Align(sizeof(struct MemoryArena_Block)) + block->used;
+		block->used += size;
+		arena->overflowUsed += size;
+	}
+
+	if(arena->used + arena->overflowUsed > arena->highWaterMark)
+		arena->highWaterMark = arena->used + arena->overflowUsed;
+
+	return memory;
+}
+
+///
+//Requests zeroed memory from a memory arena
+//The memory remains valid until the arena is reset.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to request memory from
+//	size: The number of bytes to request
+//
+//Returns:
+//	A pointer to the requested memory, aligned to MemoryArena_ALIGNMENT
+void* MemoryArena_RequestZeroed(MemoryArena* arena, size_t size)
+{
+	void* memory = MemoryArena_Request(arena, size);
+	memset(memory, 0, size);
+	return memory;
+}
+
+///
+//Releases all memory requested from a memory arena
+//If overflow blocks were needed, they are freed and the main block grows to the high water mark.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to reset
+void MemoryArena_Reset(MemoryArena* arena)
+{
+	if(arena->overflow != NULL)
+	{
+		while(arena->overflow != NULL)
+		{
+			struct MemoryArena_Block* next = arena->overflow->next;
+			free(arena->overflow);
+			arena->overflow = next;
+		}
+
+		//Grow the main block so the busiest frame so far would have fit
+		free(arena->data);
+		arena->capacity = MemoryArena_Align(arena->highWaterMark);
+		arena->data = malloc(arena->capacity);
+	}
+
+	arena->used = 0;
+	arena->overflowUsed = 0;
+}
+
+///
+//Gets the largest number of bytes which have been in use at once in a memory arena
+//
+//Parameters:
+//	arena: A pointer to the memory arena
+//
+//Returns:
+//	The high water mark of the arena in bytes
+size_t MemoryArena_GetHighWaterMark(MemoryArena* arena)
+{
+	return arena->highWaterMark;
+}
+
+///
+//Rounds a size up to a multiple of the arena alignment
+//
+//Parameters:
+//	size: The size to round
+//
+//Returns:
+//	The rounded size
+static size_t MemoryArena_Align(size_t size)
+{
+	return (size + MemoryArena_ALIGNMENT - 1) & ~(size_t)(MemoryArena_ALIGNMENT - 1);
+}
@@ -0,0 +1,97 @@
+#ifndef MEMORYARENA_H
+#define MEMORYARENA_H
+
+#include <stddef.h>
+
+//Alignment in bytes of every request made to a memory arena
+#define MemoryArena_ALIGNMENT 16
+
+///
+//A block of memory allocated when a request does not fit in the arena's main block
+struct MemoryArena_Block
+{
+	struct MemoryArena_Block* next;
+	size_t capacity;
+	size_t used;
+};
+
+///
+//A bump allocator. Requests are carved sequentially out of a single block of memory
+//and are all released together when the arena is reset.
+//Requests which do not fit are served from overflow blocks, and the next reset grows the
+//main block to the largest amount of memory ever in use so later frames fit in one block.
+typedef struct MemoryArena
+{
+	char* data;				//Main block of memory
+	size_t capacity;			//Size of the main block in bytes
+	size_t used;				//Bytes of the main block handed out since the last reset
+	size_t overflowUsed;			//Bytes handed out from overflow blocks since the last reset
+	size_t highWaterMark;			//Largest number of bytes in use at once since initialization
+	struct MemoryArena_Block* overflow;	//Overflow blocks allocated since the last reset
+} MemoryArena;
+
+///
+//Allocates a new memory arena
+//
+//Returns:
+//	A pointer to an uninitialized memory arena
+MemoryArena* MemoryArena_Allocate(void);
+
+///
+//Initializes a memory arena
+//
+//Parameters:
+//	arena: A pointer to the memory arena to initialize
+//	capacity: The initial size of the arena's main block in bytes
+void MemoryArena_Initialize(MemoryArena* arena, size_t capacity);
+
+///
+//Frees a memory arena and all memory requested from it
+//
+//Parameters:
+//	arena: A pointer to the memory arena to free
+void MemoryArena_Free(MemoryArena* arena);
+
+///
+//Requests uninitialized memory from a memory arena
+//The memory remains valid until the arena is reset.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to request memory from
+//	size: The number of bytes to request
+//
+//Returns:
+//	A pointer to the requested memory, aligned to MemoryArena_ALIGNMENT
+void* MemoryArena_Request(MemoryArena* arena, size_t size);
+
+///
+//Requests zeroed memory from a memory arena
+//The memory remains valid until the arena is reset.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to request memory from
+//	size: The number of bytes to request
+//
+//Returns:
+//	A pointer to the requested memory, aligned to MemoryArena_ALIGNMENT
+void* MemoryArena_RequestZeroed(MemoryArena* arena, size_t size);
+
+///
+//Releases all memory requested from a memory arena
+//If overflow blocks were needed, they are freed and the main block grows to the high water mark.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to reset
+void MemoryArena_Reset(MemoryArena* arena);
+
+///
+//Gets the largest number of bytes which have been in use at once in a memory arena
+//
+//Parameters:
+//	arena: A pointer to the memory arena
+//
+//Returns:
+//	The high water mark of the arena in bytes
+size_t MemoryArena_GetHighWaterMark(MemoryArena* arena);
+
+#endif
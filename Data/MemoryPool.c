@@ -1,6 +1,19 @@
 #include "MemoryPool.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+///
+//Static Declarations
+
+///
+//Grows the slab of a memory pool along with it's bookkeeping.
+//Newly created memory units are zeroed.
+//
+//Parameters:
+//	pool: A pointer to the memory pool to grow
+static void MemoryPool_Grow(MemoryPool* pool);
 
 ///
 //Allocates a new memory pool
@@ -23,8 +36,12 @@ void MemoryPool_Initialize(MemoryPool* pool, unsigned int dataSize)
 	pool->pool = DynamicArray_Allocate();
 	DynamicArray_Initialize(pool->pool, dataSize);
 
-	pool->freeQueue = LinkedList_Allocate();
-	LinkedList_Initialize(pool->freeQueue);
+	pool->slots = calloc(pool->pool->capacity, sizeof(struct MemoryPool_Slot));
+	pool->highWater = 0;
+	pool->freeHead = MemoryPool_NULL_ID;
+
+	pool->live = DynamicArray_Allocate();
+	DynamicArray_Initialize(pool->live, sizeof(unsigned int));
 }
 
 ///
@@ -35,7 +52,8 @@ void MemoryPool_Initialize(MemoryPool* pool, unsigned int dataSize)
 void MemoryPool_Free(MemoryPool* pool)
 {
 	DynamicArray_Free(pool->pool);
-	LinkedList_Free(pool->freeQueue);
+	DynamicArray_Free(pool->live);
+	free(pool->slots);
 	free(pool);
 }
 
@@ -47,33 +65,73 @@ void MemoryPool_Free(MemoryPool* pool)
 unsigned int MemoryPool_RequestID(MemoryPool* pool)
 {
 	unsigned int index;
-	if(pool->freeQueue->size > 0)
+	if(pool->freeHead != MemoryPool_NULL_ID)
 	{
-		index = (unsigned int)pool->freeQueue->head->data;
-		LinkedList_RemoveIndex(pool->freeQueue, 0);
+		//Pop the most recently released memory unit off of the free list
+		index = pool->freeHead;
+		pool->freeHead = pool->slots[index].link;
 	}
 	else
 	{
-		if(pool->pool->size == pool->pool->capacity)
-			DynamicArray_Grow(pool->pool);
-		
-		index = pool->pool->size;
+		if(pool->highWater == pool->pool->capacity)
+			MemoryPool_Grow(pool);
+
+		index = pool->highWater++;
 	}
+
+	struct MemoryPool_Slot* slot = pool->slots + index;
+	slot->generation++;
+	slot->link = pool->live->size;
+	DynamicArray_Append(pool->live, &index);
+
 	pool->pool->size++;
 
 	return index;
 }
 
+///
+//Requests a new space in memory from the memory pool and returns a handle to it
+//
+//Parameters:
+//	pool: A pointer to the pool to request memory from
+//
+//Returns:
+//	A handle referencing the newly requested memory unit
+MemoryPool_Handle MemoryPool_RequestHandle(MemoryPool* pool)
+{
+	return MemoryPool_GetHandle(pool, MemoryPool_RequestID(pool));
+}
+
 ///
 //Releases a space in memory to be reused by the memory pool it belongs to
+//Releasing a memory unit which is not in use is reported and ignored.
 //
 //Parameters:
 //	pool: A pointer to the memory pool to release memory back to
 //	id: The ID of the memory unit being released
 void MemoryPool_ReleaseID(MemoryPool* pool, const unsigned int id)
 {
+	if(!MemoryPool_IsLive(pool, id))
+	{
+		printf("MemoryPool_ReleaseID :: Memory unit %u is not in use.\n", id);
+		return;
+	}
+
+	struct MemoryPool_Slot* slot = pool->slots + id;
+
+	//Swap the last entry of the live list into the released entry's position
+	unsigned int* liveIDs = (unsigned int*)pool->live->data;
+	unsigned int lastID = liveIDs[pool->live->size - 1];
+	liveIDs[slot->link] = lastID;
+	pool->slots[lastID].link = slot->link;
+	pool->live->size--;
+
+	//Push the memory unit onto the free list
+	slot->generation++;
+	slot->link = pool->freeHead;
+	pool->freeHead = id;
+
 	pool->pool->size--;
-	LinkedList_Append(pool->freeQueue, (void*)id);
 }
 
 ///
@@ -89,3 +147,129 @@ void* MemoryPool_RequestAddress(MemoryPool* pool, const unsigned int id)
 {
 	return DynamicArray_Index(pool->pool, id);
 }
+
+///
+//Requests the memory address referenced by a handle
+//
+//Parameters:
+//	pool: A pointer to the pool the address resides in
+//	handle: The handle of the desired address
+//
+//Returns:
+//	A pointer to the first byte of the memory unit referenced by the handle,
+//	or NULL if the memory unit has been released since the handle was made
+void* MemoryPool_RequestAddressFromHandle(MemoryPool* pool, const MemoryPool_Handle handle)
+{
+	if(!MemoryPool_IsHandleValid(pool, handle))
+		return NULL;
+	return DynamicArray_Index(pool->pool, handle.id);
+}
+
+///
+//Gets the ID of a memory unit from it's address
+//
+//Parameters:
+//	pool: A pointer to the pool the address resides in
+//	address: A pointer to the first byte of a memory unit in the pool
+//
+//Returns:
+//	The ID of the memory unit at the given address, or MemoryPool_NULL_ID if the address is not in the pool
+unsigned int MemoryPool_GetID(MemoryPool* pool, const void* address)
+{
+	const char* first = (const char*)pool->pool->data;
+	const char* unit = (const char*)address;
+	if(unit < first || unit >= first + (pool->highWater * pool->pool->dataSize))
+		return MemoryPool_NULL_ID;
+	return (unsigned int)((unit - first) / pool->pool->dataSize);
+}
+
+///
+//Gets a handle to a memory unit which is currently in use
+//
+//Parameters:
+//	pool: A pointer to the pool the memory unit belongs to
+//	id: The ID of the memory unit
+//
+//Returns:
+//	A handle referencing the current generation of the memory unit
+MemoryPool_Handle MemoryPool_GetHandle(MemoryPool* pool, const unsigned int id)
+{
+	MemoryPool_Handle handle;
+	handle.id = id;
+	handle.generation = pool->slots[id].generation;
+	return handle;
+}
+
+///
+//Determines if a handle still references the memory unit it was made for
+//
+//Parameters:
+//	pool: A pointer to the pool the handle belongs to
+//	handle: The handle to check
+//
+//Returns:
+//	1 if the memory unit has not been released since the handle was made, else 0
+unsigned char MemoryPool_IsHandleValid(MemoryPool* pool, const MemoryPool_Handle handle)
+{
+	return MemoryPool_IsLive(pool, handle.id) && pool->slots[handle.id].generation == handle.generation;
+}
+
+///
+//Determines if a memory unit is currently in use
+//
+//Parameters:
+//	pool: A pointer to the pool the memory unit belongs to
+//	id: The ID of the memory unit
+//
+//Returns:
+//	1 if the memory unit is in use, else 0
+unsigned char MemoryPool_IsLive(MemoryPool* pool, const unsigned int id)
+{
+	return id < pool->highWater && (pool->slots[id].generation & 1);
+}
+
+///
+//Gets the number of memory units currently in use
+//
+//Parameters:
+//	pool: A pointer to the pool to query
+//
+//Returns:
+//	The number of memory units in use
+unsigned int MemoryPool_GetNumLive(MemoryPool* pool)
+{
+	return pool->live->size;
+}
+
+///
+//Gets the ID of a memory unit in use by it's position in the pool's live list
+//Positions are only stable until the next request or release.
+//
+//Parameters:
+//	pool: A pointer to the pool to query
+//	index: The position in the live list, from 0 to MemoryPool_GetNumLive(pool) - 1
+//
+//Returns:
+//	The ID of the memory unit at the given position of the live list
+unsigned int MemoryPool_GetLiveID(MemoryPool* pool, const unsigned int index)
+{
+	return ((unsigned int*)pool->live->data)[index];
+}
+
+///
+//Grows the slab of a memory pool along with it's bookkeeping.
+//Newly created memory units are zeroed.
+//
+//Parameters:
+//	pool: A pointer to the memory pool to grow
+static void MemoryPool_Grow(MemoryPool* pool)
+{
+	unsigned int oldCapacity = pool->pool->capacity;
+	DynamicArray_Grow(pool->pool);
+
+	unsigned int newCapacity = pool->pool->capacity;
+	memset((char*)pool->pool->data + oldCapacity * pool->pool->dataSize, 0, (newCapacity - oldCapacity) * pool->pool->dataSize);
+
+	pool->slots = realloc(pool->slots, newCapacity * sizeof(struct MemoryPool_Slot));
+	memset(pool->slots + oldCapacity, 0, (newCapacity - oldCapacity) * sizeof(struct MemoryPool_Slot));
+}
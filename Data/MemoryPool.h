@@ -2,14 +2,38 @@
 #define MEMORYPOOL_H
 
 #include "../Data/DynamicArray.h"
-#include "../Data/LinkedList.h"
+
+///
+//Bookkeeping kept for every memory unit in a memory pool
+//The generation is odd while the memory unit is in use and even while it is free.
+//The link holds the ID of the next free memory unit while the memory unit is free,
+//or the position of the memory unit in the pool's live list while it is in use.
+struct MemoryPool_Slot
+{
+	unsigned int generation;
+	unsigned int link;
+};
+
+///
+//A reference to a memory unit which can detect when the memory unit has since been released
+typedef struct MemoryPool_Handle
+{
+	unsigned int id;
+	unsigned int generation;
+} MemoryPool_Handle;
 
 typedef struct MemoryPool
 {
-	DynamicArray* pool;
-	LinkedList* freeQueue;
+	DynamicArray* pool;		//Contiguous slab of memory units. pool->size holds the number of memory units in use.
+	struct MemoryPool_Slot* slots;	//Bookkeeping for each memory unit in the slab
+	unsigned int highWater;		//Number of memory units which have ever been handed out
+	unsigned int freeHead;		//ID of the most recently released memory unit, or MemoryPool_NULL_ID
+	DynamicArray* live;		//Dense list of the IDs of all memory units in use
 } MemoryPool;
 
+//ID used to terminate the free list
+#define MemoryPool_NULL_ID 0xFFFFFFFFu
+
 ///
 //Allocates a new memory pool
 //
@@ -39,8 +63,19 @@ void MemoryPool_Free(MemoryPool* pool);
 //	pool: A pointer to the pool to request memory from
 unsigned int MemoryPool_RequestID(MemoryPool* pool);
 
+///
+//Requests a new space in memory from the memory pool and returns a handle to it
+//
+//Parameters:
+//	pool: A pointer to the pool to request memory from
+//
+//Returns:
+//	A handle referencing the newly requested memory unit
+MemoryPool_Handle MemoryPool_RequestHandle(MemoryPool* pool);
+
 ///
 //Releases a space in memory to be reused by the memory pool it belongs to
+//Releasing a memory unit which is not in use is reported and ignored.
 //
 //Parameters:
 //	pool: A pointer to the memory pool to release memory back to
@@ -58,4 +93,82 @@ void MemoryPool_ReleaseID(MemoryPool* pool, const unsigned int id);
 //	A pointer to the first byte of the memory unit referenced by the given ID
 void* MemoryPool_RequestAddress(MemoryPool* pool, const unsigned int id);
 
+///
+//Requests the memory address referenced by a handle
+//
+//Parameters:
+//	pool: A pointer to the pool the address resides in
+//	handle: The handle of the desired address
+//
+//Returns:
+//	A pointer to the first byte of the memory unit referenced by the handle,
+//	or NULL if the memory unit has been released since the handle was made
+void* MemoryPool_RequestAddressFromHandle(MemoryPool* pool, const MemoryPool_Handle handle);
+
+///
+//Gets the ID of a memory unit from it's address
+//
+//Parameters:
+//	pool: A pointer to the pool the address resides in
+//	address: A pointer to the first byte of a memory unit in the pool
+//
+//Returns:
+//	The ID of the memory unit at the given address, or MemoryPool_NULL_ID if the address is not in the pool
+unsigned int MemoryPool_GetID(MemoryPool* pool, const void* address);
+
+///
+//Gets a handle to a memory unit which is currently in use
+//
+//Parameters:
+//	pool: A pointer to the pool the memory unit belongs to
+//	id: The ID of the memory unit
+//
+//Returns:
+//	A handle referencing the current generation of the memory unit
+MemoryPool_Handle MemoryPool_GetHandle(MemoryPool* pool, const unsigned int id);
+
+///
+//Determines if a handle still references the memory unit it was made for
+//
+//Parameters:
+//	pool: A pointer to the pool the handle belongs to
+//	handle: The handle to check
+//
+//Returns:
+//	1 if the memory unit has not been released since the handle was made, else 0
+unsigned char MemoryPool_IsHandleValid(MemoryPool* pool, const MemoryPool_Handle handle);
+
+///
+//Determines if a memory unit is currently in use
+//
+//Parameters:
+//	pool: A pointer to the pool the memory unit belongs to
+//	id: The ID of the memory unit
+//
+//Returns:
+//	1 if the memory unit is in use, else 0
+unsigned char MemoryPool_IsLive(MemoryPool* pool, const unsigned int id);
+
+///
+//Gets the number of memory units currently in use
+//
+//Parameters:
+//	pool: A pointer to the pool to query
+//
+//Returns:
+//	The number of memory units in use
+unsigned int MemoryPool_GetNumLive(MemoryPool* pool);
+
+///
+//Gets the ID of a memory unit in use by it's position in the pool's live list
+//Positions are only stable until the next request or release.
+//
+//Parameters:
+//	pool: A pointer to the pool to query
+//	index: The position in the live list, from 0 to MemoryPool_GetNumLive(pool) - 1
+//
+//Returns:
+//	The ID of the memory unit at the given position of the live list
+unsigned int MemoryPool_GetLiveID(MemoryPool* pool, const unsigned int index);
+
 #endif
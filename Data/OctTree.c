@@ -3,60 +3,359 @@
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdint.h>
 
 #include <float.h>
 
+#include "RadixSort.h"
+
 ///
 //Static declarations
 static unsigned int defaultMaxOccupancy = 3;
 static unsigned int defaultMaxDepth = 3;
+static float defaultLooseness = 0.0f;
+//Smallest number of objects whose rebuild keys are worth computing across a worker pool
+static unsigned int parallelKeyThreshold = 1024;
 
+//Typed accessors for the object indices of a rebuild
+DYNARRAY_DECLARE(UInt, unsigned int);
 
 ///
-//Allocates memory for an octtree node
+//A ray prepared for the slab tests of a ray query
+struct OctTree_SlabRay
+{
+	float origin[3];
+	float inverseDirection[3];	//Reciprocal of each component of the direction, 0 where the ray is parallel to a slab
+	unsigned char parallel[3];	//1 where the ray is parallel to a slab
+};
+
+
+///
+//Gets the index in an oct tree's node pool of the first node at a given depth
+//
+//Parameters:
+//	depth: The depth to get the first node of
 //
 //Returns:
-//	A pointer to a newly allocated, uninitialized oct tree node
-static struct OctTree_Node* OctTree_Node_Allocate();
+//	The number of nodes in all levels above the given depth, (8^depth - 1) / 7
+static unsigned int OctTree_GetLevelOffset(unsigned int depth);
 
 ///
 //Initializes an oct tree node to the given specifications
 //
 //Parameters:
 //	node: A pointer to the oct tree node to initialize
-//	tree: A pointer to the oct tree this node is part of
 //	parent: A pointer to the parent node of this oct tree node
 //	depth: The depth from the root node of this node in the oct tree
+//	mortonCode: The morton code of this node among the nodes of it's depth
 //	leftBound: The left bound of the octtree
 //	rightBound: The right bound of the octtree
 //	bottomBound: The bottom bound of the octtree
 //	topBound: The top bound of the octtree
 //	backBound: The back bound of the octtree
 //	frontBound: The front bound of the octtree
-static void OctTree_Node_Initialize(struct OctTree_Node* node, OctTree* tree,  struct OctTree_Node* parent, unsigned int depth, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound);
+static void OctTree_Node_Initialize(struct OctTree_Node* node, struct OctTree_Node* parent, unsigned int depth, unsigned int mortonCode, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound);
+
+///
+//Initializes the children of an oct tree node in the tree's node pool
+//Does not attach the children to the node.
+//
+//Parameters:
+//	tree: A pointer to the oct tree the children will be apart of
+//	node: A pointer to the node to initialize the children of
+static void OctTree_Node_InitializeChildren(OctTree* tree, struct OctTree_Node* parent);
 
 ///
-//Frees data allocated by an oct tree node
+//Moves the occupants of a leaf node to the end of the tree's occupant array with room for more
+//The entries the leaf previously owned are left empty until the tree is compacted.
 //
 //Parameters:
-//	node: A pointer to the oct tree node to free
-//	tree: A pointer to the tree the node being freed belongs to
-static void OctTree_Node_Free(OctTree* tree, struct OctTree_Node* node);
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to move
+//	capacity: The number of occupants the leaf will have room for
+static void OctTree_Node_Relocate(OctTree* tree, struct OctTree_Node* leaf, unsigned int capacity);
 
 ///
-//Allocates the children of an oct tree node
+//Appends an occupant to a leaf node, making room in the tree's occupant array
+//
+//Parameters:
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to add the occupant to
+//	obj: A pointer to the game object being added
+static void OctTree_Node_InsertOccupant(OctTree* tree, struct OctTree_Node* leaf, GObject* obj);
+
+///
+//Finds an occupant of a leaf node
+//
+//Parameters:
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to search
+//	obj: A pointer to the game object to find
 //
 //Returns:
-//	A pointer to an array of 8 newly allocated, uninitialized node children
-static struct OctTree_Node* OctTree_Node_AllocateChildren();
+//	The index of the object within the leaf, or the leaf's count if the leaf does not contain the object
+static unsigned int OctTree_Node_FindOccupant(OctTree* tree, struct OctTree_Node* leaf, GObject* obj);
 
 ///
-//Initializes the children of an oct tree node
+//Removes an occupant from a leaf node, moving the leaf's last occupant into it's place
 //
 //Parameters:
-//	tree: A pointer to the oct tree the children will be apart of
-//	node: A pointer to the node to initialize the children of
-static void OctTree_Node_InitializeChildren(OctTree* tree, struct OctTree_Node* parent);
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to remove the occupant from
+//	index: The index of the occupant within the leaf
+static void OctTree_Node_RemoveOccupant(OctTree* tree, struct OctTree_Node* leaf, unsigned int index);
+
+///
+//Attaches the 8 children of a leaf node, which begin as empty leaves.
+//The occupants of the leaf are removed from the tree and returned.
+//
+//Parameters:
+//	tree: A pointer to the oct tree in which this node lives
+//	node: A pointer to the leaf node being split
+//	numOccupants: A pointer to the destination of the number of occupants the leaf had
+//
+//Returns:
+//	A newly allocated array of the occupants the leaf had, to be freed by the caller
+static GObject** OctTree_Node_Split(OctTree* tree, struct OctTree_Node* node, unsigned int* numOccupants);
+
+///
+//Appends the leaves below a node to the tree's leaves in morton order,
+//copying their occupants into the tree's compact occupant array.
+//Inner nodes holding occupants are appended before their children.
+//
+//Parameters:
+//	tree: A pointer to the oct tree being compacted
+//	node: A pointer to the node to compact the leaves of
+static void OctTree_Node_Compact(OctTree* tree, struct OctTree_Node* node);
+
+///
+//Gets the world space axis aligned bounds of a game object's collider,
+//matching the bounds used to test the collider against oct tree nodes
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the bounds in
+//	obj: A pointer to the game object to get the bounds of
+//
+//Returns:
+//	0 if the collider has no finite bounds (rays), else 1
+static unsigned char OctTree_GetObjectAABB(struct ColliderData_AABB* dest, GObject* obj);
+
+///
+//Gets the sort key of a game object for rebuilding an oct tree.
+//The key identifies the deepest node which contains the object's bounds:
+//the node's morton code extended with zeros to the tree's max depth, followed by 3 bits holding the node's depth.
+//Sorting by this key places every node's objects after the objects of it's ancestors
+//and before the objects of the nodes which follow it in morton order.
+//
+//Parameters:
+//	tree: A pointer to the oct tree being rebuilt
+//	bounds: A pointer to the world space bounds of the object
+//
+//Returns:
+//	The sort key of the object, 0 (the root) if the object is not contained by the tree
+static uint32_t OctTree_GetRebuildKey(OctTree* tree, const struct ColliderData_AABB* bounds);
+
+///
+//Gets the sort key of a game object for rebuilding a loose oct tree.
+//The key identifies the deepest node whose cell contains the center of the object's bounds
+//and whose loose bounds contain the object, in the same form as OctTree_GetRebuildKey.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree being rebuilt
+//	bounds: A pointer to the world space bounds of the object
+//
+//Returns:
+//	The sort key of the object, 0 (the root) if the object's center is not within the tree
+static uint32_t OctTree_GetLooseRebuildKey(OctTree* tree, const struct ColliderData_AABB* bounds);
+
+///
+//The state of an oct tree rebuild
+struct OctTree_Rebuild
+{
+	OctTree* tree;
+	GObject** objects;		//The objects being added to the tree
+	DynamicArray** logs;		//The log of each object, NULL in a loose oct tree
+	uint64_t* keys;			//Sort key of each object in the high 32 bits, index of the object in the low 32 bits
+	struct ColliderData_AABB* bounds;	//World space bounds of each object
+	unsigned char* bounded;		//Whether each object has finite bounds, rays do not
+	unsigned int numObjects;
+	unsigned int numChunks;		//Number of tasks the keys are computed in
+	DynamicArray* straddlers;	//Indices of objects which overlap, but are not contained by, the children of the nodes being built
+};
+
+///
+//Computes the sort keys of one chunk of the objects of a rebuild
+//
+//Parameters:
+//	data: A pointer to the struct OctTree_Rebuild
+//	chunk: The index of the chunk to compute
+static void OctTree_ComputeRebuildKeysTask(void* data, unsigned int chunk);
+
+///
+//Determines if and how an object of a rebuild is colliding with an oct tree node,
+//testing the object's bounds computed with it's key rather than it's collider
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: The node to check if the object is colliding with
+//	index: The index of the object in the rebuild
+//
+//Returns:
+//	The same status as OctTree_Node_DoesObjectCollide
+static unsigned char OctTree_Rebuild_DoesObjectCollide(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int index);
+
+///
+//Builds the subtree of a node during a rebuild
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: A pointer to the node to build
+//	begin: The index of the first sorted key belonging to this node's subtree
+//	end: One past the index of the last sorted key belonging to this node's subtree
+//	straddlersBegin: The index of the first of the rebuild's straddlers which overlap this node
+static void OctTree_Node_Build(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int begin, unsigned int end, unsigned int straddlersBegin);
+
+///
+//Makes a node a leaf of the tree being rebuilt holding the objects of it's sorted keys and straddlers
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: A pointer to the node to make a leaf
+//	begin: The index of the first sorted key belonging to this node's subtree
+//	end: One past the index of the last sorted key belonging to this node's subtree
+//	straddlersBegin: The index of the first of the rebuild's straddlers which overlap this node
+static void OctTree_Node_BuildLeaf(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int begin, unsigned int end, unsigned int straddlersBegin);
+
+///
+//Appends an object of a rebuild to the occupants of the node being built and records the node for the object
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: A pointer to the node being built
+//	index: The index of the object in the rebuild
+static void OctTree_Rebuild_AddOccupant(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int index);
+
+///
+//Determines if the loose bounds of a node of a loose oct tree contain an axis aligned bounding box
+//The loose bounds of a node are it's bounds grown about it's center by the tree's looseness.
+//The loose bounds of the root are unbounded, it holds every object which belongs in no other node.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree the node belongs to
+//	node: A pointer to the node to test
+//	bounds: A pointer to the world space bounds to test
+//
+//Returns:
+//	1 if the loose bounds contain the bounds, else 0
+static unsigned char OctTree_Node_DoLooseBoundsContain(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds);
+
+///
+//Determines if the loose bounds of a node of a loose oct tree overlap an axis aligned bounding box
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree the node belongs to
+//	node: A pointer to the node to test
+//	bounds: A pointer to the world space bounds to test
+//
+//Returns:
+//	1 if the loose bounds overlap the bounds, else 0
+static unsigned char OctTree_Node_DoLooseBoundsOverlap(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds);
+
+///
+//Finds the node of a loose oct tree which should hold an object, searching down from a given node.
+//This is the deepest node whose cell contains the center of the object's bounds and whose loose bounds contain the object.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to search
+//	node: A pointer to the node to search down from
+//	bounds: A pointer to the world space bounds of the object, or NULL if the object has no finite bounds
+//
+//Returns:
+//	A pointer to the node which should hold the object
+static struct OctTree_Node* OctTree_Node_FindLooseNode(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds);
+
+///
+//Adds a game object to a loose oct tree below a given node, recording the node which holds it in the tree's map.
+//A full leaf is split, moving each of it's occupants down into the child which should hold it.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to add the object to
+//	node: A pointer to the node to add the object below
+//	obj: A pointer to the game object being added
+//	bounds: A pointer to the world space bounds of the object, or NULL if the object has no finite bounds
+static void OctTree_Node_AddLoose(OctTree* tree, struct OctTree_Node* node, GObject* obj, const struct ColliderData_AABB* bounds);
+
+///
+//Removes a game object from a loose oct tree along with it's entry in the tree's map
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to remove the object from
+//	obj: A pointer to the game object to remove
+static void OctTree_RemoveLoose(OctTree* tree, GObject* obj);
+
+///
+//Appends the occupants of a node of a loose oct tree and it's descendants which may collide with an occupant of the tree
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to search
+//	node: A pointer to the node to search
+//	bounds: A pointer to the world space bounds of the occupant, or NULL if the occupant has no finite bounds
+//	index: The index of the occupant in the tree's occupant array, only occupants after it are appended
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+static void OctTree_Node_GetLooseCandidates(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds, unsigned int index, DynamicArray* dest);
+
+///
+//Appends the occupants of a node of an oct tree and it's descendants whose bounds overlap an axis aligned bounding box
+//Nodes of a loose oct tree are tested with their loose bounds.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	node: A pointer to the node to search
+//	bounds: A pointer to the world space bounds to search within
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+static void OctTree_Node_QueryAABB(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Appends the occupants of a node of an oct tree and it's descendants held by nodes whose bounds a ray crosses
+//Nodes of a loose oct tree are tested with their loose bounds.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	node: A pointer to the node to search
+//	ray: A pointer to the prepared ray
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+static void OctTree_Node_QueryRay(OctTree* tree, struct OctTree_Node* node, const struct OctTree_SlabRay* ray, DynamicArray* dest);
+
+///
+//Determines if a prepared ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//
+//Returns:
+//	1 if the ray crosses the bounds, else 0
+static unsigned char OctTree_DoesRayCross(const struct ColliderData_AABB* bounds, const struct OctTree_SlabRay* ray);
+
+///
+//Removes the repeated objects from the end of an array of objects found by a query
+//An object straddling leaves of a classic oct tree is found once in each of them.
+//
+//Parameters:
+//	dest: A pointer to the dynamic array of GObject* holding the objects found
+//	first: The index of the first object found by the query
+static void OctTree_RemoveDuplicates(DynamicArray* dest, unsigned int first);
+
+///
+//Compares the addresses of two game objects for qsort
+//
+//Parameters:
+//	a: A pointer to the first GObject*
+//	b: A pointer to the second GObject*
+//
+//Returns:
+//	-1 if a's object lies at a lower address than b's, 1 if it lies at a higher one, else 0
+static int OctTree_CompareObjects(const void* a, const void* b);
 
 ///
 //Subdivides an oct tree node into 8 child nodes, re-adding all occupants to the oct tree
@@ -136,14 +435,16 @@ static unsigned char OctTree_Node_DoesRayCollide(struct OctTree_Node* node, stru
 //Implementations
 
 ///
-//Allocates memory for an octtree node
+//Gets the index in an oct tree's node pool of the first node at a given depth
+//
+//Parameters:
+//	depth: The depth to get the first node of
 //
 //Returns:
-//	A pointer to a newly allocated, uninitialized oct tree node
-static struct OctTree_Node* OctTree_Node_Allocate()
+//	The number of nodes in all levels above the given depth, (8^depth - 1) / 7
+static unsigned int OctTree_GetLevelOffset(unsigned int depth)
 {
-	struct OctTree_Node* node = (struct OctTree_Node*)malloc(sizeof(struct OctTree_Node));
-	return node;
+	return ((1u << (3 * depth)) - 1) / 7;
 }
 
 ///
@@ -151,29 +452,29 @@ static struct OctTree_Node* OctTree_Node_Allocate()
 //
 //Parameters:
 //	node: A pointer to the oct tree node to initialize
-//	tree: A pointer to the oct tree this node is part of
 //	parent: A pointer to the parent node of this oct tree node
 //	depth: The depth from the root node of this node in the oct tree
+//	mortonCode: The morton code of this node among the nodes of it's depth
 //	leftBound: The left bound of the octtree
 //	rightBound: The right bound of the octtree
 //	bottomBound: The bottom bound of the octtree
 //	topBound: The top bound of the octtree
 //	backBound: The back bound of the octtree
 //	frontBound: The front bound of the octtree
-static void OctTree_Node_Initialize(struct OctTree_Node* node, OctTree* tree, struct OctTree_Node* parent, unsigned int depth, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound)
+static void OctTree_Node_Initialize(struct OctTree_Node* node, struct OctTree_Node* parent, unsigned int depth, unsigned int mortonCode, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound)
 {
 	//Set relative nodes
 	node->children = NULL;
 	node->parent = parent;
 
-	//Create data array
-	node->data = DynamicArray_Allocate();
-	//Set a max capacity of the dynamic array to the max occupancy of the oct tree
-	node->data->capacity = tree->maxOccupancy;
-	DynamicArray_Initialize(node->data, sizeof(GObject*));
+	//Nodes begin with no occupants
+	node->offset = 0;
+	node->count = 0;
+	node->capacity = 0;
 
-	//Set depth
+	//Set depth & address
 	node->depth = depth;
+	node->mortonCode = mortonCode;
 
 	//Set bounds
 	node->left = leftBound;
@@ -185,142 +486,826 @@ static void OctTree_Node_Initialize(struct OctTree_Node* node, OctTree* tree, st
 }
 
 ///
-//Frees data allocated by an oct tree node
+//Initializes the children of an oct tree node in the tree's node pool
+//Does not attach the children to the node.
+//
+//Parameters:
+//	tree: A pointer to the oct tree the children will be apart of
+//	node: A pointer to the node to initialize the children of
+static void OctTree_Node_InitializeChildren(OctTree* tree, struct OctTree_Node* parent)
+{
+	//Get the half width, half depth, and half height of the parent
+	float halfWidth = (parent->right - parent->left)/2.0f;
+	float halfHeight = (parent->top - parent->bottom)/2.0f;
+	float halfDepth = (parent->front - parent->back)/2.0f;
+
+	//The children of a node are the 8 nodes on the next level whose morton codes begin with the parent's
+	unsigned int firstChildCode = parent->mortonCode << 3;
+	struct OctTree_Node* children = OctTree_GetNode(tree, parent->depth + 1, firstChildCode);
+
+	//The child index holds one bit per axis, x | y << 1 | z << 2, set for the upper half of that axis
+	for(unsigned int i = 0; i < 8; i++)
+	{
+		float left = (i & 1) ? parent->left + halfWidth : parent->left;
+		float bottom = (i & 2) ? parent->bottom + halfHeight : parent->bottom;
+		float back = (i & 4) ? parent->back + halfDepth : parent->back;
+
+		OctTree_Node_Initialize(children + i, parent, parent->depth + 1, firstChildCode | i,
+			left, (i & 1) ? parent->right : left + halfWidth,		//Left / Right bounds
+			bottom, (i & 2) ? parent->top : bottom + halfHeight,		//Bottom / Top bounds
+			back, (i & 4) ? parent->front : back + halfDepth);		//Back / Front bounds
+	}
+}
+
+///
+//Moves the occupants of a leaf node to the end of the tree's occupant array with room for more
+//The entries the leaf previously owned are left empty until the tree is compacted.
+//
+//Parameters:
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to move
+//	capacity: The number of occupants the leaf will have room for
+static void OctTree_Node_Relocate(OctTree* tree, struct OctTree_Node* leaf, unsigned int capacity)
+{
+	unsigned int offset = tree->occupants->size;
+	DynamicArray_Reserve(tree->occupants, offset + capacity);
+
+	GObject** occupants = DynamicArray_GObjectPtr_Data(tree->occupants);
+	memcpy(occupants + offset, occupants + leaf->offset, sizeof(GObject*) * leaf->count);
+	memset(occupants + offset + leaf->count, 0, sizeof(GObject*) * (capacity - leaf->count));
+	memset(occupants + leaf->offset, 0, sizeof(GObject*) * leaf->capacity);
+	tree->occupants->size += capacity;
+
+	leaf->offset = offset;
+	leaf->capacity = capacity;
+	tree->needsCompaction = 1;
+}
+
+///
+//Appends an occupant to a leaf node, making room in the tree's occupant array
+//
+//Parameters:
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to add the occupant to
+//	obj: A pointer to the game object being added
+static void OctTree_Node_InsertOccupant(OctTree* tree, struct OctTree_Node* leaf, GObject* obj)
+{
+	if(leaf->count == leaf->capacity)
+	{
+		//Double the room of the leaf, beginning with enough for a full leaf
+		unsigned int capacity = leaf->capacity * 2;
+		if(capacity < tree->maxOccupancy + 1) capacity = tree->maxOccupancy + 1;
+		OctTree_Node_Relocate(tree, leaf, capacity);
+	}
+
+	*DynamicArray_GObjectPtr_Index(tree->occupants, leaf->offset + leaf->count) = obj;
+	leaf->count++;
+}
+
+///
+//Finds an occupant of a leaf node
+//
+//Parameters:
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to search
+//	obj: A pointer to the game object to find
+//
+//Returns:
+//	The index of the object within the leaf, or the leaf's count if the leaf does not contain the object
+static unsigned int OctTree_Node_FindOccupant(OctTree* tree, struct OctTree_Node* leaf, GObject* obj)
+{
+	GObject** occupants = OctTree_Node_GetOccupants(tree, leaf);
+	unsigned int index = 0;
+	while(index < leaf->count && occupants[index] != obj) index++;
+	return index;
+}
+
+///
+//Removes an occupant from a leaf node, moving the leaf's last occupant into it's place
+//
+//Parameters:
+//	tree: A pointer to the oct tree the leaf belongs to
+//	leaf: A pointer to the leaf node to remove the occupant from
+//	index: The index of the occupant within the leaf
+static void OctTree_Node_RemoveOccupant(OctTree* tree, struct OctTree_Node* leaf, unsigned int index)
+{
+	GObject** occupants = OctTree_Node_GetOccupants(tree, leaf);
+	leaf->count--;
+	occupants[index] = occupants[leaf->count];
+	occupants[leaf->count] = NULL;
+}
+
+///
+//Attaches the 8 children of a leaf node, which begin as empty leaves.
+//The occupants of the leaf are removed from the tree and returned.
+//
+//Parameters:
+//	tree: A pointer to the oct tree in which this node lives
+//	node: A pointer to the leaf node being split
+//	numOccupants: A pointer to the destination of the number of occupants the leaf had
+//
+//Returns:
+//	A newly allocated array of the occupants the leaf had, to be freed by the caller
+static GObject** OctTree_Node_Split(OctTree* tree, struct OctTree_Node* node, unsigned int* numOccupants)
+{
+	*numOccupants = node->count;
+	//Create a temporary list of occupants
+	GObject** occupants = (GObject**)malloc(sizeof(GObject*) * node->count);
+	//Copy occupants from node into temporary list
+	memcpy(occupants, OctTree_Node_GetOccupants(tree, node), sizeof(GObject*) * node->count);
+
+	//Clear the node's occupants, it's entries stay empty until the tree is compacted
+	memset(OctTree_Node_GetOccupants(tree, node), 0, sizeof(GObject*) * node->capacity);
+	node->count = 0;
+	node->capacity = 0;
+
+	//Attach the children, they are given room in the occupants as they are filled
+	node->children = OctTree_GetNode(tree, node->depth + 1, node->mortonCode << 3);
+	for(unsigned int i = 0; i < 8; i++)
+	{
+		node->children[i].children = NULL;
+		node->children[i].offset = 0;
+		node->children[i].count = 0;
+		node->children[i].capacity = 0;
+	}
+
+	tree->needsCompaction = 1;
+
+	return occupants;
+}
+
+///
+//Appends the leaves below a node to the tree's leaves in morton order,
+//copying their occupants into the tree's compact occupant array.
+//Inner nodes holding occupants are appended before their children.
+//
+//Parameters:
+//	tree: A pointer to the oct tree being compacted
+//	node: A pointer to the node to compact the leaves of
+static void OctTree_Node_Compact(OctTree* tree, struct OctTree_Node* node)
+{
+	if(node->children == NULL || node->count > 0)
+	{
+		unsigned int offset = tree->compactOccupants->size;
+		DynamicArray_GObjectPtr_AppendN(tree->compactOccupants, OctTree_Node_GetOccupants(tree, node), node->count);
+		node->offset = offset;
+		node->capacity = node->count;
+
+		DynamicArray_OctTreeNodePtr_Append(tree->leaves, node);
+	}
+
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			OctTree_Node_Compact(tree, node->children + i);
+		}
+	}
+}
+
+///
+//Gets the world space axis aligned bounds of a game object's collider,
+//matching the bounds used to test the collider against oct tree nodes
+//
+//Parameters:
+//	dest: A pointer to the AABB to store the bounds in
+//	obj: A pointer to the game object to get the bounds of
+//
+//Returns:
+//	0 if the collider has no finite bounds (rays), else 1
+static unsigned char OctTree_GetObjectAABB(struct ColliderData_AABB* dest, GObject* obj)
+{
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	return Collider_GetWorldAABB(dest, obj->collider, frame);
+}
+
+///
+//Gets the sort key of a game object for rebuilding an oct tree.
+//The key identifies the deepest node which contains the object's bounds:
+//the node's morton code extended with zeros to the tree's max depth, followed by 3 bits holding the node's depth.
+//Sorting by this key places every node's objects after the objects of it's ancestors
+//and before the objects of the nodes which follow it in morton order.
+//
+//Parameters:
+//	tree: A pointer to the oct tree being rebuilt
+//	bounds: A pointer to the world space bounds of the object
+//
+//Returns:
+//	The sort key of the object, 0 (the root) if the object is not contained by the tree
+static uint32_t OctTree_GetRebuildKey(OctTree* tree, const struct ColliderData_AABB* bounds)
+{
+	struct OctTree_Node* root = tree->root;
+	float rootMin[3] = { root->left, root->bottom, root->back };
+	float rootMax[3] = { root->right, root->top, root->front };
+
+	//Find the cells at the max depth holding the minimum and maximum corners of the bounds
+	unsigned int numCells = 1u << tree->maxDepth;
+	unsigned int minCell[3], maxCell[3];
+	for(int i = 0; i < 3; i++)
+	{
+		if(bounds->min[i] < rootMin[i] || bounds->max[i] > rootMax[i]) return 0;
+
+		float cellsPerUnit = numCells / (rootMax[i] - rootMin[i]);
+		minCell[i] = (unsigned int)((bounds->min[i] - rootMin[i]) * cellsPerUnit);
+		maxCell[i] = (unsigned int)((bounds->max[i] - rootMin[i]) * cellsPerUnit);
+		if(minCell[i] >= numCells) minCell[i] = numCells - 1;
+		if(maxCell[i] >= numCells) maxCell[i] = numCells - 1;
+	}
+
+	//Descend from the root while both corners fall in the same child
+	uint32_t mortonCode = 0;
+	unsigned int depth = 0;
+	while(depth < tree->maxDepth)
+	{
+		unsigned int shift = tree->maxDepth - 1 - depth;
+		unsigned int child = 0;
+		unsigned char split = 0;
+		for(int i = 0; i < 3; i++)
+		{
+			unsigned int minBit = (minCell[i] >> shift) & 1;
+			if(minBit != ((maxCell[i] >> shift) & 1)) split = 1;
+			child |= minBit << i;
+		}
+		if(split) break;
+
+		mortonCode = (mortonCode << 3) | child;
+		depth++;
+	}
+
+	return ((mortonCode << (3 * (tree->maxDepth - depth))) << 3) | depth;
+}
+
+///
+//Gets the sort key of a game object for rebuilding a loose oct tree.
+//The key identifies the deepest node whose cell contains the center of the object's bounds
+//and whose loose bounds contain the object, in the same form as OctTree_GetRebuildKey.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree being rebuilt
+//	bounds: A pointer to the world space bounds of the object
+//
+//Returns:
+//	The sort key of the object, 0 (the root) if the object's center is not within the tree
+static uint32_t OctTree_GetLooseRebuildKey(OctTree* tree, const struct ColliderData_AABB* bounds)
+{
+	struct OctTree_Node* root = tree->root;
+	float rootMin[3] = { root->left, root->bottom, root->back };
+	float rootMax[3] = { root->right, root->top, root->front };
+
+	//Find the cell at the max depth holding the center of the bounds
+	unsigned int numCells = 1u << tree->maxDepth;
+	unsigned int cell[3];
+	for(int i = 0; i < 3; i++)
+	{
+		float center = (bounds->min[i] + bounds->max[i]) * 0.5f;
+		if(center < rootMin[i] || center > rootMax[i]) return 0;
+
+		cell[i] = (unsigned int)((center - rootMin[i]) * (numCells / (rootMax[i] - rootMin[i])));
+		if(cell[i] >= numCells) cell[i] = numCells - 1;
+	}
+
+	//Descend from the root while the child holding the center can hold the object
+	uint32_t mortonCode = 0;
+	unsigned int depth = 0;
+	while(depth < tree->maxDepth)
+	{
+		unsigned int shift = tree->maxDepth - 1 - depth;
+		unsigned int child = 0;
+		for(int i = 0; i < 3; i++)
+		{
+			child |= ((cell[i] >> shift) & 1) << i;
+		}
+
+		uint32_t childCode = (mortonCode << 3) | child;
+		if(!OctTree_Node_DoLooseBoundsContain(tree, OctTree_GetNode(tree, depth + 1, childCode), bounds)) break;
+
+		mortonCode = childCode;
+		depth++;
+	}
+
+	return ((mortonCode << (3 * (tree->maxDepth - depth))) << 3) | depth;
+}
+
+///
+//Computes the sort keys of one chunk of the objects of a rebuild
+//
+//Parameters:
+//	data: A pointer to the struct OctTree_Rebuild
+//	chunk: The index of the chunk to compute
+static void OctTree_ComputeRebuildKeysTask(void* data, unsigned int chunk)
+{
+	struct OctTree_Rebuild* rebuild = (struct OctTree_Rebuild*)data;
+	unsigned int begin = (unsigned int)(((uint64_t)rebuild->numObjects * chunk) / rebuild->numChunks);
+	unsigned int end = (unsigned int)(((uint64_t)rebuild->numObjects * (chunk + 1)) / rebuild->numChunks);
+
+	for(unsigned int i = begin; i < end; i++)
+	{
+		rebuild->bounded[i] = OctTree_GetObjectAABB(rebuild->bounds + i, rebuild->objects[i]);
+		uint32_t key = 0;
+		if(rebuild->bounded[i])
+		{
+			key = rebuild->tree->looseness != 0.0f ?
+				OctTree_GetLooseRebuildKey(rebuild->tree, rebuild->bounds + i) :
+				OctTree_GetRebuildKey(rebuild->tree, rebuild->bounds + i);
+		}
+		rebuild->keys[i] = ((uint64_t)key << 32) | i;
+	}
+}
+
+///
+//Determines if and how an object of a rebuild is colliding with an oct tree node,
+//testing the object's bounds computed with it's key rather than it's collider
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: The node to check if the object is colliding with
+//	index: The index of the object in the rebuild
+//
+//Returns:
+//	The same status as OctTree_Node_DoesObjectCollide
+static unsigned char OctTree_Rebuild_DoesObjectCollide(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int index)
+{
+	if(!rebuild->bounded[index]) return OctTree_Node_DoesObjectCollide(node, rebuild->objects[index]);
+
+	const struct ColliderData_AABB* bounds = rebuild->bounds + index;
+	if(node->left > bounds->max[0] || node->right < bounds->min[0] ||
+		node->bottom > bounds->max[1] || node->top < bounds->min[1] ||
+		node->back > bounds->max[2] || node->front < bounds->min[2])
+	{
+		return 0;
+	}
+
+	if(node->left <= bounds->min[0] && node->right >= bounds->max[0] &&
+		node->bottom <= bounds->min[1] && node->top >= bounds->max[1] &&
+		node->back <= bounds->min[2] && node->front >= bounds->max[2])
+	{
+		return 2;
+	}
+	return 1;
+}
+
+///
+//Builds the subtree of a node during a rebuild
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: A pointer to the node to build
+//	begin: The index of the first sorted key belonging to this node's subtree
+//	end: One past the index of the last sorted key belonging to this node's subtree
+//	straddlersBegin: The index of the first of the rebuild's straddlers which overlap this node
+static void OctTree_Node_Build(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int begin, unsigned int end, unsigned int straddlersBegin)
+{
+	OctTree* tree = rebuild->tree;
+	unsigned int numStraddlers = rebuild->straddlers->size - straddlersBegin;
+
+	//Same limits as adding objects one at a time
+	if((end - begin) + numStraddlers <= tree->maxOccupancy + 1 || node->depth >= tree->maxDepth)
+	{
+		OctTree_Node_BuildLeaf(rebuild, node, begin, end, straddlersBegin);
+		return;
+	}
+
+	node->children = OctTree_GetNode(tree, node->depth + 1, node->mortonCode << 3);
+	node->offset = tree->occupants->size;
+
+	//Objects contained by this node but by none of it's children sort first,
+	//they straddle the children along with the objects straddling this node.
+	//A loose oct tree holds them in this node instead.
+	while(begin < end && ((uint32_t)(rebuild->keys[begin] >> 32) & 7) == node->depth)
+	{
+		unsigned int index = (uint32_t)rebuild->keys[begin];
+		if(tree->looseness != 0.0f)
+		{
+			OctTree_Rebuild_AddOccupant(rebuild, node, index);
+		}
+		else
+		{
+			DynamicArray_UInt_Append(rebuild->straddlers, index);
+		}
+		begin++;
+	}
+	unsigned int straddlersEnd = rebuild->straddlers->size;
+
+	node->count = tree->occupants->size - node->offset;
+	node->capacity = node->count;
+	if(node->count > 0)
+	{
+		DynamicArray_OctTreeNodePtr_Append(tree->leaves, node);
+	}
+
+	for(unsigned int i = 0; i < 8; i++)
+	{
+		struct OctTree_Node* child = node->children + i;
+
+		//The keys of the child's subtree come before the key of the next node at it's depth
+		uint32_t endKey = ((child->mortonCode + 1) << (3 * (tree->maxDepth - child->depth))) << 3;
+		unsigned int childEnd = begin;
+		while(childEnd < end && (uint32_t)(rebuild->keys[childEnd] >> 32) < endKey) childEnd++;
+
+		//Pass on the straddlers which overlap the child
+		unsigned int childStraddlersBegin = rebuild->straddlers->size;
+		for(unsigned int j = straddlersBegin; j < straddlersEnd; j++)
+		{
+			unsigned int index = DynamicArray_UInt_Get(rebuild->straddlers, j);
+			if(OctTree_Rebuild_DoesObjectCollide(rebuild, child, index) != 0)
+			{
+				DynamicArray_UInt_Append(rebuild->straddlers, index);
+			}
+		}
+
+		OctTree_Node_Build(rebuild, child, begin, childEnd, childStraddlersBegin);
+
+		rebuild->straddlers->size = childStraddlersBegin;
+		begin = childEnd;
+	}
+}
+
+///
+//Makes a node a leaf of the tree being rebuilt holding the objects of it's sorted keys and straddlers
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: A pointer to the node to make a leaf
+//	begin: The index of the first sorted key belonging to this node's subtree
+//	end: One past the index of the last sorted key belonging to this node's subtree
+//	straddlersBegin: The index of the first of the rebuild's straddlers which overlap this node
+static void OctTree_Node_BuildLeaf(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int begin, unsigned int end, unsigned int straddlersBegin)
+{
+	OctTree* tree = rebuild->tree;
+
+	node->children = NULL;
+	node->offset = tree->occupants->size;
+	DynamicArray_OctTreeNodePtr_Append(tree->leaves, node);
+
+	unsigned int numStraddlers = rebuild->straddlers->size - straddlersBegin;
+	for(unsigned int i = 0; i < numStraddlers + (end - begin); i++)
+	{
+		unsigned int index = i < numStraddlers ?
+			DynamicArray_UInt_Get(rebuild->straddlers, straddlersBegin + i) :
+			(uint32_t)rebuild->keys[begin + (i - numStraddlers)];
+		OctTree_Rebuild_AddOccupant(rebuild, node, index);
+	}
+
+	node->count = tree->occupants->size - node->offset;
+	node->capacity = node->count;
+}
+
+///
+//Appends an object of a rebuild to the occupants of the node being built and records the node for the object
+//
+//Parameters:
+//	rebuild: A pointer to the state of the rebuild
+//	node: A pointer to the node being built
+//	index: The index of the object in the rebuild
+static void OctTree_Rebuild_AddOccupant(struct OctTree_Rebuild* rebuild, struct OctTree_Node* node, unsigned int index)
+{
+	GObject* obj = rebuild->objects[index];
+	DynamicArray_GObjectPtr_Append(rebuild->tree->occupants, obj);
+
+	if(rebuild->logs[index] != NULL)
+	{
+		//Log the node for the object
+		struct OctTree_NodeStatus entry;
+		entry.node = node;
+		entry.collisionStatus = OctTree_Rebuild_DoesObjectCollide(rebuild, node, index);
+		DynamicArray_OctTreeNodeStatus_Append(rebuild->logs[index], entry);
+	}
+	else
+	{
+		//A loose oct tree maps the object straight to it's node
+		HashMap_LookUp(rebuild->tree->map, &obj, sizeof(GObject*))->data = node;
+	}
+}
+
+///
+//Determines if the loose bounds of a node of a loose oct tree contain an axis aligned bounding box
+//The loose bounds of a node are it's bounds grown about it's center by the tree's looseness.
+//The loose bounds of the root are unbounded, it holds every object which belongs in no other node.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree the node belongs to
+//	node: A pointer to the node to test
+//	bounds: A pointer to the world space bounds to test
+//
+//Returns:
+//	1 if the loose bounds contain the bounds, else 0
+static unsigned char OctTree_Node_DoLooseBoundsContain(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds)
+{
+	if(node == tree->root) return 1;
+
+	//Each side grows by half of the extra size
+	float growth = (tree->looseness - 1.0f) * 0.5f;
+	float growX = (node->right - node->left) * growth;
+	float growY = (node->top - node->bottom) * growth;
+	float growZ = (node->front - node->back) * growth;
+
+	return node->left - growX <= bounds->min[0] && node->right + growX >= bounds->max[0] &&
+		node->bottom - growY <= bounds->min[1] && node->top + growY >= bounds->max[1] &&
+		node->back - growZ <= bounds->min[2] && node->front + growZ >= bounds->max[2];
+}
+
+///
+//Determines if the loose bounds of a node of a loose oct tree overlap an axis aligned bounding box
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree the node belongs to
+//	node: A pointer to the node to test
+//	bounds: A pointer to the world space bounds to test
+//
+//Returns:
+//	1 if the loose bounds overlap the bounds, else 0
+static unsigned char OctTree_Node_DoLooseBoundsOverlap(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds)
+{
+	if(node == tree->root) return 1;
+
+	float growth = (tree->looseness - 1.0f) * 0.5f;
+	float growX = (node->right - node->left) * growth;
+	float growY = (node->top - node->bottom) * growth;
+	float growZ = (node->front - node->back) * growth;
+
+	return node->left - growX <= bounds->max[0] && node->right + growX >= bounds->min[0] &&
+		node->bottom - growY <= bounds->max[1] && node->top + growY >= bounds->min[1] &&
+		node->back - growZ <= bounds->max[2] && node->front + growZ >= bounds->min[2];
+}
+
+///
+//Finds the node of a loose oct tree which should hold an object, searching down from a given node.
+//This is the deepest node whose cell contains the center of the object's bounds and whose loose bounds contain the object.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to search
+//	node: A pointer to the node to search down from
+//	bounds: A pointer to the world space bounds of the object, or NULL if the object has no finite bounds
+//
+//Returns:
+//	A pointer to the node which should hold the object
+static struct OctTree_Node* OctTree_Node_FindLooseNode(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds)
+{
+	if(bounds == NULL) return node;
+
+	while(node->children != NULL)
+	{
+		//The first child's upper bounds are the middle of the node
+		struct OctTree_Node* first = node->children;
+		unsigned int child = 0;
+		if(bounds->min[0] + bounds->max[0] >= first->right * 2.0f) child |= 1;
+		if(bounds->min[1] + bounds->max[1] >= first->top * 2.0f) child |= 2;
+		if(bounds->min[2] + bounds->max[2] >= first->front * 2.0f) child |= 4;
+
+		if(!OctTree_Node_DoLooseBoundsContain(tree, node->children + child, bounds)) break;
+		node = node->children + child;
+	}
+
+	return node;
+}
+
+///
+//Adds a game object to a loose oct tree below a given node, recording the node which holds it in the tree's map.
+//A full leaf is split, moving each of it's occupants down into the child which should hold it.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to add the object to
+//	node: A pointer to the node to add the object below
+//	obj: A pointer to the game object being added
+//	bounds: A pointer to the world space bounds of the object, or NULL if the object has no finite bounds
+static void OctTree_Node_AddLoose(OctTree* tree, struct OctTree_Node* node, GObject* obj, const struct ColliderData_AABB* bounds)
+{
+	node = OctTree_Node_FindLooseNode(tree, node, bounds);
+
+	//Objects which fit none of a node's children stay in the node,
+	//so only leaves are limited to the tree's max occupancy
+	if(node->children != NULL || node->count <= tree->maxOccupancy || node->depth >= tree->maxDepth)
+	{
+		OctTree_Node_InsertOccupant(tree, node, obj);
+
+		struct HashMap_KeyValuePair* pair = HashMap_LookUp(tree->map, &obj, sizeof(GObject*));
+		if(pair != NULL)
+		{
+			pair->data = node;
+		}
+		else
+		{
+			HashMap_Add(tree->map, &obj, node, sizeof(GObject*));
+		}
+	}
+	//Else, the leaf is full and can subdivide!
+	else
+	{
+		unsigned int numOccupants;
+		GObject** occupants = OctTree_Node_Split(tree, node, &numOccupants);
+		for(unsigned int i = 0; i < numOccupants; i++)
+		{
+			struct ColliderData_AABB occupantBounds;
+			unsigned char bounded = OctTree_GetObjectAABB(&occupantBounds, occupants[i]);
+			OctTree_Node_AddLoose(tree, node, occupants[i], bounded ? &occupantBounds : NULL);
+		}
+		free(occupants);
+
+		//Finally, recall this function to add the object to the node or one of it's children
+		OctTree_Node_AddLoose(tree, node, obj, bounds);
+	}
+}
+
+///
+//Removes a game object from a loose oct tree along with it's entry in the tree's map
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to remove the object from
+//	obj: A pointer to the game object to remove
+static void OctTree_RemoveLoose(OctTree* tree, GObject* obj)
+{
+	struct OctTree_Node* node = (struct OctTree_Node*)HashMap_Remove(tree->map, &obj, sizeof(GObject*));
+	if(node == NULL) return;
+
+	unsigned int index = OctTree_Node_FindOccupant(tree, node, obj);
+	if(index < node->count)
+	{
+		OctTree_Node_RemoveOccupant(tree, node, index);
+	}
+}
+
+///
+//Appends the occupants of a node of a loose oct tree and it's descendants which may collide with an occupant of the tree
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to search
+//	node: A pointer to the node to search
+//	bounds: A pointer to the world space bounds of the occupant, or NULL if the occupant has no finite bounds
+//	index: The index of the occupant in the tree's occupant array, only occupants after it are appended
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+static void OctTree_Node_GetLooseCandidates(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds, unsigned int index, DynamicArray* dest)
+{
+	//The loose bounds of a node contain the loose bounds of it's children
+	if(bounds != NULL && !OctTree_Node_DoLooseBoundsOverlap(tree, node, bounds)) return;
+
+	//Occupants before the one searching with found their pairs when they searched
+	unsigned int end = node->offset + node->count;
+	if(node->count > 0 && end > index + 1)
+	{
+		unsigned int first = node->offset > index ? node->offset : index + 1;
+		DynamicArray_GObjectPtr_AppendN(dest, DynamicArray_GObjectPtr_Index(tree->occupants, first), end - first);
+	}
+
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			OctTree_Node_GetLooseCandidates(tree, node->children + i, bounds, index, dest);
+		}
+	}
+}
+
+///
+//Appends the occupants of a node of an oct tree and it's descendants whose bounds overlap an axis aligned bounding box
+//Nodes of a loose oct tree are tested with their loose bounds.
 //
 //Parameters:
-//	tree: A pointer to the oct tree which the node being freed is apart of
-//	node: A pointer to the oct tree node to free
-static void OctTree_Node_Free(OctTree* tree, struct OctTree_Node* node)
+//	tree: A pointer to the oct tree to search
+//	node: A pointer to the node to search
+//	bounds: A pointer to the world space bounds to search within
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+static void OctTree_Node_QueryAABB(OctTree* tree, struct OctTree_Node* node, const struct ColliderData_AABB* bounds, DynamicArray* dest)
 {
-	//If this node has children
+	if(tree->looseness != 0.0f)
+	{
+		if(!OctTree_Node_DoLooseBoundsOverlap(tree, node, bounds)) return;
+	}
+	else if(node->left > bounds->max[0] || node->right < bounds->min[0] ||
+		node->bottom > bounds->max[1] || node->top < bounds->min[1] ||
+		node->back > bounds->max[2] || node->front < bounds->min[2])
+	{
+		return;
+	}
+
+	if(node->count > 0)
+	{
+		DynamicArray_GObjectPtr_AppendN(dest, DynamicArray_GObjectPtr_Index(tree->occupants, node->offset), node->count);
+	}
+
 	if(node->children != NULL)
 	{
 		for(int i = 0; i < 8; i++)
 		{
-			//Free the children!
-			OctTree_Node_Free(tree, node->children + i);
+			OctTree_Node_QueryAABB(tree, node->children + i, bounds, dest);
 		}
-		//Free the children container...
-		free(node->children);
 	}
-	else
+}
+
+///
+//Appends the occupants of a node of an oct tree and it's descendants held by nodes whose bounds a ray crosses
+//Nodes of a loose oct tree are tested with their loose bounds.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	node: A pointer to the node to search
+//	ray: A pointer to the prepared ray
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+static void OctTree_Node_QueryRay(OctTree* tree, struct OctTree_Node* node, const struct OctTree_SlabRay* ray, DynamicArray* dest)
+{
+	//The root of a loose oct tree holds every object which fits nowhere else, wherever it is
+	if(tree->looseness == 0.0f || node != tree->root)
 	{
-		//TODO: Figure out the proper way to deal with the freeing of the tree's hashmap.
-		//Loop through the occupants of this list
-		for(unsigned int i = 0; i < node->data->size; i++)
+		float growth = tree->looseness != 0.0f ? (tree->looseness - 1.0f) * 0.5f : 0.0f;
+		float growX = (node->right - node->left) * growth;
+		float growY = (node->top - node->bottom) * growth;
+		float growZ = (node->front - node->back) * growth;
+
+		struct ColliderData_AABB bounds =
 		{
-			GObject* occupant = *(GObject**)DynamicArray_Index(node->data, i);
-			//If the occupant still has a log in the hashmap
-			if(HashMap_Contains(tree->map, &occupant, sizeof(GObject*)))
-			{
-				//Get the log of the occupant from the hashmap
-				DynamicArray* log = (DynamicArray*)HashMap_LookUp(tree->map, &occupant, sizeof(GObject*))->data;	
-				//Find this node in the log
-				struct OctTree_NodeStatus* status = NULL;
-				for(unsigned int j = 0; j < log->size; j++)
-				{
-					status = (struct OctTree_NodeStatus*)DynamicArray_Index(log, j);
-					
-					if(status->node == node)
-					{
-						//When we find it, remove this node from the log.
-						DynamicArray_RemoveAndReposition(log, j);
-						//If there is no other nodes logged, delete the log.
-						if(log->size == 0)
-						{
-							HashMap_Remove(tree->map, &occupant, sizeof(GObject*));
-							DynamicArray_Free(log);
-						}
-
-						//Stop looping
-						break;
-					}
-				}
-			}
-			
-		}
+			{ node->left - growX, node->bottom - growY, node->back - growZ },
+			{ node->right + growX, node->top + growY, node->front + growZ }
+		};
+		if(!OctTree_DoesRayCross(&bounds, ray)) return;
 	}
 
-	//Free the data contained within this tree
-	DynamicArray_Free(node->data);
+	if(node->count > 0)
+	{
+		DynamicArray_GObjectPtr_AppendN(dest, DynamicArray_GObjectPtr_Index(tree->occupants, node->offset), node->count);
+	}
 
-	//The parent node does the following, we must only free the root at the end.
-	//Free this node
-	//free(node);
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			OctTree_Node_QueryRay(tree, node->children + i, ray, dest);
+		}
+	}
 }
 
 ///
-//Allocates the children of an oct tree node
+//Determines if a prepared ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
 //
 //Returns:
-//	A pointer to an array of 8 newly allocated, uninitialized node children
-static struct OctTree_Node* OctTree_Node_AllocateChildren()
+//	1 if the ray crosses the bounds, else 0
+static unsigned char OctTree_DoesRayCross(const struct ColliderData_AABB* bounds, const struct OctTree_SlabRay* ray)
 {
-	struct OctTree_Node* children = (struct OctTree_Node*)malloc(sizeof(struct OctTree_Node) * 8);
-	return children;
+	float entry = 0.0f;
+	float exit = FLT_MAX;
+	for(int i = 0; i < 3; i++)
+	{
+		//A ray parallel to a slab must start within it
+		if(ray->parallel[i])
+		{
+			if(ray->origin[i] < bounds->min[i] || ray->origin[i] > bounds->max[i]) return 0;
+			continue;
+		}
+
+		float t1 = (bounds->min[i] - ray->origin[i]) * ray->inverseDirection[i];
+		float t2 = (bounds->max[i] - ray->origin[i]) * ray->inverseDirection[i];
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > entry) entry = t1;
+		if(t2 < exit) exit = t2;
+		if(entry > exit) return 0;
+	}
+	return 1;
 }
 
 ///
-//Initializes the children of an oct tree node
+//Removes the repeated objects from the end of an array of objects found by a query
+//An object straddling leaves of a classic oct tree is found once in each of them.
 //
 //Parameters:
-//	tree: A pointer to the oct tree the children will be apart of
-//	node: A pointer to the node to initialize the children of
-static void OctTree_Node_InitializeChildren(OctTree* tree, struct OctTree_Node* parent)
+//	dest: A pointer to the dynamic array of GObject* holding the objects found
+//	first: The index of the first object found by the query
+static void OctTree_RemoveDuplicates(DynamicArray* dest, unsigned int first)
 {
-	//Get the half width, half depth, and half height of the parent
-	float halfWidth = (parent->right - parent->left)/2.0f;
-	float halfHeight = (parent->top - parent->bottom)/2.0f;
-	float halfDepth = (parent->front - parent->back)/2.0f;
+	if(dest->size - first < 2) return;
+
+	GObject** found = DynamicArray_GObjectPtr_Index(dest, first);
+	unsigned int numFound = dest->size - first;
+	qsort(found, numFound, sizeof(GObject*), OctTree_CompareObjects);
 
-	//Bottom back right octant
-	OctTree_Node_Initialize(parent->children, tree, parent, parent->depth + 1, 
-		parent->left + halfWidth, parent->right,		//Left / Right bounds
-		parent->bottom, parent->bottom + halfHeight,		//Bottom / Top bounds
-		parent->back, parent->back + halfDepth);		//Back / Front bounds
-
-	//Bottom back left octant
-	OctTree_Node_Initialize(parent->children + 1, tree, parent, parent->depth + 1, 
-		parent->left, parent->left + halfWidth,			//Left / Right bounds
-		parent->bottom, parent->bottom + halfHeight,		//Bottom / Top bounds
-		parent->back, parent->back + halfDepth);		//Back / Front bounds
-
-	//Bottom front left octant
-	OctTree_Node_Initialize(parent->children + 2, tree, parent, parent->depth + 1, 
-		parent->left, parent->left + halfWidth,			//Left / Right bounds
-		parent->bottom, parent->bottom + halfHeight,		//Bottom / Top bounds
-		parent->back + halfDepth, parent->front);		//Back / Front bounds
-
-	//Bottom front right octant
-	OctTree_Node_Initialize(parent->children + 3, tree, parent, parent->depth + 1, 
-		parent->left + halfWidth, parent->right,		//Left / Right bounds
-		parent->bottom, parent->bottom + halfHeight,		//Bottom / Top bounds
-		parent->back + halfDepth, parent->front);		//Back / Front bounds
-
-	//Top back right octant
-	OctTree_Node_Initialize(parent->children + 4, tree, parent, parent->depth + 1, 
-		parent->left + halfWidth, parent->right,		//Left / Right bounds
-		parent->bottom + halfHeight, parent->top,		//Bottom / Top bounds
-		parent->back, parent->back + halfDepth);		//Back / Front bounds
-
-	//Top back left octant
-	OctTree_Node_Initialize(parent->children + 5, tree, parent, parent->depth + 1, 
-		parent->left, parent->left + halfWidth,			//Left / Right bounds
-		parent->bottom + halfHeight, parent->top,		//Bottom / Top bounds
-		parent->back, parent->back + halfDepth);		//Back / Front bounds
-
-	//Top front left octant
-	OctTree_Node_Initialize(parent->children + 6, tree, parent, parent->depth + 1, 
-		parent->left, parent->left + halfWidth,			//Left / Right bounds
-		parent->bottom + halfHeight, parent->top,		//Bottom / Top bounds
-		parent->back + halfDepth, parent->front);		//Back / Front bounds
-
-	//Top front right octant
-	OctTree_Node_Initialize(parent->children + 7, tree, parent, parent->depth + 1, 
-		parent->left + halfWidth, parent->right,		//Left / Right bounds
-		parent->bottom + halfHeight, parent->top,		//Bottom / Top bounds
-		parent->back + halfDepth, parent->front);		//Back / Front bounds
+	unsigned int numUnique = 1;
+	for(unsigned int i = 1; i < numFound; i++)
+	{
+		if(found[i] != found[numUnique - 1]) found[numUnique++] = found[i];
+	}
+	dest->size = first + numUnique;
+}
 
+///
+//Compares the addresses of two game objects for qsort
+//
+//Parameters:
+//	a: A pointer to the first GObject*
+//	b: A pointer to the second GObject*
+//
+//Returns:
+//	-1 if a's object lies at a lower address than b's, 1 if it lies at a higher one, else 0
+static int OctTree_CompareObjects(const void* a, const void* b)
+{
+	uintptr_t objA = (uintptr_t)*(GObject* const*)a;
+	uintptr_t objB = (uintptr_t)*(GObject* const*)b;
+	return (objA > objB) - (objA < objB);
 }
 
 //Functions
@@ -338,6 +1323,7 @@ OctTree* OctTree_Allocate()
 	//Assign default values
 	tree->maxDepth = defaultMaxDepth;
 	tree->maxOccupancy = defaultMaxOccupancy;
+	tree->looseness = defaultLooseness;
 
 	return tree;
 }
@@ -355,15 +1341,47 @@ OctTree* OctTree_Allocate()
 //	frontBound: The front bound of the octtree
 void OctTree_Initialize(OctTree* tree, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound)
 {
-	//Allocate root
-	tree->root = OctTree_Node_Allocate();
+	if(tree->maxDepth > OctTree_MAX_DEPTH)
+	{
+		printf("OctTree_Initialize failed to honor max depth of %u, using %u.\n", tree->maxDepth, OctTree_MAX_DEPTH);
+		tree->maxDepth = OctTree_MAX_DEPTH;
+	}
+
+	if(tree->looseness != 0.0f && !(tree->looseness > 1.0f))
+	{
+		printf("OctTree_Initialize failed to honor looseness of %f, using %f.\n", tree->looseness, OctTree_DEFAULT_LOOSENESS);
+		tree->looseness = OctTree_DEFAULT_LOOSENESS;
+	}
+
+	//Allocate the pool of every node down to the max depth
+	tree->numNodes = OctTree_GetLevelOffset(tree->maxDepth + 1);
+	tree->nodes = (struct OctTree_Node*)malloc(sizeof(struct OctTree_Node) * tree->numNodes);
+
 	//Initialize root
-	OctTree_Node_Initialize(tree->root, tree, NULL, 0, leftBound, rightBound, bottomBound, topBound, backBound, frontBound);
+	tree->root = tree->nodes;
+	OctTree_Node_Initialize(tree->root, NULL, 0, 0, leftBound, rightBound, bottomBound, topBound, backBound, frontBound);
+
+	//Initialize the remaining levels, each node's bounds are halved from it's parent
+	for(unsigned int i = 0; i < OctTree_GetLevelOffset(tree->maxDepth); i++)
+	{
+		OctTree_Node_InitializeChildren(tree, tree->nodes + i);
+	}
+
+	//The root begins as the only leaf
+	tree->leaves = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->leaves, sizeof(struct OctTree_Node*));
+	DynamicArray_OctTreeNodePtr_Append(tree->leaves, tree->root);
+
+	tree->occupants = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->occupants, sizeof(GObject*));
+	tree->compactOccupants = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->compactOccupants, sizeof(GObject*));
+	tree->needsCompaction = 0;
 
 	//Allocate hashmap
 	tree->map = HashMap_Allocate();
 	//Initialize map
-	HashMap_Initialize(tree->map);
+	HashMap_InitializeWithKeyType(tree->map, HashMap_KeyType_POINTER);
 }
 
 ///
@@ -374,16 +1392,152 @@ void OctTree_Initialize(OctTree* tree, float leftBound, float rightBound, float
 //	tree: A pointer to the octtree to free
 void OctTree_Free(OctTree* tree)
 {
-	//Free the nodes
-	OctTree_Node_Free(tree, tree->root);
-	//Free the root
-	free(tree->root);
+	//Free the logs of all objects still in the tree, a loose oct tree maps objects to nodes instead
+	for(unsigned int i = 0; i < tree->map->data->capacity; i++)
+	{
+		struct HashMap_KeyValuePair* pair = HashMap_GetPair(tree->map, i);
+		if(pair != NULL && tree->looseness == 0.0f)
+		{
+			DynamicArray_Free((DynamicArray*)pair->data);
+		}
+	}
 	//Free the map
 	HashMap_Free(tree->map);
+
+	//Free the nodes
+	free(tree->nodes);
+	DynamicArray_Free(tree->leaves);
+	DynamicArray_Free(tree->occupants);
+	DynamicArray_Free(tree->compactOccupants);
+
 	//Free the tree!
 	free(tree);
 }
 
+///
+//Gets a node of an oct tree by it's depth and morton code
+//
+//Parameters:
+//	tree: A pointer to the oct tree to get the node from
+//	depth: The depth of the node, no greater than the tree's max depth
+//	mortonCode: The morton code of the node among the nodes of that depth
+//
+//Returns:
+//	A pointer to the node in the tree's node pool
+struct OctTree_Node* OctTree_GetNode(OctTree* tree, unsigned int depth, unsigned int mortonCode)
+{
+	return tree->nodes + OctTree_GetLevelOffset(depth) + mortonCode;
+}
+
+///
+//Brings the leaves of an oct tree up to date and packs the occupants of each leaf
+//contiguously in morton order. Does nothing if the tree has not changed shape since it was last compacted.
+//Must be called before walking the tree's leaves or occupants.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to compact
+void OctTree_Compact(OctTree* tree)
+{
+	if(!tree->needsCompaction) return;
+
+	DynamicArray_Clear(tree->leaves);
+	tree->compactOccupants->size = 0;
+	OctTree_Node_Compact(tree, tree->root);
+
+	//The compacted occupants become the tree's occupants
+	DynamicArray* swap = tree->occupants;
+	tree->occupants = tree->compactOccupants;
+	tree->compactOccupants = swap;
+
+	tree->needsCompaction = 0;
+}
+
+///
+//Rebuilds an oct tree from scratch with every game object in a memory pool which has a collider and is not excluded.
+//Objects are sorted by the morton code of the deepest node containing their bounds,
+//then leaves are emitted top down honoring the tree's max occupancy and max depth.
+//Logs of all objects are rebuilt, so incremental updates may continue afterwards.
+//Cheaper than OCtTree_UpdateWithMemoryPool when a large fraction of objects have moved.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to rebuild
+//	pool: A memory pool of gameobjects in the simulation
+//	excluded: A pointer to a hash map keyed by the objects to leave out of the tree, or NULL
+//	workers: A pointer to a worker pool to compute and sort the keys with, or NULL
+void OctTree_RebuildWithMemoryPool(OctTree* tree, MemoryPool* pool, HashMap* excluded, WorkerPool* workers)
+{
+	struct OctTree_Rebuild rebuild;
+	rebuild.tree = tree;
+
+	unsigned int numLive = MemoryPool_GetNumLive(pool);
+	rebuild.objects = (GObject**)malloc(sizeof(GObject*) * numLive);
+	rebuild.logs = (DynamicArray**)malloc(sizeof(DynamicArray*) * numLive);
+	rebuild.numObjects = 0;
+
+	//Gather every object with a collider and empty it's log
+	for(unsigned int i = 0; i < numLive; i++)
+	{
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
+		if(obj->collider == NULL) continue;
+		if(excluded != NULL && HashMap_Contains(excluded, &obj, sizeof(GObject*))) continue;
+
+		DynamicArray* log = NULL;
+		struct HashMap_KeyValuePair* pair = HashMap_LookUp(tree->map, &obj, sizeof(GObject*));
+		if(tree->looseness != 0.0f)
+		{
+			//A loose oct tree maps the object to it's node once it has been placed
+			if(pair == NULL)
+			{
+				HashMap_Add(tree->map, &obj, tree->root, sizeof(GObject*));
+			}
+		}
+		else if(pair != NULL)
+		{
+			log = (DynamicArray*)pair->data;
+			log->size = 0;
+		}
+		else
+		{
+			log = DynamicArray_Allocate();
+			DynamicArray_Initialize(log, sizeof(struct OctTree_NodeStatus));
+			HashMap_Add(tree->map, &obj, log, sizeof(GObject*));
+		}
+
+		rebuild.objects[rebuild.numObjects] = obj;
+		rebuild.logs[rebuild.numObjects] = log;
+		rebuild.numObjects++;
+	}
+
+	//Key and sort the objects
+	rebuild.keys = (uint64_t*)malloc(sizeof(uint64_t) * rebuild.numObjects);
+	rebuild.bounds = (struct ColliderData_AABB*)malloc(sizeof(struct ColliderData_AABB) * rebuild.numObjects);
+	rebuild.bounded = (unsigned char*)malloc(sizeof(unsigned char) * rebuild.numObjects);
+	uint64_t* scratch = (uint64_t*)malloc(sizeof(uint64_t) * rebuild.numObjects);
+	rebuild.numChunks = rebuild.numObjects >= parallelKeyThreshold ? WorkerPool_GetConcurrency(workers) : 1;
+
+	WorkerPool_Run(workers, OctTree_ComputeRebuildKeysTask, &rebuild, rebuild.numChunks);
+	RadixSort_SortUInt64(rebuild.keys, scratch, rebuild.numObjects, 32, 3 * tree->maxDepth + 3, workers);
+
+	//Emit the tree from the root down
+	DynamicArray_Clear(tree->leaves);
+	tree->occupants->size = 0;
+
+	rebuild.straddlers = DynamicArray_Allocate();
+	DynamicArray_Initialize(rebuild.straddlers, sizeof(unsigned int));
+
+	OctTree_Node_Build(&rebuild, tree->root, 0, rebuild.numObjects, 0);
+	tree->needsCompaction = 0;
+
+	DynamicArray_Free(rebuild.straddlers);
+	free(scratch);
+	free(rebuild.bounded);
+	free(rebuild.bounds);
+	free(rebuild.keys);
+	free(rebuild.logs);
+	free(rebuild.objects);
+}
+
+
 ///
 //Updates the position of all gameobjects within the oct tree
 //
@@ -400,77 +1554,7 @@ void OctTree_Update(OctTree* tree, LinkedList* gameObjects)
 		//Find all gameObjects which have entries in the octtree (& treemap)
 		if(gameObj->collider != NULL)
 		{
-			//Get the treemap entry
-			DynamicArray* log = (DynamicArray*)HashMap_LookUp(tree->map, &gameObj, sizeof(GObject*))->data;
-
-			if(log->size <= 0)
-			{
-				//printf("Not contained in any tree..\n");
-				//OctTree_AddAndLog(tree, gameObj);
-			}
-
-			//For each OctTree_Node the game object was in
-			for(unsigned int i = 0; i < log->size; i++)
-			{
-				struct OctTree_NodeStatus* nodeStatus = (struct OctTree_NodeStatus*)DynamicArray_Index(log, i);
-				//get it's current status for this node
-				unsigned char currentStatus = OctTree_Node_DoesObjectCollide(nodeStatus->node, gameObj);
-
-				//If the status has remained the same, continue to the next one
-				if(nodeStatus->collisionStatus == currentStatus) continue;
-
-				//If the current status says that the object is no longer in the node
-				if(currentStatus == 0)
-				{
-
-					printf("Object left node\n");
-
-					//Remove the object from this node
-					OctTree_Node_Remove(nodeStatus->node, gameObj);
-					//Find where it moved
-					struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, gameObj);
-					//If it is still in a node
-					if(containingNode != NULL)
-					{
-						//Add it to that node!
-						OctTree_Node_AddAndLog(tree, containingNode, gameObj);
-					}
-					else
-					{
-						printf("No node found to relocate\n");
-					}
-					//Remove the ith nodeStatus from the log
-					DynamicArray_RemoveAndReposition(log, i);
-				}
-				//Object was fully contained, and now it is not
-				else if(currentStatus == 1)
-				{
-					printf("Object leaving node\n");
-
-					//Update the status
-					nodeStatus->collisionStatus = currentStatus;
-					//Find where it moved
-					struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, gameObj);
-					//If it is even in a node anymore
-					if(containingNode != NULL)
-					{
-						//Add it to that node!
-						OctTree_Node_AddAndLog(tree, containingNode, gameObj);
-					}
-					else
-					{
-						printf("No node found to relocate\n");
-					}
-				}
-				//Object was partially contained and now it is fully contained!
-				else
-				{
-					printf("Object entered node\n");
-
-					//Update the status
-					nodeStatus->collisionStatus = currentStatus;
-				}
-			}
+			OctTree_UpdateObject(tree, gameObj);
 		}
 		//Move to next object in linked list
 		current = current->next;
@@ -486,98 +1570,122 @@ void OctTree_Update(OctTree* tree, LinkedList* gameObjects)
 //	pool: A memory pool of gameobjects in the simulation to update
 void OCtTree_UpdateWithMemoryPool(OctTree* tree, MemoryPool* pool)
 {
-	
-	//while(current != NULL)
-	//{
-	for(unsigned int i = 0; i < pool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
 	{
-		GObject* gameObj = (GObject*)MemoryPool_RequestAddress(pool, i);
+		GObject* gameObj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
 		//Find all gameObjects which have entries in the octtree (& treemap)
 		if(gameObj->collider != NULL)
 		{
-			//Get the treemap entry
-			DynamicArray* log = (DynamicArray*)HashMap_LookUp(tree->map, &gameObj, sizeof(GObject*))->data;
-
-			if(log->size <= 0)
-			{
-				//printf("Not contained in any tree..\n");
-				//OctTree_AddAndLog(tree, gameObj);
-			}
+			OctTree_UpdateObject(tree, gameObj);
+		}
+	}
+}
 
-			//For each OctTree_Node the game object was in
-			for(unsigned int i = 0; i < log->size; i++)
-			{
-				struct OctTree_NodeStatus* nodeStatus = (struct OctTree_NodeStatus*)DynamicArray_Index(log, i);
-				//get it's current status for this node
-				unsigned char currentStatus = OctTree_Node_DoesObjectCollide(nodeStatus->node, gameObj);
+///
+//Updates the position of a single game object within the oct tree
+//Call this for every object whose frame of reference has changed since the tree was last updated.
+//Objects which have not been added to the tree are ignored.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to update
+//	obj: A pointer to the game object which moved
+void OctTree_UpdateObject(OctTree* tree, GObject* obj)
+{
+	//Get the treemap entry
+	struct HashMap_KeyValuePair* pair = HashMap_LookUp(tree->map, &obj, sizeof(GObject*));
+	if(pair == NULL) return;
 
-				//If the status has remained the same, continue to the next one
-				if(nodeStatus->collisionStatus == currentStatus) continue;
+	if(tree->looseness != 0.0f)
+	{
+		//Move the object only if it belongs in a different node
+		struct OctTree_Node* node = (struct OctTree_Node*)pair->data;
+		struct ColliderData_AABB bounds;
+		const struct ColliderData_AABB* objBounds = OctTree_GetObjectAABB(&bounds, obj) ? &bounds : NULL;
+		struct OctTree_Node* destination = OctTree_Node_FindLooseNode(tree, tree->root, objBounds);
+		if(destination != node)
+		{
+			OctTree_Node_RemoveOccupant(tree, node, OctTree_Node_FindOccupant(tree, node, obj));
+			OctTree_Node_AddLoose(tree, destination, obj, objBounds);
+		}
+		return;
+	}
 
-				//If the current status says that the object is no longer in the node
-				if(currentStatus == 0)
-				{
+	DynamicArray* log = (DynamicArray*)pair->data;
 
-					printf("Object left node\n");
+	//For each OctTree_Node the game object was in
+	for(unsigned int i = 0; i < log->size; i++)
+	{
+		struct OctTree_NodeStatus* nodeStatus = DynamicArray_OctTreeNodeStatus_Index(log, i);
+		//get it's current status for this node
+		unsigned char currentStatus = OctTree_Node_DoesObjectCollide(nodeStatus->node, obj);
 
-					//Remove the object from this node
-					OctTree_Node_Remove(nodeStatus->node, gameObj);
-					//Find where it moved
-					struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, gameObj);
-					//If it is still in a node
-					if(containingNode != NULL)
-					{
-						//Add it to that node!
-						OctTree_Node_AddAndLog(tree, containingNode, gameObj);
-					}
-					else
-					{
-						printf("No node found to relocate\n");
-					}
-					//Remove the ith nodeStatus from the log
-					DynamicArray_RemoveAndReposition(log, i);
-				}
-				//Object was fully contained, and now it is not
-				else if(currentStatus == 1)
-				{
-					printf("Object leaving node\n");
-
-					//Update the status
-					nodeStatus->collisionStatus = currentStatus;
-					//Find where it moved
-					struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, gameObj);
-					//If it is even in a node anymore
-					if(containingNode != NULL)
-					{
-						//Add it to that node!
-						OctTree_Node_AddAndLog(tree, containingNode, gameObj);
-					}
-					else
-					{
-						printf("No node found to relocate\n");
-					}
-				}
-				//Object was partially contained and now it is fully contained!
-				else
-				{
-					printf("Object entered node\n");
+		//If the status has remained the same, continue to the next one
+		if(nodeStatus->collisionStatus == currentStatus) continue;
 
-					//Update the status
-					nodeStatus->collisionStatus = currentStatus;
-				}
+		//If the current status says that the object is no longer in the node
+		if(currentStatus == 0)
+		{
+			//Remove the object from this node
+			OctTree_Node_Remove(tree, nodeStatus->node, obj);
+			//Find where it moved
+			struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, obj);
+			//If it is still in a node
+			if(containingNode != NULL)
+			{
+				//Add it to that node!
+				OctTree_Node_AddAndLog(tree, containingNode, obj);
+			}
+			else
+			{
+				printf("No node found to relocate\n");
+			}
+			//Remove the ith nodeStatus from the log, the last entry takes it's place and must be visited next
+			DynamicArray_OctTreeNodeStatus_SwapRemove(log, i);
+			i--;
+		}
+		//Object was fully contained, and now it is not
+		else if(currentStatus == 1)
+		{
+			//Update the status
+			nodeStatus->collisionStatus = currentStatus;
+			//Find where it moved
+			struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, obj);
+			//If it is even in a node anymore
+			if(containingNode != NULL)
+			{
+				//Add it to that node!
+				OctTree_Node_AddAndLog(tree, containingNode, obj);
+			}
+			else
+			{
+				printf("No node found to relocate\n");
 			}
 		}
+		//Object was partially contained and now it is fully contained!
+		else
+		{
+			//Update the status
+			nodeStatus->collisionStatus = currentStatus;
+		}
 	}
 }
 
+
 ///
 //Adds a game object to the oct tree
+//A loose oct tree always records the node holding the object, as OctTree_AddAndLog does.
 //
 //Parameters:
 //	tree: A pointer to The oct tree to add a game object to
 //	obj: A pointer to the game object to add
 void OctTree_Add(OctTree* tree, GObject* obj)
 {
+	if(tree->looseness != 0.0f)
+	{
+		OctTree_AddAndLog(tree, obj);
+		return;
+	}
+
 	//Add the object to the root node
 	OctTree_Node_Add(tree, tree->root, obj);
 }
@@ -590,31 +1698,61 @@ void OctTree_Add(OctTree* tree, GObject* obj)
 //	obj: A pointer to the game object to add
 void OctTree_AddAndLog(OctTree* tree, GObject* obj)
 {
+	if(tree->looseness != 0.0f)
+	{
+		//An object already in the tree only needs to be moved
+		if(HashMap_LookUp(tree->map, &obj, sizeof(GObject*)) != NULL)
+		{
+			OctTree_UpdateObject(tree, obj);
+			return;
+		}
+
+		struct ColliderData_AABB bounds;
+		unsigned char bounded = OctTree_GetObjectAABB(&bounds, obj);
+		OctTree_Node_AddLoose(tree, tree->root, obj, bounded ? &bounds : NULL);
+		return;
+	}
+
 	//Add the object to the root node
 	OctTree_Node_AddAndLog(tree, tree->root, obj);
 }
 
 ///
 //Removes a game object from the oct tree
+//A loose oct tree always forgets the node which held the object, as OctTree_RemoveAndUnLog does.
 //
 //Parameters:
 //	current: A pointer the current node that I'm working with
 //  obj: A pointer to the object to be removed
 void OctTree_Remove(OctTree* tree, GObject* obj)
 {
-	OctTree_Node_Remove(tree->root, obj);
+	if(tree->looseness != 0.0f)
+	{
+		OctTree_RemoveLoose(tree, obj);
+		return;
+	}
+
+	OctTree_Node_Remove(tree, tree->root, obj);
 }
 
 ///
 //Removes a game object from the oct tree and the tree's log
+//Objects which have not been added are ignored.
 //
 //Parameters:
 //	tree: The tree to remove the object from
 //	obj: the object to remove
 void OctTree_RemoveAndUnLog(OctTree* tree, GObject* obj)
 {
+	if(tree->looseness != 0.0f)
+	{
+		OctTree_RemoveLoose(tree, obj);
+		return;
+	}
+
 	//Remove from the treemap
 	DynamicArray* objLog = (DynamicArray*)HashMap_Remove(tree->map, &obj, sizeof(GObject*));
+	if(objLog == NULL) return;
 	
 	//Delete the log
 	DynamicArray_Free(objLog);
@@ -627,9 +1765,10 @@ void OctTree_RemoveAndUnLog(OctTree* tree, GObject* obj)
 //Removes a game object from an oct tree node
 //
 //Parameters:
+//	tree: A pointer to the oct tree the node belongs to
 //	current: A pointer to the node having the object removed
 //	obj: A pointer to the game object being removed
-void OctTree_Node_Remove(struct OctTree_Node* current, GObject* obj)
+void OctTree_Node_Remove(OctTree* tree, struct OctTree_Node* current, GObject* obj)
 {
 	if(current->children != NULL)
 	{
@@ -638,28 +1777,102 @@ void OctTree_Node_Remove(struct OctTree_Node* current, GObject* obj)
 			unsigned char collisionStatus = OctTree_Node_DoesObjectCollide(current->children + i, obj);
 			if(collisionStatus == 1)
 			{
-				OctTree_Node_Remove(current->children+i, obj);
+				OctTree_Node_Remove(tree, current->children+i, obj);
 			}
 			else if(collisionStatus == 2)
 			{
-				OctTree_Node_Remove(current->children+i, obj);
+				OctTree_Node_Remove(tree, current->children+i, obj);
 				break;
 			}
 		}
 	}
 	else
 	{
-		if(current->data->size != 0)
+		unsigned int index = OctTree_Node_FindOccupant(tree, current, obj);
+		if(index < current->count)
 		{
-
-			if(DynamicArray_ContainsWithin(current->data, &obj, current->data->size) == 1)
-			{
-				DynamicArray_RemoveDataAndReposition(current->data, &obj);
-			}
+			OctTree_Node_RemoveOccupant(tree, current, index);
 		}
 	}
 }
 
+///
+//Gets the occupants of a leaf node of an oct tree
+//The number of occupants is the node's count.
+//
+//Parameters:
+//	tree: A pointer to the oct tree the node belongs to
+//	node: A pointer to the leaf node to get the occupants of
+//
+//Returns:
+//	A pointer to the node's first occupant within the tree's occupant array.
+//	This pointer is invalidated by any addition to the tree.
+GObject** OctTree_Node_GetOccupants(OctTree* tree, struct OctTree_Node* node)
+{
+	return DynamicArray_GObjectPtr_Index(tree->occupants, node->offset);
+}
+
+///
+//Finds the occupants of a loose oct tree which may be colliding with one of it's occupants.
+//Only occupants stored after the given occupant in the tree's occupant array are found,
+//so querying every occupant finds each potentially colliding pair exactly once.
+//The tree must be compacted.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to search
+//	index: The index of the occupant to search with in the tree's occupant array
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+void OctTree_GetLooseCandidates(OctTree* tree, unsigned int index, DynamicArray* dest)
+{
+	GObject* obj = DynamicArray_GObjectPtr_Get(tree->occupants, index);
+
+	//Any node may hold an object overlapping an object without finite bounds
+	struct ColliderData_AABB bounds;
+	unsigned char bounded = OctTree_GetObjectAABB(&bounds, obj);
+	OctTree_Node_GetLooseCandidates(tree, tree->root, bounded ? &bounds : NULL, index, dest);
+}
+
+///
+//Finds the occupants of an oct tree held by nodes whose bounds overlap an axis aligned bounding box.
+//The bounds of each occupant found are not tested, only those of the nodes holding them.
+//Each occupant is appended once, even if a classic oct tree holds it in several leaves.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	bounds: A pointer to the world space bounds to search within
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+void OctTree_QueryAABB(OctTree* tree, const struct ColliderData_AABB* bounds, DynamicArray* dest)
+{
+	unsigned int first = dest->size;
+	OctTree_Node_QueryAABB(tree, tree->root, bounds, dest);
+	if(tree->looseness == 0.0f) OctTree_RemoveDuplicates(dest, first);
+}
+
+///
+//Finds the occupants of an oct tree held by nodes whose bounds a ray crosses.
+//The bounds of each occupant found are not tested, only those of the nodes holding them.
+//Each occupant is appended once, even if a classic oct tree holds it in several leaves.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+void OctTree_QueryRay(OctTree* tree, struct ColliderData_Ray* worldRay, DynamicArray* dest)
+{
+	struct OctTree_SlabRay ray;
+	for(int i = 0; i < 3; i++)
+	{
+		float direction = worldRay->direction->components[i];
+		ray.origin[i] = worldRay->position->components[i];
+		ray.parallel[i] = direction > -FLT_EPSILON && direction < FLT_EPSILON;
+		ray.inverseDirection[i] = ray.parallel[i] ? 0.0f : 1.0f / direction;
+	}
+
+	unsigned int first = dest->size;
+	OctTree_Node_QueryRay(tree, tree->root, &ray, dest);
+	if(tree->looseness == 0.0f) OctTree_RemoveDuplicates(dest, first);
+}
+
 ///
 //Adds a game object to a node of the oct tree
 //
@@ -695,13 +1908,13 @@ void OctTree_Node_Add(OctTree* tree, struct OctTree_Node* node, GObject* obj)
 	else
 	{
 		//Can we hold another object? or are we too deep to subdivide?
-		if(node->data->size <= tree->maxOccupancy || node->depth >= tree->maxDepth)
+		if(node->count <= tree->maxOccupancy || node->depth >= tree->maxDepth)
 		{
 			//Make sure we aren't already holding a pointer to the object...
-			if(DynamicArray_ContainsWithin(node->data, &obj, node->data->size) == 0)
+			if(OctTree_Node_FindOccupant(tree, node, obj) == node->count)
 			{
 				//Add the object!
-				DynamicArray_Append(node->data, &obj);
+				OctTree_Node_InsertOccupant(tree, node, obj);
 			}
 		}
 		//Else, we are out of room and can subdivide!
@@ -748,13 +1961,14 @@ void OctTree_Node_AddAndLog(OctTree* tree, struct OctTree_Node* node, GObject* o
 	else
 	{
 		//Can we hold another object? or are we too deep to subdivide?
-		if(node->data->size <= tree->maxOccupancy || node->depth >= tree->maxDepth)
+		if(node->count <= tree->maxOccupancy || node->depth >= tree->maxDepth)
 		{
 			//Make sure we aren't already holding a pointer to the object...
-			if(DynamicArray_ContainsWithin(node->data, &obj, node->data->size) == 0)
+			if(OctTree_Node_FindOccupant(tree, node, obj) == node->count)
 			{
 				//Add the object!
-				DynamicArray_Append(node->data, &obj);
+				OctTree_Node_InsertOccupant(tree, node, obj);
+
 
 				//Find the entry for this object in the treemap
 				DynamicArray* log = NULL;
@@ -794,7 +2008,7 @@ void OctTree_Node_AddAndLog(OctTree* tree, struct OctTree_Node* node, GObject* o
 				struct OctTree_NodeStatus* entry = NULL;
 				for(unsigned int i = 0; i < log->size; i++)
 				{
-					struct OctTree_NodeStatus* mightBeTheEntry = (struct OctTree_NodeStatus*)DynamicArray_Index(log, i);
+					struct OctTree_NodeStatus* mightBeTheEntry = DynamicArray_OctTreeNodeStatus_Index(log, i);
 					//If we find it
 					if(mightBeTheEntry->node == node)
 					{
@@ -849,20 +2063,10 @@ void OctTree_Node_AddAndLog(OctTree* tree, struct OctTree_Node* node, GObject* o
 //	node: A pointer to the node being subdivided
 static void OctTree_Node_Subdivide(OctTree* tree, struct OctTree_Node* node)
 {
+	//Replace this node with it's children, taking it's occupants
+	unsigned int numOccupants;
+	GObject** occupants = OctTree_Node_Split(tree, node, &numOccupants);
 
-	//Allocate this nodes children
-	node->children = OctTree_Node_AllocateChildren();
-
-	//Initialize this nodes children
-	OctTree_Node_InitializeChildren(tree, node);
-
-	unsigned int numOccupants = node->data->size;
-	//Create a temporary list of occupants
-	GObject** occupants = (GObject**)malloc(sizeof(GObject**) * numOccupants);
-	//Copy occupants from node into temporary list
-	memcpy(occupants, node->data->data, sizeof(GObject**) * numOccupants);
-	//Clear the node's data
-	DynamicArray_Clear(node->data);
 	GObject* current;
 	//re-add all contents to the node
 	for(unsigned int i = 0; i < numOccupants; i++)
@@ -887,21 +2091,9 @@ static void OctTree_Node_Subdivide(OctTree* tree, struct OctTree_Node* node)
 //	node: A pointer to the node being subdivided
 static void OctTree_Node_SubdivideAndLog(OctTree*tree, struct OctTree_Node* node)
 {
-	//Allocate this nodes children
-	node->children = OctTree_Node_AllocateChildren();
-
-	//Initialize this nodes children
-	OctTree_Node_InitializeChildren(tree, node);
-
-	unsigned int numOccupants = node->data->size;
-	//Create a temporary list of occupants
-	GObject** occupants = (GObject**)malloc(sizeof(GObject**) * numOccupants);
-
-	//Copy occupants from node into temporary list
-	memcpy(occupants, node->data->data, sizeof(GObject**) * numOccupants);
-
-	//Clear the node's data
-	DynamicArray_Clear(node->data);
+	//Replace this node with it's children, taking it's occupants
+	unsigned int numOccupants;
+	GObject** occupants = OctTree_Node_Split(tree, node, &numOccupants);
 
 	//re-add all contents to the node
 	GObject* current;
@@ -915,10 +2107,10 @@ static void OctTree_Node_SubdivideAndLog(OctTree*tree, struct OctTree_Node* node
 		//Find parent node in the log
 		for(unsigned int j = 0; j < log->size; j++)
 		{
-			if(((struct OctTree_NodeStatus*)DynamicArray_Index(log, j))->node == node)
+			if(DynamicArray_OctTreeNodeStatus_Index(log, j)->node == node)
 			{
 				//And remove it
-				DynamicArray_RemoveAndReposition(log, j);
+				DynamicArray_OctTreeNodeStatus_SwapRemove(log, j);
 				break;
 			}
 		}
@@ -1228,6 +2420,7 @@ static unsigned char OctTree_Node_DoesRayCollide(struct OctTree_Node* node, stru
 	return 1;
 }
 
+
 ///
 //Definition:
 //	Recurses through all Nodes and Children of an octree
@@ -1248,7 +2441,7 @@ void OctTree_Node_CleanAll(OctTree* tree, struct OctTree_Node* node)
 		for(int i = 0; i < 8; i++)
 		{
 			// If they have children, current node is a 'Grandfather'
-			if (node->children[i].children == NULL)
+			if (node->children[i].children != NULL)
 			{
 				isGrandfather = 1;
 			}
@@ -1271,7 +2464,7 @@ void OctTree_Node_CleanAll(OctTree* tree, struct OctTree_Node* node)
 			unsigned char hasOccupants = 0;
 			for(int i = 0; i < 8; i++)
 			{
-				if(node->children[i].data->size == 0)
+				if(node->children[i].count != 0)
 				{
 					// if so, se hasOccupants to true
 					hasOccupants = 1;
@@ -1281,13 +2474,17 @@ void OctTree_Node_CleanAll(OctTree* tree, struct OctTree_Node* node)
 			// If the current node has no occupants
 			if(hasOccupants == 0)
 			{
-				// Clean out all the children
-				for(int i = 0; i < 8; i++)
+				// Clean out all the children, this node takes their place in the leaves
+				// Inner nodes of a loose oct tree keep their own occupants
+				node->children = NULL;
+				if(tree->looseness == 0.0f)
 				{
-					OctTree_Node_Free(tree, node->children+i);
+					node->offset = 0;
+					node->count = 0;
+					node->capacity = 0;
 				}
-				free(node->children);
-				node->children = 0;
+
+				tree->needsCompaction = 1;
 			}
 		}
 	}
@@ -1295,6 +2492,7 @@ void OctTree_Node_CleanAll(OctTree* tree, struct OctTree_Node* node)
 
 
 
+
 ///
 //Searches up from a leaf node to find the lowest node which fully contains this object
 //
@@ -5,16 +5,32 @@
 #include "DynamicArray.h"
 #include "HashMap.h"
 #include "MemoryPool.h"
+#include "WorkerPool.h"
+
+//Deepest level an oct tree may subdivide to.
+//Every node down to the tree's max depth is allocated up front, (8^(maxDepth+1) - 1) / 7 nodes in total.
+#define OctTree_MAX_DEPTH 6
+//Looseness used when a loose oct tree is requested with a looseness which would not let objects leave the root
+#define OctTree_DEFAULT_LOOSENESS 2.0f
 
 struct OctTree_Node
 {
 	//Pointer to the parent of this node
 	struct OctTree_Node* parent;
 	//Pointer to array of children of this node
+	//NULL unless this node has been subdivided
 	struct OctTree_Node* children;
 
-	//The data contained in this node
-	DynamicArray* data;
+	//The occupants of a leaf are the count entries of the tree's occupant array starting at offset.
+	//The leaf owns capacity entries there, a full leaf moves it's occupants to the end of the array.
+	//Inner nodes of a loose oct tree hold occupants the same way.
+	unsigned int offset;
+	unsigned int count;
+	unsigned int capacity;
+
+	//Morton code of this node among the nodes of it's depth.
+	//Each level appends the 3 bit index of the child, (x | y << 1 | z << 2)
+	unsigned int mortonCode;
 
 	//The depth of this node from the root of the tree
 	//The root has a depth of 0.
@@ -32,17 +48,44 @@ struct OctTree_NodeStatus
 	unsigned char collisionStatus;
 };
 
+//Typed accessors for node occupant lists, leaf lists and object logs
+DYNARRAY_DECLARE(GObjectPtr, GObject*);
+DYNARRAY_DECLARE(OctTreeNodePtr, struct OctTree_Node*);
+DYNARRAY_DECLARE(OctTreeNodeStatus, struct OctTree_NodeStatus);
+
 typedef struct OctTree
 {
 	//Pointer to the root of the tree
 	struct OctTree_Node* root;
 
+	//Pool of every node the tree can contain, stored level by level.
+	//Within a level nodes are stored in order of their morton code so the 8 children of a node are contiguous.
+	struct OctTree_Node* nodes;
+	unsigned int numNodes;
+
+	//Leaves of the tree (struct OctTree_Node*) in morton order as of the last compaction.
+	//Inner nodes of a loose oct tree which hold occupants are listed too, each before it's children.
+	DynamicArray* leaves;
+	//Occupants of all leaves (GObject*) grouped by leaf in the same order as the leaves.
+	//Entries past a leaf's count, up to it's capacity, are unused.
+	DynamicArray* occupants;
+	//Storage swapped with the occupants when compacting
+	DynamicArray* compactOccupants;
+	//Set when leaves have been split, merged or moved since the tree was last compacted.
+	//The leaves array is out of date and occupants are out of order until OctTree_Compact is called.
+	unsigned char needsCompaction;
+
 	//Attributes of the tree
 	unsigned int maxDepth;		//How many subdivisions can exist
 	unsigned int maxOccupancy;	//How many occupants can an octtree have before trying to subdivide
 								//This number will be exceeded if maxDepth is reached.
+	float looseness;		//0 for a classic oct tree, where objects are stored in every leaf they overlap.
+					//Otherwise the factor each node's bounds are grown by about it's center, making a loose oct tree
+					//where every object is stored in exactly one node chosen from it's center and size.
 
 	//Hashmap used to update tree
+	//Maps each object to it's log (DynamicArray of struct OctTree_NodeStatus),
+	//or in a loose oct tree to the struct OctTree_Node holding it.
 	HashMap* map;
 } OctTree;
 
@@ -60,6 +103,7 @@ OctTree* OctTree_Allocate();
 
 ///
 //Initializes an oct tree and creates a root node with the given dimensions
+//The tree's maxDepth, maxOccupancy and looseness may be configured between allocating and initializing it.
 //
 //Parameters:
 //	tree: A pointer to the oct tree to initialize
@@ -79,6 +123,41 @@ void OctTree_Initialize(OctTree* tree, float leftBound, float rightBound, float
 //	tree: A pointer to the octtree to free
 void OctTree_Free(OctTree* tree);
 
+///
+//Gets a node of an oct tree by it's depth and morton code
+//
+//Parameters:
+//	tree: A pointer to the oct tree to get the node from
+//	depth: The depth of the node, no greater than the tree's max depth
+//	mortonCode: The morton code of the node among the nodes of that depth
+//
+//Returns:
+//	A pointer to the node in the tree's node pool
+struct OctTree_Node* OctTree_GetNode(OctTree* tree, unsigned int depth, unsigned int mortonCode);
+
+///
+//Brings the leaves of an oct tree up to date and packs the occupants of each leaf
+//contiguously in morton order. Does nothing if the tree has not changed shape since it was last compacted.
+//Must be called before walking the tree's leaves or occupants.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to compact
+void OctTree_Compact(OctTree* tree);
+
+///
+//Rebuilds an oct tree from scratch with every game object in a memory pool which has a collider and is not excluded.
+//Objects are sorted by the morton code of the deepest node containing their bounds,
+//then leaves are emitted top down honoring the tree's max occupancy and max depth.
+//Logs of all objects are rebuilt, so incremental updates may continue afterwards.
+//Cheaper than OCtTree_UpdateWithMemoryPool when a large fraction of objects have moved.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to rebuild
+//	pool: A memory pool of gameobjects in the simulation
+//	excluded: A pointer to a hash map keyed by the objects to leave out of the tree, or NULL
+//	workers: A pointer to a worker pool to compute and sort the keys with, or NULL
+void OctTree_RebuildWithMemoryPool(OctTree* tree, MemoryPool* pool, HashMap* excluded, WorkerPool* workers);
+
 ///
 //Updates the position of all gameobjects within the oct tree
 //
@@ -95,8 +174,20 @@ void OctTree_Update(OctTree* tree, LinkedList* gameObjects);
 //	pool: A memory pool of gameobjects in the simulation to update
 void OCtTree_UpdateWithMemoryPool(OctTree* tree, MemoryPool* pool);
 
+///
+//Updates the position of a single game object within the oct tree
+//Call this for every object whose frame of reference has changed since the tree was last updated.
+//Objects which have not been added to the tree are ignored.
+//In a loose oct tree the object is only moved if it now belongs in a different node.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to update
+//	obj: A pointer to the game object which moved
+void OctTree_UpdateObject(OctTree* tree, GObject* obj);
+
 ///
 //Adds a game object to the oct tree
+//A loose oct tree always records the node holding the object, as OctTree_AddAndLog does.
 //
 //Parameters:
 //	tree: A pointer to The oct tree to add a game object to
@@ -113,6 +204,7 @@ void OctTree_AddAndLog(OctTree* tree, GObject* obj);
 
 ///
 //Removes a game object from the oct tree
+//A loose oct tree always forgets the node which held the object, as OctTree_RemoveAndUnLog does.
 //
 //Parameters:
 //	tree: A pointer the tree that I'm working with
@@ -121,6 +213,7 @@ void OctTree_Remove(OctTree* tree, GObject* obj);
 
 ///
 //Removes a game object from the oct tree and the tree's log
+//Objects which have not been added are ignored.
 //
 //Parameters:
 //	tree: The tree to remove the object from
@@ -150,9 +243,23 @@ void OctTree_Node_AddAndLog(OctTree* tree, struct OctTree_Node* node, GObject* o
 //Removes a game object from an oct tree node
 //
 //Parameters:
+//	tree: A pointer to the oct tree the node belongs to
 //	current: A pointer to the node having the object removed
 //	obj: A pointer to the game object being removed
-void OctTree_Node_Remove(struct OctTree_Node* current, GObject* obj);
+void OctTree_Node_Remove(OctTree* tree, struct OctTree_Node* current, GObject* obj);
+
+///
+//Gets the occupants of a leaf node of an oct tree
+//The number of occupants is the node's count.
+//
+//Parameters:
+//	tree: A pointer to the oct tree the node belongs to
+//	node: A pointer to the leaf node to get the occupants of
+//
+//Returns:
+//	A pointer to the node's first occupant within the tree's occupant array.
+//	This pointer is invalidated by any addition to the tree.
+GObject** OctTree_Node_GetOccupants(OctTree* tree, struct OctTree_Node* node);
 
 ///
 //Determines if and how a game object is colliding with an oct tree node.
@@ -167,6 +274,40 @@ void OctTree_Node_Remove(struct OctTree_Node* current, GObject* obj);
 //	2 if the object is completely contained within the octent
 unsigned char OctTree_Node_DoesObjectCollide(struct OctTree_Node* node, GObject* obj);
 
+///
+//Finds the occupants of a loose oct tree which may be colliding with one of it's occupants.
+//Only occupants stored after the given occupant in the tree's occupant array are found,
+//so querying every occupant finds each potentially colliding pair exactly once.
+//The tree must be compacted.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to search
+//	index: The index of the occupant to search with in the tree's occupant array
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+void OctTree_GetLooseCandidates(OctTree* tree, unsigned int index, DynamicArray* dest);
+
+///
+//Finds the occupants of an oct tree held by nodes whose bounds overlap an axis aligned bounding box.
+//The bounds of each occupant found are not tested, only those of the nodes holding them.
+//Each occupant is appended once, even if a classic oct tree holds it in several leaves.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	bounds: A pointer to the world space bounds to search within
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+void OctTree_QueryAABB(OctTree* tree, const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Finds the occupants of an oct tree held by nodes whose bounds a ray crosses.
+//The bounds of each occupant found are not tested, only those of the nodes holding them.
+//Each occupant is appended once, even if a classic oct tree holds it in several leaves.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to search
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to a dynamic array of GObject* to append the occupants found to
+void OctTree_QueryRay(OctTree* tree, struct ColliderData_Ray* worldRay, DynamicArray* dest);
+
 
 
 ///
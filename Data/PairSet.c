@@ -0,0 +1,210 @@
+#include "PairSet.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Hash.h"
+
+///
+//Static Declarations
+
+///
+//Gets the slot a pair's probe sequence starts at
+//
+//Parameters:
+//	set: A pointer to the pair set
+//	first: The lower addressed member of the pair
+//	second: The higher addressed member of the pair
+//
+//Returns:
+//	The index of the first slot to probe
+static unsigned int PairSet_GetHome(const PairSet* set, const void* first, const void* second);
+
+///
+//Doubles the number of slots in a pair set, reinserting the pairs inserted since the last clear
+//
+//Parameters:
+//	set: A pointer to the pair set to grow
+static void PairSet_Grow(PairSet* set);
+
+///
+//Implementations
+
+///
+//Allocates memory for a pair set
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized pair set
+PairSet* PairSet_Allocate(void)
+{
+	PairSet* set = (PairSet*)malloc(sizeof(PairSet));
+	return set;
+}
+
+///
+//Initializes an empty pair set with PairSet_INITIAL_CAPACITY slots
+//
+//Parameters:
+//	set: A pointer to the pair set to initialize
+void PairSet_Initialize(PairSet* set)
+{
+	set->capacity = PairSet_INITIAL_CAPACITY;
+	set->slots = (struct PairSet_Slot*)calloc(set->capacity, sizeof(struct PairSet_Slot));
+	set->size = 0;
+	//Slots start with a stamp of 0, so they are empty
+	set->stamp = 1;
+}
+
+///
+//Frees a pair set
+//
+//Parameters:
+//	set: A pointer to the pair set to free
+void PairSet_Free(PairSet* set)
+{
+	free(set->slots);
+	free(set);
+}
+
+///
+//Removes every pair from a pair set without touching it's slots
+//
+//Parameters:
+//	set: A pointer to the pair set to clear
+void PairSet_Clear(PairSet* set)
+{
+	set->size = 0;
+	set->stamp++;
+
+	//Once the stamp wraps, slots stamped long ago would appear occupied again
+	if(set->stamp == 0)
+	{
+		memset(set->slots, 0, sizeof(struct PairSet_Slot) * set->capacity);
+		set->stamp = 1;
+	}
+}
+
+///
+//Inserts a pair into a pair set unless it is already present
+//The pair (a, b) is the same pair as (b, a).
+//
+//Parameters:
+//	set: A pointer to the pair set to insert into
+//	a: The first member of the pair
+//	b: The second member of the pair
+//
+//Returns:
+//	1 if the pair was inserted, 0 if it was already in the set
+unsigned char PairSet_Insert(PairSet* set, const void* a, const void* b)
+{
+	const void* first = (uintptr_t)a < (uintptr_t)b ? a : b;
+	const void* second = (uintptr_t)a < (uintptr_t)b ? b : a;
+
+	if((set->size + 1) * PairSet_MAX_LOAD_DENOMINATOR > set->capacity * PairSet_MAX_LOAD_NUMERATOR)
+	{
+		PairSet_Grow(set);
+	}
+
+	unsigned int mask = set->capacity - 1;
+	for(unsigned int index = PairSet_GetHome(set, first, second); ; index = (index + 1) & mask)
+	{
+		struct PairSet_Slot* slot = set->slots + index;
+		if(slot->stamp != set->stamp)
+		{
+			slot->first = first;
+			slot->second = second;
+			slot->stamp = set->stamp;
+			slot->index = set->size;
+			set->size++;
+			return 1;
+		}
+		if(slot->first == first && slot->second == second)
+		{
+			return 0;
+		}
+	}
+}
+
+///
+//Finds the order a pair was inserted into a pair set in since the last clear
+//Only reads the set, so any number of threads may search a set which no thread is inserting into.
+//
+//Parameters:
+//	set: A pointer to the pair set to search
+//	a: The first member of the pair
+//	b: The second member of the pair
+//
+//Returns:
+//	The number of pairs inserted before the pair since the last clear, or PairSet_NOT_FOUND if it is not in the set
+unsigned int PairSet_Find(const PairSet* set, const void* a, const void* b)
+{
+	const void* first = (uintptr_t)a < (uintptr_t)b ? a : b;
+	const void* second = (uintptr_t)a < (uintptr_t)b ? b : a;
+
+	//The load factor keeps an empty slot in every probe sequence
+	unsigned int mask = set->capacity - 1;
+	for(unsigned int index = PairSet_GetHome(set, first, second); ; index = (index + 1) & mask)
+	{
+		const struct PairSet_Slot* slot = set->slots + index;
+		if(slot->stamp != set->stamp)
+		{
+			return PairSet_NOT_FOUND;
+		}
+		if(slot->first == first && slot->second == second)
+		{
+			return slot->index;
+		}
+	}
+}
+
+///
+//Gets the slot a pair's probe sequence starts at
+//
+//Parameters:
+//	set: A pointer to the pair set
+//	first: The lower addressed member of the pair
+//	second: The higher addressed member of the pair
+//
+//Returns:
+//	The index of the first slot to probe
+static unsigned int PairSet_GetHome(const PairSet* set, const void* first, const void* second)
+{
+	//Fold both addresses into one key before mixing, multiplying the first keeps (a, b) and (b, a) apart
+	uint64_t key = (uint64_t)(uintptr_t)first * 0x9E3779B97F4A7C15ULL + (uint64_t)(uintptr_t)second;
+	return (unsigned int)Hash_MultiplyShift(&key, sizeof(key)) & (set->capacity - 1);
+}
+
+///
+//Doubles the number of slots in a pair set, reinserting the pairs inserted since the last clear
+//
+//Parameters:
+//	set: A pointer to the pair set to grow
+static void PairSet_Grow(PairSet* set)
+{
+	struct PairSet_Slot* oldSlots = set->slots;
+	unsigned int oldCapacity = set->capacity;
+	unsigned int stamp = set->stamp;
+
+	set->capacity = oldCapacity * 2;
+	set->slots = (struct PairSet_Slot*)calloc(set->capacity, sizeof(struct PairSet_Slot));
+	set->size = 0;
+	set->stamp = 1;
+
+	unsigned int mask = set->capacity - 1;
+	for(unsigned int i = 0; i < oldCapacity; i++)
+	{
+		if(oldSlots[i].stamp != stamp) continue;
+
+		unsigned int index = PairSet_GetHome(set, oldSlots[i].first, oldSlots[i].second);
+		while(set->slots[index].stamp == set->stamp)
+		{
+			index = (index + 1) & mask;
+		}
+		set->slots[index] = oldSlots[i];
+		set->slots[index].stamp = set->stamp;
+		set->size++;
+	}
+
+	free(oldSlots);
+}
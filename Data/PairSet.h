@@ -0,0 +1,88 @@
+#ifndef PAIRSET_H
+#define PAIRSET_H
+
+//Initial number of slots in a pair set, always a power of two
+#define PairSet_INITIAL_CAPACITY 256
+//Slots are doubled once occupied slots exceed this fraction of the capacity
+#define PairSet_MAX_LOAD_NUMERATOR 3
+#define PairSet_MAX_LOAD_DENOMINATOR 4
+//Index returned by PairSet_Find for pairs which are not in the set
+#define PairSet_NOT_FOUND 0xFFFFFFFFu
+
+///
+//A slot of a pair set
+//The slot is empty unless it's stamp matches the set's stamp.
+struct PairSet_Slot
+{
+	const void* first;	//The lower addressed member of the pair
+	const void* second;	//The higher addressed member of the pair
+	unsigned int stamp;	//Stamp of the set when the pair was inserted
+	unsigned int index;	//Number of pairs inserted before this pair since the last clear
+};
+
+///
+//An unordered set of unordered pairs of pointers, found by open addressing.
+//Clearing a pair set only changes it's stamp, so a set which is cleared every frame costs nothing to reset.
+typedef struct PairSet
+{
+	struct PairSet_Slot* slots;	//Slots of the set, capacity is always a power of two
+	unsigned int capacity;		//Number of slots
+	unsigned int size;		//Number of pairs inserted since the last clear
+	unsigned int stamp;		//Stamp marking the slots occupied since the last clear
+} PairSet;
+
+///
+//Allocates memory for a pair set
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized pair set
+PairSet* PairSet_Allocate(void);
+
+///
+//Initializes an empty pair set with PairSet_INITIAL_CAPACITY slots
+//
+//Parameters:
+//	set: A pointer to the pair set to initialize
+void PairSet_Initialize(PairSet* set);
+
+///
+//Frees a pair set
+//
+//Parameters:
+//	set: A pointer to the pair set to free
+void PairSet_Free(PairSet* set);
+
+///
+//Removes every pair from a pair set without touching it's slots
+//
+//Parameters:
+//	set: A pointer to the pair set to clear
+void PairSet_Clear(PairSet* set);
+
+///
+//Inserts a pair into a pair set unless it is already present
+//The pair (a, b) is the same pair as (b, a).
+//
+//Parameters:
+//	set: A pointer to the pair set to insert into
+//	a: The first member of the pair
+//	b: The second member of the pair
+//
+//Returns:
+//	1 if the pair was inserted, 0 if it was already in the set
+unsigned char PairSet_Insert(PairSet* set, const void* a, const void* b);
+
+///
+//Finds the order a pair was inserted into a pair set in since the last clear
+//Only reads the set, so any number of threads may search a set which no thread is inserting into.
+//
+//Parameters:
+//	set: A pointer to the pair set to search
+//	a: The first member of the pair
+//	b: The second member of the pair
+//
+//Returns:
+//	The number of pairs inserted before the pair since the last clear, or PairSet_NOT_FOUND if it is not in the set
+unsigned int PairSet_Find(const PairSet* set, const void* a, const void* b);
+
+#endif
@@ -0,0 +1,165 @@
+#include "RadixSort.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RadixSort_NUM_BUCKETS (1 << RadixSort_DIGIT_BITS)
+
+///
+//The state of one pass of a radix sort shared by all of it's tasks
+struct RadixSort_Pass
+{
+	const uint64_t* source;		//Values being sorted from
+	uint64_t* destination;		//Values being sorted into
+	unsigned int numValues;		//Number of values
+	unsigned int shift;		//Position of the digit being sorted by
+	unsigned int mask;		//Mask of the digit being sorted by, narrower on the last pass if the key ends mid digit
+	unsigned int numChunks;		//Number of contiguous chunks the values are split into, one per task
+	unsigned int* counts;		//numChunks * RadixSort_NUM_BUCKETS counts, then offsets, of each digit in each chunk
+};
+
+///
+//Static Declarations
+
+///
+//Gets the range of values belonging to a chunk of a pass
+//
+//Parameters:
+//	pass: A pointer to the pass
+//	chunk: The index of the chunk
+//	begin: A pointer to the destination of the first value of the chunk
+//	end: A pointer to the destination of one past the last value of the chunk
+static void RadixSort_GetChunk(const struct RadixSort_Pass* pass, unsigned int chunk, unsigned int* begin, unsigned int* end);
+
+///
+//Counts the occurrences of each digit in one chunk of a pass
+//
+//Parameters:
+//	data: A pointer to the struct RadixSort_Pass
+//	chunk: The index of the chunk to count
+static void RadixSort_CountTask(void* data, unsigned int chunk);
+
+///
+//Moves the values of one chunk of a pass to their sorted positions
+//
+//Parameters:
+//	data: A pointer to the struct RadixSort_Pass
+//	chunk: The index of the chunk to move
+static void RadixSort_ScatterTask(void* data, unsigned int chunk);
+
+///
+//Implementations
+
+///
+//Sorts an array of 64 bit values by a range of their bits with a stable least significant digit radix sort.
+//Bits outside of the range are carried along, so a payload such as an index can be packed below the key.
+//Each pass is split across a worker pool when there are enough values.
+//
+//Parameters:
+//	values: The array of values to sort, holds the sorted values when this returns
+//	scratch: An array of at least numValues values to use as temporary storage
+//	numValues: The number of values to sort
+//	firstBit: The lowest bit of the key to sort by
+//	numBits: The number of bits in the key to sort by
+//	workers: A pointer to the worker pool to sort with, or NULL to sort on the calling thread
+void RadixSort_SortUInt64(uint64_t* values, uint64_t* scratch, unsigned int numValues, unsigned int firstBit, unsigned int numBits, WorkerPool* workers)
+{
+	struct RadixSort_Pass pass;
+	pass.numValues = numValues;
+	pass.numChunks = numValues >= RadixSort_PARALLEL_THRESHOLD ? WorkerPool_GetConcurrency(workers) : 1;
+	pass.counts = (unsigned int*)malloc(sizeof(unsigned int) * RadixSort_NUM_BUCKETS * pass.numChunks);
+
+	uint64_t* source = values;
+	uint64_t* destination = scratch;
+	for(unsigned int bit = 0; bit < numBits; bit += RadixSort_DIGIT_BITS)
+	{
+		pass.source = source;
+		pass.destination = destination;
+		pass.shift = firstBit + bit;
+		pass.mask = numBits - bit < RadixSort_DIGIT_BITS ? (1u << (numBits - bit)) - 1 : RadixSort_NUM_BUCKETS - 1;
+
+		WorkerPool_Run(workers, RadixSort_CountTask, &pass, pass.numChunks);
+
+		//Turn counts into offsets, ordered by digit and then by chunk to keep the sort stable
+		unsigned int offset = 0;
+		for(unsigned int digit = 0; digit < RadixSort_NUM_BUCKETS; digit++)
+		{
+			for(unsigned int chunk = 0; chunk < pass.numChunks; chunk++)
+			{
+				unsigned int* count = pass.counts + (chunk * RadixSort_NUM_BUCKETS) + digit;
+				unsigned int numWithDigit = *count;
+				*count = offset;
+				offset += numWithDigit;
+			}
+		}
+
+		WorkerPool_Run(workers, RadixSort_ScatterTask, &pass, pass.numChunks);
+
+		//The destination of this pass is the source of the next
+		uint64_t* swap = source;
+		source = destination;
+		destination = swap;
+	}
+
+	//After an odd number of passes the sorted values are in the scratch array
+	if(source != values)
+	{
+		memcpy(values, source, sizeof(uint64_t) * numValues);
+	}
+
+	free(pass.counts);
+}
+
+///
+//Gets the range of values belonging to a chunk of a pass
+//
+//Parameters:
+//	pass: A pointer to the pass
+//	chunk: The index of the chunk
+//	begin: A pointer to the destination of the first value of the chunk
+//	end: A pointer to the destination of one past the last value of the chunk
+static void RadixSort_GetChunk(const struct RadixSort_Pass* pass, unsigned int chunk, unsigned int* begin, unsigned int* end)
+{
+	*begin = (unsigned int)(((uint64_t)pass->numValues * chunk) / pass->numChunks);
+	*end = (unsigned int)(((uint64_t)pass->numValues * (chunk + 1)) / pass->numChunks);
+}
+
+///
+//Counts the occurrences of each digit in one chunk of a pass
+//
+//Parameters:
+//	data: A pointer to the struct RadixSort_Pass
+//	chunk: The index of the chunk to count
+static void RadixSort_CountTask(void* data, unsigned int chunk)
+{
+	struct RadixSort_Pass* pass = (struct RadixSort_Pass*)data;
+	unsigned int* counts = pass->counts + (chunk * RadixSort_NUM_BUCKETS);
+	memset(counts, 0, sizeof(unsigned int) * RadixSort_NUM_BUCKETS);
+
+	unsigned int begin, end;
+	RadixSort_GetChunk(pass, chunk, &begin, &end);
+	for(unsigned int i = begin; i < end; i++)
+	{
+		counts[(pass->source[i] >> pass->shift) & pass->mask]++;
+	}
+}
+
+///
+//Moves the values of one chunk of a pass to their sorted positions
+//
+//Parameters:
+//	data: A pointer to the struct RadixSort_Pass
+//	chunk: The index of the chunk to move
+static void RadixSort_ScatterTask(void* data, unsigned int chunk)
+{
+	struct RadixSort_Pass* pass = (struct RadixSort_Pass*)data;
+	unsigned int* offsets = pass->counts + (chunk * RadixSort_NUM_BUCKETS);
+
+	unsigned int begin, end;
+	RadixSort_GetChunk(pass, chunk, &begin, &end);
+	for(unsigned int i = begin; i < end; i++)
+	{
+		uint64_t value = pass->source[i];
+		pass->destination[offsets[(value >> pass->shift) & pass->mask]++] = value;
+	}
+}
@@ -0,0 +1,27 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <stdint.h>
+
+#include "WorkerPool.h"
+
+//Number of bits sorted per pass
+#define RadixSort_DIGIT_BITS 8
+//Smallest number of values worth splitting across a worker pool
+#define RadixSort_PARALLEL_THRESHOLD 16384
+
+///
+//Sorts an array of 64 bit values by a range of their bits with a stable least significant digit radix sort.
+//Bits outside of the range are carried along, so a payload such as an index can be packed below the key.
+//Each pass is split across a worker pool when there are enough values.
+//
+//Parameters:
+//	values: The array of values to sort, holds the sorted values when this returns
+//	scratch: An array of at least numValues values to use as temporary storage
+//	numValues: The number of values to sort
+//	firstBit: The lowest bit of the key to sort by
+//	numBits: The number of bits in the key to sort by
+//	workers: A pointer to the worker pool to sort with, or NULL to sort on the calling thread
+void RadixSort_SortUInt64(uint64_t* values, uint64_t* scratch, unsigned int numValues, unsigned int firstBit, unsigned int numBits, WorkerPool* workers);
+
+#endif
@@ -0,0 +1,952 @@
+#include "SpatialHash.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <float.h>
+
+///
+//A run of tasks over the objects or buckets of a spatial hash
+struct SpatialHash_Run
+{
+	SpatialHash* grid;
+	unsigned int numTasks;
+};
+
+///
+//A ray prepared for the slab tests of a ray query
+struct SpatialHash_SlabRay
+{
+	float origin[3];
+	float inverseDirection[3];	//Reciprocal of each component of the direction, 0 where the ray is parallel to a slab
+	unsigned char parallel[3];	//1 where the ray is parallel to a slab
+};
+
+///
+//Static Declarations
+
+///
+//Gets the coordinate of the cell holding a position along one axis
+//
+//Parameters:
+//	position: The position along the axis
+//	cellSize: The edge length of the cells
+//
+//Returns:
+//	The coordinate of the cell, clamped to SpatialHash_MAX_CELL_COORDINATE
+static int SpatialHash_GetCell(float position, float cellSize);
+
+///
+//Gets the bucket a cell is hashed to
+//
+//Parameters:
+//	cell: The coordinates of the cell
+//	numBuckets: The number of buckets, a power of two
+//
+//Returns:
+//	The index of the bucket, from 0 to numBuckets - 1
+static unsigned int SpatialHash_GetBucket(const int cell[3], unsigned int numBuckets);
+
+///
+//Finds the median of an array of values, reordering the values
+//
+//Parameters:
+//	values: The array of values
+//	count: The number of values, at least 1
+//
+//Returns:
+//	The value which would be at index count / 2 if the values were sorted
+static float SpatialHash_SelectMedian(float* values, unsigned int count);
+
+///
+//Determines if the bounds of two proxies overlap
+//
+//Parameters:
+//	proxy1: A pointer to the first proxy
+//	proxy2: A pointer to the second proxy
+//
+//Returns:
+//	1 if the bounds overlap, else 0
+static unsigned char SpatialHash_DoProxiesOverlap(const struct SpatialHash_Proxy* proxy1, const struct SpatialHash_Proxy* proxy2);
+
+///
+//Finds where a prepared ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//	entry: A pointer to the destination of the parametric value where the ray enters the bounds, 0 if it starts within them
+//	exit: A pointer to the destination of the parametric value where the ray leaves the bounds
+//
+//Returns:
+//	1 if the ray crosses the bounds, else 0
+static unsigned char SpatialHash_GetRaySpan(const struct ColliderData_AABB* bounds, const struct SpatialHash_SlabRay* ray, float* entry, float* exit);
+
+///
+//Appends the object of a proxy found by a query, unless it has been removed since the last rebuild
+//
+//Parameters:
+//	grid: A pointer to the spatial hash
+//	proxy: A pointer to the proxy found
+//	dest: A pointer to the dynamic array to append the object to (GObject*)
+static void SpatialHash_AppendFound(SpatialHash* grid, const struct SpatialHash_Proxy* proxy, DynamicArray* dest);
+
+///
+//Compares the addresses of two game objects for qsort
+//
+//Parameters:
+//	a: A pointer to the first GObject*
+//	b: A pointer to the second GObject*
+//
+//Returns:
+//	-1 if a's object lies at a lower address than b's, 1 if it lies at a higher one, else 0
+static int SpatialHash_CompareObjects(const void* a, const void* b);
+
+///
+//Gets the range of a run's objects or buckets handled by one of it's tasks
+//
+//Parameters:
+//	run: A pointer to the run
+//	task: The index of the task
+//	count: The number of objects or buckets split across the tasks
+//	begin: A pointer to the destination of the index of the task's first object or bucket
+//	end: A pointer to the destination of one past the index of the task's last object or bucket
+static void SpatialHash_GetTaskRange(const struct SpatialHash_Run* run, unsigned int task, unsigned int count, unsigned int* begin, unsigned int* end);
+
+///
+//Computes the bounds of a range of the objects of a spatial hash being rebuilt
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of objects
+static void SpatialHash_ComputeBoundsTask(void* data, unsigned int task);
+
+///
+//Computes the cells overlapped by a range of the proxies of a spatial hash being rebuilt
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of proxies
+static void SpatialHash_ComputeCellsTask(void* data, unsigned int task);
+
+///
+//Writes the entries of a range of the proxies of a spatial hash being rebuilt
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of proxies
+static void SpatialHash_WriteEntriesTask(void* data, unsigned int task);
+
+///
+//Finds the pairs of overlapping proxies sharing the cells of a range of the buckets of a spatial hash
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of buckets
+static void SpatialHash_GetPairsTask(void* data, unsigned int task);
+
+///
+//Function Definitions
+
+///
+//Allocates memory for a spatial hash
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized spatial hash
+SpatialHash* SpatialHash_Allocate(void)
+{
+	SpatialHash* grid = (SpatialHash*)malloc(sizeof(SpatialHash));
+	return grid;
+}
+
+///
+//Initializes an empty spatial hash
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to initialize
+//	cellSize: The edge length of the cells, or SpatialHash_AUTO_CELL_SIZE to derive it from the objects each rebuild
+void SpatialHash_Initialize(SpatialHash* grid, float cellSize)
+{
+	grid->objects = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->objects, sizeof(GObject*));
+
+	grid->map = HashMap_Allocate();
+	HashMap_InitializeWithKeyType(grid->map, HashMap_KeyType_POINTER);
+
+	grid->cellSize = cellSize;
+	grid->currentCellSize = cellSize > 0.0f ? cellSize : SpatialHash_DEFAULT_CELL_SIZE;
+
+	grid->proxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->proxies, sizeof(struct SpatialHash_Proxy));
+	grid->largeProxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->largeProxies, sizeof(unsigned int));
+	grid->entries = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->entries, sizeof(struct SpatialHash_Entry));
+	grid->sortedEntries = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->sortedEntries, sizeof(struct SpatialHash_Entry));
+	grid->bucketStarts = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->bucketStarts, sizeof(unsigned int));
+	grid->numBuckets = 0;
+
+	grid->extents = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->extents, sizeof(float));
+	grid->taskPairs = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->taskPairs, sizeof(DynamicArray*));
+}
+
+///
+//Frees the data allocated by a spatial hash.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to free
+void SpatialHash_Free(SpatialHash* grid)
+{
+	DynamicArray_Free(grid->objects);
+	HashMap_Free(grid->map);
+
+	DynamicArray_Free(grid->proxies);
+	DynamicArray_Free(grid->largeProxies);
+	DynamicArray_Free(grid->entries);
+	DynamicArray_Free(grid->sortedEntries);
+	DynamicArray_Free(grid->bucketStarts);
+
+	DynamicArray_Free(grid->extents);
+	for(unsigned int i = 0; i < grid->taskPairs->size; i++)
+	{
+		DynamicArray_Free(((DynamicArray**)grid->taskPairs->data)[i]);
+	}
+	DynamicArray_Free(grid->taskPairs);
+	free(grid);
+}
+
+///
+//Adds a game object with a collider to a spatial hash
+//The object is hashed the next time the grid is updated.
+//Objects which have already been added are ignored.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to add to
+//	obj: A pointer to the game object to add
+void SpatialHash_Add(SpatialHash* grid, GObject* obj)
+{
+	if(obj->collider == NULL)
+	{
+		printf("SpatialHash_Add Failed: Only objects with colliders may be added.\n");
+		return;
+	}
+	if(HashMap_Contains(grid->map, &obj, sizeof(GObject*))) return;
+
+	HashMap_Add(grid->map, &obj, (void*)(uintptr_t)grid->objects->size, sizeof(GObject*));
+	DynamicArray_Append(grid->objects, &obj);
+}
+
+///
+//Removes a game object from a spatial hash
+//The grid must be updated before it's pairs are gathered again.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to remove from
+//	obj: A pointer to the game object to remove
+void SpatialHash_Remove(SpatialHash* grid, GObject* obj)
+{
+	struct HashMap_KeyValuePair* pair = HashMap_LookUp(grid->map, &obj, sizeof(GObject*));
+	if(pair == NULL) return;
+
+	unsigned int index = (unsigned int)(uintptr_t)pair->data;
+	HashMap_Remove(grid->map, &obj, sizeof(GObject*));
+
+	//Move the last object into the removed object's place
+	DynamicArray_SwapRemove(grid->objects, index);
+	if(index < grid->objects->size)
+	{
+		GObject* moved = ((GObject**)grid->objects->data)[index];
+		HashMap_LookUp(grid->map, &moved, sizeof(GObject*))->data = (void*)(uintptr_t)index;
+	}
+}
+
+///
+//Rebuilds a spatial hash from the current bounds of every object it holds
+//The cells overlapped by each object are bucketed by a counting sort over the hashes of their coordinates.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to rebuild
+//	workers: A pointer to a worker pool to compute the bounds and cells with, or NULL
+void SpatialHash_Update(SpatialHash* grid, WorkerPool* workers)
+{
+	unsigned int numObjects = grid->objects->size;
+	DynamicArray_Reserve(grid->proxies, numObjects);
+	grid->proxies->size = numObjects;
+	DynamicArray_Reserve(grid->extents, numObjects);
+	grid->extents->size = numObjects;
+
+	struct SpatialHash_Run run;
+	run.grid = grid;
+	run.numTasks = numObjects / SpatialHash_OBJECTS_PER_TASK;
+	if(run.numTasks > WorkerPool_GetConcurrency(workers)) run.numTasks = WorkerPool_GetConcurrency(workers);
+	if(run.numTasks == 0) run.numTasks = 1;
+
+	WorkerPool_Run(workers, SpatialHash_ComputeBoundsTask, &run, run.numTasks);
+
+	//Size the cells after the median object, so a typical object overlaps no more than 8 cells
+	if(grid->cellSize > 0.0f)
+	{
+		grid->currentCellSize = grid->cellSize;
+	}
+	else
+	{
+		//Unbounded objects were given a negative extent and do not count
+		float* extents = (float*)grid->extents->data;
+		unsigned int numBounded = 0;
+		for(unsigned int i = 0; i < numObjects; i++)
+		{
+			if(extents[i] >= 0.0f) extents[numBounded++] = extents[i];
+		}
+
+		float median = numBounded > 0 ? SpatialHash_SelectMedian(extents, numBounded) : 0.0f;
+		grid->currentCellSize = median > 0.0f ? median * SpatialHash_AUTO_CELL_SCALE : SpatialHash_DEFAULT_CELL_SIZE;
+	}
+
+	WorkerPool_Run(workers, SpatialHash_ComputeCellsTask, &run, run.numTasks);
+
+	//Give each proxy a range of entries, proxies overlapping too many cells are tested against every object instead
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(grid->proxies);
+	unsigned int numEntries = 0;
+	grid->largeProxies->size = 0;
+	for(int i = 0; i < 3; i++)
+	{
+		grid->bounds.min[i] = FLT_MAX;
+		grid->bounds.max[i] = -FLT_MAX;
+	}
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		if(proxies[i].numCells == 0)
+		{
+			DynamicArray_Append(grid->largeProxies, &i);
+			continue;
+		}
+		proxies[i].firstEntry = numEntries;
+		numEntries += proxies[i].numCells;
+
+		for(int j = 0; j < 3; j++)
+		{
+			if(proxies[i].bounds.min[j] < grid->bounds.min[j]) grid->bounds.min[j] = proxies[i].bounds.min[j];
+			if(proxies[i].bounds.max[j] > grid->bounds.max[j]) grid->bounds.max[j] = proxies[i].bounds.max[j];
+		}
+	}
+
+	//Twice as many buckets as entries keeps unrelated cells from sharing buckets
+	grid->numBuckets = 16;
+	while(grid->numBuckets < numEntries * 2) grid->numBuckets <<= 1;
+
+	DynamicArray_Reserve(grid->entries, numEntries);
+	grid->entries->size = numEntries;
+	WorkerPool_Run(workers, SpatialHash_WriteEntriesTask, &run, run.numTasks);
+
+	//Counting sort the entries by bucket, keeping the entries of each bucket in the order of their proxies
+	DynamicArray_Reserve(grid->bucketStarts, grid->numBuckets + 1);
+	grid->bucketStarts->size = grid->numBuckets + 1;
+	unsigned int* starts = (unsigned int*)grid->bucketStarts->data;
+	for(unsigned int i = 0; i <= grid->numBuckets; i++)
+	{
+		starts[i] = 0;
+	}
+
+	struct SpatialHash_Entry* entries = DynamicArray_SpatialHashEntry_Data(grid->entries);
+	for(unsigned int i = 0; i < numEntries; i++)
+	{
+		starts[entries[i].bucket + 1]++;
+	}
+	for(unsigned int i = 1; i <= grid->numBuckets; i++)
+	{
+		starts[i] += starts[i - 1];
+	}
+
+	DynamicArray_Reserve(grid->sortedEntries, numEntries);
+	grid->sortedEntries->size = numEntries;
+	struct SpatialHash_Entry* sortedEntries = DynamicArray_SpatialHashEntry_Data(grid->sortedEntries);
+	for(unsigned int i = 0; i < numEntries; i++)
+	{
+		sortedEntries[starts[entries[i].bucket]++] = entries[i];
+	}
+
+	//Placing the entries moved each start to the start of the next bucket
+	for(unsigned int i = grid->numBuckets; i > 0; i--)
+	{
+		starts[i] = starts[i - 1];
+	}
+	starts[0] = 0;
+}
+
+///
+//Appends every pair of objects whose bounds overlap in an updated spatial hash
+//Each pair is found once, in the cell holding the minimum corner of the overlap of their bounds.
+//The pairs are appended in the same order regardless of how many threads search for them.
+//
+//Parameters:
+//	grid: A pointer to the updated spatial hash
+//	dest: A pointer to the dynamic array to append the pairs to (struct GObject_Pair)
+//	workers: A pointer to a worker pool to search the buckets with, or NULL
+void SpatialHash_GetPairs(SpatialHash* grid, DynamicArray* dest, WorkerPool* workers)
+{
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(grid->proxies);
+
+	if(grid->sortedEntries->size > 0)
+	{
+		//Split the buckets into enough tasks to balance the threads, but not so many that each task does too little
+		struct SpatialHash_Run run;
+		run.grid = grid;
+		unsigned int maxTasks = WorkerPool_GetConcurrency(workers) * SpatialHash_TASKS_PER_THREAD;
+		run.numTasks = grid->sortedEntries->size / SpatialHash_OBJECTS_PER_TASK;
+		if(run.numTasks > maxTasks) run.numTasks = maxTasks;
+		if(run.numTasks == 0) run.numTasks = 1;
+
+		while(grid->taskPairs->size < run.numTasks)
+		{
+			DynamicArray* pairs = DynamicArray_Allocate();
+			DynamicArray_Initialize(pairs, sizeof(struct GObject_Pair));
+			DynamicArray_Append(grid->taskPairs, &pairs);
+		}
+
+		WorkerPool_Run(workers, SpatialHash_GetPairsTask, &run, run.numTasks);
+
+		for(unsigned int i = 0; i < run.numTasks; i++)
+		{
+			DynamicArray* pairs = ((DynamicArray**)grid->taskPairs->data)[i];
+			DynamicArray_AppendN(dest, pairs->data, pairs->size);
+		}
+	}
+
+	//Large proxies are tested against every other proxy, pairs of large proxies are found by the first of the two
+	unsigned int* largeProxies = (unsigned int*)grid->largeProxies->data;
+	for(unsigned int i = 0; i < grid->largeProxies->size; i++)
+	{
+		unsigned int large = largeProxies[i];
+		for(unsigned int other = 0; other < grid->proxies->size; other++)
+		{
+			if(other == large) continue;
+			if(proxies[other].numCells == 0 && other < large) continue;
+			if(!SpatialHash_DoProxiesOverlap(proxies + large, proxies + other)) continue;
+
+			struct GObject_Pair pair;
+			pair.obj1 = proxies[large < other ? large : other].obj;
+			pair.obj2 = proxies[large < other ? other : large].obj;
+			DynamicArray_GObjectPair_Append(dest, pair);
+		}
+	}
+}
+
+///
+//Finds every object in an updated spatial hash whose bounds overlap an axis aligned bounding box
+//Each object is found once, in the cell holding the minimum corner of the overlap of it's bounds with the box.
+//Objects removed since the last rebuild are not found.
+//
+//Parameters:
+//	grid: A pointer to the updated spatial hash
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SpatialHash_QueryAABB(SpatialHash* grid, const struct ColliderData_AABB* bounds, DynamicArray* dest)
+{
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(grid->proxies);
+	struct SpatialHash_Proxy query;
+	query.bounds = *bounds;
+
+	//Large proxies are in no cell
+	unsigned int* largeProxies = (unsigned int*)grid->largeProxies->data;
+	for(unsigned int i = 0; i < grid->largeProxies->size; i++)
+	{
+		if(SpatialHash_DoProxiesOverlap(proxies + largeProxies[i], &query)) SpatialHash_AppendFound(grid, proxies + largeProxies[i], dest);
+	}
+	if(grid->sortedEntries->size == 0) return;
+
+	uint64_t numCells = 1;
+	for(int i = 0; i < 3; i++)
+	{
+		query.minCell[i] = SpatialHash_GetCell(bounds->min[i], grid->currentCellSize);
+		query.maxCell[i] = SpatialHash_GetCell(bounds->max[i], grid->currentCellSize);
+
+		//Checked per axis so the product can not overflow
+		numCells *= (uint64_t)((int64_t)query.maxCell[i] - query.minCell[i] + 1);
+		if(numCells > grid->proxies->size) break;
+	}
+
+	//A box spanning more cells than there are objects is cheaper to test against every object
+	if(numCells > grid->proxies->size)
+	{
+		for(unsigned int i = 0; i < grid->proxies->size; i++)
+		{
+			if(proxies[i].numCells != 0 && SpatialHash_DoProxiesOverlap(proxies + i, &query)) SpatialHash_AppendFound(grid, proxies + i, dest);
+		}
+		return;
+	}
+
+	struct SpatialHash_Entry* entries = DynamicArray_SpatialHashEntry_Data(grid->sortedEntries);
+	unsigned int* starts = (unsigned int*)grid->bucketStarts->data;
+	int cell[3];
+	for(cell[0] = query.minCell[0]; cell[0] <= query.maxCell[0]; cell[0]++)
+	{
+		for(cell[1] = query.minCell[1]; cell[1] <= query.maxCell[1]; cell[1]++)
+		{
+			for(cell[2] = query.minCell[2]; cell[2] <= query.maxCell[2]; cell[2]++)
+			{
+				unsigned int bucket = SpatialHash_GetBucket(cell, grid->numBuckets);
+				for(unsigned int i = starts[bucket]; i < starts[bucket + 1]; i++)
+				{
+					struct SpatialHash_Entry* entry = entries + i;
+					if(entry->cell[0] != cell[0] || entry->cell[1] != cell[1] || entry->cell[2] != cell[2]) continue;
+
+					struct SpatialHash_Proxy* proxy = proxies + entry->proxy;
+					if(!SpatialHash_DoProxiesOverlap(proxy, &query)) continue;
+
+					//Only the cell holding the minimum corner of the overlap reports the object
+					unsigned char owner = 1;
+					for(int k = 0; k < 3 && owner; k++)
+					{
+						float min = proxy->bounds.min[k] > bounds->min[k] ? proxy->bounds.min[k] : bounds->min[k];
+						owner = SpatialHash_GetCell(min, grid->currentCellSize) == cell[k];
+					}
+					if(owner) SpatialHash_AppendFound(grid, proxy, dest);
+				}
+			}
+		}
+	}
+}
+
+///
+//Finds every object in an updated spatial hash whose bounds are crossed by a ray
+//The ray walks the cells it crosses within the bounds of the grid's objects,
+//unless it crosses more cells than there are objects, in which case every object is tested instead.
+//Objects removed since the last rebuild are not found.
+//
+//Parameters:
+//	grid: A pointer to the updated spatial hash
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SpatialHash_QueryRay(SpatialHash* grid, struct ColliderData_Ray* worldRay, DynamicArray* dest)
+{
+	struct SpatialHash_SlabRay ray;
+	for(int i = 0; i < 3; i++)
+	{
+		float direction = worldRay->direction->components[i];
+		ray.origin[i] = worldRay->position->components[i];
+		ray.parallel[i] = direction > -FLT_EPSILON && direction < FLT_EPSILON;
+		ray.inverseDirection[i] = ray.parallel[i] ? 0.0f : 1.0f / direction;
+	}
+
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(grid->proxies);
+	float entry, exit;
+
+	//Large proxies are in no cell
+	unsigned int* largeProxies = (unsigned int*)grid->largeProxies->data;
+	for(unsigned int i = 0; i < grid->largeProxies->size; i++)
+	{
+		if(SpatialHash_GetRaySpan(&proxies[largeProxies[i]].bounds, &ray, &entry, &exit)) SpatialHash_AppendFound(grid, proxies + largeProxies[i], dest);
+	}
+	if(grid->sortedEntries->size == 0) return;
+
+	//Only the part of the ray within the bounds of the hashed objects can cross an occupied cell
+	if(!SpatialHash_GetRaySpan(&grid->bounds, &ray, &entry, &exit)) return;
+
+	float cellSize = grid->currentCellSize;
+	int cell[3];
+	int step[3];
+	float nextBoundary[3];
+	float boundaryStep[3];
+	uint64_t numCells = 1;
+	for(int i = 0; i < 3; i++)
+	{
+		float direction = worldRay->direction->components[i];
+		cell[i] = SpatialHash_GetCell(ray.origin[i] + direction * entry, cellSize);
+		int lastCell = SpatialHash_GetCell(ray.origin[i] + direction * exit, cellSize);
+		numCells += (uint64_t)(lastCell > cell[i] ? (int64_t)lastCell - cell[i] : (int64_t)cell[i] - lastCell);
+
+		//Parametric value where the ray crosses into the next cell along each axis
+		step[i] = ray.parallel[i] ? 0 : (ray.inverseDirection[i] > 0.0f ? 1 : -1);
+		if(step[i] == 0)
+		{
+			nextBoundary[i] = FLT_MAX;
+			boundaryStep[i] = 0.0f;
+			continue;
+		}
+		float boundary = (float)(cell[i] + (step[i] > 0 ? 1 : 0)) * cellSize;
+		nextBoundary[i] = (boundary - ray.origin[i]) * ray.inverseDirection[i];
+		boundaryStep[i] = cellSize * fabsf(ray.inverseDirection[i]);
+	}
+
+	//A ray crossing more cells than there are objects is cheaper to test against every object
+	if(numCells > grid->proxies->size)
+	{
+		for(unsigned int i = 0; i < grid->proxies->size; i++)
+		{
+			if(proxies[i].numCells != 0 && SpatialHash_GetRaySpan(&proxies[i].bounds, &ray, &entry, &exit)) SpatialHash_AppendFound(grid, proxies + i, dest);
+		}
+		return;
+	}
+
+	struct SpatialHash_Entry* entries = DynamicArray_SpatialHashEntry_Data(grid->sortedEntries);
+	unsigned int* starts = (unsigned int*)grid->bucketStarts->data;
+	unsigned int first = dest->size;
+	for(uint64_t visited = 0; visited < numCells; visited++)
+	{
+		unsigned int bucket = SpatialHash_GetBucket(cell, grid->numBuckets);
+		for(unsigned int i = starts[bucket]; i < starts[bucket + 1]; i++)
+		{
+			if(entries[i].cell[0] != cell[0] || entries[i].cell[1] != cell[1] || entries[i].cell[2] != cell[2]) continue;
+
+			struct SpatialHash_Proxy* proxy = proxies + entries[i].proxy;
+			if(SpatialHash_GetRaySpan(&proxy->bounds, &ray, &entry, &exit)) SpatialHash_AppendFound(grid, proxy, dest);
+		}
+
+		//Step into the neighbouring cell the ray reaches first
+		int axis = nextBoundary[0] < nextBoundary[1] ? 0 : 1;
+		if(nextBoundary[2] < nextBoundary[axis]) axis = 2;
+		cell[axis] += step[axis];
+		nextBoundary[axis] += boundaryStep[axis];
+	}
+
+	//An object overlapping several of the cells the ray crosses is found in each of them
+	if(dest->size - first > 1)
+	{
+		GObject** found = (GObject**)dest->data + first;
+		unsigned int numFound = dest->size - first;
+		qsort(found, numFound, sizeof(GObject*), SpatialHash_CompareObjects);
+
+		unsigned int numUnique = 1;
+		for(unsigned int i = 1; i < numFound; i++)
+		{
+			if(found[i] != found[numUnique - 1]) found[numUnique++] = found[i];
+		}
+		dest->size = first + numUnique;
+	}
+}
+
+///
+//Gets the coordinate of the cell holding a position along one axis
+//
+//Parameters:
+//	position: The position along the axis
+//	cellSize: The edge length of the cells
+//
+//Returns:
+//	The coordinate of the cell, clamped to SpatialHash_MAX_CELL_COORDINATE
+static int SpatialHash_GetCell(float position, float cellSize)
+{
+	float cell = floorf(position / cellSize);
+	if(cell < -(float)SpatialHash_MAX_CELL_COORDINATE) return -SpatialHash_MAX_CELL_COORDINATE;
+	if(cell > (float)SpatialHash_MAX_CELL_COORDINATE) return SpatialHash_MAX_CELL_COORDINATE;
+	return (int)cell;
+}
+
+///
+//Gets the bucket a cell is hashed to
+//
+//Parameters:
+//	cell: The coordinates of the cell
+//	numBuckets: The number of buckets, a power of two
+//
+//Returns:
+//	The index of the bucket, from 0 to numBuckets - 1
+static unsigned int SpatialHash_GetBucket(const int cell[3], unsigned int numBuckets)
+{
+	uint32_t hash = ((uint32_t)cell[0] * 73856093u) ^ ((uint32_t)cell[1] * 19349663u) ^ ((uint32_t)cell[2] * 83492791u);
+
+	//Mix the high bits into the low bits the bucket is taken from
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3bu;
+	hash ^= hash >> 16;
+	return hash & (numBuckets - 1);
+}
+
+///
+//Finds the median of an array of values, reordering the values
+//
+//Parameters:
+//	values: The array of values
+//	count: The number of values, at least 1
+//
+//Returns:
+//	The value which would be at index count / 2 if the values were sorted
+static float SpatialHash_SelectMedian(float* values, unsigned int count)
+{
+	int target = (int)(count / 2);
+	int first = 0;
+	int last = (int)count - 1;
+
+	//Partition around the middle value until the target is in place
+	while(first < last)
+	{
+		float pivot = values[first + (last - first) / 2];
+		int i = first;
+		int j = last;
+		while(i <= j)
+		{
+			while(values[i] < pivot) i++;
+			while(values[j] > pivot) j--;
+			if(i <= j)
+			{
+				float swap = values[i];
+				values[i++] = values[j];
+				values[j--] = swap;
+			}
+		}
+
+		if(target <= j) last = j;
+		else if(target >= i) first = i;
+		else break;
+	}
+	return values[target];
+}
+
+///
+//Determines if the bounds of two proxies overlap
+//
+//Parameters:
+//	proxy1: A pointer to the first proxy
+//	proxy2: A pointer to the second proxy
+//
+//Returns:
+//	1 if the bounds overlap, else 0
+static unsigned char SpatialHash_DoProxiesOverlap(const struct SpatialHash_Proxy* proxy1, const struct SpatialHash_Proxy* proxy2)
+{
+	return proxy1->bounds.min[0] <= proxy2->bounds.max[0] && proxy2->bounds.min[0] <= proxy1->bounds.max[0]
+		&& proxy1->bounds.min[1] <= proxy2->bounds.max[1] && proxy2->bounds.min[1] <= proxy1->bounds.max[1]
+		&& proxy1->bounds.min[2] <= proxy2->bounds.max[2] && proxy2->bounds.min[2] <= proxy1->bounds.max[2];
+}
+
+///
+//Finds where a prepared ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//	entry: A pointer to the destination of the parametric value where the ray enters the bounds, 0 if it starts within them
+//	exit: A pointer to the destination of the parametric value where the ray leaves the bounds
+//
+//Returns:
+//	1 if the ray crosses the bounds, else 0
+static unsigned char SpatialHash_GetRaySpan(const struct ColliderData_AABB* bounds, const struct SpatialHash_SlabRay* ray, float* entry, float* exit)
+{
+	*entry = 0.0f;
+	*exit = FLT_MAX;
+	for(int i = 0; i < 3; i++)
+	{
+		//A ray parallel to a slab must start within it
+		if(ray->parallel[i])
+		{
+			if(ray->origin[i] < bounds->min[i] || ray->origin[i] > bounds->max[i]) return 0;
+			continue;
+		}
+
+		float t1 = (bounds->min[i] - ray->origin[i]) * ray->inverseDirection[i];
+		float t2 = (bounds->max[i] - ray->origin[i]) * ray->inverseDirection[i];
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > *entry) *entry = t1;
+		if(t2 < *exit) *exit = t2;
+		if(*entry > *exit) return 0;
+	}
+	return 1;
+}
+
+///
+//Appends the object of a proxy found by a query, unless it has been removed since the last rebuild
+//
+//Parameters:
+//	grid: A pointer to the spatial hash
+//	proxy: A pointer to the proxy found
+//	dest: A pointer to the dynamic array to append the object to (GObject*)
+static void SpatialHash_AppendFound(SpatialHash* grid, const struct SpatialHash_Proxy* proxy, DynamicArray* dest)
+{
+	//The proxies are only rebuilt by updates, but removed objects may already have been freed
+	GObject* obj = proxy->obj;
+	if(!HashMap_Contains(grid->map, &obj, sizeof(GObject*))) return;
+	DynamicArray_Append(dest, &obj);
+}
+
+///
+//Compares the addresses of two game objects for qsort
+//
+//Parameters:
+//	a: A pointer to the first GObject*
+//	b: A pointer to the second GObject*
+//
+//Returns:
+//	-1 if a's object lies at a lower address than b's, 1 if it lies at a higher one, else 0
+static int SpatialHash_CompareObjects(const void* a, const void* b)
+{
+	uintptr_t objA = (uintptr_t)*(GObject* const*)a;
+	uintptr_t objB = (uintptr_t)*(GObject* const*)b;
+	return (objA > objB) - (objA < objB);
+}
+
+///
+//Gets the range of a run's objects or buckets handled by one of it's tasks
+//
+//Parameters:
+//	run: A pointer to the run
+//	task: The index of the task
+//	count: The number of objects or buckets split across the tasks
+//	begin: A pointer to the destination of the index of the task's first object or bucket
+//	end: A pointer to the destination of one past the index of the task's last object or bucket
+static void SpatialHash_GetTaskRange(const struct SpatialHash_Run* run, unsigned int task, unsigned int count, unsigned int* begin, unsigned int* end)
+{
+	*begin = (unsigned int)(((uint64_t)count * task) / run->numTasks);
+	*end = (unsigned int)(((uint64_t)count * (task + 1)) / run->numTasks);
+}
+
+///
+//Computes the bounds of a range of the objects of a spatial hash being rebuilt
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of objects
+static void SpatialHash_ComputeBoundsTask(void* data, unsigned int task)
+{
+	struct SpatialHash_Run* run = (struct SpatialHash_Run*)data;
+	GObject** objects = (GObject**)run->grid->objects->data;
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(run->grid->proxies);
+	float* extents = (float*)run->grid->extents->data;
+
+	unsigned int begin, end;
+	SpatialHash_GetTaskRange(run, task, run->grid->objects->size, &begin, &end);
+	for(unsigned int i = begin; i < end; i++)
+	{
+		proxies[i].obj = objects[i];
+		extents[i] = -1.0f;
+		FrameOfReference* frame = objects[i]->body != NULL ? objects[i]->body->frame : objects[i]->frameOfReference;
+		if(!Collider_GetWorldAABBUnbounded(&proxies[i].bounds, objects[i]->collider, frame)) continue;
+
+		for(int j = 0; j < 3; j++)
+		{
+			float extent = proxies[i].bounds.max[j] - proxies[i].bounds.min[j];
+			if(extent > extents[i]) extents[i] = extent;
+		}
+	}
+}
+
+///
+//Computes the cells overlapped by a range of the proxies of a spatial hash being rebuilt
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of proxies
+static void SpatialHash_ComputeCellsTask(void* data, unsigned int task)
+{
+	struct SpatialHash_Run* run = (struct SpatialHash_Run*)data;
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(run->grid->proxies);
+	float cellSize = run->grid->currentCellSize;
+
+	unsigned int begin, end;
+	SpatialHash_GetTaskRange(run, task, run->grid->proxies->size, &begin, &end);
+	for(unsigned int i = begin; i < end; i++)
+	{
+		struct SpatialHash_Proxy* proxy = proxies + i;
+		uint64_t numCells = 1;
+		for(int j = 0; j < 3; j++)
+		{
+			proxy->minCell[j] = SpatialHash_GetCell(proxy->bounds.min[j], cellSize);
+			proxy->maxCell[j] = SpatialHash_GetCell(proxy->bounds.max[j], cellSize);
+
+			//Checked per axis so the product can not overflow
+			numCells *= (uint64_t)((int64_t)proxy->maxCell[j] - proxy->minCell[j] + 1);
+			if(numCells > SpatialHash_MAX_CELLS_PER_OBJECT) numCells = 0;
+			if(numCells == 0) break;
+		}
+		proxy->numCells = (unsigned int)numCells;
+	}
+}
+
+///
+//Writes the entries of a range of the proxies of a spatial hash being rebuilt
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of proxies
+static void SpatialHash_WriteEntriesTask(void* data, unsigned int task)
+{
+	struct SpatialHash_Run* run = (struct SpatialHash_Run*)data;
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(run->grid->proxies);
+	struct SpatialHash_Entry* entries = DynamicArray_SpatialHashEntry_Data(run->grid->entries);
+	unsigned int numBuckets = run->grid->numBuckets;
+
+	unsigned int begin, end;
+	SpatialHash_GetTaskRange(run, task, run->grid->proxies->size, &begin, &end);
+	for(unsigned int i = begin; i < end; i++)
+	{
+		struct SpatialHash_Proxy* proxy = proxies + i;
+		if(proxy->numCells == 0) continue;
+
+		struct SpatialHash_Entry* entry = entries + proxy->firstEntry;
+		for(int x = proxy->minCell[0]; x <= proxy->maxCell[0]; x++)
+		{
+			for(int y = proxy->minCell[1]; y <= proxy->maxCell[1]; y++)
+			{
+				for(int z = proxy->minCell[2]; z <= proxy->maxCell[2]; z++)
+				{
+					entry->cell[0] = x;
+					entry->cell[1] = y;
+					entry->cell[2] = z;
+					entry->bucket = SpatialHash_GetBucket(entry->cell, numBuckets);
+					entry->proxy = i;
+					entry++;
+				}
+			}
+		}
+	}
+}
+
+///
+//Finds the pairs of overlapping proxies sharing the cells of a range of the buckets of a spatial hash
+//
+//Parameters:
+//	data: A pointer to the run (struct SpatialHash_Run)
+//	task: The index of the range of buckets
+static void SpatialHash_GetPairsTask(void* data, unsigned int task)
+{
+	struct SpatialHash_Run* run = (struct SpatialHash_Run*)data;
+	SpatialHash* grid = run->grid;
+	struct SpatialHash_Proxy* proxies = DynamicArray_SpatialHashProxy_Data(grid->proxies);
+	struct SpatialHash_Entry* entries = DynamicArray_SpatialHashEntry_Data(grid->sortedEntries);
+	unsigned int* starts = (unsigned int*)grid->bucketStarts->data;
+	DynamicArray* dest = ((DynamicArray**)grid->taskPairs->data)[task];
+	dest->size = 0;
+
+	unsigned int begin, end;
+	SpatialHash_GetTaskRange(run, task, grid->numBuckets, &begin, &end);
+	for(unsigned int bucket = begin; bucket < end; bucket++)
+	{
+		for(unsigned int i = starts[bucket]; i < starts[bucket + 1]; i++)
+		{
+			struct SpatialHash_Entry* entry = entries + i;
+			struct SpatialHash_Proxy* proxy = proxies + entry->proxy;
+
+			for(unsigned int j = i + 1; j < starts[bucket + 1]; j++)
+			{
+				struct SpatialHash_Entry* other = entries + j;
+
+				//Other cells may be hashed to the same bucket
+				if(other->cell[0] != entry->cell[0] || other->cell[1] != entry->cell[1] || other->cell[2] != entry->cell[2]) continue;
+
+				struct SpatialHash_Proxy* otherProxy = proxies + other->proxy;
+				if(!SpatialHash_DoProxiesOverlap(proxy, otherProxy)) continue;
+
+				//Only the cell holding the minimum corner of the overlap reports the pair
+				unsigned char owner = 1;
+				for(int k = 0; k < 3 && owner; k++)
+				{
+					float min = proxy->bounds.min[k] > otherProxy->bounds.min[k] ? proxy->bounds.min[k] : otherProxy->bounds.min[k];
+					owner = SpatialHash_GetCell(min, grid->currentCellSize) == entry->cell[k];
+				}
+				if(!owner) continue;
+
+				struct GObject_Pair pair = { proxy->obj, otherProxy->obj };
+				DynamicArray_GObjectPair_Append(dest, pair);
+			}
+		}
+	}
+}
@@ -0,0 +1,170 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include "../GObject/GObject.h"		//The data the spatial hash will contain
+#include "DynamicArray.h"
+#include "HashMap.h"
+#include "WorkerPool.h"
+
+//Cell size which makes a spatial hash derive it's cell size from the sizes of it's objects each time it is rebuilt
+#define SpatialHash_AUTO_CELL_SIZE 0.0f
+//Multiple of the median of the largest extent of each object's bounds used as the derived cell size
+#define SpatialHash_AUTO_CELL_SCALE 2.0f
+//Cell size used when it is derived from objects which have no size
+#define SpatialHash_DEFAULT_CELL_SIZE 1.0f
+//Most cells an object is hashed into, objects spanning more are tested against every other object instead
+#define SpatialHash_MAX_CELLS_PER_OBJECT 64
+//Largest magnitude of a cell coordinate, positions further out share the outermost cells
+#define SpatialHash_MAX_CELL_COORDINATE 1000000000
+//Fewest objects worth handing to a single task when rebuilding in parallel
+#define SpatialHash_OBJECTS_PER_TASK 256
+//Most tasks the pair search is split into per thread, so threads which finish early can take over the remaining buckets
+#define SpatialHash_TASKS_PER_THREAD 4
+
+///
+//The bounds of a single game object in a spatial hash as of it's last rebuild
+struct SpatialHash_Proxy
+{
+	GObject* obj;				//The object bounded by this proxy
+	struct ColliderData_AABB bounds;	//World space bounds of the object
+	int minCell[3];				//Coordinates of the cell holding the minimum corner of the bounds
+	int maxCell[3];				//Coordinates of the cell holding the maximum corner of the bounds
+	unsigned int firstEntry;		//Index of the first of the proxy's entries in the unsorted entry array
+	unsigned int numCells;			//Number of cells the bounds overlap, 0 if there are too many to hash
+};
+
+///
+//A cell overlapped by a proxy
+struct SpatialHash_Entry
+{
+	int cell[3];		//Coordinates of the cell
+	unsigned int bucket;	//Bucket the cell is hashed to
+	unsigned int proxy;	//Index of the proxy overlapping the cell
+};
+
+//Typed accessors for proxy and entry arrays
+DYNARRAY_DECLARE(SpatialHashProxy, struct SpatialHash_Proxy);
+DYNARRAY_DECLARE(SpatialHashEntry, struct SpatialHash_Entry);
+
+///
+//A uniform grid of cells over unbounded space, of which only the occupied cells are stored by hashing them into buckets.
+//The grid keeps no state between frames, it is rebuilt from scratch each update in time linear in the number of objects.
+typedef struct SpatialHash
+{
+	//Every object held by the grid, in no particular order (GObject*)
+	DynamicArray* objects;
+	//Maps each object to it's index in objects
+	HashMap* map;
+
+	//Edge length of the cells, or SpatialHash_AUTO_CELL_SIZE to derive it from the objects
+	float cellSize;
+	//Edge length of the cells as of the last rebuild
+	float currentCellSize;
+
+	//Bounds of each object in the order of objects (struct SpatialHash_Proxy)
+	DynamicArray* proxies;
+	//Indices of the proxies overlapping too many cells to hash (unsigned int)
+	DynamicArray* largeProxies;
+	//Cells overlapped by each proxy, in the order of the proxies (struct SpatialHash_Entry)
+	DynamicArray* entries;
+	//Entries sorted by bucket, in the order of the proxies within each bucket (struct SpatialHash_Entry)
+	DynamicArray* sortedEntries;
+	//Index of the first sorted entry of each bucket, followed by the number of entries (unsigned int)
+	DynamicArray* bucketStarts;
+	//Number of buckets as of the last rebuild, a power of two
+	unsigned int numBuckets;
+	//Union of the bounds of the proxies hashed into cells as of the last rebuild
+	struct ColliderData_AABB bounds;
+
+	//Storage for the largest extent of each object's bounds while deriving the cell size (float)
+	DynamicArray* extents;
+	//Pairs found by each task of the pair search (DynamicArray* of struct GObject_Pair)
+	DynamicArray* taskPairs;
+} SpatialHash;
+
+///
+//Allocates memory for a spatial hash
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized spatial hash
+SpatialHash* SpatialHash_Allocate(void);
+
+///
+//Initializes an empty spatial hash
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to initialize
+//	cellSize: The edge length of the cells, or SpatialHash_AUTO_CELL_SIZE to derive it from the objects each rebuild
+void SpatialHash_Initialize(SpatialHash* grid, float cellSize);
+
+///
+//Frees the data allocated by a spatial hash.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to free
+void SpatialHash_Free(SpatialHash* grid);
+
+///
+//Adds a game object with a collider to a spatial hash
+//The object is hashed the next time the grid is updated.
+//Objects which have already been added are ignored.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to add to
+//	obj: A pointer to the game object to add
+void SpatialHash_Add(SpatialHash* grid, GObject* obj);
+
+///
+//Removes a game object from a spatial hash
+//The grid must be updated before it's pairs are gathered again.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to remove from
+//	obj: A pointer to the game object to remove
+void SpatialHash_Remove(SpatialHash* grid, GObject* obj);
+
+///
+//Rebuilds a spatial hash from the current bounds of every object it holds
+//The cells overlapped by each object are bucketed by a counting sort over the hashes of their coordinates.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash to rebuild
+//	workers: A pointer to a worker pool to compute the bounds and cells with, or NULL
+void SpatialHash_Update(SpatialHash* grid, WorkerPool* workers);
+
+///
+//Appends every pair of objects whose bounds overlap in an updated spatial hash
+//Each pair is found once, in the cell holding the minimum corner of the overlap of their bounds.
+//The pairs are appended in the same order regardless of how many threads search for them.
+//
+//Parameters:
+//	grid: A pointer to the updated spatial hash
+//	dest: A pointer to the dynamic array to append the pairs to (struct GObject_Pair)
+//	workers: A pointer to a worker pool to search the buckets with, or NULL
+void SpatialHash_GetPairs(SpatialHash* grid, DynamicArray* dest, WorkerPool* workers);
+
+///
+//Finds every object in an updated spatial hash whose bounds overlap an axis aligned bounding box
+//Each object is found once, in the cell holding the minimum corner of the overlap of it's bounds with the box.
+//Objects removed since the last rebuild are not found.
+//
+//Parameters:
+//	grid: A pointer to the updated spatial hash
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SpatialHash_QueryAABB(SpatialHash* grid, const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Finds every object in an updated spatial hash whose bounds are crossed by a ray
+//The ray walks the cells it crosses within the bounds of the grid's objects,
+//unless it crosses more cells than there are objects, in which case every object is tested instead.
+//Objects removed since the last rebuild are not found.
+//
+//Parameters:
+//	grid: A pointer to the updated spatial hash
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SpatialHash_QueryRay(SpatialHash* grid, struct ColliderData_Ray* worldRay, DynamicArray* dest);
+
+#endif
@@ -0,0 +1,589 @@
+#include "SweepAndPrune.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <float.h>
+
+///
+//A ray prepared for the slab tests of a ray query
+struct SweepAndPrune_SlabRay
+{
+	float origin[3];
+	float inverseDirection[3];	//Reciprocal of each component of the direction, 0 where the ray is parallel to a slab
+	unsigned char parallel[3];	//1 where the ray is parallel to a slab
+};
+
+///
+//Static Declarations
+
+///
+//Gets the index of the proxy of a game object
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune holding the object
+//	obj: A pointer to the game object
+//	dest: A pointer to the destination of the proxy's index
+//
+//Returns:
+//	1 if the object has a proxy, else 0
+static unsigned char SweepAndPrune_LookUpProxy(SweepAndPrune* sap, GObject* obj, unsigned int* dest);
+
+///
+//Chooses the axis along which the centers of a sweep and prune's objects are most spread out
+//The current axis is kept unless another is spread SweepAndPrune_AXIS_SWITCH_RATIO times further.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to choose the axis of
+//
+//Returns:
+//	The axis to sweep along
+static unsigned int SweepAndPrune_ChooseAxis(SweepAndPrune* sap);
+
+///
+//Drops the endpoints of released proxies and sets the value of every other endpoint
+//to it's proxy's bounds along the sweep axis, freeing the released proxies for reuse
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to refresh
+static void SweepAndPrune_RefreshEndpoints(SweepAndPrune* sap);
+
+///
+//Determines if an endpoint belongs before another along the sweep axis
+//Minimum endpoints come before maximum endpoints of equal value so touching bounds overlap,
+//remaining ties are broken by proxy index so the order is total.
+//
+//Parameters:
+//	a: A pointer to the first endpoint
+//	b: A pointer to the second endpoint
+//
+//Returns:
+//	1 if a belongs before b, else 0
+static unsigned char SweepAndPrune_IsBefore(const struct SweepAndPrune_Endpoint* a, const struct SweepAndPrune_Endpoint* b);
+
+///
+//Compares two endpoints for qsort
+//
+//Parameters:
+//	a: A pointer to the first struct SweepAndPrune_Endpoint
+//	b: A pointer to the second struct SweepAndPrune_Endpoint
+//
+//Returns:
+//	-1 if a belongs before b, 1 if b belongs before a, else 0
+static int SweepAndPrune_CompareEndpoints(const void* a, const void* b);
+
+///
+//Finds the index of the first sorted endpoint of a sweep and prune lying at or after a value along the sweep axis
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	value: The position along the sweep axis
+//
+//Returns:
+//	The index of the first endpoint whose value is not less than value, or the number of sorted endpoints if there is none
+static unsigned int SweepAndPrune_LowerBound(SweepAndPrune* sap, float value);
+
+///
+//Determines if a prepared ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//
+//Returns:
+//	1 if the ray crosses the bounds, else 0
+static unsigned char SweepAndPrune_DoesRayCross(const struct ColliderData_AABB* bounds, const struct SweepAndPrune_SlabRay* ray);
+
+///
+//Implementations
+
+///
+//Allocates memory for a sweep and prune
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized sweep and prune
+SweepAndPrune* SweepAndPrune_Allocate(void)
+{
+	SweepAndPrune* sap = (SweepAndPrune*)malloc(sizeof(SweepAndPrune));
+	return sap;
+}
+
+///
+//Initializes an empty sweep and prune
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to initialize
+//	axis: The axis to sweep along until the objects are spread further along another
+void SweepAndPrune_Initialize(SweepAndPrune* sap, unsigned int axis)
+{
+	sap->proxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(sap->proxies, sizeof(struct SweepAndPrune_Proxy));
+	sap->freeProxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(sap->freeProxies, sizeof(unsigned int));
+	sap->releasedProxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(sap->releasedProxies, sizeof(unsigned int));
+
+	sap->endpoints = DynamicArray_Allocate();
+	DynamicArray_Initialize(sap->endpoints, sizeof(struct SweepAndPrune_Endpoint));
+	sap->numUnsorted = 0;
+
+	sap->active = DynamicArray_Allocate();
+	DynamicArray_Initialize(sap->active, sizeof(unsigned int));
+
+	sap->axis = axis < 3 ? axis : 0;
+
+	sap->map = HashMap_Allocate();
+	HashMap_InitializeWithKeyType(sap->map, HashMap_KeyType_POINTER);
+}
+
+///
+//Frees the data allocated by a sweep and prune.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to free
+void SweepAndPrune_Free(SweepAndPrune* sap)
+{
+	DynamicArray_Free(sap->proxies);
+	DynamicArray_Free(sap->freeProxies);
+	DynamicArray_Free(sap->releasedProxies);
+	DynamicArray_Free(sap->endpoints);
+	DynamicArray_Free(sap->active);
+	HashMap_Free(sap->map);
+	free(sap);
+}
+
+///
+//Adds a game object with a collider to a sweep and prune
+//The object is sorted into place by the next call to SweepAndPrune_Update.
+//Objects which have already been added are updated instead.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to add to
+//	obj: A pointer to the game object to add
+void SweepAndPrune_Add(SweepAndPrune* sap, GObject* obj)
+{
+	unsigned int index;
+	if(SweepAndPrune_LookUpProxy(sap, obj, &index))
+	{
+		SweepAndPrune_UpdateObject(sap, obj);
+		return;
+	}
+
+	//Reuse a free proxy before growing
+	if(sap->freeProxies->size > 0)
+	{
+		index = ((unsigned int*)sap->freeProxies->data)[--sap->freeProxies->size];
+	}
+	else
+	{
+		index = sap->proxies->size;
+		struct SweepAndPrune_Proxy empty = { 0 };
+		DynamicArray_SweepAndPruneProxy_Append(sap->proxies, empty);
+	}
+
+	struct SweepAndPrune_Proxy* proxy = DynamicArray_SweepAndPruneProxy_Index(sap->proxies, index);
+	proxy->obj = obj;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	Collider_GetWorldAABBUnbounded(&proxy->bounds, obj->collider, frame);
+	HashMap_Add(sap->map, &obj, (void*)(uintptr_t)index, sizeof(GObject*));
+
+	struct SweepAndPrune_Endpoint endpoints[2] =
+	{
+		{ proxy->bounds.min[sap->axis], index },
+		{ proxy->bounds.max[sap->axis], index | SweepAndPrune_ENDPOINT_MAX }
+	};
+	DynamicArray_SweepAndPruneEndpoint_AppendN(sap->endpoints, endpoints, 2);
+	sap->numUnsorted += 2;
+}
+
+///
+//Removes a game object from a sweep and prune
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to remove from
+//	obj: A pointer to the game object to remove
+void SweepAndPrune_Remove(SweepAndPrune* sap, GObject* obj)
+{
+	unsigned int index;
+	if(!SweepAndPrune_LookUpProxy(sap, obj, &index)) return;
+	HashMap_Remove(sap->map, &obj, sizeof(GObject*));
+
+	//The proxy's endpoints are dropped by the next update, only then may it be reused
+	DynamicArray_SweepAndPruneProxy_Index(sap->proxies, index)->obj = NULL;
+	DynamicArray_Append(sap->releasedProxies, &index);
+}
+
+///
+//Recomputes the bounds of a single game object in a sweep and prune
+//Call this for every object whose frame of reference has changed since the last update.
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to update
+//	obj: A pointer to the game object which moved
+void SweepAndPrune_UpdateObject(SweepAndPrune* sap, GObject* obj)
+{
+	unsigned int index;
+	if(!SweepAndPrune_LookUpProxy(sap, obj, &index)) return;
+
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	Collider_GetWorldAABBUnbounded(&DynamicArray_SweepAndPruneProxy_Index(sap->proxies, index)->bounds, obj->collider, frame);
+}
+
+///
+//Sorts the endpoints of a sweep and prune by the current bounds of it's objects.
+//The sweep axis changes when objects are spread SweepAndPrune_AXIS_SWITCH_RATIO times further along another axis.
+//Endpoints are sorted by insertion, which is linear when few have changed order since the last update,
+//unless the axis changed or many endpoints were added.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to update
+void SweepAndPrune_Update(SweepAndPrune* sap)
+{
+	unsigned int axis = SweepAndPrune_ChooseAxis(sap);
+	unsigned char resort = axis != sap->axis;
+	sap->axis = axis;
+
+	SweepAndPrune_RefreshEndpoints(sap);
+
+	struct SweepAndPrune_Endpoint* endpoints = DynamicArray_SweepAndPruneEndpoint_Data(sap->endpoints);
+	unsigned int numEndpoints = sap->endpoints->size;
+	if(resort || sap->numUnsorted > numEndpoints * SweepAndPrune_RESORT_FRACTION)
+	{
+		qsort(endpoints, numEndpoints, sizeof(struct SweepAndPrune_Endpoint), SweepAndPrune_CompareEndpoints);
+	}
+	else
+	{
+		for(unsigned int i = 1; i < numEndpoints; i++)
+		{
+			struct SweepAndPrune_Endpoint endpoint = endpoints[i];
+			unsigned int j = i;
+			while(j > 0 && SweepAndPrune_IsBefore(&endpoint, endpoints + j - 1))
+			{
+				endpoints[j] = endpoints[j - 1];
+				j--;
+			}
+			endpoints[j] = endpoint;
+		}
+	}
+
+	sap->numUnsorted = 0;
+}
+
+///
+//Sweeps the sorted endpoints of a sweep and prune finding every pair of objects whose bounds overlap
+//Each pair is appended once, in an order which only depends on the order of the endpoints.
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	dest: A pointer to the dynamic array to append the pairs to (struct GObject_Pair)
+void SweepAndPrune_GetPairs(SweepAndPrune* sap, DynamicArray* dest)
+{
+	struct SweepAndPrune_Proxy* proxies = DynamicArray_SweepAndPruneProxy_Data(sap->proxies);
+	unsigned int otherAxis1 = (sap->axis + 1) % 3;
+	unsigned int otherAxis2 = (sap->axis + 2) % 3;
+
+	sap->active->size = 0;
+	DYNARRAY_FOREACH(SweepAndPruneEndpoint, endpoint, sap->endpoints)
+	{
+		unsigned int index = endpoint->proxy & ~SweepAndPrune_ENDPOINT_MAX;
+		struct SweepAndPrune_Proxy* proxy = proxies + index;
+		unsigned int* active = (unsigned int*)sap->active->data;
+
+		if(endpoint->proxy & SweepAndPrune_ENDPOINT_MAX)
+		{
+			//The proxy's bounds end here, move the last active proxy into it's place
+			unsigned int last = active[--sap->active->size];
+			active[proxy->activeIndex] = last;
+			proxies[last].activeIndex = proxy->activeIndex;
+			continue;
+		}
+
+		//Every active proxy overlaps this one along the sweep axis
+		for(unsigned int i = 0; i < sap->active->size; i++)
+		{
+			struct SweepAndPrune_Proxy* other = proxies + active[i];
+			if(other->bounds.min[otherAxis1] > proxy->bounds.max[otherAxis1] || proxy->bounds.min[otherAxis1] > other->bounds.max[otherAxis1]) continue;
+			if(other->bounds.min[otherAxis2] > proxy->bounds.max[otherAxis2] || proxy->bounds.min[otherAxis2] > other->bounds.max[otherAxis2]) continue;
+
+			struct GObject_Pair pair = { other->obj, proxy->obj };
+			DynamicArray_GObjectPair_Append(dest, pair);
+		}
+
+		proxy->activeIndex = sap->active->size;
+		DynamicArray_Append(sap->active, &index);
+	}
+}
+
+///
+//Finds every object in an updated sweep and prune whose bounds overlap an axis aligned bounding box
+//Only the endpoints before the end of the bounds along the sweep axis are visited.
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SweepAndPrune_QueryAABB(SweepAndPrune* sap, const struct ColliderData_AABB* bounds, DynamicArray* dest)
+{
+	struct SweepAndPrune_Proxy* proxies = DynamicArray_SweepAndPruneProxy_Data(sap->proxies);
+	struct SweepAndPrune_Endpoint* endpoints = DynamicArray_SweepAndPruneEndpoint_Data(sap->endpoints);
+	unsigned int numSorted = sap->endpoints->size - sap->numUnsorted;
+
+	for(unsigned int i = 0; i < sap->endpoints->size; i++)
+	{
+		//Sorted endpoints past the end of the bounds can not begin an overlapping proxy, endpoints added since the last update are unsorted
+		if(i < numSorted && endpoints[i].value > bounds->max[sap->axis])
+		{
+			i = numSorted - 1;
+			continue;
+		}
+		if(endpoints[i].proxy & SweepAndPrune_ENDPOINT_MAX) continue;
+
+		struct SweepAndPrune_Proxy* proxy = proxies + endpoints[i].proxy;
+		if(proxy->obj == NULL) continue;
+		if(proxy->bounds.min[0] > bounds->max[0] || bounds->min[0] > proxy->bounds.max[0]) continue;
+		if(proxy->bounds.min[1] > bounds->max[1] || bounds->min[1] > proxy->bounds.max[1]) continue;
+		if(proxy->bounds.min[2] > bounds->max[2] || bounds->min[2] > proxy->bounds.max[2]) continue;
+
+		DynamicArray_Append(dest, &proxy->obj);
+	}
+}
+
+///
+//Finds every object in an updated sweep and prune whose bounds are crossed by a ray
+//Only the endpoints on the side of the ray's origin it points towards along the sweep axis are visited.
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SweepAndPrune_QueryRay(SweepAndPrune* sap, struct ColliderData_Ray* worldRay, DynamicArray* dest)
+{
+	struct SweepAndPrune_SlabRay ray;
+	for(int i = 0; i < 3; i++)
+	{
+		float direction = worldRay->direction->components[i];
+		ray.origin[i] = worldRay->position->components[i];
+		ray.parallel[i] = direction > -FLT_EPSILON && direction < FLT_EPSILON;
+		ray.inverseDirection[i] = ray.parallel[i] ? 0.0f : 1.0f / direction;
+	}
+
+	struct SweepAndPrune_Proxy* proxies = DynamicArray_SweepAndPruneProxy_Data(sap->proxies);
+	struct SweepAndPrune_Endpoint* endpoints = DynamicArray_SweepAndPruneEndpoint_Data(sap->endpoints);
+	unsigned int numSorted = sap->endpoints->size - sap->numUnsorted;
+	unsigned int axis = sap->axis;
+
+	//A ray pointing up the sweep axis only crosses proxies ending after it's origin, each visited at it's maximum endpoint.
+	//Any other ray only crosses proxies beginning before it's origin, each visited at it's minimum endpoint.
+	unsigned char forward = !ray.parallel[axis] && ray.inverseDirection[axis] > 0.0f;
+	unsigned int begin = forward ? SweepAndPrune_LowerBound(sap, ray.origin[axis]) : 0;
+	unsigned int end = forward ? numSorted : SweepAndPrune_LowerBound(sap, ray.origin[axis]);
+	//Minimum endpoints equal to the origin begin proxies the ray may start on
+	while(!forward && end < numSorted && endpoints[end].value == ray.origin[axis]) end++;
+
+	for(unsigned int i = begin; i < sap->endpoints->size; i++)
+	{
+		//Endpoints added since the last update are unsorted and always visited
+		if(i == end && i < numSorted)
+		{
+			i = numSorted - 1;
+			continue;
+		}
+
+		unsigned char isMax = (endpoints[i].proxy & SweepAndPrune_ENDPOINT_MAX) != 0;
+		if(i < numSorted ? isMax != forward : isMax) continue;
+
+		struct SweepAndPrune_Proxy* proxy = proxies + (endpoints[i].proxy & ~SweepAndPrune_ENDPOINT_MAX);
+		if(proxy->obj == NULL) continue;
+		if(!SweepAndPrune_DoesRayCross(&proxy->bounds, &ray)) continue;
+
+		DynamicArray_Append(dest, &proxy->obj);
+	}
+}
+
+///
+//Gets the index of the proxy of a game object
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune holding the object
+//	obj: A pointer to the game object
+//	dest: A pointer to the destination of the proxy's index
+//
+//Returns:
+//	1 if the object has a proxy, else 0
+static unsigned char SweepAndPrune_LookUpProxy(SweepAndPrune* sap, GObject* obj, unsigned int* dest)
+{
+	struct HashMap_KeyValuePair* pair = HashMap_LookUp(sap->map, &obj, sizeof(GObject*));
+	if(pair == NULL) return 0;
+
+	*dest = (unsigned int)(uintptr_t)pair->data;
+	return 1;
+}
+
+///
+//Chooses the axis along which the centers of a sweep and prune's objects are most spread out
+//The current axis is kept unless another is spread SweepAndPrune_AXIS_SWITCH_RATIO times further.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to choose the axis of
+//
+//Returns:
+//	The axis to sweep along
+static unsigned int SweepAndPrune_ChooseAxis(SweepAndPrune* sap)
+{
+	double sum[3] = { 0.0, 0.0, 0.0 };
+	double sumSquares[3] = { 0.0, 0.0, 0.0 };
+	unsigned int numBounded = 0;
+
+	DYNARRAY_FOREACH(SweepAndPruneProxy, proxy, sap->proxies)
+	{
+		//Free proxies and unbounded objects say nothing about the spread
+		if(proxy->obj == NULL || proxy->bounds.min[0] == -FLT_MAX) continue;
+
+		for(int i = 0; i < 3; i++)
+		{
+			double center = 0.5 * ((double)proxy->bounds.min[i] + proxy->bounds.max[i]);
+			sum[i] += center;
+			sumSquares[i] += center * center;
+		}
+		numBounded++;
+	}
+	if(numBounded < 2) return sap->axis;
+
+	//Compare variances, the squares of the spreads
+	double variance[3];
+	unsigned int widest = sap->axis;
+	for(int i = 0; i < 3; i++)
+	{
+		double mean = sum[i] / numBounded;
+		variance[i] = sumSquares[i] / numBounded - mean * mean;
+		if(variance[i] > variance[widest]) widest = i;
+	}
+
+	double ratio = SweepAndPrune_AXIS_SWITCH_RATIO;
+	return variance[widest] > variance[sap->axis] * ratio * ratio ? widest : sap->axis;
+}
+
+///
+//Drops the endpoints of released proxies and sets the value of every other endpoint
+//to it's proxy's bounds along the sweep axis, freeing the released proxies for reuse
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to refresh
+static void SweepAndPrune_RefreshEndpoints(SweepAndPrune* sap)
+{
+	struct SweepAndPrune_Proxy* proxies = DynamicArray_SweepAndPruneProxy_Data(sap->proxies);
+	struct SweepAndPrune_Endpoint* endpoints = DynamicArray_SweepAndPruneEndpoint_Data(sap->endpoints);
+	unsigned int numKept = 0;
+
+	for(unsigned int i = 0; i < sap->endpoints->size; i++)
+	{
+		struct SweepAndPrune_Endpoint endpoint = endpoints[i];
+		struct SweepAndPrune_Proxy* proxy = proxies + (endpoint.proxy & ~SweepAndPrune_ENDPOINT_MAX);
+		if(proxy->obj == NULL) continue;
+
+		endpoint.value = (endpoint.proxy & SweepAndPrune_ENDPOINT_MAX) ? proxy->bounds.max[sap->axis] : proxy->bounds.min[sap->axis];
+		endpoints[numKept++] = endpoint;
+	}
+	sap->endpoints->size = numKept;
+
+	DynamicArray_AppendN(sap->freeProxies, sap->releasedProxies->data, sap->releasedProxies->size);
+	sap->releasedProxies->size = 0;
+}
+
+///
+//Determines if an endpoint belongs before another along the sweep axis
+//Minimum endpoints come before maximum endpoints of equal value so touching bounds overlap,
+//remaining ties are broken by proxy index so the order is total.
+//
+//Parameters:
+//	a: A pointer to the first endpoint
+//	b: A pointer to the second endpoint
+//
+//Returns:
+//	1 if a belongs before b, else 0
+static unsigned char SweepAndPrune_IsBefore(const struct SweepAndPrune_Endpoint* a, const struct SweepAndPrune_Endpoint* b)
+{
+	if(a->value != b->value) return a->value < b->value;
+	//Minimum endpoints have the high bit clear, so comparing the proxies orders minimums first
+	return a->proxy < b->proxy;
+}
+
+///
+//Compares two endpoints for qsort
+//
+//Parameters:
+//	a: A pointer to the first struct SweepAndPrune_Endpoint
+//	b: A pointer to the second struct SweepAndPrune_Endpoint
+//
+//Returns:
+//	-1 if a belongs before b, 1 if b belongs before a, else 0
+static int SweepAndPrune_CompareEndpoints(const void* a, const void* b)
+{
+	const struct SweepAndPrune_Endpoint* endpointA = (const struct SweepAndPrune_Endpoint*)a;
+	const struct SweepAndPrune_Endpoint* endpointB = (const struct SweepAndPrune_Endpoint*)b;
+	if(SweepAndPrune_IsBefore(endpointA, endpointB)) return -1;
+	if(SweepAndPrune_IsBefore(endpointB, endpointA)) return 1;
+	return 0;
+}
+
+///
+//Finds the index of the first sorted endpoint of a sweep and prune lying at or after a value along the sweep axis
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	value: The position along the sweep axis
+//
+//Returns:
+//	The index of the first endpoint whose value is not less than value, or the number of sorted endpoints if there is none
+static unsigned int SweepAndPrune_LowerBound(SweepAndPrune* sap, float value)
+{
+	struct SweepAndPrune_Endpoint* endpoints = DynamicArray_SweepAndPruneEndpoint_Data(sap->endpoints);
+	unsigned int first = 0;
+	unsigned int last = sap->endpoints->size - sap->numUnsorted;
+	while(first < last)
+	{
+		unsigned int middle = first + (last - first) / 2;
+		if(endpoints[middle].value < value) first = middle + 1;
+		else last = middle;
+	}
+	return first;
+}
+
+///
+//Determines if a prepared ray crosses an axis aligned bounding box using the slab method
+//
+//Parameters:
+//	bounds: A pointer to the AABB
+//	ray: A pointer to the prepared ray
+//
+//Returns:
+//	1 if the ray crosses the bounds, else 0
+static unsigned char SweepAndPrune_DoesRayCross(const struct ColliderData_AABB* bounds, const struct SweepAndPrune_SlabRay* ray)
+{
+	float entry = 0.0f;
+	float exit = FLT_MAX;
+	for(int i = 0; i < 3; i++)
+	{
+		//A ray parallel to a slab must start within it
+		if(ray->parallel[i])
+		{
+			if(ray->origin[i] < bounds->min[i] || ray->origin[i] > bounds->max[i]) return 0;
+			continue;
+		}
+
+		float t1 = (bounds->min[i] - ray->origin[i]) * ray->inverseDirection[i];
+		float t2 = (bounds->max[i] - ray->origin[i]) * ray->inverseDirection[i];
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > entry) entry = t1;
+		if(t2 < exit) exit = t2;
+		if(entry > exit) return 0;
+	}
+	return 1;
+}
@@ -0,0 +1,153 @@
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include "../GObject/GObject.h"		//The data the sweep and prune will contain
+#include "DynamicArray.h"
+#include "HashMap.h"
+
+//Set on the proxy index of an endpoint which is the maximum of it's proxy's bounds
+#define SweepAndPrune_ENDPOINT_MAX 0x80000000u
+//Factor by which the spread of object centers along another axis must exceed the spread along the sweep axis before sweeping along it instead
+#define SweepAndPrune_AXIS_SWITCH_RATIO 2.0f
+//Fraction of endpoints which may have been added since the last update before they are sorted from scratch rather than by insertion
+#define SweepAndPrune_RESORT_FRACTION 0.25f
+
+///
+//The bounds of a single game object in a sweep and prune
+struct SweepAndPrune_Proxy
+{
+	GObject* obj;				//The object bounded by this proxy, NULL while the proxy is free
+	struct ColliderData_AABB bounds;	//World space bounds of the object as of it's last update
+	unsigned int activeIndex;		//Index of this proxy in the active list while sweeping
+};
+
+///
+//An endpoint of a proxy's bounds along the sweep axis
+struct SweepAndPrune_Endpoint
+{
+	float value;		//Position of the endpoint along the sweep axis
+	unsigned int proxy;	//Index of the proxy, with SweepAndPrune_ENDPOINT_MAX set on maximum endpoints
+};
+
+//Typed accessors for proxy and endpoint arrays
+DYNARRAY_DECLARE(SweepAndPruneProxy, struct SweepAndPrune_Proxy);
+DYNARRAY_DECLARE(SweepAndPruneEndpoint, struct SweepAndPrune_Endpoint);
+
+typedef struct SweepAndPrune
+{
+	//Proxies of every object (struct SweepAndPrune_Proxy), including free ones
+	DynamicArray* proxies;
+	//Indices of free proxies whose endpoints have been purged and may be reused (unsigned int)
+	DynamicArray* freeProxies;
+	//Indices of proxies removed since the last update whose endpoints are still in the endpoint array (unsigned int)
+	DynamicArray* releasedProxies;
+
+	//Two endpoints for every proxy (struct SweepAndPrune_Endpoint).
+	//Sorted along the sweep axis as of the last update, kept between updates
+	//so objects which barely moved only need a few swaps to sort again.
+	DynamicArray* endpoints;
+	//Number of endpoints appended since the last update
+	unsigned int numUnsorted;
+
+	//Proxies overlapping the current point of a sweep (unsigned int)
+	DynamicArray* active;
+
+	//Axis the endpoints are sorted along, 0, 1 or 2 for x, y or z
+	unsigned int axis;
+
+	//Maps each object to the index of it's proxy
+	HashMap* map;
+} SweepAndPrune;
+
+///
+//Allocates memory for a sweep and prune
+//
+//Returns:
+//	Pointer to a newly allocated uninitialized sweep and prune
+SweepAndPrune* SweepAndPrune_Allocate(void);
+
+///
+//Initializes an empty sweep and prune
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to initialize
+//	axis: The axis to sweep along until the objects are spread further along another
+void SweepAndPrune_Initialize(SweepAndPrune* sap, unsigned int axis);
+
+///
+//Frees the data allocated by a sweep and prune.
+//Does not free any of the objects contained within it!
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to free
+void SweepAndPrune_Free(SweepAndPrune* sap);
+
+///
+//Adds a game object with a collider to a sweep and prune
+//The object is sorted into place by the next call to SweepAndPrune_Update.
+//Objects which have already been added are updated instead.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to add to
+//	obj: A pointer to the game object to add
+void SweepAndPrune_Add(SweepAndPrune* sap, GObject* obj);
+
+///
+//Removes a game object from a sweep and prune
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to remove from
+//	obj: A pointer to the game object to remove
+void SweepAndPrune_Remove(SweepAndPrune* sap, GObject* obj);
+
+///
+//Recomputes the bounds of a single game object in a sweep and prune
+//Call this for every object whose frame of reference has changed since the last update.
+//Objects which have not been added are ignored.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to update
+//	obj: A pointer to the game object which moved
+void SweepAndPrune_UpdateObject(SweepAndPrune* sap, GObject* obj);
+
+///
+//Sorts the endpoints of a sweep and prune by the current bounds of it's objects.
+//The sweep axis changes when objects are spread SweepAndPrune_AXIS_SWITCH_RATIO times further along another axis.
+//Endpoints are sorted by insertion, which is linear when few have changed order since the last update,
+//unless the axis changed or many endpoints were added.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune to update
+void SweepAndPrune_Update(SweepAndPrune* sap);
+
+///
+//Sweeps the sorted endpoints of a sweep and prune finding every pair of objects whose bounds overlap
+//Each pair is appended once, in an order which only depends on the order of the endpoints.
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	dest: A pointer to the dynamic array to append the pairs to (struct GObject_Pair)
+void SweepAndPrune_GetPairs(SweepAndPrune* sap, DynamicArray* dest);
+
+///
+//Finds every object in an updated sweep and prune whose bounds overlap an axis aligned bounding box
+//Only the endpoints before the end of the bounds along the sweep axis are visited.
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	bounds: A pointer to the world space bounds to test
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SweepAndPrune_QueryAABB(SweepAndPrune* sap, const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Finds every object in an updated sweep and prune whose bounds are crossed by a ray
+//Only the endpoints on the side of the ray's origin it points towards along the sweep axis are visited.
+//
+//Parameters:
+//	sap: A pointer to the updated sweep and prune
+//	worldRay: A pointer to the ray to test oriented in world space
+//	dest: A pointer to the dynamic array to append the objects to (GObject*)
+void SweepAndPrune_QueryRay(SweepAndPrune* sap, struct ColliderData_Ray* worldRay, DynamicArray* dest);
+
+#endif
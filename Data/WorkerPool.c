@@ -0,0 +1,235 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "WorkerPool.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+///
+//Static Declarations
+
+///
+//Takes and runs tasks of the current run until none remain
+//The pool's mutex must be held when called and is held when this returns.
+//
+//Parameters:
+//	pool: A pointer to the worker pool to run tasks from
+static void WorkerPool_RunAvailableTasks(WorkerPool* pool);
+
+///
+//Entry point of each worker thread
+//
+//Parameters:
+//	arg: A pointer to the worker pool the thread belongs to
+//
+//Returns:
+//	NULL
+static void* WorkerPool_WorkerMain(void* arg);
+
+///
+//Implementations
+
+///
+//Allocates a worker pool
+//
+//Returns:
+//	A pointer to a newly allocated, uninitialized worker pool
+WorkerPool* WorkerPool_Allocate(void)
+{
+	WorkerPool* pool = (WorkerPool*)malloc(sizeof(WorkerPool));
+	return pool;
+}
+
+///
+//Initializes a worker pool and starts it's threads
+//
+//Parameters:
+//	pool: A pointer to the worker pool to initialize
+//	numThreads: The number of worker threads to start, 0 runs every task on the calling thread
+void WorkerPool_Initialize(WorkerPool* pool, unsigned int numThreads)
+{
+	pthread_mutex_init(&pool->mutex, NULL);
+	pthread_cond_init(&pool->workReady, NULL);
+	pthread_cond_init(&pool->workDone, NULL);
+
+	pool->task = NULL;
+	pool->data = NULL;
+	pool->numTasks = 0;
+	pool->nextTask = 0;
+	pool->numFinished = 0;
+	pool->shuttingDown = 0;
+
+	pool->threads = (pthread_t*)malloc(sizeof(pthread_t) * (numThreads > 0 ? numThreads : 1));
+	pool->numThreads = 0;
+	for(unsigned int i = 0; i < numThreads; i++)
+	{
+		if(pthread_create(pool->threads + pool->numThreads, NULL, WorkerPool_WorkerMain, pool) != 0)
+		{
+			printf("WorkerPool_Initialize failed to start worker thread %u.\n", i);
+			break;
+		}
+		pool->numThreads++;
+	}
+}
+
+///
+//Stops the threads of a worker pool and frees it
+//
+//Parameters:
+//	pool: A pointer to the worker pool to free
+void WorkerPool_Free(WorkerPool* pool)
+{
+	pthread_mutex_lock(&pool->mutex);
+	pool->shuttingDown = 1;
+	pthread_cond_broadcast(&pool->workReady);
+	pthread_mutex_unlock(&pool->mutex);
+
+	for(unsigned int i = 0; i < pool->numThreads; i++)
+	{
+		pthread_join(pool->threads[i], NULL);
+	}
+
+	pthread_cond_destroy(&pool->workDone);
+	pthread_cond_destroy(&pool->workReady);
+	pthread_mutex_destroy(&pool->mutex);
+
+	free(pool->threads);
+	free(pool);
+}
+
+///
+//Runs a number of tasks across the worker pool and the calling thread
+//Returns once every task has finished. Tasks may run in any order.
+//
+//Parameters:
+//	pool: A pointer to the worker pool to run the tasks on, or NULL to run them on the calling thread
+//	task: The function to run for each task
+//	data: The data to pass to every task
+//	numTasks: The number of tasks to run
+void WorkerPool_Run(WorkerPool* pool, WorkerPool_Task task, void* data, unsigned int numTasks)
+{
+	//Without workers there is nothing to hand off
+	if(pool == NULL || pool->numThreads == 0 || numTasks <= 1)
+	{
+		for(unsigned int i = 0; i < numTasks; i++)
+		{
+			task(data, i);
+		}
+		return;
+	}
+
+	pthread_mutex_lock(&pool->mutex);
+
+	pool->task = task;
+	pool->data = data;
+	pool->numTasks = numTasks;
+	pool->nextTask = 0;
+	pool->numFinished = 0;
+	pthread_cond_broadcast(&pool->workReady);
+
+	//Work alongside the pool, then wait for tasks still running on the workers
+	WorkerPool_RunAvailableTasks(pool);
+	while(pool->numFinished < pool->numTasks)
+	{
+		pthread_cond_wait(&pool->workDone, &pool->mutex);
+	}
+
+	//Leave the run empty so woken workers go back to sleep
+	pool->numTasks = 0;
+	pool->nextTask = 0;
+
+	pthread_mutex_unlock(&pool->mutex);
+}
+
+///
+//Gets the number of threads which run the tasks of a worker pool
+//
+//Parameters:
+//	pool: A pointer to the worker pool, or NULL
+//
+//Returns:
+//	The number of worker threads plus the calling thread
+unsigned int WorkerPool_GetConcurrency(const WorkerPool* pool)
+{
+	return pool != NULL ? pool->numThreads + 1 : 1;
+}
+
+///
+//Gets the number of processors available to the process
+//
+//Returns:
+//	The number of online processors, at least 1
+unsigned int WorkerPool_GetNumProcessors(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	long numProcessors = (long)info.dwNumberOfProcessors;
+#else
+	long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return numProcessors > 0 ? (unsigned int)numProcessors : 1;
+}
+
+///
+//Takes and runs tasks of the current run until none remain
+//The pool's mutex must be held when called and is held when this returns.
+//
+//Parameters:
+//	pool: A pointer to the worker pool to run tasks from
+static void WorkerPool_RunAvailableTasks(WorkerPool* pool)
+{
+	while(pool->nextTask < pool->numTasks)
+	{
+		unsigned int taskIndex = pool->nextTask++;
+		WorkerPool_Task task = pool->task;
+		void* data = pool->data;
+
+		pthread_mutex_unlock(&pool->mutex);
+		task(data, taskIndex);
+		pthread_mutex_lock(&pool->mutex);
+
+		pool->numFinished++;
+		if(pool->numFinished == pool->numTasks)
+		{
+			pthread_cond_signal(&pool->workDone);
+		}
+	}
+}
+
+///
+//Entry point of each worker thread
+//
+//Parameters:
+//	arg: A pointer to the worker pool the thread belongs to
+//
+//Returns:
+//	NULL
+static void* WorkerPool_WorkerMain(void* arg)
+{
+	WorkerPool* pool = (WorkerPool*)arg;
+
+	pthread_mutex_lock(&pool->mutex);
+	while(!pool->shuttingDown)
+	{
+		if(pool->nextTask < pool->numTasks)
+		{
+			WorkerPool_RunAvailableTasks(pool);
+		}
+		else
+		{
+			pthread_cond_wait(&pool->workReady, &pool->mutex);
+		}
+	}
+	pthread_mutex_unlock(&pool->mutex);
+
+	return NULL;
+}
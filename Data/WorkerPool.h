@@ -0,0 +1,85 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <pthread.h>
+
+///
+//A function run by the workers of a worker pool
+//
+//Parameters:
+//	data: The data shared by every task of the run
+//	taskIndex: The index of the task being run, from 0 to the number of tasks - 1
+typedef void (*WorkerPool_Task)(void* data, unsigned int taskIndex);
+
+///
+//A set of persistent threads which run indexed tasks in parallel.
+//The thread calling WorkerPool_Run works alongside the pool's threads.
+typedef struct WorkerPool
+{
+	pthread_t* threads;		//Worker threads
+	unsigned int numThreads;	//Number of worker threads, not counting the thread calling WorkerPool_Run
+
+	pthread_mutex_t mutex;		//Guards all members below
+	pthread_cond_t workReady;	//Signaled when a run begins or the pool shuts down
+	pthread_cond_t workDone;	//Signaled when the last task of a run finishes
+
+	WorkerPool_Task task;		//Task of the current run
+	void* data;			//Data of the current run
+	unsigned int numTasks;		//Number of tasks in the current run
+	unsigned int nextTask;		//Index of the next task to hand out
+	unsigned int numFinished;	//Number of tasks of the current run which have finished
+
+	unsigned char shuttingDown;	//Set when the pool is freed to release the workers
+} WorkerPool;
+
+///
+//Allocates a worker pool
+//
+//Returns:
+//	A pointer to a newly allocated, uninitialized worker pool
+WorkerPool* WorkerPool_Allocate(void);
+
+///
+//Initializes a worker pool and starts it's threads
+//
+//Parameters:
+//	pool: A pointer to the worker pool to initialize
+//	numThreads: The number of worker threads to start, 0 runs every task on the calling thread
+void WorkerPool_Initialize(WorkerPool* pool, unsigned int numThreads);
+
+///
+//Stops the threads of a worker pool and frees it
+//
+//Parameters:
+//	pool: A pointer to the worker pool to free
+void WorkerPool_Free(WorkerPool* pool);
+
+///
+//Runs a number of tasks across the worker pool and the calling thread
+//Returns once every task has finished. Tasks may run in any order.
+//
+//Parameters:
+//	pool: A pointer to the worker pool to run the tasks on, or NULL to run them on the calling thread
+//	task: The function to run for each task
+//	data: The data to pass to every task
+//	numTasks: The number of tasks to run
+void WorkerPool_Run(WorkerPool* pool, WorkerPool_Task task, void* data, unsigned int numTasks);
+
+///
+//Gets the number of threads which run the tasks of a worker pool
+//
+//Parameters:
+//	pool: A pointer to the worker pool, or NULL
+//
+//Returns:
+//	The number of worker threads plus the calling thread
+unsigned int WorkerPool_GetConcurrency(const WorkerPool* pool);
+
+///
+//Gets the number of processors available to the process
+//
+//Returns:
+//	The number of online processors, at least 1
+unsigned int WorkerPool_GetNumProcessors(void);
+
+#endif
@@ -2,6 +2,20 @@
 
 #include "../Manager/ObjectManager.h"
 
+///
+//Internals
+static GObject_DirtyCallback dirtyCallback = NULL;
+
+///
+//Sets the function notified when a game object is first marked dirty
+//
+//Parameters:
+//	callback: The function to notify, or NULL to only set the mark
+void GObject_SetDirtyCallback(GObject_DirtyCallback callback)
+{
+	dirtyCallback = callback;
+}
+
 ///
 //Replaces below function for memory pools
 unsigned int GObject_Request(void)
@@ -39,6 +53,7 @@ void GObject_Initialize(GObject* GO)
 	GO->body = NULL;
 	GO->collider = NULL;
 	GO->light = NULL;
+	GO->dirty = 0;
 }
 
 ///
@@ -98,6 +113,7 @@ void GObject_InitializeDeepCopy(GObject* copy, GObject* original)
 		copy->light = NULL;
 	}
 
+	copy->dirty = 0;
 }
 
 ///
@@ -289,6 +305,7 @@ void GObject_Translate(GObject* GO, Vector* translation)
 	{
 		RigidBody_Translate(GO->body, translation);
 	}
+	GObject_MarkDirty(GO);
 }
 
 ///
@@ -305,6 +322,7 @@ void GObject_Rotate(GObject* GO,const Vector* axis, float radians)
 	{
 		RigidBody_Rotate(GO->body, axis, radians);
 	}
+	GObject_MarkDirty(GO);
 }
 
 ///
@@ -320,6 +338,7 @@ void GObject_Scale(GObject* GO, Vector* scaleVector)
 	{
 		RigidBody_Scale(GO->body, scaleVector);
 	}
+	GObject_MarkDirty(GO);
 }
 
 ///
@@ -335,6 +354,7 @@ void GObject_SetPosition(GObject* GO, Vector* position)
         {
 			RigidBody_SetPosition(GO->body, position);
         }
+        GObject_MarkDirty(GO);
 }
 
 ///
@@ -350,5 +370,19 @@ void GObject_SetRotation(GObject* GO, Matrix* rotation)
         {
 			RigidBody_SetRotation(GO->body, rotation);
         }
+        GObject_MarkDirty(GO);
 }
 
+///
+//Marks a GObject as having moved, notifying the dirty callback unless it is already marked
+//Must be called whenever an object's frame of reference is written to directly.
+//
+//Parameters:
+//	GO: The game object which moved
+void GObject_MarkDirty(GObject* GO)
+{
+	if(GO->dirty) return;
+
+	GO->dirty = 1;
+	if(dirtyCallback != NULL) dirtyCallback(GO);
+}
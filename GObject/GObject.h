@@ -12,6 +12,8 @@
 
 #include "../Collision/Collider.h"
 
+#include "../Data/DynamicArray.h"
+
 typedef struct GObject
 {
 	FrameOfReference* frameOfReference;
@@ -24,10 +26,31 @@ typedef struct GObject
 	unsigned int colliderType;	//TODO: Also temporary
 					//1 = sphere, 2 = AABB
 	unsigned int materialID;
-	unsigned int pad;
+	unsigned int dirty;		//Nonzero once moved until the mark is cleared, also pads the struct for OpenCL
 	//unsigned int padA, padB;
 } GObject;
 
+///
+//A pair of game objects whose bounds overlap, found by a broadphase
+struct GObject_Pair
+{
+	GObject* obj1;
+	GObject* obj2;
+};
+
+//Typed accessors for arrays of pairs
+DYNARRAY_DECLARE(GObjectPair, struct GObject_Pair);
+
+//Function notified the first time a game object is marked dirty after it's mark is cleared
+typedef void (*GObject_DirtyCallback)(GObject* GO);
+
+///
+//Sets the function notified when a game object is first marked dirty
+//
+//Parameters:
+//	callback: The function to notify, or NULL to only set the mark
+void GObject_SetDirtyCallback(GObject_DirtyCallback callback);
+
 ///
 //Replaces below function for memory pools
 unsigned int GObject_Request(void);
@@ -139,4 +162,12 @@ void GObject_SetPosition(GObject* GO, Vector* position);
 //  position: The rotation to set the object to
 void GObject_SetRotation(GObject* GO, Matrix* rotation);
 
+///
+//Marks a GObject as having moved, notifying the dirty callback unless it is already marked
+//Must be called whenever an object's frame of reference is written to directly.
+//
+//Parameters:
+//	GO: The game object which moved
+void GObject_MarkDirty(GObject* GO);
+
 #endif
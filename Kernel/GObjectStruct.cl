@@ -9,5 +9,5 @@ typedef struct GObject
 	uint colliderID;
 	uint colliderType;	//(ID, Type) 1 = sphere, 2 = AABB
 	uint materialID;
-	uint pad;
+	uint dirty;
 } GObject;
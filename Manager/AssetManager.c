@@ -536,7 +536,7 @@ static void AssetManager_FreeBuffer(AssetBuffer* buffer)
 {
 	for (unsigned int i = 0; i < buffer->meshMap->data->capacity; i++)
 	{
-		struct HashMap_KeyValuePair* pair = *(struct HashMap_KeyValuePair**)DynamicArray_Index(buffer->meshMap->data, i);
+		struct HashMap_KeyValuePair* pair = HashMap_GetPair(buffer->meshMap, i);
 		if(pair != NULL)
 		{
 			Mesh* m = (Mesh*)pair->data;
@@ -551,7 +551,7 @@ static void AssetManager_FreeBuffer(AssetBuffer* buffer)
 
 	for (unsigned int i = 0; i < buffer->textureMap->data->capacity; i++)
 	{
-		struct HashMap_KeyValuePair* pair = *(struct HashMap_KeyValuePair**)DynamicArray_Index(buffer->textureMap->data, i);
+		struct HashMap_KeyValuePair* pair = HashMap_GetPair(buffer->textureMap, i);
 		if(pair != NULL)
 		{
 			unsigned int ID = (unsigned int)pair->data;
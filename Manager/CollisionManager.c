@@ -1,8 +1,16 @@
 #include "CollisionManager.h"
+#include "SystemManager.h"
+#include "../Collision/GJK.h"
 #include <stdio.h>
+#include <string.h>
 #include <float.h>
 #include <math.h>
 
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define CollisionManager_SSE
+#endif
+
 ///
 //Declarations
 CollisionBuffer* collisionBuffer;
@@ -36,438 +44,1543 @@ static void CollisionManager_FreeBuffer(CollisionBuffer* buffer);
 static struct Collision* CollisionManager_AllocateCollision(void);
 
 ///
-//Initializes a collision
-//All members of the collision are set to NULL with the exception of the MTV
+//A collision found by a task of the narrowphase, copied into frame memory once every task has finished
+struct CollisionManager_Contact
+{
+	struct Collision collision;		//The collision, without it's minimum translation vector
+	float minimumTranslationVector[3];	//Components of the collision's minimum translation vector
+};
+
+///
+//The scratch memory and results of a single task of the narrowphase
+struct CollisionManager_NarrowphaseTask
+{
+	MemoryArena* scratch;	//Memory requested by the tests of the task, reset before every run
+	DynamicArray* contacts;	//Collisions found by the task in the order their pairs were tested (struct CollisionManager_Contact)
+	DynamicArray* axes;	//Axes which separated the task's convex pairs in the order they were tested (struct CollisionManager_SeparatingAxis)
+	struct CollisionManager_AxisCacheStats axisCacheStats;	//Counts of the task's last run
+};
+
+///
+//Dictates which axis separated a pair of convex colliders
+typedef enum
+{
+	SEPARATINGAXIS_NONE,		//No axis separated the pair
+	SEPARATINGAXIS_FACE1,		//The normal of the face index1 of the first collider
+	SEPARATINGAXIS_FACE2,		//The normal of the face index1 of the second collider
+	SEPARATINGAXIS_EDGES,		//The cross product of the edge index1 of the first collider and the edge index2 of the second
+	SEPARATINGAXIS_DIRECTION	//The world space direction found by GJK
+} SeparatingAxisType;
+
+///
+//The axis which separated a pair of convex colliders, tested first on the next frame
+//Faces and edges of AABBs are the world space axes.
+struct CollisionManager_SeparatingAxis
+{
+	GObject* obj1;			//The first object of the pair, the axis is only valid while the pair keeps the same order
+	GObject* obj2;			//The second object of the pair
+	SeparatingAxisType type;
+	unsigned int index1;
+	unsigned int index2;
+	float direction[3];		//Points from the second collider towards the first
+};
+
+///
+//A callback subscribed to a kind of contact event
+struct CollisionManager_ContactSubscription
+{
+	ContactEventType type;
+	GObject* obj;				//The object whose contacts are reported, NULL for every contact
+	CollisionManager_ContactCallback callback;	//NULL once unsubscribed while events were being dispatched
+	void* data;
+};
+
+//Typed accessors for contact, task, separating axis and subscription arrays
+DYNARRAY_DECLARE(CollisionContact, struct CollisionManager_Contact);
+DYNARRAY_DECLARE(NarrowphaseTask, struct CollisionManager_NarrowphaseTask);
+DYNARRAY_DECLARE(SeparatingAxis, struct CollisionManager_SeparatingAxis);
+DYNARRAY_DECLARE(PersistentContact, struct CollisionManager_PersistentContact);
+DYNARRAY_DECLARE(ContactSubscription, struct CollisionManager_ContactSubscription);
+
+///
+//The state of a run of the narrowphase
+struct CollisionManager_Narrowphase
+{
+	struct GObject_Pair* pairs;	//The pairs of objects to test
+	unsigned int numPairs;
+	unsigned int numTasks;		//Number of tasks the pairs are split into, each task tests a contiguous range of pairs
+	GObject** objects;		//The objects in the pairs, each appearing once
+	unsigned int numObjects;
+	unsigned int numUpdateTasks;	//Number of tasks the colliders of the objects are updated in
+};
+
+///
+//A convex collider as seen by the support functions of a GJK test
+struct CollisionManager_ConvexShape
+{
+	const struct ColliderData_ConvexHull* convexHull;	//The hull whose world space data is up to date, NULL if the collider is an AABB
+	const struct ColliderData_AABB* AABB;			//The world space AABB, NULL if the collider is a convex hull
+};
+
+///
+//A convex shape translated away from where it's support function places it, as tested by a sweep
+struct CollisionManager_SweptShape
+{
+	const struct GJK_Shape* shape;	//The shape before it is translated
+	float offset[3];		//The world space translation of the shape
+};
+
+///
+//Decides whether a pair of objects with colliders found by the broadphase is tested for collision,
+//checking their collision layers and then the pair filter, and counts the pair in the stats of their layers
+//
+//Parameters:
+//      obj1: A pointer to the first object of the pair
+//      obj2: A pointer to the second object of the pair
+//
+//Returns:
+//      1 if the pair should be tested for collision, else 0
+static unsigned char CollisionManager_AcceptPair(GObject* obj1, GObject* obj2);
+
+///
+//Removes the pairs which should not be tested for collision from an array of pairs found by a broadphase
+//
+//Parameters:
+//      pairs: A pointer to the dynamic array of pairs to filter (struct GObject_Pair)
+static void CollisionManager_FilterPairs(DynamicArray* pairs);
+
+///
+//Counts a collision in the stats of the collision layers of it's objects
+//
+//Parameters:
+//      collision: A pointer to the collision which occurred
+static void CollisionManager_CountCollision(const struct Collision* collision);
+
+///
+//Finds the pairs of objects with colliders within an oct tree node
+//Pairs which have already been found in another node this frame are skipped.
+//
+//Parameters:
+//      gameObjects: An array of pointers to the game objects in the node
+//      numObjects: The number of objects in the array
+static void CollisionManager_GetOctTreeNodePairs(GObject** gameObjects, unsigned int numObjects);
+
+///
+//Finds the pairs of objects with colliders in a loose oct tree
+//Every object is held by exactly one node of a loose oct tree, so each pair is only found once.
+//
+//Parameters:
+//      tree: A pointer to the compacted loose oct tree holding the game objects
+static void CollisionManager_GetLooseOctTreePairs(OctTree* tree);
+
+///
+//Finds the pairs of moving objects and static objects whose bounds overlap,
+//querying the static tree with the bounds of each object in the static pool which the tree does not hold.
+//Static objects are never paired with each other.
+static void CollisionManager_GetStaticPairs(void);
+
+///
+//Tests pairs of game objects for collision across the system's worker pool, registering the collisions which occur
+//The collisions are registered in the order of their pairs, regardless of how many threads tested them.
+//
+//Parameters:
+//      pairs: A pointer to the dynamic array of pairs to test (struct GObject_Pair)
+static void CollisionManager_TestPairs(DynamicArray* pairs);
+
+///
+//Carries the contact table over from the previous frame using this frame's list of collisions,
+//then finds and dispatches the contacts which began, stayed and ended.
+static void CollisionManager_UpdateContacts(void);
+
+///
+//Hands this frame's contact events to every subscriber, then drops the subscriptions removed while doing so
+static void CollisionManager_DispatchContactEvents(void);
+
+///
+//Tests one contiguous range of the pairs of a run of the narrowphase for collision
+//Collisions are stored in the task's contacts, any memory needed by the tests comes from the task's scratch arena.
+//
+//Parameters:
+//      data: A pointer to the struct CollisionManager_Narrowphase
+//      taskIndex: The index of the task to run
+static void CollisionManager_TestPairsTask(void* data, unsigned int taskIndex);
+
+///
+//Updates the world space colliders of one contiguous range of the objects of a run of the narrowphase
+//
+//Parameters:
+//      data: A pointer to the struct CollisionManager_Narrowphase
+//      taskIndex: The index of the task to run
+static void CollisionManager_UpdateCollidersTask(void* data, unsigned int taskIndex);
+
+///
+//Registers a collision, adding it to the list of collisions and to the current collisions of both objects
+//
+//Parameters:
+//      collision: A pointer to the collision in frame memory to register
+static void CollisionManager_RegisterCollision(struct Collision* collision);
+
+///
+//Tests for a collision between two objects whose world space colliders are up to date
+//
+//Parameters:
+//      dest: Collision to store the results of test in
+//      obj1: First game object to test (Must have collider attached)
+//      obj1FoR: Pointer to frame of reference to use to orient Object 1
+//      obj2: Second game object to test (Must have collider attached)
+//      obj2FoR: Pointer to frame of reference to use to orient Object 2
+//      axis: A pointer to the axis which separated a convex pair on the previous frame, replaced by the axis which separates it now.
+//              NULL to neither test nor remember an axis.
+//
+//Returns:
+//      1 if the remembered axis still separated the pair, else 0
+static unsigned char CollisionManager_TestUpdatedCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR, struct CollisionManager_SeparatingAxis* axis);
+
+///
+//Determines if a pair of collider types is tested by one of the convex tests, whose separating axes are remembered
+//
+//Parameters:
+//      type1: The type of the first collider
+//      type2: The type of the second collider
+//
+//Returns:
+//      1 if the pair is a convex hull on a convex hull or AABB, else 0
+static unsigned char CollisionManager_IsConvexPair(ColliderType type1, ColliderType type2);
+
+///
+//Tests if an object with an AABB is colliding with an object with a convex hull, testing a remembered separating axis first
+//
+//Parameters:
+//      dest: Collision to store the results of test in
+//      AABBObj: Pointer to the object which has an axis aligned bounding box
+//      AABBObjFrame: Pointer to the frame of reference used to orient the object with the AABB
+//      convexObj: Pointer to the object which has a convex hull collider
+//      convexFrame: Pointer to the frame of reference used to orient the the object with the convex hull collider
+//      axis: A pointer to the axis which separated the pair on the previous frame, replaced by the axis which separates it now, or NULL
+//
+//Returns:
+//      1 if the remembered axis still separated the pair, else 0
+static unsigned char CollisionManager_TestCachedAABBConvexCollision(struct Collision* dest, GObject* AABBObj, FrameOfReference* AABBObjFrame, GObject* convexObj, FrameOfReference* convexObjFrame, struct CollisionManager_SeparatingAxis* axis);
+
+///
+//Tests if two game object's convex hulls are colliding, testing a remembered separating axis first
+//
+//Parameters:
+//      dest: Collision to store the results of test in
+//      obj1: First game object to test (Must have collider attached)
+//      obj1FoR: Pointer to frame of reference to use to orient Object 1 convex hull
+//      obj2: Second game object to test (Must have collider attached)
+//      obj2FoR: Pointer to frame of reference to use to orient Object 2 convex hull
+//      axis: A pointer to the axis which separated the pair on the previous frame, replaced by the axis which separates it now, or NULL
+//
+//Returns:
+//      1 if the remembered axis still separated the pair, else 0
+static unsigned char CollisionManager_TestCachedConvexCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR, struct CollisionManager_SeparatingAxis* axis);
+
+///
+//Tests if two game objects with convex colliders are colliding using GJK, testing a remembered separating direction first
+//
+//Parameters:
+//      dest: Collision to store the results of test in
+//      obj1: First game object to test (Must have collider attached)
+//      obj1FoR: Pointer to frame of reference to use to orient Object 1 collider
+//      obj2: Second game object to test (Must have collider attached)
+//      obj2FoR: Pointer to frame of reference to use to orient Object 2 collider
+//      axis: A pointer to the axis which separated the pair on the previous frame, replaced by the axis which separates it now, or NULL
+//
+//Returns:
+//      1 if the remembered direction still separated the pair, else 0
+static unsigned char CollisionManager_TestCachedConvexCollisionGJK(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR, struct CollisionManager_SeparatingAxis* axis);
+
+///
+//Tests the face or edge axis which separated a pair of convex colliders on the previous frame
+//The axis is oriented and tested exactly as the full separating axis test would, so skipping the full test never changes a result.
+//
+//Parameters:
+//      axis: A pointer to the remembered axis, or NULL. It's type is set to SEPARATINGAXIS_NONE if it no longer separates the pair.
+//      convexHull1: The convex hull of the first collider, NULL if it is an AABB
+//      orientedPoints1: The oriented world space points of the first collider
+//      numPoints1: The number of points of the first collider
+//      convexHull2: The convex hull of the second collider, NULL if it is an AABB
+//      orientedPoints2: The oriented world space points of the second collider
+//      numPoints2: The number of points of the second collider
+//
+//Returns:
+//      1 if the axis still separates the pair, else 0
+static unsigned char CollisionManager_TestCachedAxis(struct CollisionManager_SeparatingAxis* axis,
+	const struct ColliderData_ConvexHull* convexHull1, const Vector** orientedPoints1, const unsigned int numPoints1,
+	const struct ColliderData_ConvexHull* convexHull2, const Vector** orientedPoints2, const unsigned int numPoints2);
+
+///
+//Gets a single world space face normal or edge of a convex collider
+//
+//Parameters:
+//      dest: The destination of the oriented axis
+//      convexHull: The convex hull of the collider whose world space data is up to date, NULL if it is an AABB
+//      index: The index of the face or edge
+//      edge: 1 to orient an edge, 0 to orient a face normal
+//
+//Returns:
+//      0 if the collider has no such face or edge, else 1
+static unsigned char CollisionManager_GetOrientedAxis(Vector* dest, const struct ColliderData_ConvexHull* convexHull, const unsigned int index, const unsigned char edge);
+
+///
+//Requests an array of zeroed vectors for use within a single collision test
+//Within a task of the narrowphase the vectors come from the task's scratch arena, elsewhere from frame memory.
+//
+//Parameters:
+//      count: The number of vectors in the array
+//      dimension: The dimension of each vector
+//
+//Returns:
+//      An array of pointers to the requested vectors
+static Vector** CollisionManager_RequestScratchVectors(unsigned int count, uint16_t dimension);
+
+///
+//Determines if two world space spheres overlap
+//Uses the same arithmetic as each lane of CollisionManager_TestSpherePairs.
+//
+//Parameters:
+//      sphere1: A pointer to the first sphere
+//      sphere2: A pointer to the second sphere
+//
+//Returns:
+//      1 if the distance between the centers is less than the sum of the radii, else 0
+static unsigned char CollisionManager_DoSpheresOverlap(const struct ColliderData_Sphere* sphere1, const struct ColliderData_Sphere* sphere2);
+
+///
+//Determines if two world space axis aligned bounding boxes overlap
+//
+//Parameters:
+//      AABB1: A pointer to the first AABB
+//      AABB2: A pointer to the second AABB
+//
+//Returns:
+//      1 if the AABBs overlap or touch on every axis, else 0
+static unsigned char CollisionManager_DoAABBsOverlap(const struct ColliderData_AABB* AABB1, const struct ColliderData_AABB* AABB2);
+
+///
+//Initializes the GJK shape of an object with a convex hull or AABB collider
+//
+//Parameters:
+//      dest: A pointer to the GJK shape to initialize
+//      data: A pointer to the convex shape the GJK shape's support function reads, must outlive the GJK shape
+//      obj: A pointer to the object whose world space collider is up to date
+//      frame: A pointer to the frame of reference used to orient the object's collider
+static void CollisionManager_InitializeConvexShape(struct GJK_Shape* dest, struct CollisionManager_ConvexShape* data, GObject* obj, FrameOfReference* frame);
+
+///
+//Finds the world space point of an oriented convex hull which is furthest along a direction
+//
+//Parameters:
+//      dest: The destination of the point
+//      shape: A pointer to the struct CollisionManager_ConvexShape of the hull
+//      direction: The world space direction to search along
+static void CollisionManager_SupportConvexHull(float dest[3], const void* shape, const float direction[3]);
+
+///
+//Finds the corner of a world space AABB which is furthest along a direction
+//
+//Parameters:
+//      dest: The destination of the point
+//      shape: A pointer to the struct CollisionManager_ConvexShape of the AABB
+//      direction: The world space direction to search along
+static void CollisionManager_SupportAABB(float dest[3], const void* shape, const float direction[3]);
+
+///
+//Gets the parametric value along a ray where it first meets the collider of a game object
+//Used as the test function of a ray cast through an AABB tree.
+//
+//Parameters:
+//      obj: A pointer to the game object to test
+//      worldRay: A pointer to the ray oriented in world space
+//      data: Unused
+//
+//Returns:
+//      The parametric value of the first intersection, NaN if the ray misses the collider or it cannot be ray cast against
+static float CollisionManager_GetRayGObjectIntersection(GObject* obj, struct ColliderData_Ray* worldRay, void* data);
+
+///
+//Gets the parametric value along a ray where it first meets a convex hull
+//Each face bounds a half space, the ray is inside the hull between the last face it enters and the first face it leaves.
+//
+//Parameters:
+//      worldRay: A pointer to the ray oriented in world space
+//      convexHull: A pointer to the convex hull whose world space data is up to date
+//
+//Returns:
+//      The parametric value of the first intersection, 0 if the ray starts within the hull, NaN if no intersection exists
+static float CollisionManager_GetRayConvexHullIntersection(struct ColliderData_Ray* worldRay, const struct ColliderData_ConvexHull* convexHull);
+
+///
+//Finds the objects in the query broadphase and the static tree whose colliders overlap a world space sphere or AABB
+//
+//Parameters:
+//      dest: A pointer to a dynamic array of GObject* to append the overlapping objects to
+//      bounds: A pointer to the world space bounds of the queried shape
+//      sphere: A pointer to the world space sphere to query, or NULL to query the bounds themselves
+//      filter: A function deciding which overlapping objects are reported, or NULL to report all of them
+//      data: Passed to the filter
+//
+//Returns:
+//      The number of objects appended to dest
+static unsigned int CollisionManager_Overlap(DynamicArray* dest, const struct ColliderData_AABB* bounds, const struct ColliderData_Sphere* sphere, CollisionManager_OverlapFilter filter, void* data);
+
+///
+//Appends the moving objects in the query broadphase whose bounds may overlap a world space AABB
+//
+//Parameters:
+//      bounds: A pointer to the world space AABB
+//      dest: A pointer to a dynamic array of GObject* to append the objects to
+static void CollisionManager_QueryBroadphaseAABB(const struct ColliderData_AABB* bounds, DynamicArray* dest);
+
+///
+//Appends the moving objects in the query broadphase whose bounds a world space ray may cross
+//
+//Parameters:
+//      worldRay: A pointer to the ray oriented in world space
+//      dest: A pointer to a dynamic array of GObject* to append the objects to
+static void CollisionManager_QueryBroadphaseRay(struct ColliderData_Ray* worldRay, DynamicArray* dest);
+
+///
+//Gets the squared distance from a point to the nearest point of an axis aligned bounding box
+//
+//Parameters:
+//      AABB: A pointer to the world space AABB
+//      point: The world space point
+//
+//Returns:
+//      The squared distance, 0 if the point lies within the AABB
+static float CollisionManager_GetAABBDistanceSq(const struct ColliderData_AABB* AABB, const float point[3]);
+
+///
+//Finds the point of a world space sphere which is furthest along a direction
+//
+//Parameters:
+//      dest: The destination of the point
+//      shape: A pointer to the struct ColliderData_Sphere oriented in world space
+//      direction: The world space direction to search along
+static void CollisionManager_SupportSphere(float dest[3], const void* shape, const float direction[3]);
+
+///
+//Finds the point of a translated convex shape which is furthest along a direction
+//
+//Parameters:
+//      dest: The destination of the point
+//      shape: A pointer to the struct CollisionManager_SweptShape
+//      direction: The world space direction to search along
+static void CollisionManager_SupportSwept(float dest[3], const void* shape, const float direction[3]);
+
+///
+//Finds how far a convex shape can be translated along a displacement before it touches an object's collider
+//The shape is advanced towards the collider by the distance GJK finds between them until they touch,
+//which can never carry it past the collider.
+//
+//Parameters:
+//      shape: A pointer to the world space shape at the start of the displacement
+//      displacement: The world space translation of the shape
+//      obj: A pointer to the object whose collider is tested
+//
+//Returns:
+//      The time of impact as a fraction of the displacement from 0 to 1, or NaN if the shape does not hit the collider
+static float CollisionManager_Sweep(const struct GJK_Shape* shape, const float displacement[3], GObject* obj);
+
+///
+//Performs the Separating Axis Theorem test with face normals
+//
+//Parameters:
+//      dest: A pointer to a collision to store the results of the test in. Results will not be stored if the test detects no collision
+//      orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1 involved in the test
+//      numAxes1: The number of axes belonging to object 1
+//      orientedPoints1: An array of pointers to vectors representing the oriented points of object 1 involved in the test
+//      numPoints1: The number of points belonging to object 1
+//      orientedAxes2: An array of pointersto vectors representing the oriented axes of object 2 involved in the test
+//      numAxes2: The number of axes belonging to object 2
+//      orientedPoints2: An array of pointers to vectors representing the oriented points of object 2 involved in the test
+//      numPoints2: The number of points belonging to object 2
+//      separatingAxis: A pointer to the axis to store the separating face in if the test detects no collision, or NULL
+//
+//Returns:
+//      0 if the test detects no collision
+//      1 if the test detects a collision
+static unsigned char CollisionManager_PerformSATFaces(struct Collision* dest,
+	const Vector** orientedAxes1, const unsigned int numAxes1, const Vector** orientedPoints1, const unsigned int numPoints1,
+	const Vector** orientedAxes2, const unsigned int numAxes2, const Vector** orientedPoints2, const unsigned int numPoints2,
+	struct CollisionManager_SeparatingAxis* separatingAxis);
+
+///
+//Performs the Separating axis theorem test with face normals
+//
+//Parameters:
+//      dest: A pointer to the collision to store the results of the test in. Resultswill not be stored if the test detects no collisions
+//      orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
+//      numEdges1: The number of edges belonging to object 1
+//      orientedPoints1: An array of pointers to vectors representing the oriented points of object 1
+//      numPoints1: The number of points belonging to object 1
+//      orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
+//      numEdges2: The number of edges belonging to object 2
+//  orientedPoints2: An array of pointers to vectors representing the oriented points of object 2
+//      numPoints2: the number of points belonging to object 2
+//      separatingAxis: A pointer to the axis to store the separating pair of edges in if the test detects no collision, or NULL
+static unsigned char CollisionManager_PerformSATEdges(struct Collision* dest,
+	const Vector** orientedEdges1, const unsigned int numEdges1, const Vector** orientedPoints1, const unsigned int numPoints1,
+	const Vector** orientedEdges2, const unsigned int numEdges2, const Vector** orientedPoints2, const unsigned int numPoints2,
+	struct CollisionManager_SeparatingAxis* separatingAxis);
+
+///
+//Projects a set of points onto a normalized axis getting the squared magnitude of the projection vector.
+//Finds the minimum and maximum values of the point set projected onto the axis.
+//
+//Parameters:
+//      dest: The destination of the projection bounds
+//      axis: The axis projecting onto
+//      points: The set of points to project onto the axis
+static void CollisionManager_GetProjectionBounds(struct ProjectionBounds* dest, const Vector* axis, const Vector** points, const int numPoints);
+
+
+///
+//Implementations
+
+///
+//Initializes the Collision Manager
+void CollisionManager_Initialize(void)
+{
+	//Allocate & initialize collision buffer
+	collisionBuffer = CollisionManager_AllocateBuffer();
+	CollisionManager_InitializeBuffer(collisionBuffer);
+}
+
+///
+//Frees any resources allocated by the collision manager
+void CollisionManager_Free(void)
+{
+	CollisionManager_FreeBuffer(collisionBuffer);
+}
+
+///
+//Tests for collisions on all objects which have colliders 
+//compiling a list of game objects which test true
+//Every pair of moving objects in the list is tested, then every moving object is tested against the static tree.
+//Contacts are carried over from the last update, so this must be called once per frame with every object to test.
+//
+//Parameters:
+//	gameObjects: THe list of gameObjects to test
+//
+//Returns:
+//	A pointer to a linked list of collisions which occurred this frame.
+LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
+{
+	//Clear the current list of collisions, the collisions themselves live in frame memory
+	LinkedList_Clear(collisionBuffer->collisions);
+
+	//Pair every moving object with a collider with every moving object after it in the list,
+	//the static tree pairs them with the static objects
+	BVH* staticTree = collisionBuffer->staticTree;
+	collisionBuffer->pairs->size = 0;
+	for(struct LinkedList_Node* currentNode = gameObjects->head; currentNode != NULL; currentNode = currentNode->next)
+	{
+		GObject* currentObj = (GObject*)currentNode->data;
+		if(currentObj->collider == NULL) continue;
+		if(staticTree != NULL && BVH_Contains(staticTree, currentObj)) continue;
+
+		for(struct LinkedList_Node* iterator = currentNode->next; iterator != NULL; iterator = iterator->next)
+		{
+			GObject* iteratorObj = (GObject*)iterator->data;
+			if(iteratorObj->collider == NULL) continue;
+			if(staticTree != NULL && BVH_Contains(staticTree, iteratorObj)) continue;
+
+			struct GObject_Pair pair = { currentObj, iteratorObj };
+			DynamicArray_GObjectPair_Append(collisionBuffer->pairs, pair);
+		}
+	}
+	CollisionManager_FilterPairs(collisionBuffer->pairs);
+	CollisionManager_GetStaticPairs();
+
+	CollisionManager_TestPairs(collisionBuffer->pairs);
+	CollisionManager_UpdateContacts();
+
+	return collisionBuffer->collisions;
+}
+
+///
+//Tests for collisions on all objects in an oct tree compiling a list of collisions which occur
+//
+//Parameters:
+//	tree: The oct tree holding the game objects to test
 //
-//PArameters:
-//      collision: The collision to initialize
-static void CollisionManager_InitializeCollision(struct Collision* collision);
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateOctTree(OctTree* tree)
+{
+	//Clear the current linked list of collisions, the collisions themselves live in frame memory
+	LinkedList_Clear(collisionBuffer->collisions);
+
+	OctTree_Compact(tree);
+	collisionBuffer->pairs->size = 0;
+
+	if(tree->looseness != 0.0f)
+	{
+		CollisionManager_GetLooseOctTreePairs(tree);
+	}
+	else
+	{
+		PairSet_Clear(collisionBuffer->testedPairs);
+
+		//Walk the leaves of the tree in order, their occupants are contiguous in the tree's occupant array
+		DYNARRAY_FOREACH(OctTreeNodePtr, leaf, tree->leaves)
+		{
+			if((*leaf)->count > 1)
+			{
+				CollisionManager_GetOctTreeNodePairs(OctTree_Node_GetOccupants(tree, *leaf), (*leaf)->count);
+			}
+		}
+	}
+	CollisionManager_GetStaticPairs();
+
+	CollisionManager_TestPairs(collisionBuffer->pairs);
+	CollisionManager_UpdateContacts();
+
+	//Return the list of collisions
+	return collisionBuffer->collisions;
+}
+
+///
+//Tests for collisions on all pairs of objects whose bounds overlap in a sweep and prune
+//compiling a list of collisions which occur
+//
+//Parameters:
+//	sap: The updated sweep and prune holding the game objects to test
+//
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateSweepAndPrune(SweepAndPrune* sap)
+{
+	//Clear the current linked list of collisions, the collisions themselves live in frame memory
+	LinkedList_Clear(collisionBuffer->collisions);
+
+	collisionBuffer->pairs->size = 0;
+	SweepAndPrune_GetPairs(sap, collisionBuffer->pairs);
+	CollisionManager_FilterPairs(collisionBuffer->pairs);
+	CollisionManager_GetStaticPairs();
+
+	//The broadphase finds each pair once
+	CollisionManager_TestPairs(collisionBuffer->pairs);
+	CollisionManager_UpdateContacts();
+
+	//Return the list of collisions
+	return collisionBuffer->collisions;
+}
+
+///
+//Tests for collisions on all pairs of objects whose fattened bounds overlap in an AABB tree
+//compiling a list of collisions which occur
+//
+//Parameters:
+//	tree: The AABB tree holding the game objects to test
+//
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateAABBTree(AABBTree* tree)
+{
+	//Clear the current linked list of collisions, the collisions themselves live in frame memory
+	LinkedList_Clear(collisionBuffer->collisions);
+
+	collisionBuffer->pairs->size = 0;
+	AABBTree_GetPairs(tree, collisionBuffer->pairs);
+	CollisionManager_FilterPairs(collisionBuffer->pairs);
+	CollisionManager_GetStaticPairs();
+
+	//The broadphase finds each pair once
+	CollisionManager_TestPairs(collisionBuffer->pairs);
+	CollisionManager_UpdateContacts();
+
+	//Return the list of collisions
+	return collisionBuffer->collisions;
+}
+
+///
+//Tests for collisions on all pairs of objects whose bounds overlap in a spatial hash
+//compiling a list of collisions which occur
+//The buckets of the grid are searched and the pairs are tested across the system's worker pool.
+//
+//Parameters:
+//	grid: The updated spatial hash holding the game objects to test
+//
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateSpatialHash(SpatialHash* grid)
+{
+	//Clear the current linked list of collisions, the collisions themselves live in frame memory
+	LinkedList_Clear(collisionBuffer->collisions);
+
+	collisionBuffer->pairs->size = 0;
+	SpatialHash_GetPairs(grid, collisionBuffer->pairs, SystemManager_GetWorkerPool());
+	CollisionManager_FilterPairs(collisionBuffer->pairs);
+	CollisionManager_GetStaticPairs();
+
+	//The broadphase finds each pair once
+	CollisionManager_TestPairs(collisionBuffer->pairs);
+	CollisionManager_UpdateContacts();
+
+	//Return the list of collisions
+	return collisionBuffer->collisions;
+}
+
+///
+//Selects the broadphase used to find the pairs of objects tested for collision each frame
+//The object manager keeps the selected broadphase up to date, catching it up with every object after a switch.
+//
+//Parameters:
+//	broadphase: The broadphase to use from the next frame on
+void CollisionManager_SetBroadphase(BroadphaseType broadphase)
+{
+	collisionBuffer->broadphase = broadphase;
+}
+
+///
+//Gets the broadphase used to find the pairs of objects tested for collision each frame
+//
+//Returns:
+//	The selected broadphase
+BroadphaseType CollisionManager_GetBroadphase(void)
+{
+	return collisionBuffer->broadphase;
+}
+
+///
+//Selects the algorithm used to test a pair of collider types for collision
+//Only convex hull on convex hull and AABB on convex hull pairs can be tested by more than one algorithm.
+//
+//Parameters:
+//	type1: The type of the first collider of the pair
+//	type2: The type of the second collider of the pair
+//	algorithm: The algorithm to use from the next test on
+void CollisionManager_SetConvexAlgorithm(ColliderType type1, ColliderType type2, ConvexAlgorithm algorithm)
+{
+	if(type1 == COLLIDER_CONVEXHULL && type2 == COLLIDER_CONVEXHULL)
+	{
+		collisionBuffer->convexAlgorithm = algorithm;
+	}
+	else if((type1 == COLLIDER_AABB && type2 == COLLIDER_CONVEXHULL) || (type1 == COLLIDER_CONVEXHULL && type2 == COLLIDER_AABB))
+	{
+		collisionBuffer->AABBConvexAlgorithm = algorithm;
+	}
+	else
+	{
+		printf("CollisionManager_SetConvexAlgorithm failed! Colliders of types %d and %d can only be tested by one algorithm.\n", type1, type2);
+	}
+}
+
+///
+//Gets the algorithm used to test a pair of collider types for collision
+//
+//Parameters:
+//	type1: The type of the first collider of the pair
+//	type2: The type of the second collider of the pair
+//
+//Returns:
+//	The selected algorithm, CONVEXALGORITHM_SAT for pairs with no choice of algorithm
+ConvexAlgorithm CollisionManager_GetConvexAlgorithm(ColliderType type1, ColliderType type2)
+{
+	if(type1 == COLLIDER_CONVEXHULL && type2 == COLLIDER_CONVEXHULL)
+	{
+		return collisionBuffer->convexAlgorithm;
+	}
+	else if((type1 == COLLIDER_AABB && type2 == COLLIDER_CONVEXHULL) || (type1 == COLLIDER_CONVEXHULL && type2 == COLLIDER_AABB))
+	{
+		return collisionBuffer->AABBConvexAlgorithm;
+	}
+	return CONVEXALGORITHM_SAT;
+}
+
+///
+//Gets how often the narrowphase settled convex pairs with the axis which separated them on the previous frame
+//
+//Parameters:
+//	dest: A pointer to the stats to store the counts in
+void CollisionManager_GetAxisCacheStats(struct CollisionManager_AxisCacheStats* dest)
+{
+	*dest = collisionBuffer->axisCacheStats;
+}
+
+///
+//Sets every count of the axis cache stats back to 0
+void CollisionManager_ResetAxisCacheStats(void)
+{
+	memset(&collisionBuffer->axisCacheStats, 0, sizeof(struct CollisionManager_AxisCacheStats));
+}
+
+///
+//Sets the filter deciding which pairs of objects found by the broadphase are tested for collision
+//The filter only sees pairs whose collision layers allow them to collide.
+//
+//Parameters:
+//	filter: The function deciding if a pair is tested, or NULL to test every pair
+//	data: Passed to the filter
+void CollisionManager_SetPairFilter(CollisionManager_PairFilter filter, void* data)
+{
+	collisionBuffer->pairFilter = filter;
+	collisionBuffer->pairFilterData = data;
+}
+
+///
+//Sets the tree of static objects which the oct tree, sweep and prune and AABB tree broadphases test moving objects against
+//Every object in the pool with a collider which the tree does not hold is treated as moving.
+//The static objects must be kept out of the broadphases themselves.
+//
+//Parameters:
+//	tree: A pointer to the BVH holding the static objects, or NULL to test no static objects
+//	pool: A pointer to the memory pool holding the moving and static objects
+void CollisionManager_SetStaticTree(BVH* tree, MemoryPool* pool)
+{
+	collisionBuffer->staticTree = tree;
+	collisionBuffer->staticPool = pool;
+}
+
+///
+//Sets the broadphase which ray casts, overlap queries and sweeps find moving objects with
+//The object manager sets the broadphase it keeps up to date whenever another is selected.
+//
+//Parameters:
+//	type: The type of the broadphase
+//	broadphase: A pointer to the OctTree, SweepAndPrune, AABBTree or SpatialHash matching type, or NULL to find no moving objects
+void CollisionManager_SetQueryBroadphase(BroadphaseType type, void* broadphase)
+{
+	collisionBuffer->queryBroadphase = type;
+	collisionBuffer->queryStructure = broadphase;
+}
+
+///
+//Gets the counts of what became of the pairs found by the broadphase with a collider on a collision layer,
+//since the counts were last reset
+//
+//Parameters:
+//	dest: A pointer to the stats to store the counts in
+//	layer: The collision layer to get the counts of, from 0 to Collider_NUM_LAYERS - 1
+void CollisionManager_GetLayerStats(struct CollisionManager_LayerStats* dest, unsigned int layer)
+{
+	if(layer >= Collider_NUM_LAYERS)
+	{
+		printf("CollisionManager_GetLayerStats Failed: Layer %u is out of range.\n", layer);
+		memset(dest, 0, sizeof(struct CollisionManager_LayerStats));
+		return;
+	}
+
+	*dest = collisionBuffer->layerStats[layer];
+}
+
+///
+//Sets every count of the stats of every collision layer back to 0
+void CollisionManager_ResetLayerStats(void)
+{
+	memset(collisionBuffer->layerStats, 0, sizeof(collisionBuffer->layerStats));
+}
+
+///
+//Gets the contacts which changed in a given way when collisions were last found
+//The records pointed to belong to the contact table, so no memory is allocated for contacts which carry on from frame to frame.
+//
+//Parameters:
+//	type: The kind of contact event to get
+//
+//Returns:
+//	A pointer to a dynamic array of the contacts (struct CollisionManager_PersistentContact*), valid until collisions are next found
+DynamicArray* CollisionManager_GetContactEvents(ContactEventType type)
+{
+	return collisionBuffer->contactEvents[type];
+}
+
+///
+//Subscribes a callback to a kind of contact event
+//Subscribers are called once the collisions of a frame have been found, in the order they subscribed.
+//
+//Parameters:
+//	type: The kind of contact event to receive
+//	obj: A pointer to the object whose contacts to receive events of, or NULL to receive the events of every contact
+//	callback: The function to call with each event
+//	data: Passed to the callback
+void CollisionManager_SubscribeContactEvents(ContactEventType type, GObject* obj, CollisionManager_ContactCallback callback, void* data)
+{
+	if(type >= CONTACTEVENT_NUMTYPES || callback == NULL)
+	{
+		printf("CollisionManager_SubscribeContactEvents failed! Invalid event type %d or NULL callback.\n", type);
+		return;
+	}
+
+	struct CollisionManager_ContactSubscription subscription = { type, obj, callback, data };
+	DynamicArray_ContactSubscription_Append(collisionBuffer->contactSubscriptions, subscription);
+}
+
+///
+//Removes every subscription of a callback with the given data
+//Safe to call from within a contact callback.
+//
+//Parameters:
+//	callback: The function which was subscribed
+//	data: The data it was subscribed with
+void CollisionManager_UnsubscribeContactEvents(CollisionManager_ContactCallback callback, void* data)
+{
+	DynamicArray* subscriptions = collisionBuffer->contactSubscriptions;
+	for(unsigned int i = 0; i < subscriptions->size; i++)
+	{
+		struct CollisionManager_ContactSubscription* subscription = DynamicArray_ContactSubscription_Index(subscriptions, i);
+		if(subscription->callback != callback || subscription->data != data) continue;
+
+		//The dispatch walks the subscriptions in order, so they are only removed once it is done
+		if(collisionBuffer->dispatchingContacts)
+		{
+			subscription->callback = NULL;
+		}
+		else
+		{
+			DynamicArray_RemoveAndReposition(subscriptions, i);
+			i--;
+		}
+	}
+}
+
+///
+//Drops the contacts of an object from the contact table without reporting that they ended
+//Must be called when an object leaves the simulation, so no later event refers to it.
+//
+//Parameters:
+//	obj: A pointer to the object leaving the simulation
+void CollisionManager_RemoveContacts(GObject* obj)
+{
+	//Records cannot be taken out of the pair set, so they are marked as dropped instead
+	DYNARRAY_FOREACH(PersistentContact, contact, collisionBuffer->contacts)
+	{
+		if(contact->obj1 == obj || contact->obj2 == obj)
+		{
+			contact->obj1 = NULL;
+			contact->obj2 = NULL;
+		}
+	}
+
+	//Events reported this frame may still be read until collisions are next found
+	for(int type = 0; type < CONTACTEVENT_NUMTYPES; type++)
+	{
+		DynamicArray* events = collisionBuffer->contactEvents[type];
+		unsigned int numKept = 0;
+		DYNARRAY_FOREACH(PersistentContactPtr, event, events)
+		{
+			if((*event)->obj1 != NULL && (*event)->obj1 != obj && (*event)->obj2 != obj)
+			{
+				*DynamicArray_PersistentContactPtr_Index(events, numKept++) = *event;
+			}
+		}
+		events->size = numKept;
+	}
+}
 
 ///
-//Tests for collisions on all objects within an oct tree node appending to a list of collisions which occur
+//Decides whether a pair of objects with colliders found by the broadphase is tested for collision,
+//checking their collision layers and then the pair filter, and counts the pair in the stats of their layers
 //
 //Parameters:
-//      node: A pointer to the node of the oct tree to check
-static void CollisionManager_UpdateOctTreeNode(struct OctTree_Node* node);
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+//
+//Returns:
+//	1 if the pair should be tested for collision, else 0
+static unsigned char CollisionManager_AcceptPair(GObject* obj1, GObject* obj2)
+{
+	struct CollisionManager_LayerStats* stats1 = collisionBuffer->layerStats + obj1->collider->layer;
+	struct CollisionManager_LayerStats* stats2 = collisionBuffer->layerStats + obj2->collider->layer;
+	//A pair within one layer is only counted once
+	unsigned long otherLayer = stats1 != stats2;
+
+	stats1->pairs++;
+	stats2->pairs += otherLayer;
+
+	if(!Collider_DoLayersCollide(obj1->collider, obj2->collider))
+	{
+		stats1->masked++;
+		stats2->masked += otherLayer;
+		return 0;
+	}
+
+	if(collisionBuffer->pairFilter != NULL && !collisionBuffer->pairFilter(obj1, obj2, collisionBuffer->pairFilterData))
+	{
+		stats1->filtered++;
+		stats2->filtered += otherLayer;
+		return 0;
+	}
+
+	return 1;
+}
 
 ///
-//Tests for collisions on an array of objects within an oct tree node appending to a list of collisions which occur
+//Removes the pairs which should not be tested for collision from an array of pairs found by a broadphase
 //
 //Parameters:
-//      gameObjects: An array of pointers to game objects to check collisions
-//      numObjects: The number of objects in the array
-static void CollisionManager_UpdateOctTreeNodeArray(GObject** gameObjects, unsigned int numObjects);
+//	pairs: A pointer to the dynamic array of pairs to filter (struct GObject_Pair)
+static void CollisionManager_FilterPairs(DynamicArray* pairs)
+{
+	unsigned int numKept = 0;
+	DYNARRAY_FOREACH(GObjectPair, pair, pairs)
+	{
+		if(CollisionManager_AcceptPair(pair->obj1, pair->obj2))
+		{
+			*DynamicArray_GObjectPair_Index(pairs, numKept++) = *pair;
+		}
+	}
+	pairs->size = numKept;
+}
 
 ///
-//Performs the Separating Axis Theorem test with face normals
+//Counts a collision in the stats of the collision layers of it's objects
 //
 //Parameters:
-//      dest: A pointer to a collision to store the results of the test in. Results will not be stored if the test detects no collision
-//      orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1 involved in the test
-//      numAxes1: The number of axes belonging to object 1
-//      orientedPoints1: An array of pointers to vectors representing the oriented points of object 1 involved in the test
-//      numPoints1: The number of points belonging to object 1
-//      orientedAxes2: An array of pointersto vectors representing the oriented axes of object 2 involved in the test
-//      numAxes2: The number of axes belonging to object 2
-//      orientedPoints2: An array of pointers to vectors representing the oriented points of object 2 involved in the test
-//      numPoints2: The number of points belonging to object 2
-//
-//Returns:
-//      0 if the test detects no collision
-//      1 if the test detects a collision
-static unsigned char CollisionManager_PerformSATFaces(struct Collision* dest,
-	const Vector** orientedAxes1, const unsigned int numAxes1, const Vector** orientedPoints1, const unsigned int numPoints1,
-	const Vector** orientedAxes2, const unsigned int numAxes2, const Vector** orientedPoints2, const unsigned int numPoints2);
+//	collision: A pointer to the collision which occurred
+static void CollisionManager_CountCollision(const struct Collision* collision)
+{
+	struct CollisionManager_LayerStats* stats1 = collisionBuffer->layerStats + collision->obj1->collider->layer;
+	struct CollisionManager_LayerStats* stats2 = collisionBuffer->layerStats + collision->obj2->collider->layer;
+
+	stats1->collisions++;
+	if(stats2 != stats1) stats2->collisions++;
+}
 
 ///
-//Performs the Separating axis theorem test with face normals
+//Finds the pairs of objects with colliders within an oct tree node
+//Pairs which have already been found in another node this frame are skipped.
 //
 //Parameters:
-//      dest: A pointer to the collision to store the results of the test in. Resultswill not be stored if the test detects no collisions
-//      orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
-//      numEdges1: The number of edges belonging to object 1
-//      orientedPoints1: An array of pointers to vectors representing the oriented points of object 1
-//      numPoints1: The number of points belonging to object 1
-//      orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
-//      numEdges2: The number of edges belonging to object 2
-//  orientedPoints2: An array of pointers to vectors representing the oriented points of object 2
-//      numPoints2: the number of points belonging to object 2
-static unsigned char CollisionManager_PerformSATEdges(struct Collision* dest,
-	const Vector** orientedEdges1, const unsigned int numEdges1, const Vector** orientedPoints1, const unsigned int numPoints1,
-	const Vector** orientedEdges2, const unsigned int numEdges2, const Vector** orientedPoints2, const unsigned int numPoints2);
+//	gameObjects: An array of pointers to the game objects in the node
+//	numObjects: The number of objects in the array
+static void CollisionManager_GetOctTreeNodePairs(GObject** gameObjects, unsigned int numObjects)
+{
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		if(gameObjects[i]->collider != NULL)
+		{
+			for(unsigned int j = i+1; j < numObjects; j++)
+			{
+				//Objects overlapping several leaves may meet in each of them
+				if(gameObjects[j]->collider != NULL && PairSet_Insert(collisionBuffer->testedPairs, gameObjects[i], gameObjects[j])
+					&& CollisionManager_AcceptPair(gameObjects[i], gameObjects[j]))
+				{
+					struct GObject_Pair pair = { gameObjects[i], gameObjects[j] };
+					DynamicArray_GObjectPair_Append(collisionBuffer->pairs, pair);
+				}
+			}
+		}
+	}
+}
 
 ///
-//Projects a set of points onto a normalized axis getting the squared magnitude of the projection vector.
-//Finds the minimum and maximum values of the point set projected onto the axis.
+//Finds the pairs of objects with colliders in a loose oct tree
+//Every object is held by exactly one node of a loose oct tree, so each pair is only found once.
 //
 //Parameters:
-//      dest: The destination of the projection bounds
-//      axis: The axis projecting onto
-//      points: The set of points to project onto the axis
-static void CollisionManager_GetProjectionBounds(struct ProjectionBounds* dest, const Vector* axis, const Vector** points, const int numPoints);
+//	tree: A pointer to the compacted loose oct tree holding the game objects
+static void CollisionManager_GetLooseOctTreePairs(OctTree* tree)
+{
+	DynamicArray* candidates = collisionBuffer->candidates;
+	DYNARRAY_FOREACH(OctTreeNodePtr, node, tree->leaves)
+	{
+		for(unsigned int i = (*node)->offset; i < (*node)->offset + (*node)->count; i++)
+		{
+			GObject* obj = DynamicArray_GObjectPtr_Get(tree->occupants, i);
+			if(obj->collider == NULL) continue;
 
+			candidates->size = 0;
+			OctTree_GetLooseCandidates(tree, i, candidates);
 
-///
-//Implementations
+			DYNARRAY_FOREACH(GObjectPtr, other, candidates)
+			{
+				if((*other)->collider == NULL) continue;
+				if(!CollisionManager_AcceptPair(obj, *other)) continue;
 
-///
-//Initializes the Collision Manager
-void CollisionManager_Initialize(void)
-{
-	//Allocate & initialize collision buffer
-	collisionBuffer = CollisionManager_AllocateBuffer();
-	CollisionManager_InitializeBuffer(collisionBuffer);
+				struct GObject_Pair pair = { obj, *other };
+				DynamicArray_GObjectPair_Append(collisionBuffer->pairs, pair);
+			}
+		}
+	}
 }
 
 ///
-//Frees any resources allocated by the collision manager
-void CollisionManager_Free(void)
+//Finds the pairs of moving objects and static objects whose bounds overlap,
+//querying the static tree with the bounds of each object in the static pool which the tree does not hold.
+//Static objects are never paired with each other.
+static void CollisionManager_GetStaticPairs(void)
 {
-	CollisionManager_FreeBuffer(collisionBuffer);
+	BVH* tree = collisionBuffer->staticTree;
+	MemoryPool* pool = collisionBuffer->staticPool;
+	if(tree == NULL || tree->objects->size == 0) return;
+
+	//Only rebuilt when the static objects have changed
+	BVH_Update(tree);
+
+	DynamicArray* candidates = collisionBuffer->candidates;
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
+	{
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
+		if(obj->collider == NULL || BVH_Contains(tree, obj)) continue;
+
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+		struct ColliderData_AABB bounds;
+		if(!Collider_GetWorldAABB(&bounds, obj->collider, frame)) continue;
+
+		candidates->size = 0;
+		BVH_QueryAABB(tree, &bounds, candidates);
+
+		DYNARRAY_FOREACH(GObjectPtr, other, candidates)
+		{
+			if(!CollisionManager_AcceptPair(obj, *other)) continue;
+
+			struct GObject_Pair pair = { obj, *other };
+			DynamicArray_GObjectPair_Append(collisionBuffer->pairs, pair);
+		}
+	}
 }
 
 ///
-//Tests for collisions on all objects which have colliders 
-//compiling a list of game objects which test true
+//Tests pairs of game objects for collision across the system's worker pool, registering the collisions which occur
+//The collisions are registered in the order of their pairs, regardless of how many threads tested them.
 //
 //Parameters:
-//	gameObjects: THe list of gameObjects to test
-//
-//Returns:
-//	A pointer to a linked list of collisions which occurred this frame.
-LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
+//	pairs: A pointer to the dynamic array of pairs to test (struct GObject_Pair)
+static void CollisionManager_TestPairs(DynamicArray* pairs)
 {
-	//Clear the current list of collisions
-	struct LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	struct LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
+	//Last frame's separating axes are searched by the tasks while this frame's are gathered
+	PairSet* separatedPairs = collisionBuffer->previousSeparatedPairs;
+	DynamicArray* separatingAxes = collisionBuffer->previousSeparatingAxes;
+	collisionBuffer->previousSeparatedPairs = collisionBuffer->separatedPairs;
+	collisionBuffer->previousSeparatingAxes = collisionBuffer->separatingAxes;
+	collisionBuffer->separatedPairs = separatedPairs;
+	collisionBuffer->separatingAxes = separatingAxes;
+	PairSet_Clear(separatedPairs);
+	DynamicArray_Clear(separatingAxes);
+
+	if(pairs->size == 0) return;
+
+	WorkerPool* workers = SystemManager_GetWorkerPool();
+
+	struct CollisionManager_Narrowphase narrowphase;
+	narrowphase.pairs = DynamicArray_GObjectPair_Data(pairs);
+	narrowphase.numPairs = pairs->size;
+
+	//Split the pairs into enough tasks to balance the threads, but not so many that each task does too little
+	unsigned int maxTasks = WorkerPool_GetConcurrency(workers) * CollisionManager_TASKS_PER_THREAD;
+	narrowphase.numTasks = narrowphase.numPairs / CollisionManager_PAIRS_PER_TASK;
+	if(narrowphase.numTasks > maxTasks) narrowphase.numTasks = maxTasks;
+	if(narrowphase.numTasks == 0) narrowphase.numTasks = 1;
+
+	//Update the collider of every object once, so the tests only read shared data
+	PairSet_Clear(collisionBuffer->updatedObjects);
+	collisionBuffer->objects->size = 0;
+	for(unsigned int i = 0; i < narrowphase.numPairs; i++)
 	{
-		nextNode = currentNode->next;
-		CollisionManager_FreeCollision((struct Collision*)currentNode->data);
-		currentNode = nextNode;
+		if(PairSet_Insert(collisionBuffer->updatedObjects, narrowphase.pairs[i].obj1, narrowphase.pairs[i].obj1))
+			DynamicArray_GObjectPtr_Append(collisionBuffer->objects, narrowphase.pairs[i].obj1);
+		if(PairSet_Insert(collisionBuffer->updatedObjects, narrowphase.pairs[i].obj2, narrowphase.pairs[i].obj2))
+			DynamicArray_GObjectPtr_Append(collisionBuffer->objects, narrowphase.pairs[i].obj2);
 	}
-	LinkedList_Clear(collisionBuffer->collisions);
+	narrowphase.objects = DynamicArray_GObjectPtr_Data(collisionBuffer->objects);
+	narrowphase.numObjects = collisionBuffer->objects->size;
+	narrowphase.numUpdateTasks = narrowphase.numObjects / CollisionManager_PAIRS_PER_TASK;
+	if(narrowphase.numUpdateTasks > maxTasks) narrowphase.numUpdateTasks = maxTasks;
+	if(narrowphase.numUpdateTasks == 0) narrowphase.numUpdateTasks = 1;
 
-	//Allocates a collision to store the first registered collision
-	struct Collision* collision = CollisionManager_AllocateCollision();
-	CollisionManager_InitializeCollision(collision);
+	WorkerPool_Run(workers, CollisionManager_UpdateCollidersTask, &narrowphase, narrowphase.numUpdateTasks);
 
-	//Begin looping through gameObjects
-	currentNode = gameObjects->head;
-	nextNode = NULL;
-	struct LinkedList_Node* iterator = NULL;
-	while(currentNode != NULL)
+	//Tasks keep their scratch memory and result storage between frames
+	while(collisionBuffer->tasks->size < narrowphase.numTasks)
 	{
-		//Store the next gameObject
-		nextNode = currentNode->next;
+		struct CollisionManager_NarrowphaseTask task = { 0 };
+		task.scratch = MemoryArena_Allocate();
+		MemoryArena_Initialize(task.scratch, CollisionManager_SCRATCH_SIZE);
+		task.contacts = DynamicArray_Allocate();
+		DynamicArray_Initialize(task.contacts, sizeof(struct CollisionManager_Contact));
+		task.axes = DynamicArray_Allocate();
+		DynamicArray_Initialize(task.axes, sizeof(struct CollisionManager_SeparatingAxis));
+		DynamicArray_NarrowphaseTask_Append(collisionBuffer->tasks, task);
+	}
 
-		//Get current object & make sure it has a collider
-		GObject* currentObj = (GObject*)currentNode->data;
-		if(currentObj->collider != NULL)
+	WorkerPool_Run(workers, CollisionManager_TestPairsTask, &narrowphase, narrowphase.numTasks);
+
+	//Register the collisions task by task, each task holds a contiguous range of the pairs
+	//so the collisions are registered in the same order as testing every pair on this thread would.
+	for(unsigned int i = 0; i < narrowphase.numTasks; i++)
+	{
+		struct CollisionManager_NarrowphaseTask* task = DynamicArray_NarrowphaseTask_Index(collisionBuffer->tasks, i);
+		DYNARRAY_FOREACH(CollisionContact, contact, task->contacts)
 		{
+			struct Collision* collision = CollisionManager_AllocateCollision();
+			*collision = contact->collision;
+			collision->minimumTranslationVector = SystemManager_RequestFrameVectors(1, 3)[0];
+			memcpy(collision->minimumTranslationVector->components, contact->minimumTranslationVector, sizeof(float) * 3);
 
-			//Begin looping through the rest of the list (Testing every other object with this object)
-			iterator = nextNode;
-			while(iterator != NULL)
-			{
-				//Get the next object & make sure it has a collider
-				GObject* iteratorObj = (GObject*)iterator->data;
-				if(iteratorObj->collider != NULL)
-				{
-					CollisionManager_TestCollision( 
-						collision,
-						currentObj,
-						currentObj->body != NULL ? currentObj->body->frame : currentObj->frameOfReference,	//If there is a rigidbody use that frame of reference, else use the objects
-						iteratorObj,
-						iteratorObj->body != NULL ? iteratorObj->body->frame : iteratorObj->frameOfReference);	//If there is a rigidbody use that frame of reference, else use the objects
+			CollisionManager_RegisterCollision(collision);
+		}
 
+		//Remember the axes which separated pairs for the next frame
+		//The set's indices must match the axes, so a pair tested twice keeps it's first axis
+		DYNARRAY_FOREACH(SeparatingAxis, axis, task->axes)
+		{
+			if(PairSet_Insert(collisionBuffer->separatedPairs, axis->obj1, axis->obj2))
+			{
+				DynamicArray_SeparatingAxis_Append(collisionBuffer->separatingAxes, *axis);
+			}
+		}
 
+		collisionBuffer->axisCacheStats.tests += task->axisCacheStats.tests;
+		collisionBuffer->axisCacheStats.cached += task->axisCacheStats.cached;
+		collisionBuffer->axisCacheStats.hits += task->axisCacheStats.hits;
+	}
+}
 
-					//If they are not colliding continue to test next obj. Do not register collision or perform second pass
-					if(collision->obj1 == NULL)
-					{
-						//Stop any further tests
-						iterator = iterator->next;
-						continue;
-					}
+///
+//Carries the contact table over from the previous frame using this frame's list of collisions,
+//then finds and dispatches the contacts which began, stayed and ended.
+static void CollisionManager_UpdateContacts(void)
+{
+	//Last frame's table is searched while this frame's is filled
+	PairSet* contactPairs = collisionBuffer->previousContactPairs;
+	DynamicArray* contacts = collisionBuffer->previousContacts;
+	collisionBuffer->previousContactPairs = collisionBuffer->contactPairs;
+	collisionBuffer->previousContacts = collisionBuffer->contacts;
+	collisionBuffer->contactPairs = contactPairs;
+	collisionBuffer->contacts = contacts;
+	PairSet_Clear(contactPairs);
+	DynamicArray_Clear(contacts);
+
+	for(int type = 0; type < CONTACTEVENT_NUMTYPES; type++)
+	{
+		DynamicArray_Clear(collisionBuffer->contactEvents[type]);
+	}
 
+	struct LinkedList_Node* node = collisionBuffer->collisions->head;
+	while(node != NULL)
+	{
+		struct Collision* collision = (struct Collision*)node->data;
+		node = node->next;
 
-					//If code reaches this point, all tests detected collision.
-					//add to collided list
-					LinkedList_Append(collisionBuffer->collisions, collision);
+		if(!PairSet_Insert(contactPairs, collision->obj1, collision->obj2)) continue;
 
-					//TODO: Remove
-					//Change the color of colliders to red until they are drawn
-					*Matrix_Index(currentObj->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(currentObj->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(currentObj->collider->colorMatrix, 2, 2) = 0.0f;
+		struct CollisionManager_PersistentContact contact;
+		contact.obj1 = collision->obj1;
+		contact.obj2 = collision->obj2;
+		memcpy(contact.minimumTranslationVector, collision->minimumTranslationVector->components, sizeof(float) * 3);
+		contact.overlap = collision->overlap;
+		contact.frames = 1;
 
-					*Matrix_Index(iteratorObj->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(iteratorObj->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(iteratorObj->collider->colorMatrix, 2, 2) = 0.0f;
+		unsigned int index = PairSet_Find(collisionBuffer->previousContactPairs, contact.obj1, contact.obj2);
+		if(index != PairSet_NOT_FOUND)
+		{
+			//Records of objects which left the simulation were dropped, another object may now have it's address
+			struct CollisionManager_PersistentContact* previous = DynamicArray_PersistentContact_Index(collisionBuffer->previousContacts, index);
+			if(previous->obj1 != NULL) contact.frames = previous->frames + 1;
+		}
 
-					//Allocate a new collision for next collision detected
-					collision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(collision);
+		DynamicArray_PersistentContact_Append(contacts, contact);
+	}
 
-				}
+	//The records no longer move, so the events may point to them
+	DYNARRAY_FOREACH(PersistentContact, contact, contacts)
+	{
+		ContactEventType type = contact->frames == 1 ? CONTACTEVENT_BEGIN : CONTACTEVENT_STAY;
+		DynamicArray_PersistentContactPtr_Append(collisionBuffer->contactEvents[type], contact);
+	}
 
-				iterator = iterator->next;
-			}
+	DYNARRAY_FOREACH(PersistentContact, previous, collisionBuffer->previousContacts)
+	{
+		if(previous->obj1 != NULL && PairSet_Find(contactPairs, previous->obj1, previous->obj2) == PairSet_NOT_FOUND)
+		{
+			DynamicArray_PersistentContactPtr_Append(collisionBuffer->contactEvents[CONTACTEVENT_END], previous);
 		}
-		currentNode = nextNode;
 	}
 
-	//Delete the last unused allocated collision
-	CollisionManager_FreeCollision(collision);
-
-	return collisionBuffer->collisions;
+	CollisionManager_DispatchContactEvents();
 }
 
 ///
-//Tests for collisions on all objects in an oct tree compiling a list of collisions which occur
-//
-//Parameters:
-//	tree: The oct tree holding the game objects to test
-//
-//Returns: A pointer to a linked list of collisions which occurred this frame
-LinkedList* CollisionManager_UpdateOctTree(OctTree* tree)
+//Hands this frame's contact events to every subscriber, then drops the subscriptions removed while doing so
+static void CollisionManager_DispatchContactEvents(void)
 {
-	//Clear the current linked list of collisions
-	struct LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	struct LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
+	DynamicArray* subscriptions = collisionBuffer->contactSubscriptions;
+	if(subscriptions->size == 0) return;
+
+	collisionBuffer->dispatchingContacts = 1;
+
+	//Subscriptions may be added by the callbacks, so they are indexed rather than pointed to
+	for(unsigned int i = 0; i < subscriptions->size; i++)
 	{
-		nextNode = currentNode->next;
-		CollisionManager_FreeCollision((struct Collision*)currentNode->data);
-		currentNode = nextNode;
-	}
-	LinkedList_Clear(collisionBuffer->collisions);
+		DynamicArray* events = collisionBuffer->contactEvents[DynamicArray_ContactSubscription_Index(subscriptions, i)->type];
+		for(unsigned int j = 0; j < events->size; j++)
+		{
+			struct CollisionManager_ContactSubscription subscription = *DynamicArray_ContactSubscription_Index(subscriptions, i);
+			if(subscription.callback == NULL) break;
 
-	
+			struct CollisionManager_PersistentContact* contact = DynamicArray_PersistentContactPtr_Get(events, j);
+			//Contacts dropped by a callback removing an object are not reported
+			if(contact->obj1 == NULL) continue;
 
-	//Update root node to fill the list of collisions with all collisions in the oct tree
-	CollisionManager_UpdateOctTreeNode(tree->root);
+			if(subscription.obj == NULL || subscription.obj == contact->obj1 || subscription.obj == contact->obj2)
+			{
+				subscription.callback(subscription.type, contact, subscription.data);
+			}
+		}
+	}
 
-	//Return the list of collisions
-	return collisionBuffer->collisions;
+	collisionBuffer->dispatchingContacts = 0;
+
+	unsigned int numKept = 0;
+	DYNARRAY_FOREACH(ContactSubscription, subscription, subscriptions)
+	{
+		if(subscription->callback != NULL)
+		{
+			*DynamicArray_ContactSubscription_Index(subscriptions, numKept++) = *subscription;
+		}
+	}
+	subscriptions->size = numKept;
 }
 
 ///
-//Tests for collisions on all objects within an oct tree node appending to a list of collisions which occur
+//Updates the world space colliders of one contiguous range of the objects of a run of the narrowphase
 //
 //Parameters:
-//	node: A pointer to the node of the oct tree to check
-static void CollisionManager_UpdateOctTreeNode(struct OctTree_Node* node)
+//	data: A pointer to the struct CollisionManager_Narrowphase
+//	taskIndex: The index of the task to run
+static void CollisionManager_UpdateCollidersTask(void* data, unsigned int taskIndex)
 {
-	if(node->children != NULL)
-	{
-		for(int i = 0; i < 8; i++)
-		{
-			CollisionManager_UpdateOctTreeNode(node->children+i);
-		}
-	}
-	else
+	struct CollisionManager_Narrowphase* narrowphase = (struct CollisionManager_Narrowphase*)data;
+	unsigned int begin = (unsigned int)(((uint64_t)narrowphase->numObjects * taskIndex) / narrowphase->numUpdateTasks);
+	unsigned int end = (unsigned int)(((uint64_t)narrowphase->numObjects * (taskIndex + 1)) / narrowphase->numUpdateTasks);
+
+	for(unsigned int i = begin; i < end; i++)
 	{
-		if(node->data->size != 0)
-		{
-			CollisionManager_UpdateOctTreeNodeArray((GObject**)node->data->data, node->data->size);
-			//PhysicsManager_ResolveCollisions(collisions);
-		}
+		GObject* obj = narrowphase->objects[i];
+		Collider_Update(obj->collider, obj->body != NULL ? obj->body->frame : obj->frameOfReference);
 	}
 }
 
 ///
-//Tests for collisions on an array of objects within an oct tree node appending to a list of collisions which occur
+//Tests one contiguous range of the pairs of a run of the narrowphase for collision
+//Collisions are stored in the task's contacts, any memory needed by the tests comes from the task's scratch arena.
 //
 //Parameters:
-//	gameObjects: An array of pointers to game objects to check collisions
-//	numObjects: The number of objects in the array
-static void CollisionManager_UpdateOctTreeNodeArray(GObject** gameObjects, unsigned int numObjects)
+//	data: A pointer to the struct CollisionManager_Narrowphase
+//	taskIndex: The index of the task to run
+static void CollisionManager_TestPairsTask(void* data, unsigned int taskIndex)
 {
-	//Allocates a collision to store the first registered collision
-	struct Collision* collision = CollisionManager_AllocateCollision();
-	CollisionManager_InitializeCollision(collision);
-
-	for(unsigned int i = 0; i < numObjects; i++)
+	struct CollisionManager_Narrowphase* narrowphase = (struct CollisionManager_Narrowphase*)data;
+	unsigned int begin = (unsigned int)(((uint64_t)narrowphase->numPairs * taskIndex) / narrowphase->numTasks);
+	unsigned int end = (unsigned int)(((uint64_t)narrowphase->numPairs * (taskIndex + 1)) / narrowphase->numTasks);
+
+	struct CollisionManager_NarrowphaseTask* task = DynamicArray_NarrowphaseTask_Index(collisionBuffer->tasks, taskIndex);
+	MemoryArena_Reset(task->scratch);
+	task->contacts->size = 0;
+	task->axes->size = 0;
+	memset(&task->axisCacheStats, 0, sizeof(struct CollisionManager_AxisCacheStats));
+
+	//Route the scratch memory of the tests to this task's arena, the frame arenas are not thread safe
+	pthread_setspecific(collisionBuffer->scratchKey, task->scratch);
+
+	struct CollisionManager_Contact contact;
+	Vector mtv;
+	mtv.dimension = 3;
+	mtv.components = contact.minimumTranslationVector;
+
+	//Storage for batching the sphere on sphere and AABB on AABB tests of a block of pairs
+	unsigned char needsTest[CollisionManager_BATCH_SIZE];
+	unsigned char overlaps[CollisionManager_BATCH_SIZE];
+	unsigned int sphereIndices[CollisionManager_BATCH_SIZE];
+	struct ColliderData_Sphere* spheres1[CollisionManager_BATCH_SIZE];
+	struct ColliderData_Sphere* spheres2[CollisionManager_BATCH_SIZE];
+	unsigned int AABBIndices[CollisionManager_BATCH_SIZE];
+	struct ColliderData_AABB* AABBs1[CollisionManager_BATCH_SIZE];
+	struct ColliderData_AABB* AABBs2[CollisionManager_BATCH_SIZE];
+
+	for(unsigned int blockBegin = begin; blockBegin < end; blockBegin += CollisionManager_BATCH_SIZE)
 	{
-		if(gameObjects[i]->collider != NULL)
+		unsigned int blockSize = end - blockBegin < CollisionManager_BATCH_SIZE ? end - blockBegin : CollisionManager_BATCH_SIZE;
+		struct GObject_Pair* block = narrowphase->pairs + blockBegin;
+
+		//Gather the spheres and AABBs of the block, every other pair gets the full test
+		unsigned int numSpheres = 0;
+		unsigned int numAABBs = 0;
+		for(unsigned int i = 0; i < blockSize; i++)
 		{
-			for(unsigned int j = i+1; j < numObjects; j++)
+			Collider* collider1 = block[i].obj1->collider;
+			Collider* collider2 = block[i].obj2->collider;
+			needsTest[i] = 1;
+
+			if(collider1->type == COLLIDER_SPHERE && collider2->type == COLLIDER_SPHERE)
 			{
-				if(gameObjects[j]->collider != NULL)
-				{
-					CollisionManager_TestCollision( 
-						collision,
-						gameObjects[i],
-						gameObjects[i]->body != NULL ? gameObjects[i]->body->frame : gameObjects[i]->frameOfReference,		//If there is a rigidbody use that frame of reference, else use the objects
-						gameObjects[j],
-						gameObjects[j]->body != NULL ? gameObjects[j]->body->frame : gameObjects[j]->frameOfReference);	//If there is a rigidbody use that frame of reference, else use the objects
-
-					if(collision->obj1 == NULL)
-					{
-						continue;
-					}
+				sphereIndices[numSpheres] = i;
+				spheres1[numSpheres] = Collider_GetColliderDataWorldSpace(collider1);
+				spheres2[numSpheres] = Collider_GetColliderDataWorldSpace(collider2);
+				numSpheres++;
+			}
+			else if(collider1->type == COLLIDER_AABB && collider2->type == COLLIDER_AABB)
+			{
+				AABBIndices[numAABBs] = i;
+				AABBs1[numAABBs] = Collider_GetColliderDataWorldSpace(collider1);
+				AABBs2[numAABBs] = Collider_GetColliderDataWorldSpace(collider2);
+				numAABBs++;
+			}
+		}
 
-					unsigned char duplicate = 0;
+		//Most of these pairs miss, only the ones which overlap go on to build a collision
+		CollisionManager_TestSpherePairs(overlaps, spheres1, spheres2, numSpheres);
+		for(unsigned int i = 0; i < numSpheres; i++)
+		{
+			needsTest[sphereIndices[i]] = overlaps[i];
+		}
 
-					//Loop through the current collisions for one object
-					struct LinkedList_Node* current = collision->obj1->collider->currentCollisions->head;
-					while(current != NULL)
-					{
-						//Ensure that the registered collision is not a duplicate
-						struct Collision* currentCollision = (struct Collision*)current->data;
-						if(currentCollision->obj1 == collision->obj1 || currentCollision->obj2 == collision->obj1)
-						{
-							if(currentCollision->obj1 == collision->obj2 || currentCollision->obj2 == collision->obj2)
-							{
-								duplicate = 1;
-							}
-						}
-
-						current = current->next;
-					}
+		CollisionManager_TestAABBPairs(overlaps, AABBs1, AABBs2, numAABBs);
+		for(unsigned int i = 0; i < numAABBs; i++)
+		{
+			needsTest[AABBIndices[i]] = overlaps[i];
+		}
+
+		for(unsigned int i = 0; i < blockSize; i++)
+		{
+			if(!needsTest[i]) continue;
+
+			GObject* obj1 = block[i].obj1;
+			GObject* obj2 = block[i].obj2;
+
+			contact.collision.obj1 = NULL;
+			contact.collision.obj1Frame = NULL;
+			contact.collision.obj2 = NULL;
+			contact.collision.obj2Frame = NULL;
+			contact.collision.minimumTranslationVector = &mtv;
+			Vector_Copy(&mtv, &Vector_ZERO);
+
+			//Convex pairs test the axis which separated them on the previous frame first
+			unsigned char convex = CollisionManager_IsConvexPair(obj1->collider->type, obj2->collider->type);
+			struct CollisionManager_SeparatingAxis axis;
+			axis.type = SEPARATINGAXIS_NONE;
+			if(convex)
+			{
+				task->axisCacheStats.tests++;
 
-					//If it is a duplicate, don't add it- just keep looking for collisions
-					if(duplicate)
+				unsigned int index = PairSet_Find(collisionBuffer->previousSeparatedPairs, obj1, obj2);
+				if(index != PairSet_NOT_FOUND)
+				{
+					//Which collider is first decides what the axis refers to,
+					//and an entry for any other pair must not be trusted
+					struct CollisionManager_SeparatingAxis* previous = DynamicArray_SeparatingAxis_Index(collisionBuffer->previousSeparatingAxes, index);
+					if(previous->obj1 == obj1 && previous->obj2 == obj2)
 					{
-						collision->obj1 = NULL;
-						collision->obj2 = NULL;
-						collision->overlap = 0.0f;
-						collision->obj1Frame = NULL;
-						collision->obj2Frame = NULL;
-						continue;
+						axis = *previous;
+						task->axisCacheStats.cached++;
 					}
+				}
+			}
 
-					//If code reaches this point, all tests detected collision.
-					//add to collided list
-					LinkedList_Append(collisionBuffer->collisions, collision);
-					
-
-					LinkedList_Append(collision->obj1->collider->currentCollisions, collision);
-					LinkedList_Append(collision->obj2->collider->currentCollisions, collision);
+			unsigned char cached = CollisionManager_TestUpdatedCollision( 
+				&contact.collision,
+				obj1,
+				obj1->body != NULL ? obj1->body->frame : obj1->frameOfReference,	//If there is a rigidbody use that frame of reference, else use the objects
+				obj2,
+				obj2->body != NULL ? obj2->body->frame : obj2->frameOfReference,	//If there is a rigidbody use that frame of reference, else use the objects
+				convex ? &axis : NULL);
 
-					//TODO: Remove
-					//Change the color of colliders to red until they are drawn
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 2, 2) = 0.0f;
+			if(cached) task->axisCacheStats.hits++;
 
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 2, 2) = 0.0f;
+			if(axis.type != SEPARATINGAXIS_NONE)
+			{
+				axis.obj1 = obj1;
+				axis.obj2 = obj2;
+				DynamicArray_SeparatingAxis_Append(task->axes, axis);
+			}
 
-					//Allocate a new collision for next collision detected
-					collision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(collision);
-				}
+			if(contact.collision.obj1 != NULL)
+			{
+				contact.collision.minimumTranslationVector = NULL;
+				DynamicArray_CollisionContact_Append(task->contacts, contact);
 			}
 		}
 	}
 
-	//Delete the last unused allocated collision
-	CollisionManager_FreeCollision(collision);
+	pthread_setspecific(collisionBuffer->scratchKey, NULL);
 }
 
+///
+//Registers a collision, adding it to the list of collisions and to the current collisions of both objects
+//
+//Parameters:
+//	collision: A pointer to the collision in frame memory to register
+static void CollisionManager_RegisterCollision(struct Collision* collision)
+{
+	LinkedList_Append(collisionBuffer->collisions, collision);
+	CollisionManager_CountCollision(collision);
+
+	LinkedList_Append(collision->obj1->collider->currentCollisions, collision);
+	LinkedList_Append(collision->obj2->collider->currentCollisions, collision);
+
+	//TODO: Remove
+	//Change the color of colliders to red until they are drawn
+	*Matrix_Index(collision->obj1->collider->colorMatrix, 0, 0) = 1.0f;
+	*Matrix_Index(collision->obj1->collider->colorMatrix, 1, 1) = 0.0f;
+	*Matrix_Index(collision->obj1->collider->colorMatrix, 2, 2) = 0.0f;
+
+	*Matrix_Index(collision->obj2->collider->colorMatrix, 0, 0) = 1.0f;
+	*Matrix_Index(collision->obj2->collider->colorMatrix, 1, 1) = 0.0f;
+	*Matrix_Index(collision->obj2->collider->colorMatrix, 2, 2) = 0.0f;
+}
+
+///
+//Requests an array of zeroed vectors for use within a single collision test
+//Within a task of the narrowphase the vectors come from the task's scratch arena, elsewhere from frame memory.
+//
+//Parameters:
+//	count: The number of vectors in the array
+//	dimension: The dimension of each vector
+//
+//Returns:
+//	An array of pointers to the requested vectors
+static Vector** CollisionManager_RequestScratchVectors(unsigned int count, uint16_t dimension)
+{
+	MemoryArena* scratch = (MemoryArena*)pthread_getspecific(collisionBuffer->scratchKey);
+	if(scratch != NULL)
+	{
+		return SystemManager_RequestArenaVectors(scratch, count, dimension);
+	}
+	return SystemManager_RequestFrameVectors(count, dimension);
+}
 
 ///
 //Tests for collisions on all objects which have colliders
 //compiling a list of collisions which occur
+//Every pair of moving objects in the array is tested, then every moving object is tested against the static tree.
+//Contacts are carried over from the last update, so this must be called once per frame with every object to test.
 //
 //Parameters:
 //	gameObjects: An array of game objects to test
+//	numObjects: The number of objects in the array
 //
 //Returns:
 //	A pointer to a linked list of collisions which occurred this frame
 LinkedList* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int numObjects)
 {
-	//Clear the current list of collisions
-	struct LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	struct LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
-	{
-		nextNode = currentNode->next;
-		struct Collision* currentCollision = (struct Collision*)currentNode->data;
-		CollisionManager_FreeCollision(currentCollision);
-		currentNode = nextNode;
-	}
+	//Clear the current list of collisions, the collisions themselves live in frame memory
 	LinkedList_Clear(collisionBuffer->collisions);
 
-	//Allocates a collision to store the first registered collision
-	struct Collision* collision = CollisionManager_AllocateCollision();
-	CollisionManager_InitializeCollision(collision);
-
+	//Pair every moving object with a collider with every moving object after it in the array,
+	//the static tree pairs them with the static objects
+	BVH* staticTree = collisionBuffer->staticTree;
+	collisionBuffer->pairs->size = 0;
 	for(unsigned int i = 0; i < numObjects; i++)
 	{
-		if(gameObjects[i]->collider != NULL)
+		if(gameObjects[i]->collider == NULL) continue;
+		if(staticTree != NULL && BVH_Contains(staticTree, gameObjects[i])) continue;
+
+		for(unsigned int j = i+1; j < numObjects; j++)
 		{
-			for(unsigned int j = i+1; j < numObjects; j++)
-			{
-				if(gameObjects[j]->collider != NULL)
-				{
-					CollisionManager_TestCollision( 
-						collision,
-						gameObjects[i],
-						gameObjects[i]->body != NULL ? gameObjects[i]->body->frame : gameObjects[i]->frameOfReference,		//If there is a rigidbody use that frame of reference, else use the objects
-						gameObjects[j],
-						gameObjects[j]->body != NULL ? gameObjects[j]->body->frame : gameObjects[j]->frameOfReference);	//If there is a rigidbody use that frame of reference, else use the objects
-
-					if(collision->obj1 == NULL)
-					{
-						continue;
-					}
+			if(gameObjects[j]->collider == NULL) continue;
+			if(staticTree != NULL && BVH_Contains(staticTree, gameObjects[j])) continue;
 
-					//If code reaches this point, all tests detected collision.
-					//add to collided list
-					LinkedList_Append(collisionBuffer->collisions, collision);
-					
-					//Make copies of the collision to add to object's colliders
-					struct Collision* objCollision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(objCollision);
-
-					//objCollision->minimumTranslationVector = collision->minimumTranslationVector;
-					Vector_Copy(objCollision->minimumTranslationVector, collision->minimumTranslationVector);
-					objCollision->obj1 = collision->obj1;
-					objCollision->obj1Frame = collision->obj1Frame;
-					objCollision->obj2 = collision->obj2;
-					objCollision->obj2Frame = collision->obj2Frame;
-					objCollision->overlap = collision->overlap;
-
-					LinkedList_Append(collision->obj1->collider->currentCollisions, objCollision);
-
-					 objCollision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(objCollision);
-
-					//objCollision->minimumTranslationVector = collision->minimumTranslationVector;
-					Vector_Copy(objCollision->minimumTranslationVector, collision->minimumTranslationVector);
-					objCollision->obj1 = collision->obj1;
-					objCollision->obj1Frame = collision->obj1Frame;
-					objCollision->obj2 = collision->obj2;
-					objCollision->obj2Frame = collision->obj2Frame;
-					objCollision->overlap = collision->overlap;
-
-					LinkedList_Append(collision->obj2->collider->currentCollisions, objCollision);
-
-					//TODO: Remove
-					//Change the color of colliders to red until they are drawn
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 2, 2) = 0.0f;
-
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 2, 2) = 0.0f;
-
-					//Allocate a new collision for next collision detected
-					collision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(collision);
-				}
-			}
+			struct GObject_Pair pair = { gameObjects[i], gameObjects[j] };
+			DynamicArray_GObjectPair_Append(collisionBuffer->pairs, pair);
 		}
 	}
+	CollisionManager_FilterPairs(collisionBuffer->pairs);
+	CollisionManager_GetStaticPairs();
 
-	//Delete the last unused allocated collision
-	CollisionManager_FreeCollision(collision);
+	CollisionManager_TestPairs(collisionBuffer->pairs);
+	CollisionManager_UpdateContacts();
 
 	return collisionBuffer->collisions;
 }
@@ -486,6 +1599,27 @@ void CollisionManager_TestCollision(struct Collision* dest, GObject* obj1, Frame
 	Collider_Update(obj1->collider, obj1FoR);
 	Collider_Update(obj2->collider, obj2FoR);
 
+	CollisionManager_TestUpdatedCollision(dest, obj1, obj1FoR, obj2, obj2FoR, NULL);
+}
+
+///
+//Tests for a collision between two objects whose world space colliders are up to date
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1: First game object to test (Must have collider attached)
+//	obj1FoR: Pointer to frame of reference to use to orient Object 1
+//	obj2: Second game object to test (Must have collider attached)
+//	obj2FoR: Pointer to frame of reference to use to orient Object 2
+//	axis: A pointer to the axis which separated a convex pair on the previous frame, replaced by the axis which separates it now.
+//		NULL to neither test nor remember an axis.
+//
+//Returns:
+//	1 if the remembered axis still separated the pair, else 0
+static unsigned char CollisionManager_TestUpdatedCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR, struct CollisionManager_SeparatingAxis* axis)
+{
+	unsigned char cached = 0;
+
 	//Test the types of the colliders
 	switch(obj1->collider->type)
 	{
@@ -552,12 +1686,24 @@ void CollisionManager_TestCollision(struct Collision* dest, GObject* obj1, Frame
 
 			break;
 		case COLLIDER_CONVEXHULL:					//AABB on Convex Hull case
-			CollisionManager_TestAABBConvexCollision(
+			if(collisionBuffer->AABBConvexAlgorithm == CONVEXALGORITHM_GJK)
+			{
+				cached = CollisionManager_TestCachedConvexCollisionGJK(
+					dest,
+					obj1,
+					obj1FoR,
+					obj2,
+					obj2FoR,
+					axis);
+				break;
+			}
+			cached = CollisionManager_TestCachedAABBConvexCollision(
 				dest,
 				obj1,
 				obj1FoR,
 				obj2,
-				obj2FoR);
+				obj2FoR,
+				axis);
 
 			break;
 		case COLLIDER_RAY:
@@ -583,21 +1729,45 @@ void CollisionManager_TestCollision(struct Collision* dest, GObject* obj1, Frame
 
 			break;
 		case COLLIDER_AABB:							//Convex Hull on AABB case
-			CollisionManager_TestAABBConvexCollision(
+			if(collisionBuffer->AABBConvexAlgorithm == CONVEXALGORITHM_GJK)
+			{
+				cached = CollisionManager_TestCachedConvexCollisionGJK(
+					dest,
+					obj2,
+					obj2FoR,
+					obj1,
+					obj1FoR,
+					axis);
+				break;
+			}
+			cached = CollisionManager_TestCachedAABBConvexCollision(
 				dest,
 				obj2,
 				obj2FoR,
 				obj1,
-				obj1FoR);
+				obj1FoR,
+				axis);
 
 			break;
 		case COLLIDER_CONVEXHULL:					//Convex Hull on  Convex Hull case
-			CollisionManager_TestConvexCollision(
+			if(collisionBuffer->convexAlgorithm == CONVEXALGORITHM_GJK)
+			{
+				cached = CollisionManager_TestCachedConvexCollisionGJK(
+					dest,
+					obj1,
+					obj1FoR,
+					obj2,
+					obj2FoR,
+					axis);
+				break;
+			}
+			cached = CollisionManager_TestCachedConvexCollision(
 				dest,
 				obj1,
 				obj1FoR,
 				obj2,
-				obj2FoR);
+				obj2FoR,
+				axis);
 
 			break;
 		case COLLIDER_RAY:
@@ -648,6 +1818,131 @@ void CollisionManager_TestCollision(struct Collision* dest, GObject* obj1, Frame
 		}
 		break;
 	}
+
+	return cached;
+}
+
+///
+//Determines if a pair of collider types is tested by one of the convex tests, whose separating axes are remembered
+//
+//Parameters:
+//	type1: The type of the first collider
+//	type2: The type of the second collider
+//
+//Returns:
+//	1 if the pair is a convex hull on a convex hull or AABB, else 0
+static unsigned char CollisionManager_IsConvexPair(ColliderType type1, ColliderType type2)
+{
+	return (type1 == COLLIDER_CONVEXHULL && (type2 == COLLIDER_CONVEXHULL || type2 == COLLIDER_AABB)) ||
+		(type1 == COLLIDER_AABB && type2 == COLLIDER_CONVEXHULL);
+}
+
+///
+//Tests the face or edge axis which separated a pair of convex colliders on the previous frame
+//The axis is oriented and tested exactly as the full separating axis test would, so skipping the full test never changes a result.
+//
+//Parameters:
+//	axis: A pointer to the remembered axis, or NULL. It's type is set to SEPARATINGAXIS_NONE if it no longer separates the pair.
+//	convexHull1: The convex hull of the first collider, NULL if it is an AABB
+//	orientedPoints1: The oriented world space points of the first collider
+//	numPoints1: The number of points of the first collider
+//	convexHull2: The convex hull of the second collider, NULL if it is an AABB
+//	orientedPoints2: The oriented world space points of the second collider
+//	numPoints2: The number of points of the second collider
+//
+//Returns:
+//	1 if the axis still separates the pair, else 0
+static unsigned char CollisionManager_TestCachedAxis(struct CollisionManager_SeparatingAxis* axis,
+	const struct ColliderData_ConvexHull* convexHull1, const Vector** orientedPoints1, const unsigned int numPoints1,
+	const struct ColliderData_ConvexHull* convexHull2, const Vector** orientedPoints2, const unsigned int numPoints2)
+{
+	if(axis == NULL) return 0;
+
+	Vector orientedAxis;
+	Vector_INIT_ON_STACK(orientedAxis, 3);
+	unsigned char valid = 0;
+
+	switch(axis->type)
+	{
+	case SEPARATINGAXIS_FACE1:
+		valid = CollisionManager_GetOrientedAxis(&orientedAxis, convexHull1, axis->index1, 0);
+		break;
+	case SEPARATINGAXIS_FACE2:
+		valid = CollisionManager_GetOrientedAxis(&orientedAxis, convexHull2, axis->index1, 0);
+		break;
+	case SEPARATINGAXIS_EDGES:
+	{
+		Vector edge1;
+		Vector_INIT_ON_STACK(edge1, 3);
+		Vector edge2;
+		Vector_INIT_ON_STACK(edge2, 3);
+
+		valid = CollisionManager_GetOrientedAxis(&edge1, convexHull1, axis->index1, 1) &&
+			CollisionManager_GetOrientedAxis(&edge2, convexHull2, axis->index2, 1);
+		if(valid)
+		{
+			Vector_CrossProduct(&orientedAxis, &edge1, &edge2);
+			Vector_Normalize(&orientedAxis);
+			valid = Vector_GetMag(&orientedAxis) != 0;
+		}
+		break;
+	}
+	default:
+		//Directions found by GJK are not face or edge axes
+		break;
+	}
+
+	if(valid)
+	{
+		struct ProjectionBounds bounds[2];
+		CollisionManager_GetProjectionBounds(bounds, &orientedAxis, orientedPoints1, numPoints1);
+		CollisionManager_GetProjectionBounds(bounds + 1, &orientedAxis, orientedPoints2, numPoints2);
+
+		//Faces of the first collider only overlap when their projections strictly overlap, as in CollisionManager_PerformSATFaces
+		unsigned char overlapping = axis->type == SEPARATINGAXIS_FACE1 ?
+			bounds[0].min < bounds[1].max && bounds[0].max > bounds[1].min :
+			bounds[0].min <= bounds[1].max && bounds[0].max >= bounds[1].min;
+
+		if(!overlapping) return 1;
+	}
+
+	axis->type = SEPARATINGAXIS_NONE;
+	return 0;
+}
+
+///
+//Gets a single world space face normal or edge of a convex collider
+//
+//Parameters:
+//	dest: The destination of the oriented axis
+//	convexHull: The convex hull of the collider whose world space data is up to date, NULL if it is an AABB
+//	index: The index of the face or edge
+//	edge: 1 to orient an edge, 0 to orient a face normal
+//
+//Returns:
+//	0 if the collider has no such face or edge, else 1
+static unsigned char CollisionManager_GetOrientedAxis(Vector* dest, const struct ColliderData_ConvexHull* convexHull, const unsigned int index, const unsigned char edge)
+{
+	//The faces and edges of an AABB are the world axes
+	if(convexHull == NULL)
+	{
+		if(index >= 3) return 0;
+		const Vector* axes[3] = { &Vector_E1, &Vector_E2, &Vector_E3 };
+		Vector_Copy(dest, axes[index]);
+		return 1;
+	}
+
+	if(edge)
+	{
+		if(index >= convexHull->numCachedEdges) return 0;
+		Vector_Copy(dest, convexHull->worldEdges[index]);
+	}
+	else
+	{
+		if(index >= convexHull->numCachedFaces) return 0;
+		Vector_Copy(dest, convexHull->worldAxes[index]);
+	}
+	return 1;
 }
 
 ///
@@ -665,25 +1960,28 @@ void CollisionManager_TestSphereCollision(struct Collision* dest, GObject* obj1,
 {
 	float minOverlap;
 
-	//Grab the Sphere Collider Data to perform test
-	//struct ColliderData_Sphere* sphere1 = obj1->collider->data->sphereData;
-	//struct ColliderData_Sphere* sphere2 = obj2->collider->data->sphereData;
+	//Grab the world space Sphere Collider Data to perform test, the radii are already scaled by the frames of reference
+	struct ColliderData_Sphere* sphere1 = Collider_GetColliderDataWorldSpace(obj1->collider);
+	struct ColliderData_Sphere* sphere2 = Collider_GetColliderDataWorldSpace(obj2->collider);
 
-	struct ColliderData_Sphere* sphere1 = Collider_GetColliderData(obj1->collider);
-	struct ColliderData_Sphere* sphere2 = Collider_GetColliderData(obj2->collider);
+	float obj1Radius = sphere1->radius;
+	float obj2Radius = sphere2->radius;
 
-	//Before performing the test, we must scale the sphere radius by the max scale value in the frame of reference
-	float obj1Radius = SphereCollider_GetScaledRadius(sphere1, obj1FoR);
-	float obj2Radius = SphereCollider_GetScaledRadius(sphere2, obj2FoR);
+	Vector obj1Center;
+	obj1Center.dimension = 3;
+	obj1Center.components = &sphere1->x;
+	Vector obj2Center;
+	obj2Center.dimension = 3;
+	obj2Center.components = &sphere2->x;
 
-	//Perform test
-	Vector displacement;
-	Vector_INIT_ON_STACK(displacement, 3);
+	//Perform test, the same way as the batched test so both agree on every pair
+	if(CollisionManager_DoSpheresOverlap(sphere1, sphere2))
+	{
+		Vector displacement;
+		Vector_INIT_ON_STACK(displacement, 3);
 
-	Vector_Subtract(&displacement, obj1FoR->position, obj2FoR->position);
+		Vector_Subtract(&displacement, &obj1Center, &obj2Center);
 
-	if(Vector_GetMag(&displacement) < obj1Radius + obj2Radius)
-	{
 		//There is a collision!
 		dest->obj1 = obj1;
 		dest->obj1Frame = obj1FoR;
@@ -712,10 +2010,10 @@ void CollisionManager_TestSphereCollision(struct Collision* dest, GObject* obj1,
 		Vector_GetScalarProduct(&obj2MinPoint, &displacement, -obj2Radius);
 		Vector_GetScalarProduct(&obj2MaxPoint, &displacement, obj2Radius);
 
-		Vector_Increment(&obj1MinPoint, obj1FoR->position);
-		Vector_Increment(&obj1MaxPoint, obj1FoR->position);
-		Vector_Increment(&obj2MinPoint, obj2FoR->position);
-		Vector_Increment(&obj2MaxPoint, obj2FoR->position);
+		Vector_Increment(&obj1MinPoint, &obj1Center);
+		Vector_Increment(&obj1MaxPoint, &obj1Center);
+		Vector_Increment(&obj2MinPoint, &obj2Center);
+		Vector_Increment(&obj2MaxPoint, &obj2Center);
 
 		//Get the overlaps in vector form
 		Vector ov1;
@@ -1009,6 +2307,112 @@ void CollisionManager_TestAABBCollision(struct Collision* dest, GObject* obj1, F
 
 }
 
+///
+//Tests many pairs of world space spheres for overlap, four pairs at a time where SSE is available
+//Only tells which pairs overlap, build the collisions of those pairs with CollisionManager_TestSphereCollision.
+//
+//Parameters:
+//	dest: An array to store 1 in for each pair of spheres which overlap, else 0
+//	spheres1: An array of pointers to the first sphere of each pair
+//	spheres2: An array of pointers to the second sphere of each pair
+//	numPairs: The number of pairs to test
+void CollisionManager_TestSpherePairs(unsigned char* dest, struct ColliderData_Sphere* const* spheres1, struct ColliderData_Sphere* const* spheres2, unsigned int numPairs)
+{
+	unsigned int i = 0;
+
+#ifdef CollisionManager_SSE
+	for(; i + 4 <= numPairs; i += 4)
+	{
+		//Each sphere is {x, y, z, radius}, transposing four of them gives one lane per pair
+		__m128 x1 = _mm_loadu_ps(&spheres1[i]->x);
+		__m128 y1 = _mm_loadu_ps(&spheres1[i + 1]->x);
+		__m128 z1 = _mm_loadu_ps(&spheres1[i + 2]->x);
+		__m128 r1 = _mm_loadu_ps(&spheres1[i + 3]->x);
+		_MM_TRANSPOSE4_PS(x1, y1, z1, r1);
+
+		__m128 x2 = _mm_loadu_ps(&spheres2[i]->x);
+		__m128 y2 = _mm_loadu_ps(&spheres2[i + 1]->x);
+		__m128 z2 = _mm_loadu_ps(&spheres2[i + 2]->x);
+		__m128 r2 = _mm_loadu_ps(&spheres2[i + 3]->x);
+		_MM_TRANSPOSE4_PS(x2, y2, z2, r2);
+
+		__m128 dx = _mm_sub_ps(x1, x2);
+		__m128 dy = _mm_sub_ps(y1, y2);
+		__m128 dz = _mm_sub_ps(z1, z2);
+		__m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		__m128 radii = _mm_add_ps(r1, r2);
+
+		int mask = _mm_movemask_ps(_mm_cmplt_ps(distSq, _mm_mul_ps(radii, radii)));
+		dest[i] = mask & 1;
+		dest[i + 1] = (mask >> 1) & 1;
+		dest[i + 2] = (mask >> 2) & 1;
+		dest[i + 3] = (mask >> 3) & 1;
+	}
+#endif
+
+	for(; i < numPairs; i++)
+	{
+		dest[i] = CollisionManager_DoSpheresOverlap(spheres1[i], spheres2[i]);
+	}
+}
+
+///
+//Tests many pairs of world space axis aligned bounding boxes for overlap, four pairs at a time where SSE is available
+//Only tells which pairs overlap, build the collisions of those pairs with CollisionManager_TestAABBCollision.
+//
+//Parameters:
+//	dest: An array to store 1 in for each pair of AABBs which overlap, else 0
+//	AABBs1: An array of pointers to the first AABB of each pair
+//	AABBs2: An array of pointers to the second AABB of each pair
+//	numPairs: The number of pairs to test
+void CollisionManager_TestAABBPairs(unsigned char* dest, struct ColliderData_AABB* const* AABBs1, struct ColliderData_AABB* const* AABBs2, unsigned int numPairs)
+{
+	unsigned int i = 0;
+
+#ifdef CollisionManager_SSE
+	for(; i + 4 <= numPairs; i += 4)
+	{
+		//Each AABB is {min[3], max[3]}, transposing it's first and last four floats gives one lane per pair
+		__m128 minX1 = _mm_loadu_ps(AABBs1[i]->min);
+		__m128 minY1 = _mm_loadu_ps(AABBs1[i + 1]->min);
+		__m128 minZ1 = _mm_loadu_ps(AABBs1[i + 2]->min);
+		__m128 unused1 = _mm_loadu_ps(AABBs1[i + 3]->min);
+		_MM_TRANSPOSE4_PS(minX1, minY1, minZ1, unused1);
+		__m128 unused2 = _mm_loadu_ps(AABBs1[i]->min + 2);
+		__m128 maxX1 = _mm_loadu_ps(AABBs1[i + 1]->min + 2);
+		__m128 maxY1 = _mm_loadu_ps(AABBs1[i + 2]->min + 2);
+		__m128 maxZ1 = _mm_loadu_ps(AABBs1[i + 3]->min + 2);
+		_MM_TRANSPOSE4_PS(unused2, maxX1, maxY1, maxZ1);
+
+		__m128 minX2 = _mm_loadu_ps(AABBs2[i]->min);
+		__m128 minY2 = _mm_loadu_ps(AABBs2[i + 1]->min);
+		__m128 minZ2 = _mm_loadu_ps(AABBs2[i + 2]->min);
+		__m128 unused3 = _mm_loadu_ps(AABBs2[i + 3]->min);
+		_MM_TRANSPOSE4_PS(minX2, minY2, minZ2, unused3);
+		__m128 unused4 = _mm_loadu_ps(AABBs2[i]->min + 2);
+		__m128 maxX2 = _mm_loadu_ps(AABBs2[i + 1]->min + 2);
+		__m128 maxY2 = _mm_loadu_ps(AABBs2[i + 2]->min + 2);
+		__m128 maxZ2 = _mm_loadu_ps(AABBs2[i + 3]->min + 2);
+		_MM_TRANSPOSE4_PS(unused4, maxX2, maxY2, maxZ2);
+
+		__m128 overlap = _mm_and_ps(_mm_cmple_ps(minX1, maxX2), _mm_cmpge_ps(maxX1, minX2));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(minY1, maxY2), _mm_cmpge_ps(maxY1, minY2)));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(minZ1, maxZ2), _mm_cmpge_ps(maxZ1, minZ2)));
+
+		int mask = _mm_movemask_ps(overlap);
+		dest[i] = mask & 1;
+		dest[i + 1] = (mask >> 1) & 1;
+		dest[i + 2] = (mask >> 2) & 1;
+		dest[i + 3] = (mask >> 3) & 1;
+	}
+#endif
+
+	for(; i < numPairs; i++)
+	{
+		dest[i] = CollisionManager_DoAABBsOverlap(AABBs1[i], AABBs2[i]);
+	}
+}
+
 ///
 //Tests if an object with an axis aligned bounding box is colliding with an object with a convex hull collider
 //
@@ -1019,6 +2423,24 @@ void CollisionManager_TestAABBCollision(struct Collision* dest, GObject* obj1, F
 //	convexObj: Pointer to the object which has a convex hull collider
 //	convexFrame: Pointer to the frame of reference used to orient the the object with the convex hull collider
 void CollisionManager_TestAABBConvexCollision(struct Collision* dest, GObject* AABBObj, FrameOfReference* AABBObjFrame, GObject* convexObj, FrameOfReference* convexObjFrame)
+{
+	CollisionManager_TestCachedAABBConvexCollision(dest, AABBObj, AABBObjFrame, convexObj, convexObjFrame, NULL);
+}
+
+///
+//Tests if an object with an AABB is colliding with an object with a convex hull, testing a remembered separating axis first
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	AABBObj: Pointer to the object which has an axis aligned bounding box
+//	AABBObjFrame: Pointer to the frame of reference used to orient the object with the AABB
+//	convexObj: Pointer to the object which has a convex hull collider
+//	convexFrame: Pointer to the frame of reference used to orient the the object with the convex hull collider
+//	axis: A pointer to the axis which separated the pair on the previous frame, replaced by the axis which separates it now, or NULL
+//
+//Returns:
+//	1 if the remembered axis still separated the pair, else 0
+static unsigned char CollisionManager_TestCachedAABBConvexCollision(struct Collision* dest, GObject* AABBObj, FrameOfReference* AABBObjFrame, GObject* convexObj, FrameOfReference* convexObjFrame, struct CollisionManager_SeparatingAxis* axis)
 {
 	//GEt the collider data of both objects
 	struct ColliderData_AABB* AABB = Collider_GetColliderDataWorldSpace(AABBObj->collider);
@@ -1030,53 +2452,15 @@ void CollisionManager_TestAABBConvexCollision(struct Collision* dest, GObject* A
 	AABBCollider_GetScaledDimensions(&scaledAABB, AABB, AABBObjFrame);
 
 	//We must convert the AABB to a convex hull and get the oriented axis and oriented points from both objects
-	Vector** orientedPointsAABB = (Vector**)malloc(sizeof(Vector*) * 8);
-	Vector** orientedPointsConvex = (Vector**)malloc(sizeof(Vector*) * convexHull->points->size);
-
-	Vector** orientedAxesAABB = (Vector**)malloc(sizeof(Vector*) * 3);
-	Vector** orientedAxesConvex = (Vector**)malloc(sizeof(Vector*) * convexHull->faces->size);
-
-	Vector** orientedEdgesAABB = (Vector**)malloc(sizeof(Vector*) * 3);
-	Vector** orientedEdgesConvex = (Vector**)malloc(sizeof(Vector*) * convexHull->edges->size);
-
-
-	//Allocate an initialize individual vectors in array of oriented points for AABB
-	for(int i = 0; i < 8; i++)
-	{
-		orientedPointsAABB[i] = Vector_Allocate();
-		Vector_Initialize(orientedPointsAABB[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented points for convex hull
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		orientedPointsConvex[i] = Vector_Allocate();
-		Vector_Initialize(orientedPointsConvex[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented axes & edges for AABB
-	for(int i = 0; i < 3; i++)
-	{
-		orientedAxesAABB[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxesAABB[i], 3);
+	//The convex hull's were oriented when it's collider was updated
+	Vector** orientedPointsAABB = CollisionManager_RequestScratchVectors(8, 3);
+	Vector** orientedPointsConvex = convexHull->worldPoints;
 
-		orientedEdgesAABB[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdgesAABB[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented axes for convex hull
-	for(unsigned int i = 0; i < convexHull->faces->size; i++)
-	{
-		orientedAxesConvex[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxesConvex[i], 3);
-	}
+	Vector** orientedAxesAABB = CollisionManager_RequestScratchVectors(3, 3);
+	Vector** orientedAxesConvex = convexHull->worldAxes;
 
-	//Allocate and initialize individual vectors in array of oriented edges for convex hull
-	for(unsigned int i = 0; i < convexHull->edges->size; i++)
-	{
-		orientedEdgesConvex[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdgesConvex[i], 3);
-	}
+	Vector** orientedEdgesAABB = CollisionManager_RequestScratchVectors(3, 3);
+	Vector** orientedEdgesConvex = convexHull->worldEdges;
 
 	//Get oriented points of AABB
 	//Right Bottom Front
@@ -1119,71 +2503,44 @@ void CollisionManager_TestAABBConvexCollision(struct Collision* dest, GObject* A
 	orientedPointsAABB[7]->components[1] = AABB->max[1];
 	orientedPointsAABB[7]->components[2] = AABB->max[2];
 
-	//Get oriented points of Convex Hull
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPointsConvex, convexHull, convexObjFrame);
+	//Test the axis which separated the objects on the previous frame before any other
+	if(CollisionManager_TestCachedAxis(axis,
+		NULL, (const Vector**)orientedPointsAABB, 8,
+		convexHull, (const Vector**)orientedPointsConvex, convexHull->points->size))
+	{
+		dest->overlap = 0.0f;
+		dest->obj1 = NULL;
+		dest->obj2 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2Frame = NULL;
+		return 1;
+	}
 
 	//Get oriented axes of AABB
 	Vector_Copy(orientedAxesAABB[0], &Vector_E1);
 	Vector_Copy(orientedAxesAABB[1], &Vector_E2);
 	Vector_Copy(orientedAxesAABB[2], &Vector_E3);
 
-	//Get oriented axes of convex hull
-	ConvexHullCollider_GetOrientedAxes(orientedAxesConvex, convexHull, convexObjFrame);
-
 	//Get oriented edges of AABB
 	Vector_Copy(orientedEdgesAABB[0], &Vector_E1);
 	Vector_Copy(orientedEdgesAABB[1], &Vector_E2);
 	Vector_Copy(orientedEdgesAABB[2], &Vector_E3);
 
-	//Get oriented edges of convex hull
-	ConvexHullCollider_GetOrientedEdges(orientedEdgesConvex, convexHull, convexObjFrame);
-
 
 	//Perform SAT Alorithm for face normals
 	unsigned char detected = CollisionManager_PerformSATFaces(dest,
 		(const Vector**)orientedAxesAABB, 3, (const Vector**)orientedPointsAABB, 8,
-		(const Vector**)orientedAxesConvex, convexHull->faces->size, (const Vector**)orientedPointsConvex, convexHull->points->size);
+		(const Vector**)orientedAxesConvex, convexHull->faces->size, (const Vector**)orientedPointsConvex, convexHull->points->size,
+		axis);
 
 	//If a collisionn is detected, check edge normals
 	if(detected)
 	{
 		detected = CollisionManager_PerformSATEdges(dest,
 			(const Vector**)orientedEdgesAABB, 3, (const Vector**)orientedPointsAABB, 8,
-			(const Vector**)orientedEdgesConvex, convexHull->edges->size, (const Vector**)orientedPointsConvex, convexHull->points->size);
-	}
-
-	//Delete oriented arrays
-	for(int i = 0; i < 8; i++)
-	{
-		Vector_Free(orientedPointsAABB[i]);
-	}
-	free(orientedPointsAABB);
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		Vector_Free(orientedPointsConvex[i]);
-	}
-	free(orientedPointsConvex);
-	for(int i = 0; i < 3; i++)
-	{
-		Vector_Free(orientedAxesAABB[i]);
-	}
-	free(orientedAxesAABB);
-	for(unsigned int i = 0; i < convexHull->faces->size; i++)
-	{
-		Vector_Free(orientedAxesConvex[i]);
-	}
-	free(orientedAxesConvex);
-	for(int i = 0; i < 3; i++)
-	{
-		Vector_Free(orientedEdgesAABB[i]);
-	}
-	free(orientedEdgesAABB);
-	for(unsigned int i = 0; i < convexHull->edges->size; i++)
-	{
-		Vector_Free(orientedEdgesConvex[i]);
+			(const Vector**)orientedEdgesConvex, convexHull->edges->size, (const Vector**)orientedPointsConvex, convexHull->points->size,
+			axis);
 	}
-	free(orientedEdgesConvex);
-
 
 	if(detected)
 	{
@@ -1214,6 +2571,8 @@ void CollisionManager_TestAABBConvexCollision(struct Collision* dest, GObject* A
 		dest->obj2Frame = NULL;
 
 	}
+
+	return 0;
 }
 
 ///
@@ -1429,6 +2788,24 @@ void CollisionManager_TestAABBRayCollision(struct Collision* dest, GObject* AABB
 //	obj2:		Second game object to test (Must have collider attached)
 //	obj2FoR:	Pointer to frame of reference to use to orient Object 2 convex hull
 void CollisionManager_TestConvexCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR)
+{
+	CollisionManager_TestCachedConvexCollision(dest, obj1, obj1FoR, obj2, obj2FoR, NULL);
+}
+
+///
+//Tests if two game object's convex hulls are colliding, testing a remembered separating axis first
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1: First game object to test (Must have collider attached)
+//	obj1FoR: Pointer to frame of reference to use to orient Object 1 convex hull
+//	obj2: Second game object to test (Must have collider attached)
+//	obj2FoR: Pointer to frame of reference to use to orient Object 2 convex hull
+//	axis: A pointer to the axis which separated the pair on the previous frame, replaced by the axis which separates it now, or NULL
+//
+//Returns:
+//	1 if the remembered axis still separated the pair, else 0
+static unsigned char CollisionManager_TestCachedConvexCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR, struct CollisionManager_SeparatingAxis* axis)
 {
 	//float minOverlap;
 	unsigned char detected = 1;
@@ -1437,132 +2814,135 @@ void CollisionManager_TestConvexCollision(struct Collision* dest, GObject* obj1,
 	struct ColliderData_ConvexHull* convexHull1 = obj1->collider->data->convexHullData;
 	struct ColliderData_ConvexHull* convexHull2 = obj2->collider->data->convexHullData;
 
-	//Create array of pointers to vectors to hold the oriented points of the colliders of objects in collision
-	Vector** orientedPoints1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->points->size);
-	Vector** orientedPoints2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->points->size);
-
-	//Create array of pointers to vectors to hold the oriented axes of the colliders of objects in collision
-	Vector** orientedAxes1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->faces->size);
-	Vector** orientedAxes2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->faces->size);
-
-	//Create array of pointers to hold oriented edges of colliders of objects in collision
-	Vector** orientedEdges1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->edges->size);
-	Vector** orientedEdges2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->edges->size);
-
-	//Allocate & initialize individual vectors in array of point vectors for obj1
-	for(unsigned int i = 0; i < convexHull1->points->size; i++)
-	{
-		orientedPoints1[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints1[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array in array of point vectors for obj2
-	for(unsigned int i = 0; i < convexHull2->points->size; i++)
-	{
-		orientedPoints2[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints2[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array of axes vectors for obj1
-	for(unsigned int i = 0; i < convexHull1->faces->size; i++)
-	{
-		orientedAxes1[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes1[i], 3);
-	}
+	//The oriented points, axes and edges of both hulls were computed when their colliders were updated
+	Vector** orientedPoints1 = convexHull1->worldPoints;
+	Vector** orientedPoints2 = convexHull2->worldPoints;
 
-	//Allocate & initialize individual vectors in array in array of axes vectors for obj2
-	for(unsigned int i = 0; i < convexHull2->faces->size; i++)
-	{
-		orientedAxes2[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes2[i], 3);
-	}
+	Vector** orientedAxes1 = convexHull1->worldAxes;
+	Vector** orientedAxes2 = convexHull2->worldAxes;
 
-	//Allocate & initialize individual vectors in array of edges vectors for obj1
-	for(unsigned int i = 0; i < convexHull1->edges->size; i++)
-	{
-		orientedEdges1[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdges1[i], 3);
-	}
+	Vector** orientedEdges1 = convexHull1->worldEdges;
+	Vector** orientedEdges2 = convexHull2->worldEdges;
 
-	//Allocate & initialize individual vectors in array in array of axes vectors for obj2
-	for(unsigned int i = 0; i < convexHull2->edges->size; i++)
+	//Test the axis which separated the objects on the previous frame before any other
+	if(CollisionManager_TestCachedAxis(axis,
+		convexHull1, (const Vector**)orientedPoints1, convexHull1->points->size,
+		convexHull2, (const Vector**)orientedPoints2, convexHull2->points->size))
 	{
-		orientedEdges2[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdges2[i], 3);
+		dest->overlap = 0.0f;
+		dest->obj1 = NULL;
+		dest->obj2 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2Frame = NULL;
+		return 1;
 	}
 
-	//Get oriented points of objects
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints1, convexHull1, obj1FoR);
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints2, convexHull2, obj2FoR);
-
-	//Get oriented axes of objects
-	ConvexHullCollider_GetOrientedAxes(orientedAxes1, convexHull1, obj1FoR);
-	ConvexHullCollider_GetOrientedAxes(orientedAxes2, convexHull2, obj2FoR);
-
-	//Get oriented edges of objects
-	ConvexHullCollider_GetOrientedEdges(orientedEdges1, convexHull1, obj1FoR);
-	ConvexHullCollider_GetOrientedEdges(orientedEdges2, convexHull2, obj2FoR);
-
 	//Perform SAT Algorithm for face normals
 	detected = CollisionManager_PerformSATFaces(dest, 
 		(const Vector**)orientedAxes1, convexHull1->faces->size, (const Vector**)orientedPoints1, convexHull1->points->size,
-		(const Vector**)orientedAxes2, convexHull2->faces->size, (const Vector**)orientedPoints2, convexHull2->points->size);
+		(const Vector**)orientedAxes2, convexHull2->faces->size, (const Vector**)orientedPoints2, convexHull2->points->size,
+		axis);
 
 	//If there is a collision detection, test the edge normals
 	if(detected)
 	{
 		detected = CollisionManager_PerformSATEdges(dest, 
 			(const Vector**)orientedEdges1, convexHull1->edges->size, (const Vector**)orientedPoints1, convexHull1->points->size,
-			(const Vector**)orientedEdges2, convexHull2->edges->size, (const Vector**)orientedPoints2, convexHull2->points->size);
+			(const Vector**)orientedEdges2, convexHull2->edges->size, (const Vector**)orientedPoints2, convexHull2->points->size,
+			axis);
 	}
 
+	if(detected)
+	{
+		//MTV must always face obj1
+		Vector bToa;
+		Vector_INIT_ON_STACK(bToa, 3);
 
+		Vector_Subtract(&bToa, obj1FoR->position, obj2FoR->position);
 
-	//Delete oriented arrays
-	for(unsigned int i = 0; i < convexHull1->points->size; i++)
-	{
-		Vector_Free(orientedPoints1[i]);
-	}
-	free(orientedPoints1);
-	for(unsigned int i = 0; i < convexHull2->points->size; i++)
-	{
-		Vector_Free(orientedPoints2[i]);
-	}
-	free(orientedPoints2);
-	for(unsigned int i = 0; i < convexHull1->faces->size; i++)
-	{
-		Vector_Free(orientedAxes1[i]);
-	}
-	free(orientedAxes1);
-	for(unsigned int i = 0; i < convexHull2->faces->size; i++)
-	{
-		Vector_Free(orientedAxes2[i]);
-	}
-	free(orientedAxes2);
-	for(unsigned int i = 0; i < convexHull1->edges->size; i++)
-	{
-		Vector_Free(orientedEdges1[i]);
+		//Check if MTV must be reversed to face Obj 1
+		if(Vector_DotProduct(&bToa, dest->minimumTranslationVector) < 0.0f)
+		{
+			Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		}
+
+		dest->obj1 = obj1;
+		dest->obj1Frame = obj1FoR;
+		dest->obj2 = obj2;
+		dest->obj2Frame = obj2FoR;
 	}
-	free(orientedEdges1);
-	for(unsigned int i = 0; i < convexHull2->edges->size; i++)
+	else
 	{
-		Vector_Free(orientedEdges2[i]);
+		//If there is no collision set collision atributes to null
+		dest->overlap = 0.0f;
+		dest->obj1 = NULL;
+		dest->obj2 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2Frame = NULL;
+
 	}
-	free(orientedEdges2);
 
-	if(detected)
+	return 0;
+}
+
+///
+//Tests if two game objects with convex colliders are colliding
+//Utilizes GJK to detect the collision and EPA to find the minimum translation vector
+//Either object may have a convex hull or an axis aligned bounding box collider.
+//If there is no collision, collision.obj1 and obj2 will be set to null upon
+//The end of this function
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1:		First game object to test (Must have collider attached)
+//	obj1FoR:	Pointer to frame of reference to use to orient Object 1 collider
+//	obj2:		Second game object to test (Must have collider attached)
+//	obj2FoR:	Pointer to frame of reference to use to orient Object 2 collider
+void CollisionManager_TestConvexCollisionGJK(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR)
+{
+	CollisionManager_TestCachedConvexCollisionGJK(dest, obj1, obj1FoR, obj2, obj2FoR, NULL);
+}
+
+///
+//Tests if two game objects with convex colliders are colliding using GJK, testing a remembered separating direction first
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1: First game object to test (Must have collider attached)
+//	obj1FoR: Pointer to frame of reference to use to orient Object 1 collider
+//	obj2: Second game object to test (Must have collider attached)
+//	obj2FoR: Pointer to frame of reference to use to orient Object 2 collider
+//	axis: A pointer to the axis which separated the pair on the previous frame, replaced by the axis which separates it now, or NULL
+//
+//Returns:
+//	1 if the remembered direction still separated the pair, else 0
+static unsigned char CollisionManager_TestCachedConvexCollisionGJK(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR, struct CollisionManager_SeparatingAxis* axis)
+{
+	//Describe both colliders by their support functions
+	struct CollisionManager_ConvexShape convex1;
+	struct CollisionManager_ConvexShape convex2;
+	struct GJK_Shape shape1;
+	struct GJK_Shape shape2;
+	CollisionManager_InitializeConvexShape(&shape1, &convex1, obj1, obj1FoR);
+	CollisionManager_InitializeConvexShape(&shape2, &convex2, obj2, obj2FoR);
+
+	//Test the direction which separated the objects on the previous frame before searching for a new one
+	unsigned char cached = axis != NULL && axis->type == SEPARATINGAXIS_DIRECTION && GJK_IsSeparatingAxis(axis->direction, &shape1, &shape2);
+
+	struct GJK_Simplex simplex;
+	if(!cached && GJK_Intersect(&simplex, NULL, &shape1, &shape2))
 	{
-		//MTV must always face obj1
-		Vector bToa;
-		Vector_INIT_ON_STACK(bToa, 3);
+		if(axis != NULL) axis->type = SEPARATINGAXIS_NONE;
 
-		Vector_Subtract(&bToa, obj1FoR->position, obj2FoR->position);
+		float normal[3];
+		float depth;
+		GJK_GetPenetration(normal, &depth, &simplex, &shape1, &shape2);
 
-		//Check if MTV must be reversed to face Obj 1
-		if(Vector_DotProduct(&bToa, dest->minimumTranslationVector) < 0.0f)
-		{
-			Vector_Scale(dest->minimumTranslationVector, -1.0f);
-		}
+		//The penetration normal points from obj1 into obj2, the MTV must face obj1
+		dest->minimumTranslationVector->components[0] = -normal[0];
+		dest->minimumTranslationVector->components[1] = -normal[1];
+		dest->minimumTranslationVector->components[2] = -normal[2];
+		dest->overlap = depth;
 
 		dest->obj1 = obj1;
 		dest->obj1Frame = obj1FoR;
@@ -1571,14 +2951,22 @@ void CollisionManager_TestConvexCollision(struct Collision* dest, GObject* obj1,
 	}
 	else
 	{
+		//Remember the direction GJK separated the objects along
+		if(axis != NULL && !cached)
+		{
+			axis->type = SEPARATINGAXIS_DIRECTION;
+			memcpy(axis->direction, simplex.direction, sizeof(float) * 3);
+		}
+
 		//If there is no collision set collision atributes to null
 		dest->overlap = 0.0f;
 		dest->obj1 = NULL;
 		dest->obj2 = NULL;
 		dest->obj1Frame = NULL;
 		dest->obj2Frame = NULL;
-
 	}
+
+	return cached;
 }
 
 ///
@@ -1610,24 +2998,9 @@ void CollisionManager_TestConvexSphereCollision(struct Collision* dest, GObject*
 	spherePos.components[1] = worldSphere->y;
 	spherePos.components[2] = worldSphere->z;
 
-	//Create an array of pointers to vectors to hold the oriented points and axes of the convex hull collider
-	Vector** orientedPoints = (Vector**)malloc(sizeof(Vector*) * convexHull->points->size);
-	Vector** orientedAxes = (Vector**)malloc(sizeof(Vector*) * convexHull->faces->size);
-
-	//Allocate and initialize oriented points and axes
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		orientedPoints[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints[i], 3);
-	}
-	for(unsigned int i = 0; i < convexHull->faces->size; i++)
-	{
-		orientedAxes[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes[i], 3);
-	}
-	//Get oriented points and axes
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints, convexHull, convexFoR);
-	ConvexHullCollider_GetOrientedAxes(orientedAxes, convexHull, convexFoR);
+	//The oriented points and axes of the convex hull were computed when it's collider was updated
+	Vector** orientedPoints = convexHull->worldPoints;
+	Vector** orientedAxes = convexHull->worldAxes;
 
 	//Get the scaled radius of the sphere
 	float scaledRadius = worldSphere->radius;//SphereCollider_GetScaledRadius(sphere, sphereFoR);
@@ -1813,19 +3186,6 @@ void CollisionManager_TestConvexSphereCollision(struct Collision* dest, GObject*
 			}
 		}
 	}
-	
-	//Cleanup anything allocated on the heap
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		Vector_Free(orientedPoints[i]);
-	}
-	free(orientedPoints);
-
-	for(unsigned int i = 0; i < convexHull->faces->size; i++)
-	{
-		Vector_Free(orientedAxes[i]);
-	}
-	free(orientedAxes);
 
 	DynamicArray_Free(candidates);
 
@@ -1867,29 +3227,16 @@ void CollisionManager_TestConvexRayCollision(struct Collision* dest, GObject* co
 {
 	struct ColliderData_Ray* ray = rayObj->collider->data->rayData;
 	struct ColliderData_ConvexHull* convexHull = convexObj->collider->data->convexHullData;
+	//The hull's cached world points and axes are already oriented by convexFrame
+	(void)convexFrame;
 
 	struct ColliderData_Ray worldRay;
 	ColliderData_Ray_INIT_ON_STACK(worldRay);
 	RayCollider_GetWorldRay(&worldRay, ray, rayFrame);
 
-	//Create an array of pointers to vectors to hold the oriented points and axes of the convex hull collider
-	Vector** orientedPoints = (Vector**)malloc(sizeof(Vector*) * convexHull->points->size);
-	Vector** orientedAxes = (Vector**)malloc(sizeof(Vector*) * convexHull->faces->size);
-
-	//Allocate and initialize oriented points and axes
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		orientedPoints[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints[i], 3);
-	}
-	for(unsigned int i = 0; i < convexHull->faces->size; i++)
-	{
-		orientedAxes[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes[i], 3);
-	}
-	//Get oriented points and axes
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints, convexHull, convexFrame);
-	ConvexHullCollider_GetOrientedAxes(orientedAxes, convexHull, convexFrame);
+	//The oriented points and axes of the convex hull were computed when it's collider was updated
+	Vector** orientedPoints = convexHull->worldPoints;
+	Vector** orientedAxes = convexHull->worldAxes;
 
 	float largestIn = -1.0f;
 	float smallestOut = -1.0f;
@@ -1942,12 +3289,7 @@ void CollisionManager_TestConvexRayCollision(struct Collision* dest, GObject* co
 	else
 	{
 		//Collision
-		Vector** orientedPointsRay = malloc(sizeof(Vector*) * 2);
-		for(int i = 0; i < 2; i++)
-		{
-			orientedPointsRay[i] = Vector_Allocate();
-			Vector_Initialize(orientedPointsRay[i], 3);
-		}	
+		Vector** orientedPointsRay = CollisionManager_RequestScratchVectors(2, 3);
 
 		Vector_GetScalarProduct(orientedPointsRay[0], worldRay.direction, largestIn);
 		Vector_GetScalarProduct(orientedPointsRay[1], worldRay.direction, smallestOut);
@@ -1959,7 +3301,8 @@ void CollisionManager_TestConvexRayCollision(struct Collision* dest, GObject* co
 				(const Vector**)orientedAxes, convexHull->faces->size,
 				(const Vector**)orientedPoints, convexHull->points->size,
 				NULL, 0,
-				(const Vector**)orientedPointsRay, 2);
+				(const Vector**)orientedPointsRay, 2,
+				NULL);
 
 		Vector projNormal;
 		Vector_INIT_ON_STACK(projNormal, 3);
@@ -1970,25 +3313,8 @@ void CollisionManager_TestConvexRayCollision(struct Collision* dest, GObject* co
 
 		//TODO: Determine new overlap
 
-		for(int i = 0; i < 2; i++)
-		{
-			Vector_Free(orientedPointsRay[i]);
-		}
-		free(orientedPointsRay);
-
 	}
 
-	//Allocate and initialize oriented points and axes
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		orientedPoints[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints[i], 3);
-	}
-	for(unsigned int i = 0; i < convexHull->faces->size; i++)
-	{
-		orientedAxes[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes[i], 3);
-	}
 }
 
 ///
@@ -2137,43 +3463,509 @@ unsigned char CollisionManager_RayCastGObject(struct ColliderData_Ray* worldRay,
 }
 
 ///
-//Performs a ray cast against a sphere collider
+//Performs a ray cast against the objects in the query broadphase and the static tree
+//Only objects whose bounds the ray crosses are tested.
+//
+//Parameters:
+//	worldRay: A pointer to the ray to raycast with oriented in worldspace
+//
+//Returns:
+//	0 if there is no collision between the ray and any object
+//	The result of CollisionManager_RayCastGObject for the first object found colliding with the ray
+unsigned char CollisionManager_RayCastBroadphase(struct ColliderData_Ray* worldRay)
+{
+	DynamicArray* candidates = collisionBuffer->candidates;
+	candidates->size = 0;
+	CollisionManager_QueryBroadphaseRay(worldRay, candidates);
+	if(collisionBuffer->staticTree != NULL)
+	{
+		BVH_Update(collisionBuffer->staticTree);
+		BVH_QueryRay(collisionBuffer->staticTree, worldRay, candidates);
+	}
+
+	DYNARRAY_FOREACH(GObjectPtr, candidate, candidates)
+	{
+		unsigned char hit = CollisionManager_RayCastGObject(worldRay, *candidate);
+		if(hit) return hit;
+	}
+	return 0;
+}
+
+///
+//Casts a batch of rays against the objects in the query broadphase and the static tree, finding the object each ray meets first
+//An AABB tree broadphase is visited front to back, stopping once nothing nearer than a ray's closest hit remains,
+//other broadphases test every object whose bounds the ray crosses.
+//The static tree is cast through second, so it only replaces the hits of the broadphase with nearer static objects.
+//Sphere, AABB and convex hull colliders are tested, other colliders are ignored.
+//
+//Parameters:
+//	dest: An array of numRays hits to store the object each ray meets and the parametric value where it meets it
+//	worldRays: An array of numRays rays oriented in world space
+//	numRays: The number of rays to cast
+//	maxDistance: The furthest parametric value along each ray at which a hit is accepted
+//	anyHit: 1 to accept the first object each ray is found to meet rather than the nearest, for visibility checks
+void CollisionManager_RayCast(struct AABBTree_RayHit* dest, struct ColliderData_Ray* worldRays, unsigned int numRays, float maxDistance, unsigned char anyHit)
+{
+	if(collisionBuffer->queryBroadphase == BROADPHASE_AABBTREE && collisionBuffer->queryStructure != NULL)
+	{
+		AABBTree_RayCast(collisionBuffer->queryStructure, dest, worldRays, numRays, maxDistance, anyHit, CollisionManager_GetRayGObjectIntersection, NULL);
+	}
+	else
+	{
+		DynamicArray* candidates = collisionBuffer->candidates;
+		for(unsigned int i = 0; i < numRays; i++)
+		{
+			dest[i].obj = NULL;
+			dest[i].distance = maxDistance;
+
+			candidates->size = 0;
+			CollisionManager_QueryBroadphaseRay(worldRays + i, candidates);
+			DYNARRAY_FOREACH(GObjectPtr, candidate, candidates)
+			{
+				//NaN misses fail both comparisons
+				float distance = CollisionManager_GetRayGObjectIntersection(*candidate, worldRays + i, NULL);
+				if(distance >= 0.0f && distance <= dest[i].distance)
+				{
+					dest[i].obj = *candidate;
+					dest[i].distance = distance;
+					if(anyHit) break;
+				}
+			}
+		}
+	}
+
+	if(collisionBuffer->staticTree != NULL)
+	{
+		BVH_Update(collisionBuffer->staticTree);
+		BVH_RayCast(collisionBuffer->staticTree, dest, worldRays, numRays, anyHit, CollisionManager_GetRayGObjectIntersection, NULL);
+	}
+}
+
+///
+//Finds the objects in the query broadphase and the static tree whose colliders overlap a world space sphere
+//No collisions are created, so the query may be made at any time outside of the narrowphase.
+//Sphere, AABB and convex hull colliders are tested, other colliders are ignored.
+//
+//Parameters:
+//	dest: A pointer to a dynamic array of GObject* to append the overlapping objects to
+//	center: The world space center of the sphere
+//	radius: The radius of the sphere
+//	filter: A function deciding which overlapping objects are reported, or NULL to report all of them
+//	data: Passed to the filter
+//
+//Returns:
+//	The number of objects appended to dest
+unsigned int CollisionManager_OverlapSphere(DynamicArray* dest, const float center[3], float radius, CollisionManager_OverlapFilter filter, void* data)
+{
+	struct ColliderData_Sphere sphere = { center[0], center[1], center[2], radius };
+
+	struct ColliderData_AABB bounds;
+	for(int i = 0; i < 3; i++)
+	{
+		bounds.min[i] = center[i] - radius;
+		bounds.max[i] = center[i] + radius;
+	}
+
+	return CollisionManager_Overlap(dest, &bounds, &sphere, filter, data);
+}
+
+///
+//Finds the objects in the query broadphase and the static tree whose colliders overlap a world space axis aligned bounding box
+//No collisions are created, so the query may be made at any time outside of the narrowphase.
+//Sphere, AABB and convex hull colliders are tested, other colliders are ignored.
+//
+//Parameters:
+//	dest: A pointer to a dynamic array of GObject* to append the overlapping objects to
+//	bounds: A pointer to the world space AABB
+//	filter: A function deciding which overlapping objects are reported, or NULL to report all of them
+//	data: Passed to the filter
+//
+//Returns:
+//	The number of objects appended to dest
+unsigned int CollisionManager_OverlapAABB(DynamicArray* dest, const struct ColliderData_AABB* bounds, CollisionManager_OverlapFilter filter, void* data)
+{
+	return CollisionManager_Overlap(dest, bounds, NULL, filter, data);
+}
+
+///
+//Finds how far a world space sphere can be translated along a displacement before it touches an object's collider
+//Sphere, AABB and convex hull colliders are tested, other colliders are never hit.
+//A collider the sphere already touches before moving is left to the narrowphase and is not hit.
+//
+//Parameters:
+//	sphere: A pointer to the world space sphere at the start of the displacement
+//	displacement: The world space translation of the sphere
+//	obj: A pointer to the object whose collider is tested
+//
+//Returns:
+//	The time of impact as a fraction of the displacement from 0 to 1, or NaN if the sphere does not hit the collider
+float CollisionManager_SweepSphere(const struct ColliderData_Sphere* sphere, const float displacement[3], GObject* obj)
+{
+	struct GJK_Shape shape;
+	shape.support = CollisionManager_SupportSphere;
+	shape.data = sphere;
+	shape.center[0] = sphere->x;
+	shape.center[1] = sphere->y;
+	shape.center[2] = sphere->z;
+
+	return CollisionManager_Sweep(&shape, displacement, obj);
+}
+
+///
+//Finds how far a world space axis aligned bounding box can be translated along a displacement before it touches an object's collider
+//Sphere, AABB and convex hull colliders are tested, other colliders are never hit.
+//A collider the AABB already touches before moving is left to the narrowphase and is not hit.
+//
+//Parameters:
+//	bounds: A pointer to the world space AABB at the start of the displacement
+//	displacement: The world space translation of the AABB
+//	obj: A pointer to the object whose collider is tested
+//
+//Returns:
+//	The time of impact as a fraction of the displacement from 0 to 1, or NaN if the AABB does not hit the collider
+float CollisionManager_SweepAABB(const struct ColliderData_AABB* bounds, const float displacement[3], GObject* obj)
+{
+	struct CollisionManager_ConvexShape data = { NULL, bounds };
+	struct GJK_Shape shape;
+	shape.support = CollisionManager_SupportAABB;
+	shape.data = &data;
+	for(int i = 0; i < 3; i++)
+	{
+		shape.center[i] = (bounds->min[i] + bounds->max[i]) * 0.5f;
+	}
+
+	return CollisionManager_Sweep(&shape, displacement, obj);
+}
+
+///
+//Finds the first collider an object's collider hits when it is translated along a displacement from it's current frame
+//Only the objects the query broadphase and the static tree find within the swept bounds are tested.
+//Moving objects are found where the broadphase last saw them, as it is updated after the bodies are.
+//Objects whose collision layers do not allow them to collide with the object are passed through.
+//
+//Parameters:
+//	hit: The destination of a pointer to the object which was hit, or NULL
+//	obj: A pointer to the object with a sphere, AABB or convex hull collider to sweep
+//	displacement: The world space translation of the object
+//
+//Returns:
+//	The earliest time of impact as a fraction of the displacement from 0 to 1, or NaN if nothing is hit
+float CollisionManager_SweepObject(GObject** hit, GObject* obj, const float displacement[3])
+{
+	if(hit != NULL) *hit = NULL;
+
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	Collider_Update(obj->collider, frame);
+
+	struct GJK_Shape shape;
+	struct CollisionManager_ConvexShape data;
+	switch(obj->collider->type)
+	{
+	case COLLIDER_SPHERE:
+	{
+		const struct ColliderData_Sphere* sphere = Collider_GetColliderDataWorldSpace(obj->collider);
+		shape.support = CollisionManager_SupportSphere;
+		shape.data = sphere;
+		shape.center[0] = sphere->x;
+		shape.center[1] = sphere->y;
+		shape.center[2] = sphere->z;
+		break;
+	}
+	case COLLIDER_AABB:
+	case COLLIDER_CONVEXHULL:
+		CollisionManager_InitializeConvexShape(&shape, &data, obj, frame);
+		break;
+	default:
+		return NAN;
+	}
+
+	//Bound the whole sweep with the extremes of the shape along each axis
+	struct ColliderData_AABB sweptBounds;
+	for(int i = 0; i < 3; i++)
+	{
+		float axis[3] = { 0.0f, 0.0f, 0.0f };
+		float extreme[3];
+
+		axis[i] = 1.0f;
+		shape.support(extreme, shape.data, axis);
+		sweptBounds.max[i] = extreme[i] + (displacement[i] > 0.0f ? displacement[i] : 0.0f);
+
+		axis[i] = -1.0f;
+		shape.support(extreme, shape.data, axis);
+		sweptBounds.min[i] = extreme[i] + (displacement[i] < 0.0f ? displacement[i] : 0.0f);
+	}
+
+	DynamicArray* candidates = collisionBuffer->candidates;
+	candidates->size = 0;
+
+	CollisionManager_QueryBroadphaseAABB(&sweptBounds, candidates);
+	if(collisionBuffer->staticTree != NULL)
+	{
+		BVH_Update(collisionBuffer->staticTree);
+		BVH_QueryAABB(collisionBuffer->staticTree, &sweptBounds, candidates);
+	}
+
+	float earliest = NAN;
+	DYNARRAY_FOREACH(GObjectPtr, candidate, candidates)
+	{
+		GObject* other = *candidate;
+		if(other == obj) continue;
+		if(!Collider_DoLayersCollide(obj->collider, other->collider)) continue;
+
+		float timeOfImpact = CollisionManager_Sweep(&shape, displacement, other);
+		if(!isnan(timeOfImpact) && (isnan(earliest) || timeOfImpact < earliest))
+		{
+			earliest = timeOfImpact;
+			if(hit != NULL) *hit = other;
+		}
+	}
+
+	return earliest;
+}
+
+///
+//Performs a ray cast against a sphere collider
+//
+//Parameters:
+//	worldRay: A pointer to the ray to raycast with oriented in worldSpace
+//	sphere: A pointer to the sphere collider to raycast against
+//	sphereFoR: A pointer to the frame of reference with which to orient the sphere
+unsigned char CollisionManager_RayCastSphere(struct ColliderData_Ray* worldRay, struct ColliderData_Sphere* sphere, FrameOfReference* sphereFoR)
+{
+
+	//Translate objects to a system such that ray is centered at the origin
+	Vector spherePos;
+	Vector_INIT_ON_STACK(spherePos, 3);
+
+	Vector_Copy(&spherePos, sphereFoR->position);
+	Vector_Decrement(&spherePos, worldRay->position);
+
+	float scaledRadius = SphereCollider_GetScaledRadius(sphere, sphereFoR);
+
+	//Get a vector from the ray origin to the sphere
+	//Vector toSphere;
+	//Vector_INIT_ON_STACK(toSphere, 3);
+	//Vector_Subtract(&toSphere, &spherePos, worldRay->position);
+
+	//Get the projection of toSphere onto the rays direction
+	float scalarProj = Vector_DotProduct(&spherePos, worldRay->direction);
+	if(scalarProj <= -FLT_EPSILON) return 0;
+
+	//Get the component of toSphere perpendicular to the ray's direction
+	float perpCompSq = Vector_GetMagSq(&spherePos) - (scalarProj * scalarProj);
+
+	if((scaledRadius * scaledRadius) > perpCompSq)
+	{
+		//printf("Perp:\t%f\n", perpComp);
+		//Vector_PrintTranspose(&spherePos);
+		return 255;
+	}
+	return 0;
+}
+
+///
+//Gets the parametric value of the intersection point between a ray and a sphere
+//returns NaN if no intersection point exists.
+//
+//Parameters:
+//	worldRay: a pointer to the ray to test oriented in worldspace
+//	sphere: a pointer to the sphere collider to test
+//	sphereFoR: a pointer to the frame of reference with which to orient the sphere
+//
+//returns:
+//	a float indicating the parametric value along the ray where first the intersection point of the ray and the sphere lay
+//	0 if the ray starts within the sphere
+//	will return NaN if no such point exists
+float CollisionManager_GetRaySphereIntersection(struct ColliderData_Ray* worldRay, struct ColliderData_Sphere* sphere, FrameOfReference* sphereFoR)
+{
+	//Orient the center of the sphere as SphereCollider_Update does, relative to the ray's origin
+	Vector toSphere;
+	Vector_INIT_ON_STACK(toSphere, 3);
+	toSphere.components[0] = sphere->x;
+	toSphere.components[1] = sphere->y;
+	toSphere.components[2] = sphere->z;
+	Matrix_TransformVector(sphereFoR->rotation, &toSphere);
+	Matrix_TransformVector(sphereFoR->scale, &toSphere);
+	Vector_Increment(&toSphere, sphereFoR->position);
+	Vector_Decrement(&toSphere, worldRay->position);
+
+	float scaledRadius = SphereCollider_GetScaledRadius(sphere, sphereFoR);
+
+	//Solve |t * direction - toSphere|^2 = radius^2 for the smallest t
+	float a = Vector_GetMagSq(worldRay->direction);
+	float b = Vector_DotProduct(&toSphere, worldRay->direction);
+	float c = Vector_GetMagSq(&toSphere) - scaledRadius * scaledRadius;
+
+	if(c <= 0.0f) return 0.0f;
+	if(b <= 0.0f || a <= FLT_EPSILON) return NAN;
+
+	float discriminant = b * b - a * c;
+	if(discriminant < 0.0f) return NAN;
+
+	return (b - sqrtf(discriminant)) / a;
+}
+
+///
+//Gets the parametric value of the intersection point between a ray and an AABB
+//returns NaN if no intersection point exists.
+//
+//Parameters:
+//	worldRay: A pointer to the ray to test oriented in worldspace
+//	aabb: A pointer to the AABB collider to test
+//	aabbFoR: A pointer to the frame of reference with which to orient the AABB
+//
+//Returns:
+//	The parametric value along the ray where it first enters the AABB, 0 if the ray starts within the AABB
+float CollisionManager_GetRayAABBIntersection(struct ColliderData_Ray* worldRay, struct ColliderData_AABB* aabb, FrameOfReference* aabbFoR)
+{
+	struct ColliderData_AABB worldAABB;
+	AABBCollider_GetWorldAABB(&worldAABB, aabb, aabbFoR);
+
+	float entry = 0.0f;
+	float exit = FLT_MAX;
+	for(int i = 0; i < 3; i++)
+	{
+		float origin = worldRay->position->components[i];
+		float direction = worldRay->direction->components[i];
+
+		//A ray parallel to a slab must start within it
+		if(direction > -FLT_EPSILON && direction < FLT_EPSILON)
+		{
+			if(origin < worldAABB.min[i] || origin > worldAABB.max[i]) return NAN;
+			continue;
+		}
+
+		float t1 = (worldAABB.min[i] - origin) / direction;
+		float t2 = (worldAABB.max[i] - origin) / direction;
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+		if(t1 > entry) entry = t1;
+		if(t2 < exit) exit = t2;
+		if(entry > exit) return NAN;
+	}
+	return entry;
+}
+
+///
+//Determines if two world space spheres overlap
+//Uses the same arithmetic as each lane of CollisionManager_TestSpherePairs.
+//
+//Parameters:
+//	sphere1: A pointer to the first sphere
+//	sphere2: A pointer to the second sphere
+//
+//Returns:
+//	1 if the distance between the centers is less than the sum of the radii, else 0
+static unsigned char CollisionManager_DoSpheresOverlap(const struct ColliderData_Sphere* sphere1, const struct ColliderData_Sphere* sphere2)
+{
+	float dx = sphere1->x - sphere2->x;
+	float dy = sphere1->y - sphere2->y;
+	float dz = sphere1->z - sphere2->z;
+	float radii = sphere1->radius + sphere2->radius;
+	return dx * dx + dy * dy + dz * dz < radii * radii;
+}
+
+///
+//Determines if two world space axis aligned bounding boxes overlap
+//
+//Parameters:
+//	AABB1: A pointer to the first AABB
+//	AABB2: A pointer to the second AABB
+//
+//Returns:
+//	1 if the AABBs overlap or touch on every axis, else 0
+static unsigned char CollisionManager_DoAABBsOverlap(const struct ColliderData_AABB* AABB1, const struct ColliderData_AABB* AABB2)
+{
+	return AABB1->min[0] <= AABB2->max[0] && AABB1->max[0] >= AABB2->min[0] &&
+		AABB1->min[1] <= AABB2->max[1] && AABB1->max[1] >= AABB2->min[1] &&
+		AABB1->min[2] <= AABB2->max[2] && AABB1->max[2] >= AABB2->min[2];
+}
+
+///
+//Initializes the GJK shape of an object with a convex hull or AABB collider
+//
+//Parameters:
+//	dest: A pointer to the GJK shape to initialize
+//	data: A pointer to the convex shape the GJK shape's support function reads, must outlive the GJK shape
+//	obj: A pointer to the object whose world space collider is up to date
+//	frame: A pointer to the frame of reference used to orient the object's collider
+static void CollisionManager_InitializeConvexShape(struct GJK_Shape* dest, struct CollisionManager_ConvexShape* data, GObject* obj, FrameOfReference* frame)
+{
+	dest->data = data;
+
+	if(obj->collider->type == COLLIDER_AABB)
+	{
+		data->convexHull = NULL;
+		data->AABB = Collider_GetColliderDataWorldSpace(obj->collider);
+		dest->support = CollisionManager_SupportAABB;
+
+		for(int i = 0; i < 3; i++)
+		{
+			dest->center[i] = (data->AABB->min[i] + data->AABB->max[i]) * 0.5f;
+		}
+	}
+	else
+	{
+		data->convexHull = obj->collider->data->convexHullData;
+		data->AABB = NULL;
+		dest->support = CollisionManager_SupportConvexHull;
+
+		for(int i = 0; i < 3; i++)
+		{
+			dest->center[i] = frame->position->components[i];
+		}
+	}
+}
+
+///
+//Finds the world space point of an oriented convex hull which is furthest along a direction
+//The points are read from the world space data computed when the hull's collider was updated.
 //
 //Parameters:
-//	worldRay: A pointer to the ray to raycast with oriented in worldSpace
-//	sphere: A pointer to the sphere collider to raycast against
-//	sphereFoR: A pointer to the frame of reference with which to orient the sphere
-unsigned char CollisionManager_RayCastSphere(struct ColliderData_Ray* worldRay, struct ColliderData_Sphere* sphere, FrameOfReference* sphereFoR)
+//	dest: The destination of the point
+//	shape: A pointer to the struct CollisionManager_ConvexShape of the hull
+//	direction: The world space direction to search along
+static void CollisionManager_SupportConvexHull(float dest[3], const void* shape, const float direction[3])
 {
+	const struct ColliderData_ConvexHull* convexHull = ((const struct CollisionManager_ConvexShape*)shape)->convexHull;
 
-	//Translate objects to a system such that ray is centered at the origin
-	Vector spherePos;
-	Vector_INIT_ON_STACK(spherePos, 3);
-
-	Vector_Copy(&spherePos, sphereFoR->position);
-	Vector_Decrement(&spherePos, worldRay->position);
-
-	float scaledRadius = SphereCollider_GetScaledRadius(sphere, sphereFoR);
-
-	//Get a vector from the ray origin to the sphere
-	//Vector toSphere;
-	//Vector_INIT_ON_STACK(toSphere, 3);
-	//Vector_Subtract(&toSphere, &spherePos, worldRay->position);
-
-	//Get the projection of toSphere onto the rays direction
-	float scalarProj = Vector_DotProduct(&spherePos, worldRay->direction);
-	if(scalarProj <= -FLT_EPSILON) return 0;
+	const float* furthest = NULL;
+	float maxProjection = -FLT_MAX;
+	for(unsigned int i = 0; i < convexHull->numCachedPoints; i++)
+	{
+		const float* point = convexHull->worldPoints[i]->components;
+		float projection = point[0] * direction[0] + point[1] * direction[1] + point[2] * direction[2];
+		if(projection > maxProjection)
+		{
+			maxProjection = projection;
+			furthest = point;
+		}
+	}
 
-	//Get the component of toSphere perpendicular to the ray's direction
-	float perpCompSq = Vector_GetMagSq(&spherePos) - (scalarProj * scalarProj);
+	for(int i = 0; i < 3; i++)
+	{
+		dest[i] = furthest != NULL ? furthest[i] : 0.0f;
+	}
+}
 
-	if((scaledRadius * scaledRadius) > perpCompSq)
+///
+//Finds the corner of a world space AABB which is furthest along a direction
+//
+//Parameters:
+//	dest: The destination of the point
+//	shape: A pointer to the struct CollisionManager_ConvexShape of the AABB
+//	direction: The world space direction to search along
+static void CollisionManager_SupportAABB(float dest[3], const void* shape, const float direction[3])
+{
+	const struct ColliderData_AABB* AABB = ((const struct CollisionManager_ConvexShape*)shape)->AABB;
+	for(int i = 0; i < 3; i++)
 	{
-		//printf("Perp:\t%f\n", perpComp);
-		//Vector_PrintTranspose(&spherePos);
-		return 255;
+		dest[i] = direction[i] >= 0.0f ? AABB->max[i] : AABB->min[i];
 	}
-	return 0;
 }
 
 ///
@@ -2189,6 +3981,7 @@ unsigned char CollisionManager_RayCastSphere(struct ColliderData_Ray* worldRay,
 //	numAxes2: The number of axes belonging to object 2
 //	orientedPoints2: An array of pointers to vectors representing the oriented points of object 2 involved in the test
 //	numPoints2: The number of points belonging to object 2
+//	separatingAxis: A pointer to the axis to store the separating face in if the test detects no collision, or NULL
 //
 //Returns:
 //	0 if the test detects no collision
@@ -2197,7 +3990,8 @@ static unsigned char CollisionManager_PerformSATFaces(struct Collision* dest,
 	const Vector** orientedAxes1, unsigned int numAxes1, 
 	const Vector** orientedPoints1, const unsigned int numPoints1, 
 	const Vector** orientedAxes2, const unsigned int numAxes2, 
-	const Vector** orientedPoints2, const unsigned int numPoints2)
+	const Vector** orientedPoints2, const unsigned int numPoints2,
+	struct CollisionManager_SeparatingAxis* separatingAxis)
 {
 	unsigned char detected = 1;		//Tracks if any axis does not detect a collision
 	float minOverlap = 0.0f;		//Stores the minimum overlap of all axes
@@ -2236,6 +4030,11 @@ static unsigned char CollisionManager_PerformSATFaces(struct Collision* dest,
 		{
 			//If any axis is not overlapping, there is no collision
 			detected = 0;
+			if(separatingAxis != NULL)
+			{
+				separatingAxis->type = SEPARATINGAXIS_FACE1;
+				separatingAxis->index1 = i;
+			}
 			break;
 		}
 	}
@@ -2274,6 +4073,11 @@ static unsigned char CollisionManager_PerformSATFaces(struct Collision* dest,
 			{
 				//If any axis is not overlapping, there is no collision
 				detected = 0;
+				if(separatingAxis != NULL)
+				{
+					separatingAxis->type = SEPARATINGAXIS_FACE2;
+					separatingAxis->index1 = i;
+				}
 				break;
 			}
 		}
@@ -2302,11 +4106,13 @@ static unsigned char CollisionManager_PerformSATFaces(struct Collision* dest,
 //	numEdges2: The number of edges belonging to object 2
 //  orientedPoints2: An array of pointers to vectors representing the oriented points of object 2
 //	numPoints2: the number of points belonging to object 2
+//	separatingAxis: A pointer to the axis to store the separating pair of edges in if the test detects no collision, or NULL
 static unsigned char CollisionManager_PerformSATEdges(struct Collision* dest,
 	const Vector** orientedEdges1, const unsigned int numEdges1,
 	const Vector** orientedPoints1, const unsigned int numPoints1,
 	const Vector** orientedEdges2, const unsigned int numEdges2,
-	const Vector** orientedPoints2, const unsigned int numPoints2)
+	const Vector** orientedPoints2, const unsigned int numPoints2,
+	struct CollisionManager_SeparatingAxis* separatingAxis)
 {
 	float minOverlap = dest->overlap;	//Stores the minimum overlap of all axes
 
@@ -2361,6 +4167,12 @@ static unsigned char CollisionManager_PerformSATEdges(struct Collision* dest,
 			else
 			{
 				//If any axis is not overlapping, there is no collision
+				if(separatingAxis != NULL)
+				{
+					separatingAxis->type = SEPARATINGAXIS_EDGES;
+					separatingAxis->index1 = i;
+					separatingAxis->index2 = j;
+				}
 				return 0;
 			}
 
@@ -2417,6 +4229,66 @@ static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer)
 	buffer->collisions = LinkedList_Allocate();
 	LinkedList_Initialize(buffer->collisions);
 
+	buffer->candidates = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->candidates, sizeof(GObject*));
+
+	buffer->testedPairs = PairSet_Allocate();
+	PairSet_Initialize(buffer->testedPairs);
+
+	buffer->pairs = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->pairs, sizeof(struct GObject_Pair));
+
+	buffer->updatedObjects = PairSet_Allocate();
+	PairSet_Initialize(buffer->updatedObjects);
+
+	buffer->objects = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->objects, sizeof(GObject*));
+
+	buffer->tasks = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->tasks, sizeof(struct CollisionManager_NarrowphaseTask));
+
+	pthread_key_create(&buffer->scratchKey, NULL);
+
+	buffer->broadphase = BROADPHASE_OCTTREE;
+	buffer->convexAlgorithm = CONVEXALGORITHM_SAT;
+	buffer->AABBConvexAlgorithm = CONVEXALGORITHM_SAT;
+
+	buffer->separatedPairs = PairSet_Allocate();
+	PairSet_Initialize(buffer->separatedPairs);
+	buffer->separatingAxes = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->separatingAxes, sizeof(struct CollisionManager_SeparatingAxis));
+	buffer->previousSeparatedPairs = PairSet_Allocate();
+	PairSet_Initialize(buffer->previousSeparatedPairs);
+	buffer->previousSeparatingAxes = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->previousSeparatingAxes, sizeof(struct CollisionManager_SeparatingAxis));
+	memset(&buffer->axisCacheStats, 0, sizeof(struct CollisionManager_AxisCacheStats));
+
+	buffer->pairFilter = NULL;
+	buffer->pairFilterData = NULL;
+	memset(buffer->layerStats, 0, sizeof(buffer->layerStats));
+
+	buffer->staticTree = NULL;
+	buffer->staticPool = NULL;
+	buffer->queryBroadphase = BROADPHASE_OCTTREE;
+	buffer->queryStructure = NULL;
+
+	buffer->contactPairs = PairSet_Allocate();
+	PairSet_Initialize(buffer->contactPairs);
+	buffer->contacts = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->contacts, sizeof(struct CollisionManager_PersistentContact));
+	buffer->previousContactPairs = PairSet_Allocate();
+	PairSet_Initialize(buffer->previousContactPairs);
+	buffer->previousContacts = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->previousContacts, sizeof(struct CollisionManager_PersistentContact));
+	for(int type = 0; type < CONTACTEVENT_NUMTYPES; type++)
+	{
+		buffer->contactEvents[type] = DynamicArray_Allocate();
+		DynamicArray_Initialize(buffer->contactEvents[type], sizeof(struct CollisionManager_PersistentContact*));
+	}
+	buffer->contactSubscriptions = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->contactSubscriptions, sizeof(struct CollisionManager_ContactSubscription));
+	buffer->dispatchingContacts = 0;
+
 	buffer->sphereData = MemoryPool_Allocate();
 	MemoryPool_Initialize(buffer->sphereData, sizeof(struct ColliderData_Sphere));
 
@@ -2450,17 +4322,38 @@ static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer)
 //	buffer: A pointer to The collision buffer to free
 static void CollisionManager_FreeBuffer(CollisionBuffer* buffer)
 {
-	//Free all individual collisions in the list of collisions
-	struct LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	struct LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
+	//The collisions in the list live in frame memory
+	LinkedList_Free(buffer->collisions);
+	DynamicArray_Free(buffer->candidates);
+	PairSet_Free(buffer->testedPairs);
+	DynamicArray_Free(buffer->pairs);
+
+	PairSet_Free(buffer->updatedObjects);
+	DynamicArray_Free(buffer->objects);
+
+	DYNARRAY_FOREACH(NarrowphaseTask, task, buffer->tasks)
 	{
-		nextNode = currentNode->next;
-		CollisionManager_FreeCollision((struct Collision*)currentNode->data);
-		currentNode = nextNode;
+		MemoryArena_Free(task->scratch);
+		DynamicArray_Free(task->contacts);
+		DynamicArray_Free(task->axes);
 	}
-
-	LinkedList_Free(buffer->collisions);
+	DynamicArray_Free(buffer->tasks);
+	pthread_key_delete(buffer->scratchKey);
+
+	PairSet_Free(buffer->separatedPairs);
+	DynamicArray_Free(buffer->separatingAxes);
+	PairSet_Free(buffer->previousSeparatedPairs);
+	DynamicArray_Free(buffer->previousSeparatingAxes);
+
+	PairSet_Free(buffer->contactPairs);
+	DynamicArray_Free(buffer->contacts);
+	PairSet_Free(buffer->previousContactPairs);
+	DynamicArray_Free(buffer->previousContacts);
+	for(int type = 0; type < CONTACTEVENT_NUMTYPES; type++)
+	{
+		DynamicArray_Free(buffer->contactEvents[type]);
+	}
+	DynamicArray_Free(buffer->contactSubscriptions);
 
 	MemoryPool_Free(buffer->sphereData);
 	MemoryPool_Free(buffer->worldSphereData);
@@ -2474,44 +4367,17 @@ static void CollisionManager_FreeBuffer(CollisionBuffer* buffer)
 }
 
 ///
-//Allocates memory for a new collision
+//Allocates memory for a new collision from frame memory
+//The collision lives until the end of the next frame and must not be freed.
 //
 //Returns:
 //	Pointer to a newly allocated collision
 static struct Collision* CollisionManager_AllocateCollision(void)
 {
-	struct Collision* collision = (struct Collision*)malloc(sizeof(struct Collision));
+	struct Collision* collision = (struct Collision*)SystemManager_RequestFrameMemory(sizeof(struct Collision));
 	return collision;
 }
 
-///
-//Initializes a collision
-//
-//PArameters:
-//	collision: The collision to initialize
-static void CollisionManager_InitializeCollision(struct Collision* collision)
-{
-	collision->obj1 = NULL;
-	collision->obj1Frame = NULL;
-	collision->obj2 = NULL;
-	collision->obj2Frame = NULL;
-
-	collision->minimumTranslationVector = Vector_Allocate();
-	Vector_Initialize(collision->minimumTranslationVector, 3);
-}
-
-///
-//Frees the memory allocated for a collision.
-//Does not free the objects involved in the collision!
-//
-//Parameters:
-//	collision: The collision being freed
-void CollisionManager_FreeCollision(struct Collision* collision)
-{
-	Vector_Free(collision->minimumTranslationVector);
-	free(collision);
-}
-
 ///
 //Gets a pointer to the memory pool which contains a certain type of collider
 //
@@ -2555,3 +4421,385 @@ MemoryPool* CollisionManager_RetrieveMemoryPool(ColliderType type, unsigned char
 
 	return NULL;
 }
+
+///
+//Gets the parametric value along a ray where it first meets the collider of a game object
+//Used as the test function of a ray cast through an AABB tree.
+//
+//Parameters:
+//	obj: A pointer to the game object to test
+//	worldRay: A pointer to the ray oriented in world space
+//	data: Unused
+//
+//Returns:
+//	The parametric value of the first intersection, NaN if the ray misses the collider or it cannot be ray cast against
+static float CollisionManager_GetRayGObjectIntersection(GObject* obj, struct ColliderData_Ray* worldRay, void* data)
+{
+	(void)data;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+
+	switch(obj->collider->type)
+	{
+	case COLLIDER_SPHERE:
+		return CollisionManager_GetRaySphereIntersection(worldRay, Collider_GetColliderData(obj->collider), frame);
+	case COLLIDER_AABB:
+		return CollisionManager_GetRayAABBIntersection(worldRay, Collider_GetColliderData(obj->collider), frame);
+	case COLLIDER_CONVEXHULL:
+		//Only reorients the hull if it has moved since it's collider was last updated
+		ConvexHullCollider_Update(obj->collider->data->convexHullData, frame);
+		return CollisionManager_GetRayConvexHullIntersection(worldRay, obj->collider->data->convexHullData);
+	default:
+		return NAN;
+	}
+}
+
+///
+//Gets the parametric value along a ray where it first meets a convex hull
+//Each face bounds a half space, the ray is inside the hull between the last face it enters and the first face it leaves.
+//
+//Parameters:
+//	worldRay: A pointer to the ray oriented in world space
+//	convexHull: A pointer to the convex hull whose world space data is up to date
+//
+//Returns:
+//	The parametric value of the first intersection, 0 if the ray starts within the hull, NaN if no intersection exists
+static float CollisionManager_GetRayConvexHullIntersection(struct ColliderData_Ray* worldRay, const struct ColliderData_ConvexHull* convexHull)
+{
+	float entry = 0.0f;
+	float exit = FLT_MAX;
+	for(unsigned int i = 0; i < convexHull->numCachedFaces; i++)
+	{
+		const struct ConvexHullCollider_Face* face = *(struct ConvexHullCollider_Face**)DynamicArray_Index(convexHull->faces, i);
+		if(face->indicesOnFace->size == 0) continue;
+
+		const Vector* normal = convexHull->worldAxes[i];
+		const Vector* pointOnFace = convexHull->worldPoints[*(unsigned int*)DynamicArray_Index(face->indicesOnFace, 0)];
+
+		//Distance from the ray's origin to the face's plane along the normal, positive while the origin is behind the face
+		float distance = Vector_DotProduct(normal, pointOnFace) - Vector_DotProduct(normal, worldRay->position);
+		float approach = Vector_DotProduct(normal, worldRay->direction);
+
+		//A ray parallel to a face must start behind it
+		if(approach > -FLT_EPSILON && approach < FLT_EPSILON)
+		{
+			if(distance < 0.0f) return NAN;
+			continue;
+		}
+
+		float t = distance / approach;
+		if(approach < 0.0f)
+		{
+			if(t > entry) entry = t;
+		}
+		else
+		{
+			if(t < exit) exit = t;
+		}
+		if(entry > exit) return NAN;
+	}
+	return entry;
+}
+
+///
+//Finds the objects in the query broadphase and the static tree whose colliders overlap a world space sphere or AABB
+//The candidates found by the broadphase are gathered in dest and compacted in place, so the query allocates nothing once dest has grown.
+//
+//Parameters:
+//	dest: A pointer to a dynamic array of GObject* to append the overlapping objects to
+//	bounds: A pointer to the world space bounds of the queried shape
+//	sphere: A pointer to the world space sphere to query, or NULL to query the bounds themselves
+//	filter: A function deciding which overlapping objects are reported, or NULL to report all of them
+//	data: Passed to the filter
+//
+//Returns:
+//	The number of objects appended to dest
+static unsigned int CollisionManager_Overlap(DynamicArray* dest, const struct ColliderData_AABB* bounds, const struct ColliderData_Sphere* sphere, CollisionManager_OverlapFilter filter, void* data)
+{
+	unsigned int first = dest->size;
+	CollisionManager_QueryBroadphaseAABB(bounds, dest);
+	if(collisionBuffer->staticTree != NULL)
+	{
+		BVH_Update(collisionBuffer->staticTree);
+		BVH_QueryAABB(collisionBuffer->staticTree, bounds, dest);
+	}
+
+	//The queried shape as seen by GJK when testing convex hulls
+	struct GJK_Shape queryShape;
+	struct CollisionManager_ConvexShape queryAABB = { NULL, bounds };
+	if(sphere != NULL)
+	{
+		queryShape.support = CollisionManager_SupportSphere;
+		queryShape.data = sphere;
+	}
+	else
+	{
+		queryShape.support = CollisionManager_SupportAABB;
+		queryShape.data = &queryAABB;
+	}
+	for(int i = 0; i < 3; i++)
+	{
+		queryShape.center[i] = (bounds->min[i] + bounds->max[i]) * 0.5f;
+	}
+
+	unsigned int numFound = first;
+	for(unsigned int i = first; i < dest->size; i++)
+	{
+		GObject* obj = DynamicArray_GObjectPtr_Get(dest, i);
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+
+		struct ColliderData_AABB objBounds;
+		if(!Collider_GetWorldAABB(&objBounds, obj->collider, frame)) continue;
+		if(!CollisionManager_DoAABBsOverlap(bounds, &objBounds)) continue;
+
+		unsigned char overlapping = 0;
+		switch(obj->collider->type)
+		{
+		case COLLIDER_SPHERE:
+		{
+			Collider_Update(obj->collider, frame);
+			const struct ColliderData_Sphere* worldSphere = Collider_GetColliderDataWorldSpace(obj->collider);
+			if(sphere != NULL)
+			{
+				overlapping = CollisionManager_DoSpheresOverlap(sphere, worldSphere);
+			}
+			else
+			{
+				float center[3] = { worldSphere->x, worldSphere->y, worldSphere->z };
+				overlapping = CollisionManager_GetAABBDistanceSq(bounds, center) < worldSphere->radius * worldSphere->radius;
+			}
+			break;
+		}
+		case COLLIDER_AABB:
+		{
+			Collider_Update(obj->collider, frame);
+			const struct ColliderData_AABB* worldAABB = Collider_GetColliderDataWorldSpace(obj->collider);
+			if(sphere != NULL)
+			{
+				float center[3] = { sphere->x, sphere->y, sphere->z };
+				overlapping = CollisionManager_GetAABBDistanceSq(worldAABB, center) < sphere->radius * sphere->radius;
+			}
+			else
+			{
+				overlapping = CollisionManager_DoAABBsOverlap(bounds, worldAABB);
+			}
+			break;
+		}
+		case COLLIDER_CONVEXHULL:
+		{
+			Collider_Update(obj->collider, frame);
+
+			struct GJK_Shape hullShape;
+			struct CollisionManager_ConvexShape hull;
+			CollisionManager_InitializeConvexShape(&hullShape, &hull, obj, frame);
+
+			struct GJK_Simplex simplex;
+			overlapping = GJK_Intersect(&simplex, NULL, &queryShape, &hullShape);
+			break;
+		}
+		default:
+			break;
+		}
+
+		if(overlapping && (filter == NULL || filter(obj, data)))
+		{
+			*DynamicArray_GObjectPtr_Index(dest, numFound++) = obj;
+		}
+	}
+
+	dest->size = numFound;
+	return numFound - first;
+}
+
+///
+//Appends the moving objects in the query broadphase whose bounds may overlap a world space AABB
+//
+//Parameters:
+//	bounds: A pointer to the world space AABB
+//	dest: A pointer to a dynamic array of GObject* to append the objects to
+static void CollisionManager_QueryBroadphaseAABB(const struct ColliderData_AABB* bounds, DynamicArray* dest)
+{
+	void* structure = collisionBuffer->queryStructure;
+	if(structure == NULL) return;
+
+	switch(collisionBuffer->queryBroadphase)
+	{
+	case BROADPHASE_OCTTREE:
+		OctTree_QueryAABB(structure, bounds, dest);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE:
+		SweepAndPrune_QueryAABB(structure, bounds, dest);
+		break;
+	case BROADPHASE_AABBTREE:
+		AABBTree_QueryAABB(structure, bounds, dest);
+		break;
+	case BROADPHASE_SPATIALHASH:
+		SpatialHash_QueryAABB(structure, bounds, dest);
+		break;
+	default:
+		break;
+	}
+}
+
+///
+//Appends the moving objects in the query broadphase whose bounds a world space ray may cross
+//
+//Parameters:
+//	worldRay: A pointer to the ray oriented in world space
+//	dest: A pointer to a dynamic array of GObject* to append the objects to
+static void CollisionManager_QueryBroadphaseRay(struct ColliderData_Ray* worldRay, DynamicArray* dest)
+{
+	void* structure = collisionBuffer->queryStructure;
+	if(structure == NULL) return;
+
+	switch(collisionBuffer->queryBroadphase)
+	{
+	case BROADPHASE_OCTTREE:
+		OctTree_QueryRay(structure, worldRay, dest);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE:
+		SweepAndPrune_QueryRay(structure, worldRay, dest);
+		break;
+	case BROADPHASE_AABBTREE:
+		AABBTree_QueryRay(structure, worldRay, dest);
+		break;
+	case BROADPHASE_SPATIALHASH:
+		SpatialHash_QueryRay(structure, worldRay, dest);
+		break;
+	default:
+		break;
+	}
+}
+
+///
+//Gets the squared distance from a point to the nearest point of an axis aligned bounding box
+//
+//Parameters:
+//	AABB: A pointer to the world space AABB
+//	point: The world space point
+//
+//Returns:
+//	The squared distance, 0 if the point lies within the AABB
+static float CollisionManager_GetAABBDistanceSq(const struct ColliderData_AABB* AABB, const float point[3])
+{
+	float distanceSq = 0.0f;
+	for(int i = 0; i < 3; i++)
+	{
+		float outside = 0.0f;
+		if(point[i] < AABB->min[i]) outside = AABB->min[i] - point[i];
+		else if(point[i] > AABB->max[i]) outside = point[i] - AABB->max[i];
+		distanceSq += outside * outside;
+	}
+	return distanceSq;
+}
+
+///
+//Finds the point of a world space sphere which is furthest along a direction
+//
+//Parameters:
+//	dest: The destination of the point
+//	shape: A pointer to the struct ColliderData_Sphere oriented in world space
+//	direction: The world space direction to search along
+static void CollisionManager_SupportSphere(float dest[3], const void* shape, const float direction[3])
+{
+	const struct ColliderData_Sphere* sphere = shape;
+	float magnitude = sqrtf(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+	float scale = magnitude > FLT_EPSILON ? sphere->radius / magnitude : 0.0f;
+
+	dest[0] = sphere->x + direction[0] * scale;
+	dest[1] = sphere->y + direction[1] * scale;
+	dest[2] = sphere->z + direction[2] * scale;
+}
+
+///
+//Finds the point of a translated convex shape which is furthest along a direction
+//
+//Parameters:
+//	dest: The destination of the point
+//	shape: A pointer to the struct CollisionManager_SweptShape
+//	direction: The world space direction to search along
+static void CollisionManager_SupportSwept(float dest[3], const void* shape, const float direction[3])
+{
+	const struct CollisionManager_SweptShape* swept = shape;
+	swept->shape->support(dest, swept->shape->data, direction);
+
+	dest[0] += swept->offset[0];
+	dest[1] += swept->offset[1];
+	dest[2] += swept->offset[2];
+}
+
+///
+//Finds how far a convex shape can be translated along a displacement before it touches an object's collider
+//The shape is advanced towards the collider by the distance GJK finds between them until they touch,
+//which can never carry it past the collider.
+//
+//Parameters:
+//	shape: A pointer to the world space shape at the start of the displacement
+//	displacement: The world space translation of the shape
+//	obj: A pointer to the object whose collider is tested
+//
+//Returns:
+//	The time of impact as a fraction of the displacement from 0 to 1, or NaN if the shape does not hit the collider
+static float CollisionManager_Sweep(const struct GJK_Shape* shape, const float displacement[3], GObject* obj)
+{
+	if(obj->collider == NULL) return NAN;
+
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+
+	struct GJK_Shape target;
+	struct CollisionManager_ConvexShape targetData;
+	switch(obj->collider->type)
+	{
+	case COLLIDER_SPHERE:
+	{
+		Collider_Update(obj->collider, frame);
+		const struct ColliderData_Sphere* sphere = Collider_GetColliderDataWorldSpace(obj->collider);
+		target.support = CollisionManager_SupportSphere;
+		target.data = sphere;
+		target.center[0] = sphere->x;
+		target.center[1] = sphere->y;
+		target.center[2] = sphere->z;
+		break;
+	}
+	case COLLIDER_AABB:
+	case COLLIDER_CONVEXHULL:
+		Collider_Update(obj->collider, frame);
+		CollisionManager_InitializeConvexShape(&target, &targetData, obj, frame);
+		break;
+	default:
+		return NAN;
+	}
+
+	struct CollisionManager_SweptShape swept = { shape, { 0.0f, 0.0f, 0.0f } };
+	struct GJK_Shape moved;
+	moved.support = CollisionManager_SupportSwept;
+	moved.data = &swept;
+
+	float timeOfImpact = 0.0f;
+	for(unsigned int i = 0; i < GJK_MAX_ITERATIONS; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			swept.offset[j] = displacement[j] * timeOfImpact;
+			moved.center[j] = shape->center[j] + swept.offset[j];
+		}
+
+		struct GJK_Simplex simplex;
+		float distance = 0.0f;
+		if(GJK_Intersect(&simplex, &distance, &moved, &target) || distance <= CollisionManager_SWEEP_TOLERANCE)
+		{
+			//Colliders touched before moving are left to the narrowphase
+			return i == 0 ? NAN : timeOfImpact;
+		}
+
+		//The closest point of the difference points from the collider towards the shape,
+		//the shape can not touch the collider before crossing the gap between them along it.
+		float closingSpeed = -(displacement[0] * simplex.direction[0] + displacement[1] * simplex.direction[1] + displacement[2] * simplex.direction[2]) / distance;
+		if(closingSpeed <= 0.0f) return NAN;
+
+		timeOfImpact += distance / closingSpeed;
+		if(timeOfImpact > 1.0f) return NAN;
+	}
+
+	//The shape has not been found to touch the collider yet, but can be no further along than this
+	return timeOfImpact;
+}
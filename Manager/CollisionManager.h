@@ -3,9 +3,16 @@
 
 #include "../GObject/GObject.h"
 #include "../Data/LinkedList.h"
+#include "../Data/MemoryArena.h"
+#include <pthread.h>
 
 #include "../Data/OctTree.h"
+#include "../Data/SweepAndPrune.h"
+#include "../Data/AABBTree.h"
+#include "../Data/BVH.h"
+#include "../Data/SpatialHash.h"
 #include "../Data/MemoryPool.h"
+#include "../Data/PairSet.h"
 
 struct Collision
 {
@@ -18,6 +25,109 @@ struct Collision
 	float resolutionImpulse;		//The magnitude of the impulse which resolved the collision
 };
 
+//Fewest pairs of objects worth handing to a single task of the parallel narrowphase
+#define CollisionManager_PAIRS_PER_TASK 64
+//Most tasks the narrowphase is split into per thread, so threads which finish early can take over the remaining work
+#define CollisionManager_TASKS_PER_THREAD 4
+//Initial size in bytes of the scratch memory of each narrowphase task
+#define CollisionManager_SCRATCH_SIZE 16384
+//Number of consecutive pairs whose sphere on sphere and AABB on AABB tests a narrowphase task batches together
+#define CollisionManager_BATCH_SIZE 64
+//Distance between two colliders within which a sweep considers them to touch
+#define CollisionManager_SWEEP_TOLERANCE 0.001f
+
+//Dictates how the pairs of objects tested for collision are found
+typedef enum
+{
+	BROADPHASE_OCTTREE,		//Objects are tested against the objects sharing their oct tree nodes
+	BROADPHASE_SWEEPANDPRUNE,	//Objects are tested against the objects whose bounds overlap theirs in a sweep and prune
+	BROADPHASE_AABBTREE,		//Objects are tested against the objects whose fattened bounds overlap theirs in a dynamic AABB tree
+	BROADPHASE_SPATIALHASH		//Objects are tested against the objects sharing the cells of a uniform grid rebuilt each frame
+} BroadphaseType;
+
+//Dictates how pairs of convex colliders are tested for collision
+typedef enum
+{
+	CONVEXALGORITHM_SAT,		//Colliders are tested with the separating axis theorem over their oriented faces and edges
+	CONVEXALGORITHM_GJK		//Colliders are tested with GJK, and their penetration found with EPA, over support functions
+} ConvexAlgorithm;
+
+//Dictates which change in the contact between a pair of objects a contact event reports
+typedef enum
+{
+	CONTACTEVENT_BEGIN,		//The objects touch this frame but did not on the previous frame
+	CONTACTEVENT_STAY,		//The objects touched on the previous frame and still touch
+	CONTACTEVENT_END,		//The objects touched on the previous frame but no longer touch
+	CONTACTEVENT_NUMTYPES
+} ContactEventType;
+
+///
+//A pair of objects whose colliders touch, kept in the contact table from frame to frame for as long as they keep touching
+struct CollisionManager_PersistentContact
+{
+	GObject* obj1;				//The first object of the pair on the most recent frame they touched
+	GObject* obj2;				//The second object of the pair
+	float minimumTranslationVector[3];	//Contact normal of the most recent frame the objects touched, facing obj1
+	float overlap;				//Overlap of the most recent frame the objects touched
+	unsigned int frames;			//Number of consecutive frames the objects have touched
+};
+
+//Typed accessors for arrays of contact events
+DYNARRAY_DECLARE(PersistentContactPtr, struct CollisionManager_PersistentContact*);
+
+///
+//Receives the contact events a subscriber asked for
+//
+//Parameters:
+//	type: The kind of event
+//	contact: A pointer to the contact the event is about, valid until the next frame's collisions are found
+//	data: The data given when subscribing
+typedef void (*CollisionManager_ContactCallback)(ContactEventType type, const struct CollisionManager_PersistentContact* contact, void* data);
+
+///
+//Counts of how often the axis which separated a convex pair on the previous frame spared it the full test
+struct CollisionManager_AxisCacheStats
+{
+	unsigned long tests;	//Convex hull on convex hull or AABB pairs tested by the narrowphase
+	unsigned long cached;	//Pairs with an axis remembered from the previous frame
+	unsigned long hits;	//Pairs still separated by their remembered axis, which skipped the full test
+};
+
+///
+//Counts of what became of the pairs of objects the broadphase found with a collider on one collision layer
+//A pair of colliders on different layers is counted by both layers.
+struct CollisionManager_LayerStats
+{
+	unsigned long pairs;		//Pairs found by the broadphase
+	unsigned long masked;		//Pairs whose layer masks do not allow them to collide, which were never tested
+	unsigned long filtered;		//Pairs rejected by the pair filter, which were never tested
+	unsigned long collisions;	//Pairs found to collide
+};
+
+///
+//Decides whether a pair of objects found by the broadphase, whose layers allow them to collide, is tested for collision
+//Called once for each pair every frame before the pair is tested, so it must not test the pair's geometry itself.
+//
+//Parameters:
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+//	data: The data given with the filter
+//
+//Returns:
+//	1 if the pair should be tested for collision, 0 if it should never collide
+typedef unsigned char (*CollisionManager_PairFilter)(GObject* obj1, GObject* obj2, void* data);
+
+///
+//Decides whether an object found by an overlap query is reported
+//
+//Parameters:
+//	obj: A pointer to the object overlapping the queried shape
+//	data: The data given to the overlap query
+//
+//Returns:
+//	1 to report the object, 0 to skip it
+typedef unsigned char (*CollisionManager_OverlapFilter)(GObject* obj, void* data);
+
 typedef struct CollisionBuffer
 {
 	MemoryPool* sphereData;
@@ -26,6 +136,35 @@ typedef struct CollisionBuffer
 	MemoryPool* aabbData;
 	MemoryPool* worldAABBData;
 	LinkedList* collisions;		//Contains the list of registered collisions for each frame
+	DynamicArray* candidates;	//Objects which may collide with the object being tested in a loose oct tree (GObject*)
+	PairSet* testedPairs;		//Pairs of objects which have already been found this frame in a classic oct tree
+	DynamicArray* pairs;		//Pairs of objects found by the broadphase to be tested for collision this frame (struct GObject_Pair)
+	PairSet* updatedObjects;	//Objects whose colliders have been updated for this frame's narrowphase, each stored as a pair of the object with itself
+	DynamicArray* objects;		//Objects in this frame's pairs whose colliders are updated before the pairs are tested (GObject*)
+	DynamicArray* tasks;		//Scratch memory and results of each task of the narrowphase (struct CollisionManager_NarrowphaseTask)
+	pthread_key_t scratchKey;	//Scratch memory arena of the narrowphase task running on the current thread, NULL outside of a task
+	BroadphaseType broadphase;	//Broadphase used each frame, selected with CollisionManager_SetBroadphase
+	ConvexAlgorithm convexAlgorithm;	//Algorithm testing convex hulls against convex hulls, selected with CollisionManager_SetConvexAlgorithm
+	ConvexAlgorithm AABBConvexAlgorithm;	//Algorithm testing AABBs against convex hulls, selected with CollisionManager_SetConvexAlgorithm
+	PairSet* separatedPairs;		//Convex pairs separated this frame, each indexing it's axis in separatingAxes
+	DynamicArray* separatingAxes;		//Axis which separated each convex pair this frame (struct CollisionManager_SeparatingAxis)
+	PairSet* previousSeparatedPairs;	//Convex pairs separated on the previous frame, only read while the narrowphase runs
+	DynamicArray* previousSeparatingAxes;	//Axis which separated each convex pair on the previous frame (struct CollisionManager_SeparatingAxis)
+	struct CollisionManager_AxisCacheStats axisCacheStats;	//Counted since the last call to CollisionManager_ResetAxisCacheStats
+	PairSet* contactPairs;			//Pairs of objects touching this frame, each indexing it's record in contacts
+	DynamicArray* contacts;			//Record of each pair of objects touching this frame (struct CollisionManager_PersistentContact)
+	PairSet* previousContactPairs;		//Pairs of objects which touched on the previous frame
+	DynamicArray* previousContacts;		//Record of each pair of objects which touched on the previous frame (struct CollisionManager_PersistentContact)
+	DynamicArray* contactEvents[CONTACTEVENT_NUMTYPES];	//Contacts which began, stayed and ended this frame, by ContactEventType (struct CollisionManager_PersistentContact*)
+	DynamicArray* contactSubscriptions;	//Callbacks receiving contact events (struct CollisionManager_ContactSubscription)
+	unsigned char dispatchingContacts;	//Set while contact events are being handed to subscribers
+	CollisionManager_PairFilter pairFilter;	//Decides which pairs whose layers may collide are tested, NULL to test all of them
+	void* pairFilterData;			//Passed to the pair filter
+	struct CollisionManager_LayerStats layerStats[Collider_NUM_LAYERS];	//Counted by collision layer since the last call to CollisionManager_ResetLayerStats
+	BVH* staticTree;			//Objects which never move, only tested against the moving objects, NULL if there are none
+	MemoryPool* staticPool;			//Pool holding the moving objects tested against the static tree
+	BroadphaseType queryBroadphase;		//Type of the broadphase ray casts, overlap queries and sweeps are made against
+	void* queryStructure;			//The broadphase ray casts, overlap queries and sweeps are made against, NULL if there is none
 } CollisionBuffer;
 
 ///
@@ -38,14 +177,6 @@ struct ProjectionBounds
 
 extern CollisionBuffer* collisionBuffer;
 
-///
-//Frees the memory allocated for a collision.
-//Does not free the objects involved in the collision!
-//
-//Parameters:
-//	collision: The collision being freed
-void CollisionManager_FreeCollision(struct Collision* collision);
-
 ///
 //Initializes the Collision Manager
 void CollisionManager_Initialize(void);
@@ -69,6 +200,8 @@ MemoryPool* CollisionManager_RetrieveMemoryPool(ColliderType type, unsigned char
 ///
 //Tests for collisions on all objects which have colliders 
 //compiling a list of game objects which test true
+//Every pair of moving objects in the list is tested, then every moving object is tested against the static tree.
+//Contacts are carried over from the last update, so this must be called once per frame with every object to test.
 //
 //Parameters:
 //	gameObjects: THe list of gameObjects to test
@@ -80,9 +213,12 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects);
 ///
 //Tests for collisions on all objects which have colliders
 //compiling a list of collisions which occur
+//Every pair of moving objects in the array is tested, then every moving object is tested against the static tree.
+//Contacts are carried over from the last update, so this must be called once per frame with every object to test.
 //
 //Parameters:
 //	gameObjects: An array of game objects to test
+//	numObjects: The number of objects in the array
 //
 //Returns:
 //	A pointer to a linked list of collisions which occurred this frame
@@ -90,6 +226,7 @@ LinkedList* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int num
 
 ///
 //Tests for collisions on all objects in an oct tree compiling a list of collisions which occur
+//The pairs found in the tree's leaves are tested across the system's worker pool.
 //
 //Parameters:
 //	tree: The oct tree holding the game objects to test
@@ -97,6 +234,166 @@ LinkedList* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int num
 //Returns: A pointer to a linked list of collisions which occurred this frame
 LinkedList* CollisionManager_UpdateOctTree(OctTree* tree);
 
+///
+//Tests for collisions on all pairs of objects whose bounds overlap in a sweep and prune
+//compiling a list of collisions which occur
+//The pairs are tested across the system's worker pool.
+//
+//Parameters:
+//	sap: The updated sweep and prune holding the game objects to test
+//
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateSweepAndPrune(SweepAndPrune* sap);
+
+///
+//Tests for collisions on all pairs of objects whose fattened bounds overlap in an AABB tree
+//compiling a list of collisions which occur
+//The pairs are tested across the system's worker pool.
+//
+//Parameters:
+//	tree: The AABB tree holding the game objects to test
+//
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateAABBTree(AABBTree* tree);
+
+///
+//Tests for collisions on all pairs of objects whose bounds overlap in a spatial hash
+//compiling a list of collisions which occur
+//The buckets of the grid are searched and the pairs are tested across the system's worker pool.
+//
+//Parameters:
+//	grid: The updated spatial hash holding the game objects to test
+//
+//Returns: A pointer to a linked list of collisions which occurred this frame
+LinkedList* CollisionManager_UpdateSpatialHash(SpatialHash* grid);
+
+///
+//Selects the broadphase used to find the pairs of objects tested for collision each frame
+//The object manager keeps the selected broadphase up to date, catching it up with every object after a switch.
+//
+//Parameters:
+//	broadphase: The broadphase to use from the next frame on
+void CollisionManager_SetBroadphase(BroadphaseType broadphase);
+
+///
+//Gets the broadphase used to find the pairs of objects tested for collision each frame
+//
+//Returns:
+//	The selected broadphase
+BroadphaseType CollisionManager_GetBroadphase(void);
+
+///
+//Selects the algorithm used to test a pair of collider types for collision
+//Only convex hull on convex hull and AABB on convex hull pairs can be tested by more than one algorithm.
+//
+//Parameters:
+//	type1: The type of the first collider of the pair
+//	type2: The type of the second collider of the pair
+//	algorithm: The algorithm to use from the next test on
+void CollisionManager_SetConvexAlgorithm(ColliderType type1, ColliderType type2, ConvexAlgorithm algorithm);
+
+///
+//Gets the algorithm used to test a pair of collider types for collision
+//
+//Parameters:
+//	type1: The type of the first collider of the pair
+//	type2: The type of the second collider of the pair
+//
+//Returns:
+//	The selected algorithm, CONVEXALGORITHM_SAT for pairs with no choice of algorithm
+ConvexAlgorithm CollisionManager_GetConvexAlgorithm(ColliderType type1, ColliderType type2);
+
+///
+//Gets how often the narrowphase settled convex pairs with the axis which separated them on the previous frame
+//
+//Parameters:
+//	dest: A pointer to the stats to store the counts in
+void CollisionManager_GetAxisCacheStats(struct CollisionManager_AxisCacheStats* dest);
+
+///
+//Sets every count of the axis cache stats back to 0
+void CollisionManager_ResetAxisCacheStats(void);
+
+///
+//Sets the filter deciding which pairs of objects found by the broadphase are tested for collision
+//The filter only sees pairs whose collision layers allow them to collide.
+//
+//Parameters:
+//	filter: The function deciding if a pair is tested, or NULL to test every pair
+//	data: Passed to the filter
+void CollisionManager_SetPairFilter(CollisionManager_PairFilter filter, void* data);
+
+///
+//Sets the tree of static objects which the oct tree, sweep and prune and AABB tree broadphases test moving objects against
+//Every object in the pool with a collider which the tree does not hold is treated as moving.
+//The static objects must be kept out of the broadphases themselves.
+//
+//Parameters:
+//	tree: A pointer to the BVH holding the static objects, or NULL to test no static objects
+//	pool: A pointer to the memory pool holding the moving and static objects
+void CollisionManager_SetStaticTree(BVH* tree, MemoryPool* pool);
+
+///
+//Sets the broadphase which ray casts, overlap queries and sweeps find moving objects with
+//The object manager sets the broadphase it keeps up to date whenever another is selected.
+//
+//Parameters:
+//	type: The type of the broadphase
+//	broadphase: A pointer to the OctTree, SweepAndPrune, AABBTree or SpatialHash matching type, or NULL to find no moving objects
+void CollisionManager_SetQueryBroadphase(BroadphaseType type, void* broadphase);
+
+///
+//Gets the counts of what became of the pairs found by the broadphase with a collider on a collision layer,
+//since the counts were last reset
+//
+//Parameters:
+//	dest: A pointer to the stats to store the counts in
+//	layer: The collision layer to get the counts of, from 0 to Collider_NUM_LAYERS - 1
+void CollisionManager_GetLayerStats(struct CollisionManager_LayerStats* dest, unsigned int layer);
+
+///
+//Sets every count of the stats of every collision layer back to 0
+void CollisionManager_ResetLayerStats(void);
+
+///
+//Gets the contacts which changed in a given way when collisions were last found
+//The records pointed to belong to the contact table, so no memory is allocated for contacts which carry on from frame to frame.
+//
+//Parameters:
+//	type: The kind of contact event to get
+//
+//Returns:
+//	A pointer to a dynamic array of the contacts (struct CollisionManager_PersistentContact*), valid until collisions are next found
+DynamicArray* CollisionManager_GetContactEvents(ContactEventType type);
+
+///
+//Subscribes a callback to a kind of contact event
+//Subscribers are called once the collisions of a frame have been found, in the order they subscribed.
+//
+//Parameters:
+//	type: The kind of contact event to receive
+//	obj: A pointer to the object whose contacts to receive events of, or NULL to receive the events of every contact
+//	callback: The function to call with each event
+//	data: Passed to the callback
+void CollisionManager_SubscribeContactEvents(ContactEventType type, GObject* obj, CollisionManager_ContactCallback callback, void* data);
+
+///
+//Removes every subscription of a callback with the given data
+//Safe to call from within a contact callback.
+//
+//Parameters:
+//	callback: The function which was subscribed
+//	data: The data it was subscribed with
+void CollisionManager_UnsubscribeContactEvents(CollisionManager_ContactCallback callback, void* data);
+
+///
+//Drops the contacts of an object from the contact table without reporting that they ended
+//Must be called when an object leaves the simulation, so no later event refers to it.
+//
+//Parameters:
+//	obj: A pointer to the object leaving the simulation
+void CollisionManager_RemoveContacts(GObject* obj);
+
 ///
 //Tests for a collision between two objects which have colliders
 //
@@ -123,6 +420,28 @@ void CollisionManager_TestCollision(struct Collision* dest, GObject* obj1, Frame
 //	Minimal translation vector if collision was detected
 void CollisionManager_TestSphereCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR);
 
+///
+//Tests many pairs of world space spheres for overlap, four pairs at a time where SSE is available
+//Only tells which pairs overlap, build the collisions of those pairs with CollisionManager_TestSphereCollision.
+//
+//Parameters:
+//	dest: An array to store 1 in for each pair of spheres which overlap, else 0
+//	spheres1: An array of pointers to the first sphere of each pair
+//	spheres2: An array of pointers to the second sphere of each pair
+//	numPairs: The number of pairs to test
+void CollisionManager_TestSpherePairs(unsigned char* dest, struct ColliderData_Sphere* const* spheres1, struct ColliderData_Sphere* const* spheres2, unsigned int numPairs);
+
+///
+//Tests many pairs of world space axis aligned bounding boxes for overlap, four pairs at a time where SSE is available
+//Only tells which pairs overlap, build the collisions of those pairs with CollisionManager_TestAABBCollision.
+//
+//Parameters:
+//	dest: An array to store 1 in for each pair of AABBs which overlap, else 0
+//	AABBs1: An array of pointers to the first AABB of each pair
+//	AABBs2: An array of pointers to the second AABB of each pair
+//	numPairs: The number of pairs to test
+void CollisionManager_TestAABBPairs(unsigned char* dest, struct ColliderData_AABB* const* AABBs1, struct ColliderData_AABB* const* AABBs2, unsigned int numPairs);
+
 ///
 //Tests for collision between an object with a sphere collider and a ray
 //
@@ -189,6 +508,21 @@ void CollisionManager_TestAABBRayCollision(struct Collision* dest, GObject* AABB
 //	obj2FoR:	Pointer to frame of reference to use to orient Object 2 convex hull
 void CollisionManager_TestConvexCollision(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR);
 
+///
+//Tests if two game objects with convex colliders are colliding
+//Utilizes GJK to detect the collision and EPA to find the minimum translation vector
+//Either object may have a convex hull or an axis aligned bounding box collider.
+//If there is no collision, collision.obj1 and obj2 will be set to null upon
+//The end of this function
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1:		First game object to test (Must have collider attached)
+//	obj1FoR:	Pointer to frame of reference to use to orient Object 1 collider
+//	obj2:		Second game object to test (Must have collider attached)
+//	obj2FoR:	Pointer to frame of reference to use to orient Object 2 collider
+void CollisionManager_TestConvexCollisionGJK(struct Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR);
+
 ///
 //Tests if a game objects convex hull is colliding with a ray
 //
@@ -234,6 +568,107 @@ void CollisionManager_TestRayCollision(struct Collision* dest, GObject* obj1, Fr
 //	1 if there is a collision between the ray and the GObject
 unsigned char CollisionManager_RayCastGObject(struct ColliderData_Ray* worldRay, GObject* gObj);
 
+///
+//Performs a ray cast against the objects in the query broadphase and the static tree
+//Only objects whose bounds the ray crosses are tested.
+//
+//Parameters:
+//	worldRay: A pointer to the ray to raycast with oriented in worldspace
+//
+//Returns:
+//	0 if there is no collision between the ray and any object
+//	The result of CollisionManager_RayCastGObject for the first object found colliding with the ray
+unsigned char CollisionManager_RayCastBroadphase(struct ColliderData_Ray* worldRay);
+
+///
+//Casts a batch of rays against the objects in the query broadphase and the static tree, finding the object each ray meets first
+//An AABB tree broadphase is visited front to back, stopping once nothing nearer than a ray's closest hit remains,
+//other broadphases test every object whose bounds the ray crosses.
+//The static tree is cast through second, so it only replaces the hits of the broadphase with nearer static objects.
+//Sphere, AABB and convex hull colliders are tested, other colliders are ignored.
+//
+//Parameters:
+//	dest: An array of numRays hits to store the object each ray meets and the parametric value where it meets it
+//	worldRays: An array of numRays rays oriented in world space
+//	numRays: The number of rays to cast
+//	maxDistance: The furthest parametric value along each ray at which a hit is accepted
+//	anyHit: 1 to accept the first object each ray is found to meet rather than the nearest, for visibility checks
+void CollisionManager_RayCast(struct AABBTree_RayHit* dest, struct ColliderData_Ray* worldRays, unsigned int numRays, float maxDistance, unsigned char anyHit);
+
+///
+//Finds the objects in the query broadphase and the static tree whose colliders overlap a world space sphere
+//No collisions are created, so the query may be made at any time outside of the narrowphase.
+//Sphere, AABB and convex hull colliders are tested, other colliders are ignored.
+//
+//Parameters:
+//	dest: A pointer to a dynamic array of GObject* to append the overlapping objects to
+//	center: The world space center of the sphere
+//	radius: The radius of the sphere
+//	filter: A function deciding which overlapping objects are reported, or NULL to report all of them
+//	data: Passed to the filter
+//
+//Returns:
+//	The number of objects appended to dest
+unsigned int CollisionManager_OverlapSphere(DynamicArray* dest, const float center[3], float radius, CollisionManager_OverlapFilter filter, void* data);
+
+///
+//Finds the objects in the query broadphase and the static tree whose colliders overlap a world space axis aligned bounding box
+//No collisions are created, so the query may be made at any time outside of the narrowphase.
+//Sphere, AABB and convex hull colliders are tested, other colliders are ignored.
+//
+//Parameters:
+//	dest: A pointer to a dynamic array of GObject* to append the overlapping objects to
+//	bounds: A pointer to the world space AABB
+//	filter: A function deciding which overlapping objects are reported, or NULL to report all of them
+//	data: Passed to the filter
+//
+//Returns:
+//	The number of objects appended to dest
+unsigned int CollisionManager_OverlapAABB(DynamicArray* dest, const struct ColliderData_AABB* bounds, CollisionManager_OverlapFilter filter, void* data);
+
+///
+//Finds how far a world space sphere can be translated along a displacement before it touches an object's collider
+//Sphere, AABB and convex hull colliders are tested, other colliders are never hit.
+//A collider the sphere already touches before moving is left to the narrowphase and is not hit.
+//
+//Parameters:
+//	sphere: A pointer to the world space sphere at the start of the displacement
+//	displacement: The world space translation of the sphere
+//	obj: A pointer to the object whose collider is tested
+//
+//Returns:
+//	The time of impact as a fraction of the displacement from 0 to 1, or NaN if the sphere does not hit the collider
+float CollisionManager_SweepSphere(const struct ColliderData_Sphere* sphere, const float displacement[3], GObject* obj);
+
+///
+//Finds how far a world space axis aligned bounding box can be translated along a displacement before it touches an object's collider
+//Sphere, AABB and convex hull colliders are tested, other colliders are never hit.
+//A collider the AABB already touches before moving is left to the narrowphase and is not hit.
+//
+//Parameters:
+//	bounds: A pointer to the world space AABB at the start of the displacement
+//	displacement: The world space translation of the AABB
+//	obj: A pointer to the object whose collider is tested
+//
+//Returns:
+//	The time of impact as a fraction of the displacement from 0 to 1, or NaN if the AABB does not hit the collider
+float CollisionManager_SweepAABB(const struct ColliderData_AABB* bounds, const float displacement[3], GObject* obj);
+
+///
+//Finds the first collider an object's collider hits when it is translated along a displacement from it's current frame
+//Only the objects the query broadphase and the static tree find within the swept bounds are tested.
+//Moving objects are found where the broadphase last saw them, as it is updated after the bodies are.
+//Objects whose collision layers do not allow them to collide with the object are passed through.
+//
+//Parameters:
+//	hit: The destination of a pointer to the object which was hit, or NULL
+//	obj: A pointer to the object with a sphere, AABB or convex hull collider to sweep
+//	displacement: The world space translation of the object
+//
+//Returns:
+//	The earliest time of impact as a fraction of the displacement from 0 to 1, or NaN if nothing is hit
+float CollisionManager_SweepObject(GObject** hit, GObject* obj, const float displacement[3]);
+
 ///
 //Performs a ray cast against a sphere collider
 //
@@ -249,19 +684,26 @@ unsigned char CollisionManager_RayCastSphere(struct ColliderData_Ray* worldRay,
 //
 //Parameters:
 //	worldRay: a pointer to the ray to test oriented in worldspace
-//	worldSphere: a pointer to the sphere to test oriented in worldspace
+//	sphere: a pointer to the sphere collider to test
+//	sphereFoR: a pointer to the frame of reference with which to orient the sphere
 //
 //returns:
 //	a float indicating the parametric value along the ray where first the intersection point of the ray and the sphere lay
+//	0 if the ray starts within the sphere
 //	will return NaN if no such point exists
 float CollisionManager_GetRaySphereIntersection(struct ColliderData_Ray* worldRay, struct ColliderData_Sphere* sphere, FrameOfReference* sphereFoR);
 
 ///
 //Gets the parametric value of the intersection point between a ray and an AABB
+//returns NaN if no intersection point exists.
 //
 //Parameters:
 //	worldRay: A pointer to the ray to test oriented in worldspace
-//	aabb: A pointer to the AABB to test oriented in worldspace
+//	aabb: A pointer to the AABB collider to test
+//	aabbFoR: A pointer to the frame of reference with which to orient the AABB
+//
+//Returns:
+//	The parametric value along the ray where it first enters the AABB, 0 if the ray starts within the AABB
 float CollisionManager_GetRayAABBIntersection(struct ColliderData_Ray* worldRay, struct ColliderData_AABB* aabb, FrameOfReference* aabbFoR);
 
 #endif
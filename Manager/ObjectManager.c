@@ -2,6 +2,7 @@
 #include <stdio.h>
 
 #include "CollisionManager.h"
+#include "SystemManager.h"
 
 ///
 //Internals
@@ -38,6 +39,80 @@ static void ObjectManager_FreeBuffer(ObjectBuffer* buffer);
 //	objID: The ID of the object to release
 static void ObjectManager_ReleaseObject(unsigned int objID);
 
+///
+//Queues an object marked dirty to be moved within the broadphase on the next update
+//Installed as the game objects' dirty callback, objects which do not belong to the objectPool are ignored.
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_QueueDirtyObject(GObject* obj);
+
+///
+//Determines if an object with a collider is registered into the static tree rather than the active broadphase
+//Checks only that the object has no rigidbody, or a rigidbody frozen in translation and rotation,
+//and that it's collider is not a ray. Static objects which are moved later are made dynamic by the next update.
+//
+//Parameters:
+//	obj: A pointer to the object with a collider
+//
+//Returns:
+//	1 if the object should start out in the static tree, else 0
+static unsigned char ObjectManager_IsStatic(GObject* obj);
+
+///
+//Visits each object marked dirty since the last update once, clearing it's mark
+//Static objects are moved out of the static tree into the active broadphase,
+//every other object with a collider is passed to UpdateObject.
+//
+//Parameters:
+//	UpdateObject: A pointer to the function moving a dynamic object within the active broadphase, or NULL
+static void ObjectManager_UpdateDirtyObjects(void (*UpdateObject)(GObject* obj));
+
+///
+//Passes every live dynamic object with a collider to a function
+//Used to catch a broadphase up on the objects added and moved while another broadphase was in use.
+//
+//Parameters:
+//	UpdateObject: A pointer to the function adding or moving a dynamic object within the broadphase
+static void ObjectManager_UpdateAllObjects(void (*UpdateObject)(GObject* obj));
+
+///
+//Makes a broadphase the one holding the moving objects, and the one the collision manager queries
+//
+//Parameters:
+//	broadphase: The type of the broadphase
+//	structure: A pointer to the object manager's OctTree, SweepAndPrune, AABBTree or SpatialHash matching broadphase
+static void ObjectManager_SelectBroadphase(BroadphaseType broadphase, void* structure);
+
+///
+//Adds a dynamic object to the active broadphase, updating it instead if the broadphase already holds it
+//The oct tree does not update objects it already holds, they must only be added once.
+//
+//Parameters:
+//	obj: A pointer to the object with a collider
+static void ObjectManager_AddToBroadphase(GObject* obj);
+
+///
+//Moves a dynamic object within the oct tree
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_UpdateOctTreeObject(GObject* obj);
+
+///
+//Moves a dynamic object within the sweep and prune
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_UpdateSweepAndPruneObject(GObject* obj);
+
+///
+//Moves a dynamic object within the AABB tree
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_UpdateAABBTreeObject(GObject* obj);
+
 
 ///
 //Definitions
@@ -49,12 +124,14 @@ void ObjectManager_Initialize(void)
 {
 	objectBuffer = ObjectManager_AllocateBuffer();
 	ObjectManager_InitializeBuffer(objectBuffer);
+	GObject_SetDirtyCallback(ObjectManager_QueueDirtyObject);
 }
 
 ///
 //Frees all internal data managed by the Object Manager
 void ObjectManager_Free(void)
 {
+	GObject_SetDirtyCallback(NULL);
 	ObjectManager_FreeBuffer(objectBuffer);
 }
 
@@ -115,23 +192,20 @@ void ObjectManager_Update(void)
 //	struct LinkedList_Node* next = NULL;
 //	while (current != NULL)
 //	{
-	for(unsigned int i = 0; i < objectBuffer->objectPool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(objectBuffer->objectPool); i++)
 	{
 		//next = current->next;
-		GObject* gameObj = MemoryPool_RequestAddress(objectBuffer->objectPool, i);
+		GObject* gameObj = MemoryPool_RequestAddress(objectBuffer->objectPool, MemoryPool_GetLiveID(objectBuffer->objectPool, i));
 	
-		if(gameObj->frameOfReference != NULL)
-		{
-			GObject_Update(gameObj);
+		GObject_Update(gameObj);
 
-		
-			//Clear the game objects list of collisions which occurred with itself last frame
-			if(gameObj->collider != NULL)
+	
+		//Clear the game objects list of collisions which occurred with itself last frame
+		if(gameObj->collider != NULL)
+		{
+			if(gameObj->collider->currentCollisions->size > 0)
 			{
-				if(gameObj->collider->currentCollisions->size > 0)
-				{
-					LinkedList_Clear(gameObj->collider->currentCollisions);
-				}
+				LinkedList_Clear(gameObj->collider->currentCollisions);
 			}
 		}
 		//current = next;
@@ -145,7 +219,9 @@ void ObjectManager_Update(void)
 		next = current->next;
 		unsigned int objID = (unsigned int)(current->data);
 		//ObjectManager_DeleteObject(gameObj);
-		ObjectManager_ReleaseObject(objID);
+		//An object may be queued more than once in a frame, only release it once
+		if(MemoryPool_IsLive(objectBuffer->objectPool, objID))
+			ObjectManager_ReleaseObject(objID);
 		current = next;
 	}
 
@@ -154,10 +230,74 @@ void ObjectManager_Update(void)
 
 ///
 //Updates the internal state of the OctTree
+//Only objects marked dirty since the last update are visited. The tree is rebuilt from scratch
+//when more than ObjectManager_OCTTREE_REBUILD_FRACTION of the live objects are dirty.
 void ObjectManager_UpdateOctTree(void)
 {
 	//OctTree_Update(objectBuffer->octTree, objectBuffer->gameObjects);
-	OCtTree_UpdateWithMemoryPool(objectBuffer->octTree, objectBuffer->objectPool);
+	MemoryPool* pool = objectBuffer->objectPool;
+
+	//Objects have not been added to or moved in the oct tree while another broadphase was in use
+	unsigned char rebuild = objectBuffer->broadphase != BROADPHASE_OCTTREE
+		|| objectBuffer->dirtyObjects->size > MemoryPool_GetNumLive(pool) * ObjectManager_OCTTREE_REBUILD_FRACTION;
+	if(rebuild)
+	{
+		OctTree_RebuildWithMemoryPool(objectBuffer->octTree, pool, objectBuffer->staticTree->map, SystemManager_GetWorkerPool());
+		ObjectManager_SelectBroadphase(BROADPHASE_OCTTREE, objectBuffer->octTree);
+	}
+
+	//A rebuilt oct tree already holds every object where it is now
+	ObjectManager_UpdateDirtyObjects(rebuild ? NULL : ObjectManager_UpdateOctTreeObject);
+}
+
+///
+//Updates the internal state of the sweep and prune
+//Only objects marked dirty since the last update are visited, unless another broadphase was updated instead last frame.
+void ObjectManager_UpdateSweepAndPrune(void)
+{
+	//Objects have not been added to or moved in the sweep and prune while another broadphase was in use
+	if(objectBuffer->broadphase != BROADPHASE_SWEEPANDPRUNE)
+	{
+		ObjectManager_SelectBroadphase(BROADPHASE_SWEEPANDPRUNE, objectBuffer->sweepAndPrune);
+		ObjectManager_UpdateAllObjects(ObjectManager_AddToBroadphase);
+	}
+
+	ObjectManager_UpdateDirtyObjects(ObjectManager_UpdateSweepAndPruneObject);
+
+	SweepAndPrune_Update(objectBuffer->sweepAndPrune);
+}
+
+///
+//Updates the internal state of the AABB tree
+//Only objects marked dirty since the last update are visited, unless another broadphase was updated instead last frame.
+//Unlike the oct tree, the AABB tree has no fixed world bounds.
+void ObjectManager_UpdateAABBTree(void)
+{
+	//Objects have not been added to or moved in the AABB tree while another broadphase was in use
+	if(objectBuffer->broadphase != BROADPHASE_AABBTREE)
+	{
+		ObjectManager_SelectBroadphase(BROADPHASE_AABBTREE, objectBuffer->aabbTree);
+		ObjectManager_UpdateAllObjects(ObjectManager_AddToBroadphase);
+	}
+
+	ObjectManager_UpdateDirtyObjects(ObjectManager_UpdateAABBTreeObject);
+}
+
+///
+//Rebuilds the spatial hash from the current bounds of every object it holds
+//Objects marked dirty are only visited to clear their marks, as every object is hashed again regardless.
+void ObjectManager_UpdateSpatialHash(void)
+{
+	//Objects have not been added to the spatial hash while another broadphase was in use
+	if(objectBuffer->broadphase != BROADPHASE_SPATIALHASH)
+	{
+		ObjectManager_SelectBroadphase(BROADPHASE_SPATIALHASH, objectBuffer->spatialHash);
+		ObjectManager_UpdateAllObjects(ObjectManager_AddToBroadphase);
+	}
+
+	ObjectManager_UpdateDirtyObjects(NULL);
+
+	SpatialHash_Update(objectBuffer->spatialHash, SystemManager_GetWorkerPool());
 }
 
 ///
@@ -173,16 +313,26 @@ unsigned int ObjectManager_RequestObject(void)
 
 //TODO: This should have nothing to do with Objects, only with colliders.
 ///
-//Adds an object with a collider to the Object Manager's internal oct tree
+//Adds an object with a collider to the Object Manager's active broadphase,
+//or to the static tree if it has no body or a fully frozen one.
+//The object's collider and rigidbody must be set up before it is registered.
 //
 //Parameters:
 //	objID: The memory unit ID of the object in the object manager's objectPool to register into the OctTree system
 void ObjectManager_RegisterObject(unsigned int objID)
 {
 	GObject* obj = ObjectManager_LookupObject(objID);
-	if(obj->collider != NULL)
+	if(obj->collider == NULL) return;
+
+	if(ObjectManager_IsStatic(obj))
 	{
-		OctTree_AddAndLog(objectBuffer->octTree, obj);
+		//Moving the object while setting it up must not make it dynamic
+		obj->dirty = 0;
+		BVH_Add(objectBuffer->staticTree, obj);
+	}
+	else
+	{
+		ObjectManager_AddToBroadphase(obj);
 	}
 }
 
@@ -208,7 +358,15 @@ static void ObjectManager_ReleaseObject(unsigned int objID)
 
 	if(GO->collider != NULL)
 	{
-		OctTree_RemoveAndUnLog(objectBuffer->octTree, GO);
+		if(!BVH_Remove(objectBuffer->staticTree, GO))
+		{
+			//Broadphases used before the active one may still hold the object
+			OctTree_RemoveAndUnLog(objectBuffer->octTree, GO);
+			SweepAndPrune_Remove(objectBuffer->sweepAndPrune, GO);
+			AABBTree_Remove(objectBuffer->aabbTree, GO);
+			SpatialHash_Remove(objectBuffer->spatialHash, GO);
+		}
+		CollisionManager_RemoveContacts(GO);
 	}	
 
 	GObject_FreeMembers(objID);
@@ -239,10 +397,18 @@ GObject* ObjectManager_LookupObject(unsigned int objID)
 void ObjectManager_AddObject(GObject* obj)
 {
 	LinkedList_Append(objectBuffer->gameObjects, obj);
-	if(obj->collider != NULL)
+	if(obj->collider == NULL) return;
+
+	if(ObjectManager_IsStatic(obj))
+	{
+		//Moving the object while setting it up must not make it dynamic
+		obj->dirty = 0;
+		BVH_Add(objectBuffer->staticTree, obj);
+	}
+	else
 	{
 		//Add the object
-		OctTree_AddAndLog(objectBuffer->octTree, obj);
+		ObjectManager_AddToBroadphase(obj);
 	}
 }
 
@@ -259,7 +425,15 @@ void ObjectManager_RemoveObject(GObject* obj)
 	LinkedList_RemoveValue(objectBuffer->gameObjects, obj);
 	if(obj->collider != NULL)
 	{
-		OctTree_RemoveAndUnLog(objectBuffer->octTree, obj);
+		if(!BVH_Remove(objectBuffer->staticTree, obj))
+		{
+			//Broadphases used before the active one may still hold the object
+			OctTree_RemoveAndUnLog(objectBuffer->octTree, obj);
+			SweepAndPrune_Remove(objectBuffer->sweepAndPrune, obj);
+			AABBTree_Remove(objectBuffer->aabbTree, obj);
+			SpatialHash_Remove(objectBuffer->spatialHash, obj);
+		}
+		CollisionManager_RemoveContacts(obj);
 	}
 }
 
@@ -316,10 +490,29 @@ static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer)
 	//LinkedList_Initialize(buffer->gameObjects);
 
 	buffer->octTree = OctTree_Allocate();
+	buffer->octTree->looseness = ObjectManager_OCTTREE_LOOSENESS;
 	OctTree_Initialize(buffer->octTree, -100.0f, 100.0f, -100.0f, 100.0f, -100.0f, 100.0f);
 
+	buffer->sweepAndPrune = SweepAndPrune_Allocate();
+	SweepAndPrune_Initialize(buffer->sweepAndPrune, ObjectManager_SWEEPANDPRUNE_AXIS);
+
+	buffer->aabbTree = AABBTree_Allocate();
+	AABBTree_Initialize(buffer->aabbTree, ObjectManager_AABBTREE_MARGIN);
+
+	buffer->spatialHash = SpatialHash_Allocate();
+	SpatialHash_Initialize(buffer->spatialHash, ObjectManager_SPATIALHASH_CELL_SIZE);
+	buffer->broadphase = BROADPHASE_OCTTREE;
+
 	buffer->objectPool = MemoryPool_Allocate();
 	MemoryPool_Initialize(buffer->objectPool, sizeof(GObject));
+
+	buffer->staticTree = BVH_Allocate();
+	BVH_Initialize(buffer->staticTree);
+	CollisionManager_SetStaticTree(buffer->staticTree, buffer->objectPool);
+	CollisionManager_SetQueryBroadphase(buffer->broadphase, buffer->octTree);
+
+	buffer->dirtyObjects = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->dirtyObjects, sizeof(unsigned int));
 }
 
 ///
@@ -331,19 +524,21 @@ static void ObjectManager_FreeBuffer(ObjectBuffer* buffer)
 {
 	//Free the oct tree
 	OctTree_Free(buffer->octTree);
+	SweepAndPrune_Free(buffer->sweepAndPrune);
+	AABBTree_Free(buffer->aabbTree);
+	SpatialHash_Free(buffer->spatialHash);
+	CollisionManager_SetStaticTree(NULL, NULL);
+	CollisionManager_SetQueryBroadphase(buffer->broadphase, NULL);
+	BVH_Free(buffer->staticTree);
 
 	//Delete all Objects being held in the object buffer
 	//struct LinkedList_Node* current = buffer->gameObjects->head;
 
 	//while (current != NULL)
 	//{
-	for(unsigned int i = 0; i < buffer->objectPool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(buffer->objectPool); i++)
 	{
-		GObject* obj = (GObject*)MemoryPool_RequestAddress(buffer->objectPool, i);
-		if(obj->frameOfReference != NULL)
-		{
-			GObject_FreeMembers(i);
-		}
+		GObject_FreeMembers(MemoryPool_GetLiveID(buffer->objectPool, i));
 		//current = current->next;
 	}
 
@@ -353,4 +548,160 @@ static void ObjectManager_FreeBuffer(ObjectBuffer* buffer)
 	LinkedList_Free(buffer->toDelete);
 
 	MemoryPool_Free(buffer->objectPool);
+
+	DynamicArray_Free(buffer->dirtyObjects);
+}
+
+///
+//Determines if an object with a collider is registered into the static tree rather than the active broadphase
+//Checks only that the object has no rigidbody, or a rigidbody frozen in translation and rotation,
+//and that it's collider is not a ray. Static objects which are moved later are made dynamic by the next update.
+//
+//Parameters:
+//	obj: A pointer to the object with a collider
+//
+//Returns:
+//	1 if the object should start out in the static tree, else 0
+static unsigned char ObjectManager_IsStatic(GObject* obj)
+{
+	if(obj->collider->type == COLLIDER_RAY) return 0;
+	return obj->body == NULL || (obj->body->freezeTranslation && obj->body->freezeRotation);
+}
+
+///
+//Queues an object marked dirty to be moved within the broadphase on the next update
+//Installed as the game objects' dirty callback, objects which do not belong to the objectPool are ignored.
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_QueueDirtyObject(GObject* obj)
+{
+	unsigned int objID = MemoryPool_GetID(objectBuffer->objectPool, obj);
+	if(objID == MemoryPool_NULL_ID) return;
+
+	DynamicArray_Append(objectBuffer->dirtyObjects, &objID);
+}
+
+///
+//Visits each object marked dirty since the last update once, clearing it's mark
+//Static objects are moved out of the static tree into the active broadphase,
+//every other object with a collider is passed to UpdateObject.
+//
+//Parameters:
+//	UpdateObject: A pointer to the function moving a dynamic object within the active broadphase, or NULL
+static void ObjectManager_UpdateDirtyObjects(void (*UpdateObject)(GObject* obj))
+{
+	MemoryPool* pool = objectBuffer->objectPool;
+	unsigned int* dirtyIDs = (unsigned int*)objectBuffer->dirtyObjects->data;
+	unsigned int numDirty = objectBuffer->dirtyObjects->size;
+
+	for(unsigned int i = 0; i < numDirty; i++)
+	{
+		//Objects released since being marked have had their memory cleared,
+		//and objects marked more than once are only updated the first time.
+		if(!MemoryPool_IsLive(pool, dirtyIDs[i])) continue;
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, dirtyIDs[i]);
+		if(!obj->dirty) continue;
+
+		obj->dirty = 0;
+		if(obj->collider == NULL) continue;
+		if(BVH_Remove(objectBuffer->staticTree, obj))
+		{
+			//Objects without bodies may be moved every frame by their states,
+			//which would rebuild the whole static tree each time they are.
+			ObjectManager_AddToBroadphase(obj);
+		}
+		else if(UpdateObject != NULL)
+		{
+			UpdateObject(obj);
+		}
+	}
+
+	DynamicArray_Clear(objectBuffer->dirtyObjects);
+}
+
+///
+//Passes every live dynamic object with a collider to a function
+//Used to catch a broadphase up on the objects added and moved while another broadphase was in use.
+//
+//Parameters:
+//	UpdateObject: A pointer to the function adding or moving a dynamic object within the broadphase
+static void ObjectManager_UpdateAllObjects(void (*UpdateObject)(GObject* obj))
+{
+	MemoryPool* pool = objectBuffer->objectPool;
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
+	{
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
+		if(obj->collider != NULL && !BVH_Contains(objectBuffer->staticTree, obj))
+		{
+			UpdateObject(obj);
+		}
+	}
+}
+
+///
+//Makes a broadphase the one holding the moving objects, and the one the collision manager queries
+//
+//Parameters:
+//	broadphase: The type of the broadphase
+//	structure: A pointer to the object manager's OctTree, SweepAndPrune, AABBTree or SpatialHash matching broadphase
+static void ObjectManager_SelectBroadphase(BroadphaseType broadphase, void* structure)
+{
+	objectBuffer->broadphase = broadphase;
+	CollisionManager_SetQueryBroadphase(broadphase, structure);
+}
+
+///
+//Adds a dynamic object to the active broadphase, updating it instead if the broadphase already holds it
+//The oct tree does not update objects it already holds, they must only be added once.
+//
+//Parameters:
+//	obj: A pointer to the object with a collider
+static void ObjectManager_AddToBroadphase(GObject* obj)
+{
+	switch(objectBuffer->broadphase)
+	{
+	case BROADPHASE_OCTTREE:
+		OctTree_AddAndLog(objectBuffer->octTree, obj);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE:
+		SweepAndPrune_Add(objectBuffer->sweepAndPrune, obj);
+		break;
+	case BROADPHASE_AABBTREE:
+		AABBTree_Add(objectBuffer->aabbTree, obj);
+		break;
+	case BROADPHASE_SPATIALHASH:
+		SpatialHash_Add(objectBuffer->spatialHash, obj);
+		break;
+	}
+}
+
+///
+//Moves a dynamic object within the oct tree
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_UpdateOctTreeObject(GObject* obj)
+{
+	OctTree_UpdateObject(objectBuffer->octTree, obj);
+}
+
+///
+//Moves a dynamic object within the sweep and prune
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_UpdateSweepAndPruneObject(GObject* obj)
+{
+	SweepAndPrune_UpdateObject(objectBuffer->sweepAndPrune, obj);
+}
+
+///
+//Moves a dynamic object within the AABB tree
+//
+//Parameters:
+//	obj: A pointer to the object which moved
+static void ObjectManager_UpdateAABBTreeObject(GObject* obj)
+{
+	AABBTree_UpdateObject(objectBuffer->aabbTree, obj);
 }
@@ -4,16 +4,37 @@
 #include "../Data/LinkedList.h"
 #include "../GObject/GObject.h"
 #include "../Data/OctTree.h"
+#include "../Data/SweepAndPrune.h"
+#include "../Data/AABBTree.h"
+#include "../Data/BVH.h"
+#include "../Data/SpatialHash.h"
 #include "../Data/HashMap.h"
 #include "../Data/MemoryPool.h"
+#include "CollisionManager.h"
+
+//Fraction of live objects which must be dirty before the oct tree is rebuilt instead of updated
+#define ObjectManager_OCTTREE_REBUILD_FRACTION 0.5f
+//Looseness of the oct tree, 0 for a classic oct tree which stores objects in every leaf they overlap
+#define ObjectManager_OCTTREE_LOOSENESS OctTree_DEFAULT_LOOSENESS
+//Axis the sweep and prune sweeps along until the objects are spread further along another
+#define ObjectManager_SWEEPANDPRUNE_AXIS 0
+//Distance the AABB tree fattens each object's bounds by, objects moving less are not reinserted
+#define ObjectManager_AABBTREE_MARGIN AABBTree_DEFAULT_MARGIN
+#define ObjectManager_SPATIALHASH_CELL_SIZE SpatialHash_AUTO_CELL_SIZE
 
 typedef struct ObjectBuffer
 {
 	LinkedList* toDelete;
 	LinkedList* gameObjects;
 	OctTree* octTree;
+	SweepAndPrune* sweepAndPrune;
+	AABBTree* aabbTree;
+	SpatialHash* spatialHash;
+	BroadphaseType broadphase;	//Broadphase holding the moving objects, the only one kept up to date
+	BVH* staticTree;		//Colliders which have not moved since they were registered, kept out of the broadphases and only tested against moving colliders
 
 	MemoryPool* objectPool;
+	DynamicArray* dirtyObjects;	//IDs of objects whose frame of reference changed since the broadphase was last updated
 } ObjectBuffer;
 
 //Internal
@@ -42,8 +63,27 @@ void ObjectManager_Update(void);
 
 ///
 //Updates the internal state of the OctTree
+//Only objects marked dirty since the last update are visited. The tree is rebuilt from scratch
+//when more than ObjectManager_OCTTREE_REBUILD_FRACTION of the live objects are dirty,
+//or when another broadphase was updated instead last frame.
 void ObjectManager_UpdateOctTree(void);
 
+///
+//Updates the internal state of the sweep and prune
+//Only objects marked dirty since the last update are visited, unless another broadphase was updated instead last frame.
+void ObjectManager_UpdateSweepAndPrune(void);
+
+///
+//Updates the internal state of the AABB tree
+//Only objects marked dirty since the last update are visited, unless another broadphase was updated instead last frame.
+//Unlike the oct tree, the AABB tree has no fixed world bounds.
+void ObjectManager_UpdateAABBTree(void);
+
+///
+//Rebuilds the spatial hash from the current bounds of every object it holds
+//Objects marked dirty are only visited to clear their marks, as every object is hashed again regardless.
+void ObjectManager_UpdateSpatialHash(void);
+
 ///
 //Requests an Object Memory Unit ID with which to create a new GObject
 //
@@ -53,7 +93,8 @@ unsigned int ObjectManager_RequestObject(void);
 
 //TODO: This should have nothing to do with Objects, only with colliders.
 ///
-//Adds an object with a collider to the Object Manager's internal oct tree
+//Adds an object with a collider to the Object Manager's active broadphase,
+//or to the static tree if it has no body or a fully frozen one.
 //
 //Parameters:
 //	objID: The memory unit ID of the object in the object manager's objectPool to register into the OctTree system
@@ -3,8 +3,11 @@
 #include <stdio.h>
 #include <float.h>
 #include <math.h>
+#include <string.h>
 
 #include "TimeManager.h"
+#include "SystemManager.h"
+#include "ObjectManager.h"
 
 //Internals
 PhysicsBuffer* physicsBuffer = 0;
@@ -40,6 +43,15 @@ static void PhysicsManager_FreeBuffer(PhysicsBuffer* buffer);
 //      collisions: The collision which needs to be resolved
 static void PhysicsManager_ResolveCollision(struct Collision* collision);
 
+///
+//Sweeps the collider of a body with continuous collision detection along the motion of it's last update,
+//and pulls the body back to the first collider in it's path so it can not pass through it
+//
+//Parameters:
+//      obj: The object whose body has just been updated
+//      start: The world space position of the body before it's update
+static void PhysicsManager_SweepBody(GObject* obj, const float start[3]);
+
 ///
 //Determines if a collision needs to be resolved, or if it is resolving itself
 //
@@ -328,8 +340,18 @@ void PhysicsManager_UpdateBodies(LinkedList* gameObjects)
 			if( gameObject->body->physicsOn)
 			{
 				PhysicsManager_ApplyGlobals(gameObject->body);
-				PhysicsManager_UpdateLinearPhysicsOfBody(gameObject->body, dt);
-				PhysicsManager_UpdateRotationalPhysicsOfBody(gameObject->body, dt);
+				float start[3];
+				memcpy(start, gameObject->body->frame->position->components, sizeof(float) * 3);
+				unsigned char moved = PhysicsManager_UpdateLinearPhysicsOfBody(gameObject->body, dt);
+				moved |= PhysicsManager_UpdateRotationalPhysicsOfBody(gameObject->body, dt);
+				if(moved && gameObject->body->continuousCollision && gameObject->collider != NULL)
+				{
+					PhysicsManager_SweepBody(gameObject, start);
+				}
+				if(moved)
+				{
+					GObject_MarkDirty(gameObject);
+				}
 			}
 		}
 
@@ -348,20 +370,76 @@ void PhysicsManager_UpdateBodiesWithMemoryPool(MemoryPool* pool)
 {
 	float dt = TimeManager_GetDeltaSec();
 
-	for(unsigned int i = 0; i < pool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
 	{
-		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, i);
+		GObject* obj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
 		if(obj->body != NULL)
 		{
 			if(obj->body->physicsOn)
 			{
 				PhysicsManager_ApplyGlobals(obj->body);
-				PhysicsManager_UpdateLinearPhysicsOfBody(obj->body, dt);
-				PhysicsManager_UpdateRotationalPhysicsOfBody(obj->body, dt);
+				float start[3];
+				memcpy(start, obj->body->frame->position->components, sizeof(float) * 3);
+				unsigned char moved = PhysicsManager_UpdateLinearPhysicsOfBody(obj->body, dt);
+				moved |= PhysicsManager_UpdateRotationalPhysicsOfBody(obj->body, dt);
+				if(moved && obj->body->continuousCollision && obj->collider != NULL)
+				{
+					PhysicsManager_SweepBody(obj, start);
+				}
+				if(moved)
+				{
+					GObject_MarkDirty(obj);
+				}
+			}
+		}
+	}
+}
 
+///
+//Sweeps the collider of a body with continuous collision detection along the motion of it's last update,
+//and pulls the body back to the first collider in it's path so it can not pass through it
+//
+//Parameters:
+//	obj: The object whose body has just been updated
+//	start: The world space position of the body before it's update
+static void PhysicsManager_SweepBody(GObject* obj, const float start[3])
+{
+	float* position = obj->body->frame->position->components;
+	float displacement[3] =
+	{
+		position[0] - start[0],
+		position[1] - start[1],
+		position[2] - start[2]
+	};
+	float distance = sqrtf(displacement[0] * displacement[0] + displacement[1] * displacement[1] + displacement[2] * displacement[2]);
+	if(distance <= FLT_EPSILON) return;
+
+	//Sweep from where the body started, in it's new orientation
+	memcpy(position, start, sizeof(float) * 3);
+	float timeOfImpact = CollisionManager_SweepObject(NULL, obj, displacement);
+
+	float fraction = 1.0f;
+	if(!isnan(timeOfImpact))
+	{
+		//Carry the body slightly into the collider it hits so the collision is resolved this update
+		struct ColliderData_AABB bounds;
+		float extent = 0.0f;
+		if(Collider_GetWorldAABB(&bounds, obj->collider, obj->body->frame))
+		{
+			for(int i = 0; i < 3; i++)
+			{
+				extent += fabsf(displacement[i]) * (bounds.max[i] - bounds.min[i]) * 0.5f;
 			}
+			extent /= distance;
 		}
+
+		fraction = timeOfImpact + PhysicsManager_CCD_PENETRATION * extent / distance;
+		if(fraction > 1.0f) fraction = 1.0f;
 	}
+
+	position[0] += displacement[0] * fraction;
+	position[1] += displacement[1] * fraction;
+	position[2] += displacement[2] * fraction;
 }
 
 ///
@@ -411,7 +489,10 @@ void PhysicsManager_ApplyGlobals(RigidBody* body)
 //Parameters:
 //	body: The body to update
 //	dt: The change in time since last update
-void PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt)
+//
+//Returns:
+//	1 if the body's position changed, else 0
+unsigned char PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt)
 {
 	//F = MA
 	//A = 1/M * F
@@ -449,6 +530,8 @@ void PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt)
 	Vector_Increment(body->velocity, &AT);	
 	//V += 1/M * J
 	Vector_Increment(body->velocity, body->netImpulse);
+
+	return VAT2.components[0] != 0.0f || VAT2.components[1] != 0.0f || VAT2.components[2] != 0.0f;
 }
 
 ///
@@ -459,7 +542,10 @@ void PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt)
 //Parameters:
 //	body: The body to update
 //	dt: The change in time since last update
-void PhysicsManager_UpdateRotationalPhysicsOfBody(RigidBody* body, float dt)
+//
+//Returns:
+//	1 if the body's orientation changed, else 0
+unsigned char PhysicsManager_UpdateRotationalPhysicsOfBody(RigidBody* body, float dt)
 {
 	Vector AT;
 	Vector_INIT_ON_STACK(AT, 3);
@@ -497,8 +583,10 @@ void PhysicsManager_UpdateRotationalPhysicsOfBody(RigidBody* body, float dt)
 	if(theta != 0)
 	{
 		FrameOfReference_Rotate(body->frame, &VT, theta);
+		return 1;
 	}
 
+	return 0;
 }
 
 ///
@@ -560,9 +648,9 @@ void PhysicsManager_UpdateObjectsWithMemoryPool(MemoryPool* pool)
 	GObject* gameObject = NULL;
 
 
-	for(unsigned int i = 0; i < pool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
 	{
-		gameObject = (GObject*)MemoryPool_RequestAddress(pool, i);
+		gameObject = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
 		if(gameObject->body != NULL)
 		{
 			if( gameObject->body->physicsOn)
@@ -628,15 +716,8 @@ static void PhysicsManager_ResolveCollision(struct Collision* collision)
 	PhysicsManager_DecoupleCollision(collision);
 
 	//Step 2: Calculate the point of collision
-	//In the case that one of the objects is an AABB, there will be different collision points. Allocate an array of two vectors to store these points.
-	Vector* pointsOfCollision[2];
-
-	//Allocate and initialize these vectors individually
-	pointsOfCollision[0] = Vector_Allocate();
-	pointsOfCollision[1] = Vector_Allocate();
-
-	Vector_Initialize(pointsOfCollision[0], 3);
-	Vector_Initialize(pointsOfCollision[1], 3);
+	//In the case that one of the objects is an AABB, there will be different collision points. Get an array of two vectors from frame memory to store these points.
+	Vector** pointsOfCollision = SystemManager_RequestFrameVectors(2, 3);
 
 	PhysicsManager_DetermineCollisionPoints(pointsOfCollision, collision);
 
@@ -663,11 +744,6 @@ static void PhysicsManager_ResolveCollision(struct Collision* collision)
 		
 		PhysicsManager_ApplyRollingResistance(collision, pointsOfCollision, rollingResistance);
 	}
-		
-
-	//Free the vectors used to hold the collision points
-	Vector_Free(pointsOfCollision[0]);
-	Vector_Free(pointsOfCollision[1]);
 
 
 }
@@ -788,6 +864,7 @@ static void PhysicsManager_DecoupleCollision(struct Collision* collision)
 		//MTV always points toward obj1, so move obj1 along mtv
 		Vector_GetScalarProduct(&resolutionVector, collision->minimumTranslationVector, scale1);
 		FrameOfReference_Translate(body1->frame, &resolutionVector);
+		GObject_MarkDirty(collision->obj1);
 	}
 
 	if(body2 != NULL && !body2->freezeTranslation && body2->inverseMass != 0.0f)
@@ -795,6 +872,7 @@ static void PhysicsManager_DecoupleCollision(struct Collision* collision)
 		//MTV always points toward obj1, so move obj2 opposite mtv
 		Vector_GetScalarProduct(&resolutionVector, collision->minimumTranslationVector, -scale2);
 		FrameOfReference_Translate(body2->frame, &resolutionVector);
+		GObject_MarkDirty(collision->obj2);
 	}
 }
 
@@ -994,24 +1072,9 @@ static void PhysicsManager_DetermineCollisionPointConvexHull(Vector* dest,
 	//Create an unsigned character to serve as a boolean for whether the collision point was found yet
 	unsigned char found = 0;
 
-	//allocate arrays of vectors to hold the model space oriented points of colliders
-	Vector** modelOrientedPoints1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->points->size);
-	Vector** modelOrientedPoints2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->points->size);
-
-	//Allocate & initialize individual vectors in array
-	for(unsigned int i = 0; i < convexHull1->points->size; i++)
-	{
-		modelOrientedPoints1[i] = Vector_Allocate();
-		Vector_Initialize(modelOrientedPoints1[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array
-	for(unsigned int i = 0; i < convexHull2->points->size; i++)
-	{
-		modelOrientedPoints2[i] = Vector_Allocate();
-		Vector_Initialize(modelOrientedPoints2[i], 3);
-	}
-
+	//Get arrays of vectors from frame memory to hold the model space oriented points of colliders
+	Vector** modelOrientedPoints1 = SystemManager_RequestFrameVectors(convexHull1->points->size, 3);
+	Vector** modelOrientedPoints2 = SystemManager_RequestFrameVectors(convexHull2->points->size, 3);
 
 	//Get the points of the collider oriented in modelSpace
 	ConvexHullCollider_GetOrientedModelPoints(modelOrientedPoints1, convexHull1, convexFrame1);
@@ -1108,19 +1171,6 @@ static void PhysicsManager_DetermineCollisionPointConvexHull(Vector* dest,
 		found = 1;
 	}
 
-	//Delete arrays of modelSpace oriented collider points
-	for(unsigned int i = 0; i < convexHull1->points->size; i++)
-	{
-		Vector_Free(modelOrientedPoints1[i]);
-	}
-	free(modelOrientedPoints1);
-	for(unsigned int i = 0; i < convexHull2->points->size; i++)
-	{
-		Vector_Free(modelOrientedPoints2[i]);
-	}
-	free(modelOrientedPoints2);
-
-
 	//Delete dynamic arrays of furthest points
 	DynamicArray_Free(furthestPoints1);
 	DynamicArray_Free(furthestPoints2);
@@ -20,6 +20,10 @@
 #include "../Data/LinkedList.h"
 #include "../Data/MemoryPool.h"
 
+//Fraction of a body's extent along it's motion by which a swept body is carried past the time of impact,
+//so the narrowphase finds the collision and resolves it
+#define PhysicsManager_CCD_PENETRATION 0.1f
+
 typedef struct PhysicsBuffer
 {
 	LinkedList* globalForces;			//Contains the list of global forces to apply to all bodies upon each update
@@ -99,7 +103,10 @@ void PhysicsManager_ApplyGlobals(RigidBody* body);
 //Parameters:
 //	body: The body to update
 //	dt: The change in time since last update
-void PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt);
+//
+//Returns:
+//	1 if the body's position changed, else 0
+unsigned char PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt);
 
 ///
 //Updates the rotational physics of a rigidbody
@@ -109,7 +116,10 @@ void PhysicsManager_UpdateLinearPhysicsOfBody(RigidBody* body, float dt);
 //Parameters:
 //	body: The body to update
 //	dt: The change in time since last update
-void PhysicsManager_UpdateRotationalPhysicsOfBody(RigidBody* body, float dt);
+//
+//Returns:
+//	1 if the body's orientation changed, else 0
+unsigned char PhysicsManager_UpdateRotationalPhysicsOfBody(RigidBody* body, float dt);
 
 ///
 //Updates the Frame of reference component of all gameObjects to match their rigidbodies
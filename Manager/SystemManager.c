@@ -24,6 +24,17 @@ static SystemBuffer* SystemManager_AllocateBuffer(void)
 static void SystemManager_InitializeBuffer(SystemBuffer* buffer)
 {
 	buffer->running = 1;
+
+	for(int i = 0; i < 2; i++)
+	{
+		buffer->frameArenas[i] = MemoryArena_Allocate();
+		MemoryArena_Initialize(buffer->frameArenas[i], SystemManager_FRAME_ARENA_SIZE);
+	}
+	buffer->currentFrameArena = 0;
+
+	//The main thread works alongside the pool
+	buffer->workers = WorkerPool_Allocate();
+	WorkerPool_Initialize(buffer->workers, WorkerPool_GetNumProcessors() - 1);
 }
 
 //Externals
@@ -42,6 +53,9 @@ void SystemManager_Initialize(void)
 //Free's the internal data of the system system manager
 void SystemManager_Free(void)
 {
+	MemoryArena_Free(systemBuffer->frameArenas[0]);
+	MemoryArena_Free(systemBuffer->frameArenas[1]);
+	WorkerPool_Free(systemBuffer->workers);
 	free(systemBuffer);
 }
 
@@ -64,3 +78,95 @@ uint8_t SystemManager_GetRunning(void)
 {
 	return systemBuffer->running;
 }
+
+///
+//Begins a new frame of frame memory.
+//Memory requested during the previous frame stays valid through this frame,
+//memory requested before that is released. Called at the start of every update.
+void SystemManager_ResetFrameMemory(void)
+{
+	//Collisions found in one frame are read by object states at the start of the next,
+	//so the arena filled last frame is kept and the one before it is reused.
+	systemBuffer->currentFrameArena ^= 1;
+	MemoryArena_Reset(systemBuffer->frameArenas[systemBuffer->currentFrameArena]);
+}
+
+///
+//Requests uninitialized memory which lives until the end of the next frame
+//Never free memory requested from here.
+//
+//Parameters:
+//	size: The number of bytes to request
+//
+//Returns:
+//	A pointer to the requested memory
+void* SystemManager_RequestFrameMemory(size_t size)
+{
+	return MemoryArena_Request(systemBuffer->frameArenas[systemBuffer->currentFrameArena], size);
+}
+
+///
+//Requests an array of zeroed vectors which live until the end of the next frame
+//Never free the array or it's vectors.
+//
+//Parameters:
+//	count: The number of vectors in the array
+//	dimension: The dimension of each vector
+//
+//Returns:
+//	An array of pointers to the requested vectors
+Vector** SystemManager_RequestFrameVectors(unsigned int count, uint16_t dimension)
+{
+	return SystemManager_RequestArenaVectors(systemBuffer->frameArenas[systemBuffer->currentFrameArena], count, dimension);
+}
+
+///
+//Requests an array of zeroed vectors from a memory arena
+//The vectors live until the arena is reset. Never free the array or it's vectors.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to request the vectors from
+//	count: The number of vectors in the array
+//	dimension: The dimension of each vector
+//
+//Returns:
+//	An array of pointers to the requested vectors
+Vector** SystemManager_RequestArenaVectors(MemoryArena* arena, unsigned int count, uint16_t dimension)
+{
+	Vector** vectors = MemoryArena_Request(arena, sizeof(Vector*) * count);
+	Vector* vectorData = MemoryArena_Request(arena, sizeof(Vector) * count);
+	float* components = MemoryArena_RequestZeroed(arena, sizeof(float) * dimension * count);
+
+	for(unsigned int i = 0; i < count; i++)
+	{
+		vectorData[i].dimension = dimension;
+		vectorData[i].components = components + i * dimension;
+		vectors[i] = vectorData + i;
+	}
+
+	return vectors;
+}
+
+///
+//Gets the largest number of bytes of frame memory requested in a single frame
+//Use this to size SystemManager_FRAME_ARENA_SIZE.
+//
+//Returns:
+//	The high water mark of the frame arenas in bytes
+size_t SystemManager_GetFrameMemoryHighWaterMark(void)
+{
+	size_t mark0 = MemoryArena_GetHighWaterMark(systemBuffer->frameArenas[0]);
+	size_t mark1 = MemoryArena_GetHighWaterMark(systemBuffer->frameArenas[1]);
+	return mark0 > mark1 ? mark0 : mark1;
+}
+
+///
+//Gets the worker pool shared by the engine's systems.
+//The pool has one thread per processor besides the main thread.
+//
+//Returns:
+//	A pointer to the system's worker pool
+WorkerPool* SystemManager_GetWorkerPool(void)
+{
+	return systemBuffer->workers;
+}
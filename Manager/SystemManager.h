@@ -2,10 +2,23 @@
 #define SYSTEMMANAGER_H
 
 #include <stdint.h>
+#include <stddef.h>
+
+#include "../Data/MemoryArena.h"
+#include "../Data/WorkerPool.h"
+#include "../Math/Vector.h"
+
+//Initial size in bytes of each frame arena
+#define SystemManager_FRAME_ARENA_SIZE (256 * 1024)
 
 typedef struct SystemBuffer
 {
 	uint8_t running;	//Is the system running? 
+
+	MemoryArena* frameArenas[2];	//Arenas for memory which lives for one frame, alternating each frame
+	uint8_t currentFrameArena;	//Index of the arena serving requests this frame
+
+	WorkerPool* workers;		//Threads shared by systems which split work across processors
 } SystemBuffer;
 
 extern SystemBuffer* systemBuffer; 
@@ -34,5 +47,63 @@ void SystemManager_SetRunning(const uint8_t isRunning);
 //	0 if the system is not running | 1 if the system is running.
 uint8_t SystemManager_GetRunning(void);
 
+///
+//Begins a new frame of frame memory.
+//Memory requested during the previous frame stays valid through this frame,
+//memory requested before that is released. Called at the start of every update.
+void SystemManager_ResetFrameMemory(void);
+
+///
+//Requests uninitialized memory which lives until the end of the next frame
+//Never free memory requested from here.
+//
+//Parameters:
+//	size: The number of bytes to request
+//
+//Returns:
+//	A pointer to the requested memory
+void* SystemManager_RequestFrameMemory(size_t size);
+
+///
+//Requests an array of zeroed vectors which live until the end of the next frame
+//Never free the array or it's vectors.
+//
+//Parameters:
+//	count: The number of vectors in the array
+//	dimension: The dimension of each vector
+//
+//Returns:
+//	An array of pointers to the requested vectors
+Vector** SystemManager_RequestFrameVectors(unsigned int count, uint16_t dimension);
+
+///
+//Requests an array of zeroed vectors from a memory arena
+//The vectors live until the arena is reset. Never free the array or it's vectors.
+//
+//Parameters:
+//	arena: A pointer to the memory arena to request the vectors from
+//	count: The number of vectors in the array
+//	dimension: The dimension of each vector
+//
+//Returns:
+//	An array of pointers to the requested vectors
+Vector** SystemManager_RequestArenaVectors(MemoryArena* arena, unsigned int count, uint16_t dimension);
+
+///
+//Gets the largest number of bytes of frame memory requested in a single frame
+//Use this to size SystemManager_FRAME_ARENA_SIZE.
+//
+//Returns:
+//	The high water mark of the frame arenas in bytes
+size_t SystemManager_GetFrameMemoryHighWaterMark(void);
+
+///
+//Gets the worker pool shared by the engine's systems.
+//The pool has one thread per processor besides the main thread.
+//
+//Returns:
+//	A pointer to the system's worker pool
+WorkerPool* SystemManager_GetWorkerPool(void);
+
 
 #endif
@@ -90,7 +90,8 @@ void RigidBody_Initialize(RigidBody* body, const FrameOfReference* startingFrame
 	body->freezeTranslation = 0;
 	body->freezeRotation = 0;
 
-	
+	//Motion is only swept for bodies which need it
+	body->continuousCollision = 0;
 }
 
 ///
@@ -127,6 +128,7 @@ void RigidBody_InitializeDeepCopy(RigidBody* copy, RigidBody* original)
 	copy->freezeRotation = original->freezeRotation;
 	copy->freezeTranslation = original->freezeTranslation;
 	copy->physicsOn = original->physicsOn;
+	copy->continuousCollision = original->continuousCollision;
 }
 
 ///
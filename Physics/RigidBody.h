@@ -27,6 +27,7 @@ typedef struct RigidBody
 	unsigned char freezeTranslation;	//Freezes the rigidbody so it can not have any linear forces applied
 	unsigned char freezeRotation;		//Freezes the rigidbody so it cannot have any torques applied
 	unsigned char physicsOn;		//Boolean to turn physics off. 1 = on | 0 = off.
+	unsigned char continuousCollision;	//Boolean to sweep the motion of fast bodies so they stop at the first collider in their path. 1 = on | 0 = off.
 } RigidBody;
 
 ///
@@ -330,12 +330,13 @@ static void RayTracerGeometryShaderProgram_RenderWithMemoryPool(ShaderProgram* p
 	//struct LinkedList_Node* current = gameObjects->head;
 	GObject* gameObj = NULL;
 	//while(current != NULL)
-	for(unsigned int i = 0; i < pool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
 	{
-		gameObj = (GObject*)MemoryPool_RequestAddress(pool, i);
+		unsigned int objID = MemoryPool_GetLiveID(pool, i);
+		gameObj = (GObject*)MemoryPool_RequestAddress(pool, objID);
 		if(gameObj->mesh != NULL)
 		{
-			RayTracerGeometryShaderProgram_SetVariableUniforms(prog,  buffer->camera, gameObj, i);
+			RayTracerGeometryShaderProgram_SetVariableUniforms(prog,  buffer->camera, gameObj, objID);
 			Mesh_Render(gameObj->mesh, gameObj->mesh->primitive);
 		}
 	}
@@ -708,9 +708,9 @@ static void RayTracerRenderPipeline_RenderWithMemoryPool(RenderPipeline* pipelin
 	//GObject* gameObj = NULL;
 	//while(current != NULL)
 	//{
-	for(unsigned int i = 0; i < pool->pool->capacity; i++)
+	for(unsigned int i = 0; i < MemoryPool_GetNumLive(pool); i++)
 	{
-		GObject* gameObj = (GObject*)MemoryPool_RequestAddress(pool, i);
+		GObject* gameObj = (GObject*)MemoryPool_RequestAddress(pool, MemoryPool_GetLiveID(pool, i));
 		if(gameObj->light != NULL)
 		{
 			pointShadowParams.light = gameObj;
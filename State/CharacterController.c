@@ -274,6 +274,8 @@ void State_CharacterController_ShootBullet(GObject* GO, State* state)
 			bullet->body = RigidBody_Allocate();
 			RigidBody_Initialize(bullet->body, bullet->frameOfReference, 0.45f);
 			bullet->body->coefficientOfRestitution = 0.2f;
+			//Arrows are fast enough to pass through thin objects between updates
+			bullet->body->continuousCollision = 1;
 
 			bullet->collider = Collider_Allocate();
 			ConvexHullCollider_Initialize(bullet->collider);
@@ -665,6 +665,8 @@ void State_ParkourController_Shoot(GObject* obj, State* state)
 			bullet->body->rollingResistance = 0.2f;	
 			bullet->body->staticFriction = 0.4f;
 			bullet->body->dynamicFriction = 0.2f;	
+			//Bullets are fast enough to pass through thin objects between updates
+			bullet->body->continuousCollision = 1;
 	
 			//Create collider
 			bullet->collider = Collider_Allocate();
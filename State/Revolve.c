@@ -103,4 +103,5 @@ void State_Revolution_Update(GObject* GO, State* state)
 
 	Matrix_GetProductVector(GO->frameOfReference->position, members->frameOfRevolution->rotation, members->startPoint);
 	Vector_Increment(GO->frameOfReference->position, members->frameOfRevolution->position);
+	GObject_MarkDirty(GO);
 }
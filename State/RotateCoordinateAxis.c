@@ -83,5 +83,5 @@ void State_RotateCoordinateAxis_Update(GObject* GO, State* state)
 	*Matrix_Index(GO->frameOfReference->rotation, members->axis, 0) = axis.components[0];
 	*Matrix_Index(GO->frameOfReference->rotation, members->axis, 1) = axis.components[1];
 	*Matrix_Index(GO->frameOfReference->rotation, members->axis, 2) = axis.components[2];
-
+	GObject_MarkDirty(GO);
 }
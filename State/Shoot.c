@@ -109,6 +109,8 @@ void State_Shoot_Update(GObject* obj, State* state)
 			bullet->body->dynamicFriction = 0.85f;
 
 			bullet->body->rollingResistance = 0.6f;
+			//Bullets are fast enough to pass through thin objects between updates
+			bullet->body->continuousCollision = 1;
 
 			/*
 			//Construct a rotation matrix to orient bullet
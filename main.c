@@ -66,6 +66,7 @@ void Init(void)
 {
 
 	//Initialize managers
+	SystemManager_Initialize();
 	CollisionManager_Initialize();
 	KernelManager_Initialize();
 	InputManager_Initialize();
@@ -77,7 +78,6 @@ void Init(void)
 	ObjectManager_Initialize();
 	RenderingManager_Initialize();
 	PhysicsManager_Initialize();
-	SystemManager_Initialize();
 
 
 
@@ -90,26 +90,6 @@ void Init(void)
 	TimeManager_Initialize();
 }
 
-void CalculateOctTreeCollisions(struct OctTree_Node* node)
-{
-	if(node->children != NULL)
-	{
-		for(int i = 0; i < 8; i++)
-		{
-			CalculateOctTreeCollisions(node->children+i);
-		}
-	}
-	else
-	{
-		if(node->data->size != 0)
-		{
-			LinkedList* collisions = CollisionManager_UpdateArray((GObject**)node->data->data, node->data->size);
-			PhysicsManager_ResolveCollisions(collisions);
-		}
-	}
-}
-
-
 ///
 //Draws the current state of the engine
 void Draw(void)
@@ -123,6 +103,9 @@ void Draw(void)
 //
 void Update(int val)
 {
+	//Release frame memory from two frames ago
+	SystemManager_ResetFrameMemory();
+
 	//Update time manager
 	TimeManager_Update();
 
@@ -132,9 +115,27 @@ void Update(int val)
 	//PhysicsManager_Update(ObjectManager_GetObjectBuffer().gameObjects);
 	PhysicsManager_UpdateWithMemoryPool(ObjectManager_GetObjectBuffer().objectPool);
 
-	//Update the oct tree
-	ObjectManager_UpdateOctTree();
-	LinkedList* collisions = CollisionManager_UpdateOctTree(ObjectManager_GetObjectBuffer().octTree);
+	//Update the selected broadphase and find collisions with it
+	LinkedList* collisions;
+	switch(CollisionManager_GetBroadphase())
+	{
+	case BROADPHASE_SWEEPANDPRUNE:
+		ObjectManager_UpdateSweepAndPrune();
+		collisions = CollisionManager_UpdateSweepAndPrune(ObjectManager_GetObjectBuffer().sweepAndPrune);
+		break;
+	case BROADPHASE_AABBTREE:
+		ObjectManager_UpdateAABBTree();
+		collisions = CollisionManager_UpdateAABBTree(ObjectManager_GetObjectBuffer().aabbTree);
+		break;
+	case BROADPHASE_SPATIALHASH:
+		ObjectManager_UpdateSpatialHash();
+		collisions = CollisionManager_UpdateSpatialHash(ObjectManager_GetObjectBuffer().spatialHash);
+		break;
+	default:
+		ObjectManager_UpdateOctTree();
+		collisions = CollisionManager_UpdateOctTree(ObjectManager_GetObjectBuffer().octTree);
+		break;
+	}
 
 
 	//Pass collisions to physics manager to be resolved
@@ -243,6 +244,11 @@ int main(int argc, char* argv[])
 	printf("Physics done\n");
 	TimeManager_Free();
 	printf("Time done\n");
+	printf("Frame memory high water mark: %lu bytes\n", (unsigned long)SystemManager_GetFrameMemoryHighWaterMark());
+	SystemManager_Free();
+	printf("System done\n");
+	LinkedList_FreeNodePool();
+	printf("List nodes done\n");
 
 	return 0;
 }